@@ -0,0 +1,127 @@
+#include "bandwidth_history.h"
+#include <string.h>
+
+void BandwidthHistory::reset(uint32_t nowSec) {
+    memset(_sec, 0, sizeof(_sec));
+    memset(_min, 0, sizeof(_min));
+    memset(_hour, 0, sizeof(_hour));
+    _hourAccUp = 0;
+    _hourAccDown = 0;
+    _lastSec = nowSec;
+    _secIdx = 0;
+    _minIdx = 0;
+    _hourIdx = 0;
+}
+
+void BandwidthHistory::add(uint32_t nowSec, uint32_t bytes, bool isUpload) {
+    if (nowSec != _lastSec) {
+        advance(nowSec);
+    }
+
+    if (isUpload) {
+        _sec[_secIdx].up += bytes;
+        _min[_minIdx].up += bytes;
+        _hourAccUp += bytes;
+    } else {
+        _sec[_secIdx].down += bytes;
+        _min[_minIdx].down += bytes;
+        _hourAccDown += bytes;
+    }
+}
+
+void BandwidthHistory::advance(uint32_t nowSec) {
+    if (nowSec <= _lastSec) {
+        return;
+    }
+
+    // Number of period boundaries crossed at each resolution
+    uint32_t secSteps  = nowSec - _lastSec;
+    uint32_t minSteps  = nowSec / 60 - _lastSec / 60;
+    uint32_t hourSteps = nowSec / 3600 - _lastSec / 3600;
+
+    roll(_sec, SECOND_BUCKETS, _secIdx, secSteps);
+    roll(_min, MINUTE_BUCKETS, _minIdx, minSteps);
+
+    if (hourSteps > 0) {
+        closeHour();
+        roll(_hour, HOUR_BUCKETS, _hourIdx, hourSteps);
+    }
+
+    _lastSec = nowSec;
+}
+
+// Step idx forward, zeroing each slot entered. Long gaps are capped at one
+// full lap since older buckets would be overwritten anyway.
+void BandwidthHistory::roll(TrafficBucket* buckets, uint8_t size, uint8_t& idx, uint32_t steps) {
+    if (steps >= size) {
+        memset(buckets, 0, size * sizeof(TrafficBucket));
+        idx = (uint8_t)((idx + steps) % size);
+        return;
+    }
+    for (uint32_t i = 0; i < steps; i++) {
+        idx = (uint8_t)((idx + 1) % size);
+        buckets[idx].up = 0;
+        buckets[idx].down = 0;
+    }
+}
+
+// Fold the exact byte count of the finished hour into its KiB bucket
+void BandwidthHistory::closeHour() {
+    _hour[_hourIdx].up = (uint32_t)((_hourAccUp + 512) / 1024);
+    _hour[_hourIdx].down = (uint32_t)((_hourAccDown + 512) / 1024);
+    _hourAccUp = 0;
+    _hourAccDown = 0;
+}
+
+uint8_t BandwidthHistory::count(HistoryResolution res) {
+    switch (res) {
+        case HISTORY_SECONDS: return SECOND_BUCKETS;
+        case HISTORY_MINUTES: return MINUTE_BUCKETS;
+        case HISTORY_HOURS:   return HOUR_BUCKETS;
+    }
+    return 0;
+}
+
+uint32_t BandwidthHistory::interval(HistoryResolution res) {
+    switch (res) {
+        case HISTORY_SECONDS: return 1;
+        case HISTORY_MINUTES: return 60;
+        case HISTORY_HOURS:   return 3600;
+    }
+    return 0;
+}
+
+uint64_t BandwidthHistory::uploadAt(HistoryResolution res, uint8_t i) const {
+    return valueAt(res, i, true);
+}
+
+uint64_t BandwidthHistory::downloadAt(HistoryResolution res, uint8_t i) const {
+    return valueAt(res, i, false);
+}
+
+uint64_t BandwidthHistory::valueAt(HistoryResolution res, uint8_t i, bool up) const {
+    uint8_t size = count(res);
+    if (i >= size) {
+        return 0;
+    }
+
+    // Oldest bucket sits just after the current index
+    switch (res) {
+        case HISTORY_SECONDS: {
+            const TrafficBucket& b = _sec[(_secIdx + 1 + i) % size];
+            return up ? b.up : b.down;
+        }
+        case HISTORY_MINUTES: {
+            const TrafficBucket& b = _min[(_minIdx + 1 + i) % size];
+            return up ? b.up : b.down;
+        }
+        case HISTORY_HOURS: {
+            if (i == size - 1) {
+                return up ? _hourAccUp : _hourAccDown;  // Current hour, exact
+            }
+            const TrafficBucket& b = _hour[(_hourIdx + 1 + i) % size];
+            return (uint64_t)(up ? b.up : b.down) * 1024;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+#ifndef BANDWIDTH_HISTORY_H
+#define BANDWIDTH_HISTORY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Fixed-memory, multi-resolution traffic history for one device:
+//   - 60 x 1-second buckets  (last minute)
+//   - 60 x 1-minute buckets  (last hour)
+//   - 168 x 1-hour buckets   (last week)
+//
+// Every add() updates the current bucket of all three levels at once, so no
+// level is ever rebuilt from a finer one. Moving to a new period just steps
+// that level's index and zeroes the slot it lands on, which is O(1) per tick
+// (bounded by the bucket count after long idle gaps).
+//
+// Second and minute buckets count bytes. Hour buckets count KiB so that a
+// saturated link cannot overflow 32 bits; the partial hour is kept exact in
+// 64-bit accumulators until it closes.
+//
+// Time is passed in by the caller (seconds since boot), so the class has no
+// platform dependencies.
+
+enum HistoryResolution {
+    HISTORY_SECONDS,
+    HISTORY_MINUTES,
+    HISTORY_HOURS
+};
+
+struct TrafficBucket {
+    uint32_t up;
+    uint32_t down;
+};
+
+class BandwidthHistory {
+public:
+    static const uint8_t SECOND_BUCKETS = 60;
+    static const uint8_t MINUTE_BUCKETS = 60;
+    static const uint8_t HOUR_BUCKETS   = 168;
+
+    void reset(uint32_t nowSec);
+
+    // Account bytes at time nowSec (advances first if the clock moved)
+    void add(uint32_t nowSec, uint32_t bytes, bool isUpload);
+
+    // Roll periods forward to nowSec without adding traffic
+    void advance(uint32_t nowSec);
+
+    // Query: index 0 is the oldest bucket, count()-1 the current (partial) one.
+    // Values are always returned in bytes.
+    static uint8_t count(HistoryResolution res);
+    static uint32_t interval(HistoryResolution res);
+    uint64_t uploadAt(HistoryResolution res, uint8_t i) const;
+    uint64_t downloadAt(HistoryResolution res, uint8_t i) const;
+
+private:
+    TrafficBucket _sec[SECOND_BUCKETS];
+    TrafficBucket _min[MINUTE_BUCKETS];
+    TrafficBucket _hour[HOUR_BUCKETS];     // KiB
+    uint64_t _hourAccUp;                   // Bytes in the current hour
+    uint64_t _hourAccDown;
+    uint32_t _lastSec;
+    uint8_t _secIdx;
+    uint8_t _minIdx;
+    uint8_t _hourIdx;
+
+    static void roll(TrafficBucket* buckets, uint8_t size, uint8_t& idx, uint32_t steps);
+    void closeHour();
+    uint64_t valueAt(HistoryResolution res, uint8_t i, bool up) const;
+};
+
+// Per-device byte budget (checked at compile time)
+#define BANDWIDTH_HISTORY_BYTES 2336
+static_assert(sizeof(BandwidthHistory) <= BANDWIDTH_HISTORY_BYTES,
+              "BandwidthHistory exceeds its per-device byte budget");
+
+#endif // BANDWIDTH_HISTORY_H
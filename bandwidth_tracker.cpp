@@ -1,16 +1,38 @@
 #include "bandwidth_tracker.h"
-#include "storage_manager.h"
+#include "presence.h"
 #include <WiFi.h>
+#include "esp_timer.h"
+#include <time.h>
+#include <algorithm>
 
 BandwidthTracker bandwidthTracker;
 
-BandwidthTracker::BandwidthTracker() : lastSaveTime(0), _head(0), _tail(0) {
+uint32_t uptimeSeconds() {
+    return (uint32_t)(esp_timer_get_time() / 1000000ULL);
+}
+
+BandwidthTracker::BandwidthTracker() :
+    lastSaveTime(0),
+    _saveRequested(false),
+    _fullSaveRequested(false),
+    _archiveCount(0),
+    _historyFree(MAX_HISTORY_DEVICES),
+    _lastHistoryTick(0),
+    _rateAlpha(TrafficRate::alphaForTau(RATE_EWMA_TAU_SEC)),
+    _lastFlowExpire(0),
+    _quotaDay(0),
+    _quotaMonth(0),
+    _quotaListenerCount(0) {
     memset(_apMac, 0, 6);
+    memset(_historyUsed, 0, sizeof(_historyUsed));
 }
 
 void BandwidthTracker::begin() {
     // Cache AP MAC so recordPacket doesn't need to call WiFi APIs
     WiFi.softAPmacAddress(_apMac);
+    if (!_flows.begin(FLOW_TABLE_SIZE)) {
+        DEBUG_PRINTLN("Bandwidth: Flow table allocation failed");
+    }
     loadStats();
     lastSaveTime = millis();
     DEBUG_PRINTLN("Bandwidth: Tracker initialized");
@@ -20,23 +42,41 @@ void BandwidthTracker::update() {
     // Drain packet queue from WiFi task (must happen before anything else)
     processPacketQueue();
 
-    // Periodic save
-    if (millis() - lastSaveTime > STATS_SAVE_INTERVAL_MS) {
+    // Roll every device's time series and rates once per second, even when idle
+    uint32_t nowSec = uptimeSeconds();
+    if (nowSec != _lastHistoryTick) {
+        advanceSeries(nowSec);
+        rollQuotaPeriod();
+        _lastHistoryTick = nowSec;
+    }
+
+    // Expire idle flows (LRU tail first, so this stops at the first live one)
+    if (millis() - _lastFlowExpire >= 1000) {
+        _flows.expireIdle(millis(), FLOW_IDLE_TIMEOUT_MS);
+        _lastFlowExpire = millis();
+    }
+
+    // Periodic (or requested) save of the devices that changed
+    if (_saveRequested || millis() - lastSaveTime > STATS_SAVE_INTERVAL_MS) {
         saveStats();
-        lastSaveTime = millis();
     }
 
-    // Mark inactive devices
+    // Mark inactive devices (an online device is still being seen)
     uint32_t now = millis();
-    for (auto& device : devices) {
-        if (device.active && (now - device.lastSeen > DEVICE_TIMEOUT_MS)) {
-            device.active = false;
+    DeviceRegistry& reg = deviceRegistry;
+    for (uint16_t i = 0; i < reg.count(); i++) {
+        DeviceId id = reg.at(i);
+        if (reg.has(id, DEVICE_ACTIVE) && !reg.has(id, DEVICE_ONLINE) &&
+            (now - reg.lastSeen[id] > DEVICE_TIMEOUT_MS)) {
+            reg.set(id, DEVICE_ACTIVE, false);
+            freeHistory(reg.historySlot[id]);
+            reg.historySlot[id] = -1;
         }
     }
 }
 
 void BandwidthTracker::recordPacket(const uint8_t* srcMac, const uint8_t* dstMac, uint16_t length, bool isUpload) {
-    // Called from WiFi task (promiscuous callback) - keep minimal, no allocations
+    // Called from the capture backend's task - keep minimal, no allocations
     if (srcMac[0] & 0x01 || dstMac[0] & 0x01) {
         return;
     }
@@ -48,142 +88,476 @@ void BandwidthTracker::recordPacket(const uint8_t* srcMac, const uint8_t* dstMac
         return;
     }
 
-    // Write to ring buffer (lock-free: single producer from WiFi task)
-    int next = (_head + 1) % RING_SIZE;
-    if (next != _tail) {  // Not full
-        memcpy(_ring[_head].mac, clientMac, 6);
-        _ring[_head].length = length;
-        _ring[_head].isUpload = isUpload;
-        _head = next;  // Publish (volatile write makes it visible to consumer)
+    // Write to ring buffer (lock-free: one producer per direction)
+    PacketEvent evt;
+    memcpy(evt.mac, clientMac, 6);
+    evt.length = length;
+    evt.isUpload = isUpload;
+    if (isUpload) {
+        _uploadRing.push(evt);
+    } else {
+        _downloadRing.push(evt);
     }
-    // If full, drop the packet event (stats will be slightly off, but no crash)
+    // If full, the event is dropped (stats will be slightly off, but no crash)
 }
 
-void BandwidthTracker::processPacketQueue() {
-    // Called from main loop only - safe to modify vectors
-    while (_tail != _head) {
-        PacketEvent& evt = _ring[_tail];
-        DeviceStats* stats = findOrCreateDevice(evt.mac);
-        if (stats) {
+void BandwidthTracker::recordFlow(const FlowEvent& evt) {
+    // Each direction has exactly one producer task, so each gets its own ring
+    if (evt.isUpload) {
+        _flowUpRing.push(evt);
+    } else {
+        _flowDownRing.push(evt);
+    }
+}
+
+void BandwidthTracker::drainFlowRing(SpscRing<FlowEvent, FLOW_RING_SIZE>& ring, uint32_t now) {
+    FlowEvent batch[DRAIN_BATCH];
+    size_t n;
+    while ((n = ring.popBatch(batch, DRAIN_BATCH)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            _flows.record(batch[i], now);
+        }
+    }
+}
+
+void BandwidthTracker::drainPacketRing(SpscRing<PacketEvent, RING_SIZE>& ring, uint32_t now, uint32_t nowSec) {
+    DeviceRegistry& reg = deviceRegistry;
+    PacketEvent batch[DRAIN_BATCH];
+    size_t n;
+    while ((n = ring.popBatch(batch, DRAIN_BATCH)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            const PacketEvent& evt = batch[i];
+            DeviceId id = reg.acquire(evt.mac);
+            if (id == DEVICE_NONE) {
+                continue;
+            }
             if (evt.isUpload) {
-                stats->uploadBytes += evt.length;
+                reg.uploadBytes[id] += evt.length;
             } else {
-                stats->downloadBytes += evt.length;
+                reg.downloadBytes[id] += evt.length;
+            }
+            if (reg.historySlot[id] < 0) {
+                reg.historySlot[id] = allocHistory(nowSec);
+            }
+            if (reg.historySlot[id] >= 0) {
+                _history[reg.historySlot[id]].add(nowSec, evt.length, evt.isUpload);
+            }
+            reg.rate[id].add(nowSec, evt.length, evt.isUpload, _rateAlpha);
+            reg.quota[id].add(evt.length);
+            reg.lastSeen[id] = now;
+            reg.flags[id] |= DEVICE_ACTIVE | DEVICE_DIRTY;
+            reg.touch(id);
+            if (!reg.has(id, DEVICE_ONLINE)) {
+                presence.seen(id, PRESENCE_TRAFFIC, now);
+            }
+            if (!reg.has(id, DEVICE_QUOTA_EXCEEDED) && reg.quotaConfig[id].enabled()) {
+                checkQuota(id);
             }
-            stats->lastSeen = millis();
-            stats->active = true;
         }
-        _tail = (_tail + 1) % RING_SIZE;
     }
 }
 
-DeviceStats* BandwidthTracker::findOrCreateDevice(const uint8_t* mac) {
-    // Find existing
-    for (auto& device : devices) {
-        if (macEqual(device.mac, mac)) {
-            return &device;
+void BandwidthTracker::processPacketQueue() {
+    // Called from main loop only - safe to modify vectors
+    uint32_t now = millis();
+    uint32_t nowSec = uptimeSeconds();
+    drainPacketRing(_uploadRing, now, nowSec);
+    drainPacketRing(_downloadRing, now, nowSec);
+
+    drainFlowRing(_flowUpRing, now);
+    drainFlowRing(_flowDownRing, now);
+}
+
+void BandwidthTracker::onDeviceAdded(DeviceId id) {
+    // Saved stats were all loaded at boot (into the table or the archive), so
+    // this never reads flash. A device that is in neither starts at zero; its
+    // history slot is taken with the first packet.
+    DeviceRegistry& reg = deviceRegistry;
+    reg.rate[id].reset(uptimeSeconds());
+
+    int archived = archiveFind(reg.mac[id]);
+    if (archived >= 0) {
+        const DeviceStatsRecord& record = _archive[archived];
+        reg.uploadBytes[id] = record.uploadBytes;
+        reg.downloadBytes[id] = record.downloadBytes;
+        reg.quotaConfig[id] = record.quotaConfig;
+        reg.quota[id] = record.quota;
+        reg.set(id, DEVICE_DIRTY, _archiveDirty[archived]);
+        archiveRemove(archived);
+    }
+    reg.quota[id].roll(_quotaDay, _quotaMonth);
+    if (archived >= 0) {
+        checkQuota(id);
+    }
+}
+
+void BandwidthTracker::onDeviceRemoved(DeviceId id) {
+    DeviceRegistry& reg = deviceRegistry;
+    if (reg.has(id, DEVICE_QUOTA_EXCEEDED)) {
+        for (uint8_t i = 0; i < _quotaListenerCount; i++) {
+            _quotaListeners[i]->onQuotaRestored(reg.mac[id]);
+        }
+    }
+    freeHistory(reg.historySlot[id]);
+
+    // Keep its totals (canEvict made sure there is room)
+    if (reg.hasStats(id) && _archiveCount < STATS_ARCHIVE_MAX) {
+        fillRecord(_archive[_archiveCount], id);
+        _archiveDirty[_archiveCount] = reg.has(id, DEVICE_DIRTY);
+        _archiveCount++;
+    }
+}
+
+bool BandwidthTracker::canEvict(DeviceId id) {
+    return !deviceRegistry.hasStats(id) || _archiveCount < STATS_ARCHIVE_MAX;
+}
+
+int BandwidthTracker::archiveFind(const uint8_t* mac) const {
+    for (uint8_t i = 0; i < _archiveCount; i++) {
+        if (memcmp(_archive[i].mac, mac, 6) == 0) {
+            return i;
         }
     }
+    return -1;
+}
 
-    // Create new if under limit
-    if (devices.size() >= MAX_DEVICES) {
-        // Remove oldest inactive device
-        int oldestIdx = -1;
-        uint32_t oldestTime = UINT32_MAX;
-        for (int i = 0; i < devices.size(); i++) {
-            if (!devices[i].active && devices[i].lastSeen < oldestTime) {
-                oldestTime = devices[i].lastSeen;
-                oldestIdx = i;
-            }
+void BandwidthTracker::archiveRemove(int index) {
+    _archiveCount--;
+    _archive[index] = _archive[_archiveCount];
+    _archiveDirty[index] = _archiveDirty[_archiveCount];
+}
+
+bool BandwidthTracker::recordHasStats(const DeviceStatsRecord& record) {
+    return record.uploadBytes > 0 || record.downloadBytes > 0 || record.quotaConfig.enabled();
+}
+
+void BandwidthTracker::advanceSeries(uint32_t nowSec) {
+    for (int i = 0; i < MAX_HISTORY_DEVICES; i++) {
+        if (_historyUsed[i]) {
+            _history[i].advance(nowSec);
         }
-        if (oldestIdx >= 0) {
-            devices.erase(devices.begin() + oldestIdx);
+    }
+    // Rates decay every second; only a change in what the API shows counts
+    DeviceRegistry& reg = deviceRegistry;
+    for (uint16_t i = 0; i < reg.count(); i++) {
+        DeviceId id = reg.at(i);
+        TrafficRate& rate = reg.rate[id];
+        TrafficRate::Shown before = rate.shown();
+        rate.advance(nowSec, _rateAlpha);
+        if (rate.shown() != before) {
+            reg.touch(id);
+        }
+    }
+}
+
+void BandwidthTracker::rollQuotaPeriod() {
+    // One division per second; devices are only touched when the day changes
+    uint32_t day, month;
+    if (!quotaPeriod((int64_t)time(nullptr), UTC_OFFSET_SEC, day, month) || day == _quotaDay) {
+        return;
+    }
+    _quotaDay = day;
+    _quotaMonth = month;
+
+    DeviceRegistry& reg = deviceRegistry;
+    for (uint16_t i = 0; i < reg.count(); i++) {
+        DeviceId id = reg.at(i);
+        reg.quota[id].roll(day, month);
+        reg.set(id, DEVICE_DIRTY, true);
+        checkQuota(id);
+    }
+}
+
+void BandwidthTracker::checkQuota(DeviceId id) {
+    DeviceRegistry& reg = deviceRegistry;
+    bool over = reg.quotaConfig[id].enabled() && reg.quota[id].exceeds(reg.quotaConfig[id]);
+    if (over == reg.has(id, DEVICE_QUOTA_EXCEEDED)) {
+        return;
+    }
+    reg.set(id, DEVICE_QUOTA_EXCEEDED, over);
+
+    const uint8_t* mac = reg.mac[id];
+    DEBUG_PRINTF("Bandwidth: %02X:%02X:%02X:%02X:%02X:%02X quota %s\n",
+                 mac[0], mac[1], mac[2], mac[3], mac[4], mac[5],
+                 over ? "exceeded" : "restored");
+    for (uint8_t i = 0; i < _quotaListenerCount; i++) {
+        if (over) {
+            _quotaListeners[i]->onQuotaExceeded(mac, reg.quotaConfig[id]);
         } else {
-            DEBUG_PRINTLN("Bandwidth: Max devices reached");
-            return nullptr;
+            _quotaListeners[i]->onQuotaRestored(mac);
         }
     }
+}
 
-    DeviceStats newDevice;
-    macCopy(newDevice.mac, mac);
-    newDevice.uploadBytes = 0;
-    newDevice.downloadBytes = 0;
-    newDevice.lastSeen = millis();
-    newDevice.active = true;
+bool BandwidthTracker::addQuotaListener(QuotaListener* listener) {
+    if (_quotaListenerCount >= QUOTA_MAX_LISTENERS) {
+        return false;
+    }
+    _quotaListeners[_quotaListenerCount++] = listener;
+    return true;
+}
 
-    // Try to load saved stats for this MAC
-    uint64_t savedUp = 0, savedDown = 0;
-    if (storage.loadDeviceStats(mac, savedUp, savedDown)) {
-        newDevice.uploadBytes = savedUp;
-        newDevice.downloadBytes = savedDown;
+bool BandwidthTracker::setDeviceQuota(const uint8_t* mac, const QuotaConfig& cfg) {
+    DeviceRegistry& reg = deviceRegistry;
+    DeviceId id = reg.find(mac);
+    if (id == DEVICE_NONE) {
+        return false;
     }
 
-    devices.push_back(newDevice);
+    // Re-notify so listeners pick up a changed action or throttle rate
+    if (reg.has(id, DEVICE_QUOTA_EXCEEDED)) {
+        reg.set(id, DEVICE_QUOTA_EXCEEDED, false);
+        for (uint8_t i = 0; i < _quotaListenerCount; i++) {
+            _quotaListeners[i]->onQuotaRestored(mac);
+        }
+    }
+    reg.quotaConfig[id] = cfg;
+    reg.set(id, DEVICE_DIRTY, true);
+    reg.touch(id);
+    checkQuota(id);
+    _saveRequested = true;
+    return true;
+}
 
-    DEBUG_PRINTF("Bandwidth: New device %02X:%02X:%02X:%02X:%02X:%02X\n",
-                 mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+int8_t BandwidthTracker::allocHistory(uint32_t nowSec) {
+    if (_historyFree == 0) {
+        return -1;  // Checked per packet for devices without a slot
+    }
+    for (int i = 0; i < MAX_HISTORY_DEVICES; i++) {
+        if (!_historyUsed[i]) {
+            _historyUsed[i] = true;
+            _historyFree--;
+            _history[i].reset(nowSec);
+            return i;
+        }
+    }
+    return -1;
+}
 
-    return &devices.back();
+void BandwidthTracker::freeHistory(int8_t slot) {
+    if (slot >= 0 && _historyUsed[slot]) {
+        _historyUsed[slot] = false;
+        _historyFree++;
+    }
 }
 
-std::vector<DeviceStats> BandwidthTracker::getAllStats() {
-    // Return sorted by total bandwidth (descending)
-    std::vector<DeviceStats> sorted = devices;
-    std::sort(sorted.begin(), sorted.end(), [](const DeviceStats& a, const DeviceStats& b) {
-        return a.totalBytes() > b.totalBytes();
+uint16_t BandwidthTracker::getDevicesByTotal(DeviceId* ids) {
+    // Sort IDs rather than copies of the rows
+    DeviceRegistry& reg = deviceRegistry;
+    uint16_t count = reg.count();
+    for (uint16_t i = 0; i < count; i++) {
+        ids[i] = reg.at(i);
+    }
+    std::sort(ids, ids + count, [&reg](DeviceId a, DeviceId b) {
+        return reg.totalBytes(a) > reg.totalBytes(b);
     });
-    return sorted;
+    return count;
 }
 
-DeviceStats* BandwidthTracker::getDeviceStats(const uint8_t* mac) {
-    for (auto& device : devices) {
-        if (macEqual(device.mac, mac)) {
-            return &device;
-        }
+const BandwidthHistory* BandwidthTracker::getDeviceHistory(const uint8_t* mac) {
+    DeviceId id = deviceRegistry.find(mac);
+    if (id == DEVICE_NONE || deviceRegistry.historySlot[id] < 0) {
+        return nullptr;
     }
-    return nullptr;
+    // Bring idle periods up to date before the caller reads them
+    BandwidthHistory& history = _history[deviceRegistry.historySlot[id]];
+    history.advance(uptimeSeconds());
+    return &history;
 }
 
 int BandwidthTracker::getActiveDeviceCount() {
+    DeviceRegistry& reg = deviceRegistry;
     int count = 0;
-    for (const auto& device : devices) {
-        if (device.active) count++;
+    for (uint16_t i = 0; i < reg.count(); i++) {
+        if (reg.has(reg.at(i), DEVICE_ACTIVE)) count++;
     }
     return count;
 }
 
+float BandwidthTracker::getTotalUploadRate() {
+    DeviceRegistry& reg = deviceRegistry;
+    float total = 0;
+    for (uint16_t i = 0; i < reg.count(); i++) {
+        total += reg.rate[reg.at(i)].uploadBytesPerSec();
+    }
+    return total;
+}
+
+float BandwidthTracker::getTotalDownloadRate() {
+    DeviceRegistry& reg = deviceRegistry;
+    float total = 0;
+    for (uint16_t i = 0; i < reg.count(); i++) {
+        total += reg.rate[reg.at(i)].downloadBytesPerSec();
+    }
+    return total;
+}
+
 void BandwidthTracker::resetDeviceStats(const uint8_t* mac) {
-    for (auto& device : devices) {
-        if (macEqual(device.mac, mac)) {
-            device.uploadBytes = 0;
-            device.downloadBytes = 0;
-            storage.saveDeviceStats(mac, 0, 0);
-            DEBUG_PRINTF("Bandwidth: Reset stats for %02X:%02X:%02X:%02X:%02X:%02X\n",
-                         mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
-            return;
+    DeviceRegistry& reg = deviceRegistry;
+    DeviceId id = reg.find(mac);
+    if (id == DEVICE_NONE) {
+        // Evicted: zero the archived record, the next full save drops it
+        // unless it still carries a quota
+        int archived = archiveFind(mac);
+        if (archived >= 0) {
+            DeviceStatsRecord& record = _archive[archived];
+            record.uploadBytes = 0;
+            record.downloadBytes = 0;
+            record.quota.dayBytes = 0;
+            record.quota.monthBytes = 0;
+            _archiveDirty[archived] = true;
+            _saveRequested = true;
         }
+        return;
+    }
+    reg.uploadBytes[id] = 0;
+    reg.downloadBytes[id] = 0;
+    reg.quota[id].dayBytes = 0;
+    reg.quota[id].monthBytes = 0;
+    if (reg.historySlot[id] >= 0) {
+        _history[reg.historySlot[id]].reset(uptimeSeconds());
     }
+    reg.set(id, DEVICE_DIRTY, true);
+    reg.touch(id);
+    checkQuota(id);
+    _saveRequested = true;
+    DEBUG_PRINTF("Bandwidth: Reset stats for %02X:%02X:%02X:%02X:%02X:%02X\n",
+                 mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
 }
 
 void BandwidthTracker::resetAllStats() {
-    for (auto& device : devices) {
-        device.uploadBytes = 0;
-        device.downloadBytes = 0;
+    uint32_t nowSec = uptimeSeconds();
+    DeviceRegistry& reg = deviceRegistry;
+    for (uint16_t i = 0; i < reg.count(); i++) {
+        DeviceId id = reg.at(i);
+        reg.uploadBytes[id] = 0;
+        reg.downloadBytes[id] = 0;
+        reg.quota[id].dayBytes = 0;
+        reg.quota[id].monthBytes = 0;
+        if (reg.historySlot[id] >= 0) {
+            _history[reg.historySlot[id]].reset(nowSec);
+        }
+        reg.touch(id);
+        checkQuota(id);
+    }
+    for (uint8_t i = 0; i < _archiveCount; i++) {
+        _archive[i].uploadBytes = 0;
+        _archive[i].downloadBytes = 0;
+        _archive[i].quota.dayBytes = 0;
+        _archive[i].quota.monthBytes = 0;
     }
-    storage.clearAllStats();
+
+    // Rewrite the base with the zeroed devices (quota settings are kept;
+    // archived devices without one are dropped)
+    _fullSaveRequested = true;
+    _saveRequested = true;
     DEBUG_PRINTLN("Bandwidth: All stats reset");
 }
 
 void BandwidthTracker::saveStats() {
-    for (const auto& device : devices) {
-        storage.saveDeviceStats(device.mac, device.uploadBytes, device.downloadBytes);
+    // Runs under dataMutex: only fills the store's snapshot buffer, the flash
+    // write happens on the stats task. If it is still busy with the last
+    // save, retry next loop.
+    StatsSnapshot* snapshot = statsStore.acquire();
+    if (!snapshot) {
+        _saveRequested = true;
+        return;
+    }
+
+    bool full = _fullSaveRequested || statsStore.needsFull();
+    snapshot->full = full;
+    snapshot->count = 0;
+    DeviceRegistry& reg = deviceRegistry;
+    for (uint16_t i = 0; i < reg.count(); i++) {
+        DeviceId id = reg.at(i);
+        if (full || reg.has(id, DEVICE_DIRTY)) {
+            fillRecord(snapshot->records[snapshot->count++], id);
+        }
+    }
+
+    // Evicted devices: a full save rewrites every one that still has
+    // something to keep and forgets the rest (they were reset)
+    for (uint8_t i = 0; i < _archiveCount; ) {
+        if (full && !recordHasStats(_archive[i])) {
+            archiveRemove(i);
+            continue;
+        }
+        if (full || _archiveDirty[i]) {
+            snapshot->records[snapshot->count++] = _archive[i];
+        }
+        i++;
+    }
+
+    lastSaveTime = millis();
+    _saveRequested = false;
+    uint8_t count = snapshot->count;
+    if (!full && count == 0) {
+        return;  // Nothing changed
     }
-    DEBUG_PRINTF("Bandwidth: Saved stats for %d devices\n", devices.size());
+
+    // The buffer belongs to the stats task from here on
+    if (!statsStore.submit()) {
+        _saveRequested = true;
+        return;
+    }
+    for (uint16_t i = 0; i < reg.count(); i++) {
+        reg.set(reg.at(i), DEVICE_DIRTY, false);
+    }
+    memset(_archiveDirty, 0, sizeof(_archiveDirty));
+    _fullSaveRequested = false;
+    DEBUG_PRINTF("Bandwidth: Queued %s save of %d devices\n", full ? "full" : "incremental", count);
+}
+
+void BandwidthTracker::fillRecord(DeviceStatsRecord& record, DeviceId id) {
+    DeviceRegistry& reg = deviceRegistry;
+    memset(&record, 0, sizeof(record));
+    macCopy(record.mac, reg.mac[id]);
+    record.uploadBytes = reg.uploadBytes[id];
+    record.downloadBytes = reg.downloadBytes[id];
+    record.quotaConfig = reg.quotaConfig[id];
+    record.quota = reg.quota[id];
 }
 
 void BandwidthTracker::loadStats() {
-    // Stats are loaded on-demand when devices are first seen
-    DEBUG_PRINTLN("Bandwidth: Ready to load device stats on demand");
+    // Bulk load at boot: every saved device goes into the table up front, so
+    // historical totals show immediately and the packet drain never reads
+    // stats from flash (saved names are read later by DeviceManager::update())
+    std::vector<DeviceStatsRecord> records;
+    statsStore.begin(records);
+
+    DeviceRegistry& reg = deviceRegistry;
+    uint16_t loaded = 0;
+    for (const auto& record : records) {
+        // The table takes the first MAX_DEVICES, the archive the rest
+        if (reg.full()) {
+            if (_archiveCount < STATS_ARCHIVE_MAX) {
+                _archive[_archiveCount] = record;
+                _archiveDirty[_archiveCount] = false;
+                _archiveCount++;
+            } else {
+                // Only after MAX_DEVICES or STATS_ARCHIVE_MAX was lowered
+                DEBUG_PRINTF("Bandwidth: Saved stats for %02X:%02X:%02X:%02X:%02X:%02X do not fit\n",
+                             record.mac[0], record.mac[1], record.mac[2],
+                             record.mac[3], record.mac[4], record.mac[5]);
+            }
+            continue;
+        }
+
+        // Added inactive with lastSeen 0 until it shows up again
+        DeviceId id = reg.acquire(record.mac);
+        if (id == DEVICE_NONE) {
+            continue;
+        }
+        reg.uploadBytes[id] = record.uploadBytes;
+        reg.downloadBytes[id] = record.downloadBytes;
+        reg.quotaConfig[id] = record.quotaConfig;
+        reg.quota[id] = record.quota;
+        reg.quota[id].roll(_quotaDay, _quotaMonth);
+        checkQuota(id);
+        loaded++;
+    }
+
+    DEBUG_PRINTF("Bandwidth: Loaded stats for %d devices (%d archived)\n", loaded, _archiveCount);
 }
 
 bool BandwidthTracker::macEqual(const uint8_t* mac1, const uint8_t* mac2) {
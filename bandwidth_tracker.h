@@ -4,18 +4,13 @@
 #include <Arduino.h>
 #include <vector>
 #include "config.h"
-
-struct DeviceStats {
-    uint8_t mac[6];
-    uint64_t uploadBytes;
-    uint64_t downloadBytes;
-    uint32_t lastSeen;
-    bool active;
-
-    uint64_t totalBytes() const {
-        return uploadBytes + downloadBytes;
-    }
-};
+#include "spsc_ring.h"
+#include "bandwidth_history.h"
+#include "traffic_rate.h"
+#include "flow_table.h"
+#include "quota.h"
+#include "stats_store.h"
+#include "device_registry.h"
 
 // Lock-free ring buffer entry for cross-task packet events
 struct PacketEvent {
@@ -24,7 +19,9 @@ struct PacketEvent {
     bool isUpload;
 };
 
-class BandwidthTracker {
+// Per-device byte counters, rates, history and quotas. The counters are
+// columns of deviceRegistry; this class fills them from the capture rings.
+class BandwidthTracker : public DeviceListener {
 public:
     BandwidthTracker();
 
@@ -32,42 +29,109 @@ public:
     void begin();
     void update();  // Call periodically to save stats
 
-    // Packet counting (called from WiFi task via promiscuous callback - ISR-safe)
+    // Packet counting (called from the capture backend - ISR-safe). Uploads always
+    // come from the WiFi task; downloads from the WiFi task (promiscuous) or the
+    // lwIP task (netif hook), so each direction has its own single-producer ring.
     void recordPacket(const uint8_t* srcMac, const uint8_t* dstMac, uint16_t length, bool isUpload);
 
-    // Stats access
-    std::vector<DeviceStats> getAllStats();
-    DeviceStats* getDeviceStats(const uint8_t* mac);
+    // Flow counting (upload from WiFi task, download from lwIP task - one ring each)
+    void recordFlow(const FlowEvent& evt);
+
+    // Stats access. getDevicesByTotal fills ids (MAX_DEVICES entries) with
+    // every device, busiest first, and returns how many there are.
+    uint16_t getDevicesByTotal(DeviceId* ids);
+    const BandwidthHistory* getDeviceHistory(const uint8_t* mac);
     int getActiveDeviceCount();
 
+    // Live rates (bytes/s), summed over all devices
+    float getTotalUploadRate();
+    float getTotalDownloadRate();
+
+    // Flow table (read under dataMutex)
+    const FlowTable& getFlowTable() const { return _flows; }
+
+    // Data caps. Listeners are told when a device crosses its quota or the
+    // period rolls over; setDeviceQuota persists the config immediately.
+    bool addQuotaListener(QuotaListener* listener);
+    bool setDeviceQuota(const uint8_t* mac, const QuotaConfig& cfg);
+    bool isClockSynced() const { return _quotaDay != 0; }
+
     // Reset
     void resetDeviceStats(const uint8_t* mac);
     void resetAllStats();
 
-    // Persistence
+    // Persistence (saves are written by StatsStore's background task)
     void saveStats();
     void loadStats();
+    void requestSave() { _saveRequested = true; }
+
+    // DeviceListener: set up / tear down a device's counters
+    void onDeviceAdded(DeviceId id) override;
+    void onDeviceRemoved(DeviceId id) override;
+    bool canEvict(DeviceId id) override;
 
 private:
-    std::vector<DeviceStats> devices;
     uint32_t lastSaveTime;
+    bool _saveRequested;
+    bool _fullSaveRequested;
+
+    // Saved totals of devices evicted from the table. They stay in every
+    // full save and go back into the row if the device returns; only a
+    // stats reset drops them.
+    DeviceStatsRecord _archive[STATS_ARCHIVE_MAX];
+    bool _archiveDirty[STATS_ARCHIVE_MAX];  // Not saved since it changed
+    uint8_t _archiveCount;
+
+    // Time series for devices with traffic in the last DEVICE_TIMEOUT_MS,
+    // fixed pool (MAX_HISTORY_DEVICES * BANDWIDTH_HISTORY_BYTES)
+    BandwidthHistory _history[MAX_HISTORY_DEVICES];
+    bool _historyUsed[MAX_HISTORY_DEVICES];
+    uint8_t _historyFree;
+    uint32_t _lastHistoryTick;
+    float _rateAlpha;
 
     // Cached AP MAC to avoid WiFi calls from callback context
     uint8_t _apMac[6];
 
-    // Lock-free SPSC ring buffer (producer: WiFi task, consumer: main loop)
-    static const int RING_SIZE = 512;
-    PacketEvent _ring[RING_SIZE];
-    volatile int _head;
-    volatile int _tail;
+    // Lock-free SPSC ring buffers (producer: capture backend, consumer: main loop)
+    static const size_t RING_SIZE = 256;
+    static const size_t DRAIN_BATCH = 32;
+    SpscRing<PacketEvent, RING_SIZE> _uploadRing;
+    SpscRing<PacketEvent, RING_SIZE> _downloadRing;
+
+    // Flow events, one SPSC ring per producer task
+    static const size_t FLOW_RING_SIZE = 256;
+    SpscRing<FlowEvent, FLOW_RING_SIZE> _flowUpRing;
+    SpscRing<FlowEvent, FLOW_RING_SIZE> _flowDownRing;
+    FlowTable _flows;
+    uint32_t _lastFlowExpire;
+
+    // Quota periods (0 until the wall clock is set) and enforcement hooks
+    uint32_t _quotaDay;
+    uint32_t _quotaMonth;
+    QuotaListener* _quotaListeners[QUOTA_MAX_LISTENERS];
+    uint8_t _quotaListenerCount;
 
     void processPacketQueue();
-    DeviceStats* findOrCreateDevice(const uint8_t* mac);
+    void drainPacketRing(SpscRing<PacketEvent, RING_SIZE>& ring, uint32_t now, uint32_t nowSec);
+    void drainFlowRing(SpscRing<FlowEvent, FLOW_RING_SIZE>& ring, uint32_t now);
+    void advanceSeries(uint32_t nowSec);
+    void rollQuotaPeriod();
+    void checkQuota(DeviceId id);
+    void fillRecord(DeviceStatsRecord& record, DeviceId id);
+    int archiveFind(const uint8_t* mac) const;
+    void archiveRemove(int index);
+    static bool recordHasStats(const DeviceStatsRecord& record);
+    int8_t allocHistory(uint32_t nowSec);
+    void freeHistory(int8_t slot);
     bool isLocalMAC(const uint8_t* mac);
     bool macEqual(const uint8_t* mac1, const uint8_t* mac2);
     void macCopy(uint8_t* dst, const uint8_t* src);
 };
 
+// Seconds since boot from the 64-bit esp_timer (does not wrap like millis())
+uint32_t uptimeSeconds();
+
 extern BandwidthTracker bandwidthTracker;
 
 #endif // BANDWIDTH_TRACKER_H
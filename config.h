@@ -27,10 +27,25 @@
 
 // --- Web Server ---
 #define WEB_SERVER_PORT      80
+#define RESPONSE_CACHE_MAX_BYTES 8192  // Larger array bodies are streamed, not cached
+
+// --- Dashboard Push (Server-Sent Events on /api/events) ---
+#define PUSH_INTERVAL_MS     2000   // Default time between frames (settable at runtime)
+#define PUSH_INTERVAL_MIN_MS 500
+#define PUSH_INTERVAL_MAX_MS 60000
+#define PUSH_MAX_CLIENTS     4      // Later connections are told to poll instead
+#define PUSH_RECONNECT_MS    3000   // Retry delay suggested to browsers
 
 // --- mDNS (Local Domain) ---
 #define MDNS_HOSTNAME        "networkmonitor"  // Access via http://networkmonitor.local
 
+// --- LAN Discovery (mDNS + SSDP, discovery.h) ---
+#define DISCOVERY_INTERVAL_MS     45000   // One query round every 45s
+#define DISCOVERY_LISTEN_MS       3000    // Collect replies for 3s (> SSDP MX)
+#define DISCOVERY_QUEUE_SIZE      16
+#define DISCOVERY_TASK_STACK_SIZE 4096
+#define DISCOVERY_TASK_PRIORITY   1
+
 // --- DNS Async Forwarding & Cache ---
 #define DNS_CACHE_SIZE         16
 #define DNS_CACHE_TTL_MS       60000   // Cache TTL: 60 seconds
@@ -38,22 +53,80 @@
 #define DNS_TASK_STACK_SIZE    8192
 #define DNS_TASK_PRIORITY      2
 
+// --- Bandwidth Accounting Backend ---
+// 0 = promiscuous 802.11 sniffing, 1 = AP netif input/linkoutput hooks
+// (selectable at runtime via /api/settings/accounting)
+#define DEFAULT_ACCOUNTING_BACKEND 0
+
+// --- Traffic Shaping ---
+#define SHAPER_MAX_DEVICES   16            // Devices that can have a limit
+#define SHAPER_BURST_MS      250           // Bucket depth, in time at the limit rate
+#define SHAPER_MIN_BURST     3028          // Never less than two full Ethernet frames
+#define SHAPER_MAX_KBPS      1000000       // Largest accepted limit (1 Gbit/s)
+
+// --- Data Quotas ---
+#define NTP_SERVER           "pool.ntp.org"
+#define UTC_OFFSET_SEC       0             // Local time offset for day/month rollover
+#define QUOTA_MAX_LISTENERS  2             // DNS blocking + throttling
+#define QUOTA_DEFAULT_THROTTLE_KBPS 256    // Throttle rate when none is configured
+
+// --- Flow Accounting ---
+#define FLOW_TABLE_SIZE        128     // Max tracked 5-tuple flows (LRU eviction)
+#define FLOW_IDLE_TIMEOUT_MS   120000  // Drop flows idle for 2 minutes
+#define FLOW_TOP_MAX           16      // Max rows returned by /api/flows
+
 // --- Device Limits ---
-#define MAX_DEVICES          16
+#define MAX_DEVICES          64    // Device registry rows
+#define MAX_HISTORY_DEVICES  16    // Devices with a bandwidth time series at once
+#define DEVICE_MAX_LISTENERS 3     // DeviceManager + BandwidthTracker + PresenceTracker
+#define DEVICE_TOMBSTONES    16    // Removed devices remembered for /api/devices?since=
+#define STATS_ARCHIVE_MAX    32    // Saved totals of devices evicted from the table
+                                   // (MAX_DEVICES + this at most 255: stats blob format)
 #define MAX_BLOCKED_DOMAINS  100
 #define MAX_DOMAIN_LENGTH    64
 #define MAX_DEVICE_NAME      32
+// Name pool: an entry for every device's custom and automatic name, and
+// text for both at half of MAX_DEVICE_NAME on average (shared names once)
+#define NAME_POOL_ENTRIES    (MAX_DEVICES * 2)
+#define NAME_POOL_BYTES      (MAX_DEVICES * MAX_DEVICE_NAME)
 
 // --- Timing ---
 #define WIFI_CONNECT_TIMEOUT_MS   15000
 #define STATS_SAVE_INTERVAL_MS    300000  // Save stats every 5 minutes
+#define STATS_JOURNAL_MAX         8       // Incremental saves before the base is rewritten
+#define STATS_TASK_STACK_SIZE     4096
+#define STATS_TASK_PRIORITY       1
 #define DEVICE_TIMEOUT_MS         3600000 // Consider device offline after 1 hour
+#define RATE_EWMA_TAU_SEC         5       // Time constant of per-device rate averages
+
+// --- Presence ---
+#define PRESENCE_SESSION_HISTORY  64      // Closed online sessions kept, all devices
+#define PRESENCE_SESSIONS_MAX     16      // Max sessions returned per device
+#define PRESENCE_REJOIN_GUARD_MS  5000    // Traffic this soon after leaving is not a sighting
+
+// --- Vendor Lookup ---
+// Prefixes missing from oui_data.h can be resolved online (off by default).
+// The URL is an http(s) template where %s becomes "AA:BB:CC", or file:/path
+// on LittleFS; both can be changed at runtime from the settings page.
+#define OUI_ONLINE_DEFAULT        false
+#define OUI_RESOLVER_URL          "https://api.macvendors.com/%s"
+#define OUI_URL_MAX_LEN           128
+#define OUI_QUEUE_SIZE            8       // Lookups in flight
+#define OUI_MISS_CACHE_SIZE       16      // Recent misses not asked again
+#define OUI_CACHE_MAX             128     // Resolved prefixes kept in NVS
+#define OUI_REQUEST_INTERVAL_MS   1100    // Public APIs allow ~1 request/s
+#define OUI_HTTP_TIMEOUT_MS       5000
+#define OUI_UPLINK_WAIT_MS        30000   // Wait for the router, then a miss
+#define OUI_TASK_STACK_SIZE       8192    // TLS handshake
+#define OUI_TASK_PRIORITY         1
 
 // --- NVS Namespaces ---
 #define NVS_NAMESPACE_WIFI    "wifi"
 #define NVS_NAMESPACE_DEVICES "devices"
 #define NVS_NAMESPACE_DNS     "dns"
 #define NVS_NAMESPACE_STATS   "stats"
+#define NVS_NAMESPACE_NET     "net"
+#define NVS_NAMESPACE_OUI     "oui"
 
 // --- Debug ---
 #define DEBUG_SERIAL          true
@@ -1,124 +1,188 @@
 #include "device_manager.h"
 #include "storage_manager.h"
 #include "oui_lookup.h"
+#include "presence.h"
 
 DeviceManager deviceManager;
 
-DeviceManager::DeviceManager() {}
+// Saved names read per update(), so a boot with a full table of loaded
+// devices spreads its flash reads over several loop passes
+static const uint8_t NAME_LOOKUPS_PER_UPDATE = 4;
 
-void DeviceManager::updateDevice(const uint8_t* mac, const IPAddress& ip) {
-    DeviceInfo* device = findOrCreateDevice(mac);
-    if (device) {
-        device->ip = ip;
+DeviceManager::DeviceManager() : _nameLookups(0) {
+    memset(_nameLookup, 0, sizeof(_nameLookup));
+}
+
+void DeviceManager::updateDevice(const uint8_t* mac, const IPAddress& ip, PresenceSource source) {
+    DeviceId id = deviceRegistry.acquire(mac);
+    if (id == DEVICE_NONE) {
+        return;
     }
+    uint32_t now = millis();
+    deviceRegistry.setIP(id, ip);
+    deviceRegistry.lastSeen[id] = now;
+    deviceRegistry.set(id, DEVICE_ACTIVE, true);
+    presence.seen(id, source, now);
 }
 
-void DeviceManager::updateDeviceHostname(const uint8_t* mac, const String& hostname) {
-    DeviceInfo* device = findOrCreateDevice(mac);
-    if (device && !device->hasCustomName) {
-        strncpy(device->autoName, hostname.c_str(), MAX_DEVICE_NAME - 1);
-        device->autoName[MAX_DEVICE_NAME - 1] = '\0';
-        DEBUG_PRINTF("Device: Auto-name for %s: %s\n",
-                     device->getMACString().c_str(), hostname.c_str());
+void DeviceManager::deviceOffline(const uint8_t* mac, uint32_t when) {
+    DeviceId id = deviceRegistry.find(mac);
+    if (id != DEVICE_NONE) {
+        presence.left(id, when);
     }
 }
 
-DeviceInfo* DeviceManager::findOrCreateDevice(const uint8_t* mac) {
-    // Find existing
-    for (auto& device : devices) {
-        if (macEqual(device.mac, mac)) {
-            return &device;
-        }
+void DeviceManager::updateDeviceHostname(DeviceId id, const char* hostname) {
+    if (deviceRegistry.has(id, DEVICE_CUSTOM_NAME)) {
+        return;
     }
+    deviceRegistry.setAutoName(id, hostname);
+    char macStr[MAC_STRING_LEN];
+    formatMAC(deviceRegistry.mac[id], macStr);
+    DEBUG_PRINTF("Device: Auto-name for %s: %s\n", macStr, hostname);
+}
 
-    // Create new
-    if (devices.size() >= MAX_DEVICES) {
-        return nullptr;
+void DeviceManager::updateDeviceDHCP(const DhcpEvent& evt) {
+    DeviceId id = deviceRegistry.acquire(evt.mac);
+    if (id == DEVICE_NONE) {
+        return;
     }
 
-    DeviceInfo newDevice;
-    memcpy(newDevice.mac, mac, 6);
-    newDevice.ip = IPAddress(0, 0, 0, 0);
-    newDevice.customName[0] = '\0';
-    newDevice.autoName[0] = '\0';
-    newDevice.hasCustomName = false;
+    // A release is a clean goodbye; anything else means the client is here
+    if (evt.messageType == DHCP_MSG_RELEASE) {
+        presence.left(id, millis());
+        return;
+    }
+    presence.seen(id, PRESENCE_DHCP, millis());
 
-    // Load custom name from storage
-    String savedName = storage.loadDeviceName(mac);
-    if (savedName.length() > 0) {
-        strncpy(newDevice.customName, savedName.c_str(), MAX_DEVICE_NAME - 1);
-        newDevice.customName[MAX_DEVICE_NAME - 1] = '\0';
-        newDevice.hasCustomName = true;
-    } else {
-        // Check if MAC is locally administered (randomized/private)
-        // Bit 1 of first octet = 1 means locally administered
-        bool isRandomized = (mac[0] & 0x02) != 0;
+    // Renewals repeat the hostname; only a new one is worth a copy
+    if (evt.hostname[0] != '\0' &&
+        strncmp(deviceRegistry.getAutoName(id), evt.hostname, MAX_DEVICE_NAME - 1) != 0) {
+        updateDeviceHostname(id, evt.hostname);
+    }
+
+    uint8_t cls = classifyDhcp(evt);
+    if (cls != 0) {
+        if (deviceRegistry.dhcpClass[id] != cls) {
+            deviceRegistry.dhcpClass[id] = cls;
+            deviceRegistry.touch(id);
+        }
+    } else if (deviceRegistry.dhcpClass[id] == 0) {
+        // Log unknown fingerprints so they can be added to the table
+        char params[DHCP_MAX_PARAMS * 4];
+        formatDhcpParams(evt, params, sizeof(params));
+        DEBUG_PRINTF("Device: Unknown DHCP fingerprint for %s: 55=%s 60=%s\n",
+                     macToString(evt.mac).c_str(), params, evt.vendorClass);
+    }
+}
+
+void DeviceManager::onDeviceAdded(DeviceId id) {
+    // Runs inside acquire(), often from the packet drain: no flash here. The
+    // automatic name shows until update() has read a saved custom name.
+    const uint8_t* mac = deviceRegistry.mac[id];
+    _nameLookup[id] = true;
+    _nameLookups++;
 
-        if (isRandomized) {
-            strncpy(newDevice.autoName, "Private Device", MAX_DEVICE_NAME - 1);
-            newDevice.autoName[MAX_DEVICE_NAME - 1] = '\0';
+    // Check if MAC is locally administered (randomized/private)
+    // Bit 1 of first octet = 1 means locally administered
+    bool isRandomized = (mac[0] & 0x02) != 0;
+
+    if (isRandomized) {
+        deviceRegistry.setAutoName(id, "Private Device");
+    } else {
+        // Try OUI vendor lookup for real MAC addresses
+        const char* vendor = ouiLookup.lookupVendor(mac);
+        if (vendor) {
+            deviceRegistry.setAutoName(id, vendor);
         } else {
-            // Try OUI vendor lookup for real MAC addresses
-            String vendor = ouiLookup.lookupVendor(mac);
-            if (vendor.length() > 0) {
-                strncpy(newDevice.autoName, vendor.c_str(), MAX_DEVICE_NAME - 1);
-                newDevice.autoName[MAX_DEVICE_NAME - 1] = '\0';
-            }
+            // Not in the table: ask the online resolver, if enabled
+            ouiLookup.resolveAsync(mac);
         }
     }
 
-    devices.push_back(newDevice);
     DEBUG_PRINTF("Device: New device tracked %02X:%02X:%02X:%02X:%02X:%02X\n",
                  mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+}
+
+void DeviceManager::onDeviceRemoved(DeviceId id) {
+    cancelNameLookup(id);
+}
 
-    return &devices.back();
+void DeviceManager::cancelNameLookup(DeviceId id) {
+    if (_nameLookup[id]) {
+        _nameLookup[id] = false;
+        _nameLookups--;
+    }
 }
 
-DeviceInfo* DeviceManager::getDevice(const uint8_t* mac) {
-    for (auto& device : devices) {
-        if (macEqual(device.mac, mac)) {
-            return &device;
+void DeviceManager::update() {
+    uint8_t done = 0;
+    for (DeviceId id = 0; id < MAX_DEVICES && _nameLookups > 0 && done < NAME_LOOKUPS_PER_UPDATE; id++) {
+        if (!_nameLookup[id]) {
+            continue;
+        }
+        cancelNameLookup(id);
+        done++;
+
+        String savedName = storage.loadDeviceName(deviceRegistry.mac[id]);
+        // A full pool leaves the automatic name (counted in names.failed)
+        if (savedName.length() > 0 && deviceRegistry.setCustomName(id, savedName.c_str())) {
+            deviceRegistry.set(id, DEVICE_CUSTOM_NAME, true);
         }
     }
-    return nullptr;
 }
 
-std::vector<DeviceInfo> DeviceManager::getAllDevices() {
-    return devices;
+void DeviceManager::applyVendor(const uint8_t* oui, const char* vendor) {
+    for (uint16_t i = 0; i < deviceRegistry.count(); i++) {
+        DeviceId id = deviceRegistry.at(i);
+        // Never overwrite a custom name or a hostname learned meanwhile
+        if (memcmp(deviceRegistry.mac[id], oui, 3) != 0 ||
+            deviceRegistry.has(id, DEVICE_CUSTOM_NAME) ||
+            deviceRegistry.autoName[id] != 0) {
+            continue;
+        }
+        deviceRegistry.setAutoName(id, vendor);
+    }
 }
 
 bool DeviceManager::setDeviceName(const uint8_t* mac, const String& name) {
-    DeviceInfo* device = findOrCreateDevice(mac);
-    if (!device) {
+    DeviceId id = deviceRegistry.acquire(mac);
+    if (id == DEVICE_NONE) {
         return false;
     }
 
-    strncpy(device->customName, name.c_str(), MAX_DEVICE_NAME - 1);
-    device->customName[MAX_DEVICE_NAME - 1] = '\0';
-    device->hasCustomName = true;
+    // Room in the pool is taken before anything is saved: after a reboot the
+    // device would otherwise show a name the user was told had failed. The
+    // row only changes once NVS has the name, so a failed save leaves the
+    // previous name and flag in place.
+    NameHandle reserved = namePool.intern(name.c_str());
+    if (reserved == 0 && name.length() > 0) {
+        DEBUG_PRINTF("Device: Name pool full, name for %s not set\n", macToString(mac).c_str());
+        return false;
+    }
+    if (!storage.saveDeviceName(mac, name)) {
+        namePool.release(reserved);
+        return false;
+    }
+    deviceRegistry.setCustomName(id, name.c_str());  // Same string: cannot fail
+    namePool.release(reserved);
+    cancelNameLookup(id);  // The new name replaces whatever is saved
+    deviceRegistry.set(id, DEVICE_CUSTOM_NAME, true);
 
-    storage.saveDeviceName(mac, name);
     DEBUG_PRINTF("Device: Set name for %s: %s\n",
-                 device->getMACString().c_str(), name.c_str());
+                 macToString(mac).c_str(), name.c_str());
 
     return true;
 }
 
-String DeviceManager::getDeviceName(const uint8_t* mac) {
-    DeviceInfo* device = getDevice(mac);
-    if (device) {
-        return device->getDisplayName();
-    }
-    return "Unknown Device";
-}
-
 void DeviceManager::clearDeviceName(const uint8_t* mac) {
-    DeviceInfo* device = getDevice(mac);
-    if (device) {
-        device->customName[0] = '\0';
-        device->hasCustomName = false;
+    DeviceId id = deviceRegistry.find(mac);
+    if (id != DEVICE_NONE) {
+        cancelNameLookup(id);
+        deviceRegistry.setCustomName(id, "");
+        deviceRegistry.set(id, DEVICE_CUSTOM_NAME, false);
         storage.deleteDeviceName(mac);
-        DEBUG_PRINTF("Device: Cleared name for %s\n", device->getMACString().c_str());
+        DEBUG_PRINTF("Device: Cleared name for %s\n", macToString(mac).c_str());
     }
 }
 
@@ -141,13 +205,17 @@ bool DeviceManager::parseMAC(const String& macStr, uint8_t* mac) {
     return true;
 }
 
-String DeviceManager::macToString(const uint8_t* mac) {
-    char buf[18];
-    snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X",
-             mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
-    return String(buf);
+void formatMAC(const uint8_t* mac, char* out) {
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    for (int i = 0; i < 6; i++) {
+        *out++ = HEX_DIGITS[mac[i] >> 4];
+        *out++ = HEX_DIGITS[mac[i] & 0x0F];
+        *out++ = i < 5 ? ':' : '\0';
+    }
 }
 
-bool DeviceManager::macEqual(const uint8_t* mac1, const uint8_t* mac2) {
-    return memcmp(mac1, mac2, 6) == 0;
+String DeviceManager::macToString(const uint8_t* mac) {
+    char buf[MAC_STRING_LEN];
+    formatMAC(mac, buf);
+    return String(buf);
 }
@@ -2,58 +2,58 @@
 #define DEVICE_MANAGER_H
 
 #include <Arduino.h>
-#include <map>
 #include "config.h"
+#include "device_registry.h"
+#include "dhcp_fingerprint.h"
+#include "presence.h"
 
-struct DeviceInfo {
-    uint8_t mac[6];
-    char customName[MAX_DEVICE_NAME];
-    char autoName[MAX_DEVICE_NAME];
-    IPAddress ip;
-    bool hasCustomName;
-
-    String getDisplayName() const {
-        if (hasCustomName && customName[0] != '\0') {
-            return String(customName);
-        }
-        if (autoName[0] != '\0') {
-            return String(autoName);
-        }
-        return "Unknown Device";
-    }
-
-    String getMACString() const {
-        char buf[18];
-        snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X",
-                 mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
-        return String(buf);
-    }
-};
+// "AA:BB:CC:DD:EE:FF" into out (MAC_STRING_LEN bytes), no allocation
+static const size_t MAC_STRING_LEN = 18;
+void formatMAC(const uint8_t* mac, char* out);
 
-class DeviceManager {
+// Device identity: addresses, custom names (persisted) and automatic names
+// (OUI vendor, DHCP or mDNS hostname). The data itself lives in deviceRegistry.
+class DeviceManager : public DeviceListener {
 public:
     DeviceManager();
 
-    // Device tracking
-    void updateDevice(const uint8_t* mac, const IPAddress& ip);
-    void updateDeviceHostname(const uint8_t* mac, const String& hostname);
-    DeviceInfo* getDevice(const uint8_t* mac);
-    std::vector<DeviceInfo> getAllDevices();
+    // Device tracking. updateDevice() is a sighting and brings the device
+    // online; deviceOffline() records when it left (AP disconnect, ARP expiry).
+    // Both go through the presence tracker.
+    void updateDevice(const uint8_t* mac, const IPAddress& ip, PresenceSource source);
+    void deviceOffline(const uint8_t* mac, uint32_t when);
+    void updateDeviceHostname(DeviceId id, const char* hostname);
+
+    // Hostname and OS class from a DHCP request seen at the AP (also a
+    // sighting; DHCPRELEASE takes the device offline)
+    void updateDeviceDHCP(const DhcpEvent& evt);
+
+    // Name every device with this OUI that has no name yet (online lookup result)
+    void applyVendor(const uint8_t* oui, const char* vendor);
 
-    // Name management
+    // Read the saved custom names of devices added since the last call, a few
+    // per call (main loop, dataMutex held). New rows are added by the packet
+    // drain, which must not wait on flash, so the lookup is deferred to here.
+    void update();
+
+    // Name management. setDeviceName() fails if the device table or the
+    // name pool is full (nothing is saved then) or the NVS write fails.
     bool setDeviceName(const uint8_t* mac, const String& name);
-    String getDeviceName(const uint8_t* mac);
     void clearDeviceName(const uint8_t* mac);
 
-    // Utility
+    // Utility. macToString() allocates; API paths use formatMAC().
     bool parseMAC(const String& macStr, uint8_t* mac);
     String macToString(const uint8_t* mac);
 
-private:
-    std::vector<DeviceInfo> devices;
+    // DeviceListener: give a new device its automatic name and queue the
+    // saved-name lookup for update()
+    void onDeviceAdded(DeviceId id) override;
+    void onDeviceRemoved(DeviceId id) override;
 
-    DeviceInfo* findOrCreateDevice(const uint8_t* mac);
-    bool macEqual(const uint8_t* mac1, const uint8_t* mac2);
+private:
+    bool _nameLookup[MAX_DEVICES];  // Rows whose saved name has not been read yet
+    uint16_t _nameLookups;
+    void cancelNameLookup(DeviceId id);
 };
 
 extern DeviceManager deviceManager;
@@ -0,0 +1,331 @@
+#include "device_registry.h"
+#include <freertos/task.h>
+
+DeviceRegistry deviceRegistry;
+
+// Lock-free reads lookupIP tries before waiting for the writer on dataMutex
+// (a write takes microseconds)
+static const int IP_READ_RETRIES = 100;
+
+DeviceRegistry::DeviceRegistry() :
+    _ipSeq(0),
+    _generation(0),
+    _pending(false),
+    _tombstoneHead(0),
+    _tombstoneCount(0),
+    _tombstoneFloor(0),
+    _count(0),
+    _listenerCount(0) {
+    memset(_macIndex, 0xFF, sizeof(_macIndex));
+    memset(_ipIndex, 0xFF, sizeof(_ipIndex));
+    memset(_used, 0, sizeof(_used));
+    memset(_tombstones, 0, sizeof(_tombstones));
+}
+
+bool DeviceRegistry::addListener(DeviceListener* listener) {
+    if (_listenerCount >= DEVICE_MAX_LISTENERS) {
+        return false;
+    }
+    _listeners[_listenerCount++] = listener;
+    return true;
+}
+
+DeviceId DeviceRegistry::find(const uint8_t* key) const {
+    for (uint16_t i = hashMAC(key);; i = (i + 1) & INDEX_MASK) {
+        DeviceId id = _macIndex[i];
+        if (id == DEVICE_NONE || memcmp(mac[id], key, 6) == 0) {
+            return id;
+        }
+    }
+}
+
+DeviceId DeviceRegistry::findByIP(const IPAddress& addr) const {
+    uint32_t key = (uint32_t)addr;
+    if (key == 0) {
+        return DEVICE_NONE;
+    }
+    return probeIP(key);
+}
+
+bool DeviceRegistry::lookupIP(const IPAddress& addr, uint8_t* macOut) const {
+    uint32_t key = (uint32_t)addr;
+    if (key == 0) {
+        return false;
+    }
+
+    for (int attempt = 0; attempt < IP_READ_RETRIES; attempt++) {
+        uint32_t seq = _ipSeq.load(std::memory_order_acquire);
+        if (seq & 1) {
+            taskYIELD();  // Writer in progress; let it finish if it shares the core
+            continue;
+        }
+
+        // A row is only reused after remove() has taken it out of the IP
+        // index, which moves the sequence, so a MAC copied from a row found
+        // here belongs to that IP if the sequence is unchanged afterwards
+        DeviceId id = probeIP(key);
+        if (id != DEVICE_NONE) {
+            memcpy(macOut, mac[id], 6);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_ipSeq.load(std::memory_order_relaxed) == seq) {
+            return id != DEVICE_NONE;
+        }
+        taskYIELD();
+    }
+
+    // Still racing a writer (e.g. one at a lower priority that taskYIELD()
+    // does not run): take the lock writers hold and read under it
+    xSemaphoreTake(dataMutex, portMAX_DELAY);
+    DeviceId id = findByIP(addr);
+    if (id != DEVICE_NONE) {
+        memcpy(macOut, mac[id], 6);
+    }
+    xSemaphoreGive(dataMutex);
+    return id != DEVICE_NONE;
+}
+
+DeviceId DeviceRegistry::probeIP(uint32_t key) const {
+    // Bounded, so a reader racing a writer cannot spin on a torn index
+    uint16_t i = hashIP(key);
+    for (uint16_t n = 0; n < INDEX_SIZE; n++, i = (i + 1) & INDEX_MASK) {
+        DeviceId id = _ipIndex[i];
+        if (id == DEVICE_NONE || (id < MAX_DEVICES && ip[id] == key)) {
+            return id;
+        }
+    }
+    return DEVICE_NONE;
+}
+
+DeviceId DeviceRegistry::acquire(const uint8_t* key) {
+    DeviceId id = find(key);
+    if (id != DEVICE_NONE) {
+        return id;
+    }
+
+    if (full()) {
+        DeviceId victim = evictionCandidate();
+        if (victim == DEVICE_NONE) {
+            DEBUG_PRINTLN("Registry: Max devices reached");
+            return DEVICE_NONE;
+        }
+        remove(victim);
+    }
+
+    for (id = 0; _used[id]; id++) {}
+
+    _used[id] = true;
+    memcpy(mac[id], key, 6);
+    ip[id] = 0;
+    flags[id] = 0;
+    customName[id] = 0;
+    autoName[id] = 0;
+    uploadBytes[id] = 0;
+    downloadBytes[id] = 0;
+    lastSeen[id] = 0;
+    presenceSince[id] = 0;
+    historySlot[id] = -1;
+    dhcpClass[id] = 0;
+    memset(&rate[id], 0, sizeof(rate[id]));
+    memset(&quotaConfig[id], 0, sizeof(quotaConfig[id]));
+    memset(&quota[id], 0, sizeof(quota[id]));
+
+    _pos[id] = _count;
+    _order[_count++] = id;
+    indexInsert(_macIndex, hashMAC(key), id);
+    touch(id);
+
+    for (uint8_t i = 0; i < _listenerCount; i++) {
+        _listeners[i]->onDeviceAdded(id);
+    }
+    return id;
+}
+
+void DeviceRegistry::remove(DeviceId id) {
+    if (id >= MAX_DEVICES || !_used[id]) {
+        return;
+    }
+    for (uint8_t i = 0; i < _listenerCount; i++) {
+        _listeners[i]->onDeviceRemoved(id);
+    }
+
+    indexErase(_macIndex, id, false);
+    if (ip[id] != 0) {
+        beginIPWrite();
+        indexErase(_ipIndex, id, true);
+        ip[id] = 0;
+        endIPWrite();
+    }
+    namePool.release(customName[id]);
+    namePool.release(autoName[id]);
+    customName[id] = 0;
+    autoName[id] = 0;
+
+    // Swap the last live ID into the hole
+    DeviceId last = _order[--_count];
+    _order[_pos[id]] = last;
+    _pos[last] = _pos[id];
+    _used[id] = false;
+
+    // Tombstone; a full ring forgets its oldest, and deltas from before that
+    // removal can no longer be answered
+    DeviceTombstone& t = _tombstones[_tombstoneHead];
+    if (_tombstoneCount == DEVICE_TOMBSTONES) {
+        _tombstoneFloor = t.generation;
+    } else {
+        _tombstoneCount++;
+    }
+    memcpy(t.mac, mac[id], 6);
+    t.generation = _generation + 1;
+    _tombstoneHead = (_tombstoneHead + 1) % DEVICE_TOMBSTONES;
+    _pending = true;
+}
+
+uint8_t DeviceRegistry::removedSince(uint32_t since, uint8_t (*macs)[6]) const {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < _tombstoneCount; i++) {
+        const DeviceTombstone& t = _tombstones[i];
+        // A MAC that came back is reported as a changed row instead
+        if (t.generation > since && find(t.mac) == DEVICE_NONE) {
+            memcpy(macs[n++], t.mac, 6);
+        }
+    }
+    return n;
+}
+
+void DeviceRegistry::setIP(DeviceId id, const IPAddress& addr) {
+    uint32_t key = (uint32_t)addr;
+    if (ip[id] == key) {
+        return;
+    }
+
+    beginIPWrite();
+    if (ip[id] != 0) {
+        indexErase(_ipIndex, id, true);
+        ip[id] = 0;
+    }
+    if (key != 0) {
+        DeviceId previous = probeIP(key);
+        if (previous != DEVICE_NONE) {
+            indexErase(_ipIndex, previous, true);
+            ip[previous] = 0;
+            touch(previous);  // Delta readers must see it lose the address
+        }
+        ip[id] = key;
+        indexInsert(_ipIndex, hashIP(key), id);
+    }
+    endIPWrite();
+    touch(id);
+}
+
+void DeviceRegistry::beginIPWrite() {
+    // Writers are serialized by dataMutex; only readers race with this
+    _ipSeq.store(_ipSeq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void DeviceRegistry::endIPWrite() {
+    _ipSeq.store(_ipSeq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+const char* DeviceRegistry::displayName(DeviceId id) const {
+    if ((flags[id] & DEVICE_CUSTOM_NAME) && customName[id] != 0) {
+        return namePool.str(customName[id]);
+    }
+    if (autoName[id] != 0) {
+        return namePool.str(autoName[id]);
+    }
+    return "Unknown Device";
+}
+
+bool DeviceRegistry::setName(DeviceId id, NameHandle& column, const char* name) {
+    // New reference first: name may be the current string itself
+    NameHandle h = namePool.intern(name);
+    if (h == 0 && name[0] != '\0') {
+        return false;
+    }
+    namePool.release(column);
+    column = h;
+    touch(id);
+    return true;
+}
+
+DeviceId DeviceRegistry::evictionCandidate() const {
+    // Devices with nothing saved go first, so a quiet host from the LAN scan
+    // is dropped before a device loaded with its totals at boot (lastSeen 0)
+    DeviceId oldest = DEVICE_NONE;
+    bool oldestHasStats = false;
+    for (uint16_t i = 0; i < _count; i++) {
+        DeviceId id = _order[i];
+        if (flags[id] & DEVICE_ACTIVE) {
+            continue;
+        }
+        bool stats = hasStats(id);
+        bool better = oldest == DEVICE_NONE ||
+                      (oldestHasStats && !stats) ||
+                      (stats == oldestHasStats && lastSeen[id] < lastSeen[oldest]);
+        if (better && evictable(id)) {
+            oldest = id;
+            oldestHasStats = stats;
+        }
+    }
+    return oldest;
+}
+
+bool DeviceRegistry::evictable(DeviceId id) const {
+    for (uint8_t i = 0; i < _listenerCount; i++) {
+        if (!_listeners[i]->canEvict(id)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DeviceRegistry::indexInsert(DeviceId* index, uint16_t home, DeviceId id) {
+    uint16_t i = home;
+    while (index[i] != DEVICE_NONE) {
+        i = (i + 1) & INDEX_MASK;
+    }
+    index[i] = id;
+}
+
+void DeviceRegistry::indexErase(DeviceId* index, DeviceId id, bool byIP) {
+    uint16_t hole = homeOf(id, byIP);
+    while (index[hole] != id) {
+        if (index[hole] == DEVICE_NONE) {
+            return;  // Not indexed
+        }
+        hole = (hole + 1) & INDEX_MASK;
+    }
+
+    // Backward-shift deletion: pull later entries of the probe run into the
+    // hole unless that would move them in front of their home slot
+    uint16_t i = hole;
+    for (;;) {
+        index[hole] = DEVICE_NONE;
+        for (;;) {
+            i = (i + 1) & INDEX_MASK;
+            if (index[i] == DEVICE_NONE) {
+                return;
+            }
+            uint16_t home = homeOf(index[i], byIP);
+            bool stays = hole <= i ? (hole < home && home <= i) : (hole < home || home <= i);
+            if (!stays) {
+                break;
+            }
+        }
+        index[hole] = index[i];
+        hole = i;
+    }
+}
+
+uint16_t DeviceRegistry::hashMAC(const uint8_t* mac) {
+    // The vendor prefix repeats a lot; the last four bytes carry the entropy
+    uint32_t key = ((uint32_t)mac[2] << 24) | ((uint32_t)mac[3] << 16) | ((uint32_t)mac[4] << 8) | mac[5];
+    return (uint16_t)((key * 2654435761u) >> 16) & INDEX_MASK;
+}
+
+uint16_t DeviceRegistry::hashIP(uint32_t ip) {
+    return (uint16_t)((ip * 2654435761u) >> 16) & INDEX_MASK;
+}
@@ -0,0 +1,199 @@
+#ifndef DEVICE_REGISTRY_H
+#define DEVICE_REGISTRY_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "config.h"
+#include "traffic_rate.h"
+#include "quota.h"
+#include "name_pool.h"
+
+// Index of a device's row in the registry. Stays the same for as long as the
+// device is in the table; a removed device's ID is reused by a later one.
+typedef uint16_t DeviceId;
+static const DeviceId DEVICE_NONE = 0xFFFF;
+
+enum DeviceFlag : uint8_t {
+    DEVICE_ACTIVE         = 0x01,  // Seen within DEVICE_TIMEOUT_MS
+    DEVICE_CUSTOM_NAME    = 0x02,  // customName set by the user
+    DEVICE_DIRTY          = 0x04,  // Counters changed since the last stats save
+    DEVICE_QUOTA_EXCEEDED = 0x08,
+    DEVICE_ONLINE         = 0x10   // Associated to the AP or in the LAN's ARP table
+};
+
+// A device removed from the table, kept so delta readers learn it is gone
+struct DeviceTombstone {
+    uint8_t mac[6];
+    uint32_t generation;  // Generation the removal belongs to
+};
+
+// Told when a row is filled or is about to be reused (main loop, dataMutex held).
+// onDeviceAdded runs with the MAC set and every other column zeroed;
+// onDeviceRemoved runs before anything is cleared. canEvict is asked before
+// an inactive row is reused for a new device; false keeps it.
+class DeviceListener {
+public:
+    virtual ~DeviceListener() {}
+    virtual void onDeviceAdded(DeviceId id) = 0;
+    virtual void onDeviceRemoved(DeviceId id) = 0;
+    virtual bool canEvict(DeviceId id) { (void)id; return true; }
+};
+
+// Every known device - AP clients and LAN hosts found by the scanner - in one
+// struct-of-arrays table. DeviceManager owns the identity columns (names),
+// BandwidthTracker the counters; both address rows by DeviceId, so the API
+// never has to join two device lists.
+//
+// MAC and IP lookups go through open-addressed hash indexes (linear probing,
+// backward-shift deletion, at most half full), so they stay O(1) when
+// MAX_DEVICES is raised to a couple of hundred. Live IDs are also kept in a
+// dense list for iteration.
+//
+// Not thread safe: everything here is read and written under dataMutex,
+// except lookupIP(), which any task may call without it.
+class DeviceRegistry {
+public:
+    DeviceRegistry();
+
+    bool addListener(DeviceListener* listener);
+
+    // Lookups (DEVICE_NONE if unknown)
+    DeviceId find(const uint8_t* mac) const;
+    DeviceId findByIP(const IPAddress& ip) const;
+
+    // IP -> MAC for tasks that do not hold dataMutex (DNS task). The IP index
+    // is published under a seqlock: writers bump a sequence number before and
+    // after changing it, readers retry if it moved or was odd while they read,
+    // and take dataMutex after IP_READ_RETRIES tries. Never call it with
+    // dataMutex held.
+    bool lookupIP(const IPAddress& ip, uint8_t* macOut) const;
+
+    // Find or add a device. When the table is full an inactive device makes
+    // room: one with no counters or quota first, then the one seen longest
+    // ago, among those every listener lets go. DEVICE_NONE if there is none.
+    DeviceId acquire(const uint8_t* mac);
+    void remove(DeviceId id);
+
+    // Assign an address. A device that held it before loses it, so an IP
+    // always resolves to the device that was seen with it last.
+    void setIP(DeviceId id, const IPAddress& ip);
+
+    // Iteration: at(0) .. at(count() - 1), in no particular order
+    uint16_t count() const { return _count; }
+    DeviceId at(uint16_t i) const { return _order[i]; }
+    bool full() const { return _count >= MAX_DEVICES; }
+
+    bool has(DeviceId id, DeviceFlag flag) const { return (flags[id] & flag) != 0; }
+    void set(DeviceId id, DeviceFlag flag, bool on) {
+        uint8_t f = on ? (flags[id] | flag) : (flags[id] & ~flag);
+        if (f != flags[id]) {
+            flags[id] = f;
+            if (flag != DEVICE_DIRTY) touch(id);
+        }
+    }
+
+    // Change counter for everything /api/devices shows. Writers call touch()
+    // after changing a row's counters, rates or attributes; flags, names,
+    // addresses and adds/removes touch by themselves. A touched row is stamped
+    // with the next generation, which a reader taking a snapshot closes with
+    // seal(), so the counter only moves once per snapshot however many
+    // packets were counted in between.
+    //
+    // generation() is what seal() would return; it is read without dataMutex
+    // for ETag checks.
+    uint32_t generation() const { return _generation + (_pending ? 1 : 0); }
+    uint32_t seal() {
+        if (_pending) {
+            _pending = false;
+            _generation = _generation + 1;
+        }
+        return _generation;
+    }
+    void touch(DeviceId id) {
+        changed[id] = _generation + 1;
+        _pending = true;
+    }
+
+    // Deltas: rows with changed[id] > since, plus the MACs removed after since.
+    // Only complete while the removals since then are still in the tombstone
+    // ring (and since is not ahead of the table); otherwise read everything.
+    bool deltaAvailable(uint32_t since) const { return since >= _tombstoneFloor && since <= _generation; }
+    uint8_t removedSince(uint32_t since, uint8_t (*macs)[6]) const;  // Up to DEVICE_TOMBSTONES
+
+    // Custom name, else the automatic one, else "Unknown Device". Like
+    // getAutoName(), valid until a name is next set (see NamePool::str).
+    const char* displayName(DeviceId id) const;
+
+    // Names are interned in namePool; "" clears. False if the pool is full,
+    // in which case the row keeps its previous name.
+    bool setCustomName(DeviceId id, const char* name) { return setName(id, customName[id], name); }
+    bool setAutoName(DeviceId id, const char* name) { return setName(id, autoName[id], name); }
+    const char* getAutoName(DeviceId id) const { return namePool.str(autoName[id]); }
+    uint64_t totalBytes(DeviceId id) const { return uploadBytes[id] + downloadBytes[id]; }
+
+    // Anything worth saving: traffic counted or a quota configured
+    bool hasStats(DeviceId id) const { return totalBytes(id) > 0 || quotaConfig[id].enabled(); }
+
+    // Columns, indexed by DeviceId. Written through the owning module;
+    // mac and ip only through acquire() and setIP() (they are indexed).
+    uint8_t mac[MAX_DEVICES][6];
+    uint32_t ip[MAX_DEVICES];  // IPAddress as uint32_t, 0 = unknown
+    uint8_t flags[MAX_DEVICES];
+    NameHandle customName[MAX_DEVICES];  // Set through setCustomName()
+    NameHandle autoName[MAX_DEVICES];    // Set through setAutoName()
+    uint64_t uploadBytes[MAX_DEVICES];
+    uint64_t downloadBytes[MAX_DEVICES];
+    uint32_t lastSeen[MAX_DEVICES];   // millis(), 0 = not seen since boot
+    uint32_t presenceSince[MAX_DEVICES]; // millis() of the last online/offline change, 0 = none
+    int8_t historySlot[MAX_DEVICES];  // BandwidthTracker history pool, -1 if none
+    uint8_t dhcpClass[MAX_DEVICES];   // DHCP fingerprint match (dhcp_fingerprint.h), 0 = unknown
+    TrafficRate rate[MAX_DEVICES];    // EWMA bytes/s and packets/s
+    QuotaConfig quotaConfig[MAX_DEVICES];
+    QuotaUsage quota[MAX_DEVICES];    // Counted alongside uploadBytes/downloadBytes
+    uint32_t changed[MAX_DEVICES];    // Generation of the last touch()
+
+private:
+    static const uint16_t INDEX_SIZE = 2 * MAX_DEVICES <= 64 ? 64 :
+                                       2 * MAX_DEVICES <= 128 ? 128 :
+                                       2 * MAX_DEVICES <= 256 ? 256 : 512;
+    static const uint16_t INDEX_MASK = INDEX_SIZE - 1;
+    static_assert(2 * MAX_DEVICES <= INDEX_SIZE, "MAX_DEVICES too large for the device index");
+
+    DeviceId _macIndex[INDEX_SIZE];
+    DeviceId _ipIndex[INDEX_SIZE];  // Written only inside beginIPWrite/endIPWrite
+    std::atomic<uint32_t> _ipSeq;   // Odd while the IP index is being changed
+    volatile uint32_t _generation;
+    volatile bool _pending;         // Rows touched since the last seal()
+
+    DeviceTombstone _tombstones[DEVICE_TOMBSTONES];
+    uint8_t _tombstoneHead;
+    uint8_t _tombstoneCount;
+    uint32_t _tombstoneFloor;       // Generation of the newest removal dropped from the ring
+
+    DeviceId _order[MAX_DEVICES];  // Dense list of live IDs
+    uint16_t _pos[MAX_DEVICES];    // Position of each live ID in _order
+    uint16_t _count;
+    bool _used[MAX_DEVICES];
+
+    DeviceListener* _listeners[DEVICE_MAX_LISTENERS];
+    uint8_t _listenerCount;
+
+    DeviceId evictionCandidate() const;
+    bool evictable(DeviceId id) const;
+    bool setName(DeviceId id, NameHandle& column, const char* name);
+    DeviceId probeIP(uint32_t key) const;
+    void beginIPWrite();
+    void endIPWrite();
+    void indexInsert(DeviceId* index, uint16_t home, DeviceId id);
+    void indexErase(DeviceId* index, DeviceId id, bool byIP);
+    uint16_t homeOf(DeviceId id, bool byIP) const {
+        return byIP ? hashIP(ip[id]) : hashMAC(mac[id]);
+    }
+
+    static uint16_t hashMAC(const uint8_t* mac);
+    static uint16_t hashIP(uint32_t ip);
+};
+
+extern DeviceRegistry deviceRegistry;
+
+#endif // DEVICE_REGISTRY_H
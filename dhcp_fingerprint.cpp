@@ -0,0 +1,176 @@
+#include "dhcp_fingerprint.h"
+#include <string.h>
+#include <stdio.h>
+
+// --- Fingerprint table ---
+
+// A row matches on an option 60 prefix or on the exact option 55 list.
+// Vendor class rows come first: a client that names itself is trusted over
+// the parameter list. Lists are from public DHCP fingerprint collections;
+// unknown requests are logged with their list so rows can be added here.
+struct DhcpFingerprint {
+    const char* vendorClass;
+    const char* params;
+    const char* os;
+    const char* type;
+};
+
+static const DhcpFingerprint FINGERPRINTS[] = {
+    { nullptr, nullptr, nullptr, nullptr },  // Class 0: unknown
+
+    // Option 60
+    { "MSFT 5.0",      nullptr, "Windows", "Computer" },
+    { "android-dhcp-", nullptr, "Android", "Mobile" },
+    { "dhcpcd-",       nullptr, "Linux",   "Computer" },
+    { "udhcp",         nullptr, "Linux",   "Embedded" },
+    { "ubnt",          nullptr, "AirOS",   "Network" },
+
+    // Option 55
+    { nullptr, "1,3,6,15,31,33,43,44,46,47,119,121,249,252", "Windows", "Computer" },
+    { nullptr, "1,15,3,6,44,46,47,31,33,121,249,43,252",     "Windows", "Computer" },
+    { nullptr, "1,15,3,6,44,46,47,31,33,121,249,43",         "Windows", "Computer" },
+    { nullptr, "1,121,3,6,15,119,252,95,44,46",              "macOS",   "Computer" },
+    { nullptr, "1,3,6,15,119,95,252,44,46,101",              "macOS",   "Computer" },
+    { nullptr, "1,121,3,6,15,114,119,252",                   "iOS",     "Mobile" },
+    { nullptr, "1,121,3,6,15,119,252",                       "iOS",     "Mobile" },
+    { nullptr, "1,3,6,15,119,252",                           "iOS",     "Mobile" },
+    { nullptr, "1,3,6,15,26,28,51,58,59,43,114",             "Android", "Mobile" },
+    { nullptr, "1,3,6,15,26,28,51,58,59,43",                 "Android", "Mobile" },
+    { nullptr, "1,3,6,15,26,28,51,58,59",                    "Android", "Mobile" },
+    { nullptr, "1,28,2,3,15,6,119,12,44,47,26,121,42",       "Linux",   "Computer" },
+    { nullptr, "1,3,6,12,15,28,42",                          "Linux",   "Embedded" },
+    { nullptr, "1,3,28,6,15,44,46,47,31,33,121,43",          "lwIP",    "IoT" },
+    { nullptr, "1,3,28,6",                                   "lwIP",    "IoT" },
+};
+
+static const uint8_t FINGERPRINT_COUNT = sizeof(FINGERPRINTS) / sizeof(FINGERPRINTS[0]);
+static_assert(sizeof(FINGERPRINTS) / sizeof(FINGERPRINTS[0]) <= 255, "Fingerprint class must fit a uint8_t");
+
+// --- Frame parsing ---
+
+static uint16_t readBE16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+// Copy an option value as a C string, keeping printable ASCII only
+static void copyPrintable(char* dst, size_t size, const uint8_t* src, uint8_t len) {
+    size_t n = 0;
+    for (uint8_t i = 0; i < len && n < size - 1; i++) {
+        if (src[i] >= 0x20 && src[i] < 0x7F) {
+            dst[n++] = (char)src[i];
+        }
+    }
+    dst[n] = '\0';
+}
+
+bool parseDhcpFrame(const uint8_t* frame, uint16_t len, DhcpEvent& out) {
+    const uint16_t ETH_HDR = 14;
+    const uint16_t UDP_HDR = 8;
+    const uint16_t BOOTP_FIXED = 236;  // op .. file, before the magic cookie
+
+    if (len < ETH_HDR + 20 + UDP_HDR + BOOTP_FIXED + 4) return false;
+    if (readBE16(frame + 12) != 0x0800) return false;  // IPv4
+
+    const uint8_t* ip = frame + ETH_HDR;
+    if ((ip[0] >> 4) != 4 || ip[9] != 17) return false;  // UDP
+    if (readBE16(ip + 6) & 0x3FFF) return false;          // Fragmented
+    uint16_t ihl = (ip[0] & 0x0F) * 4;
+    if (ihl < 20) return false;
+
+    const uint8_t* udp = ip + ihl;
+    const uint8_t* bootp = udp + UDP_HDR;
+    const uint8_t* end = frame + len;
+    if (bootp + BOOTP_FIXED + 4 > end) return false;
+    if (readBE16(udp) != 68 || readBE16(udp + 2) != 67) return false;
+
+    // BOOTREQUEST over Ethernet with the DHCP magic cookie
+    if (bootp[0] != 1 || bootp[1] != 1 || bootp[2] != 6) return false;
+    static const uint8_t COOKIE[4] = { 0x63, 0x82, 0x53, 0x63 };
+    if (memcmp(bootp + BOOTP_FIXED, COOKIE, 4) != 0) return false;
+
+    memcpy(out.mac, bootp + 28, 6);
+    out.messageType = 0;
+    out.paramCount = 0;
+    out.hostname[0] = '\0';
+    out.vendorClass[0] = '\0';
+
+    const uint8_t* opt = bootp + BOOTP_FIXED + 4;
+    while (opt < end) {
+        uint8_t code = opt[0];
+        if (code == 0) {  // Pad
+            opt++;
+            continue;
+        }
+        if (code == 255 || opt + 2 > end) {  // End
+            break;
+        }
+        uint8_t optLen = opt[1];
+        const uint8_t* value = opt + 2;
+        if (value + optLen > end) {
+            break;  // Truncated
+        }
+
+        switch (code) {
+            case 53:
+                if (optLen >= 1) out.messageType = value[0];
+                break;
+            case 12:
+                copyPrintable(out.hostname, sizeof(out.hostname), value, optLen);
+                break;
+            case 60:
+                copyPrintable(out.vendorClass, sizeof(out.vendorClass), value, optLen);
+                break;
+            case 55:
+                out.paramCount = optLen < DHCP_MAX_PARAMS ? optLen : DHCP_MAX_PARAMS;
+                memcpy(out.params, value, out.paramCount);
+                break;
+        }
+        opt = value + optLen;
+    }
+
+    return out.messageType != 0;
+}
+
+// --- Classification ---
+
+void formatDhcpParams(const DhcpEvent& evt, char* buf, size_t len) {
+    size_t n = 0;
+    buf[0] = '\0';
+    for (uint8_t i = 0; i < evt.paramCount; i++) {
+        int w = snprintf(buf + n, len - n, i ? ",%u" : "%u", evt.params[i]);
+        if (w < 0 || (size_t)w >= len - n) {
+            break;  // Truncated: will not match a row
+        }
+        n += w;
+    }
+}
+
+uint8_t classifyDhcp(const DhcpEvent& evt) {
+    if (evt.vendorClass[0] != '\0') {
+        for (uint8_t i = 1; i < FINGERPRINT_COUNT; i++) {
+            const char* prefix = FINGERPRINTS[i].vendorClass;
+            if (prefix && strncmp(evt.vendorClass, prefix, strlen(prefix)) == 0) {
+                return i;
+            }
+        }
+    }
+
+    if (evt.paramCount > 0) {
+        char params[DHCP_MAX_PARAMS * 4];
+        formatDhcpParams(evt, params, sizeof(params));
+        for (uint8_t i = 1; i < FINGERPRINT_COUNT; i++) {
+            if (FINGERPRINTS[i].params && strcmp(params, FINGERPRINTS[i].params) == 0) {
+                return i;
+            }
+        }
+    }
+    return 0;
+}
+
+const char* dhcpOSName(uint8_t cls) {
+    return cls < FINGERPRINT_COUNT ? FINGERPRINTS[cls].os : nullptr;
+}
+
+const char* dhcpDeviceType(uint8_t cls) {
+    return cls < FINGERPRINT_COUNT ? FINGERPRINTS[cls].type : nullptr;
+}
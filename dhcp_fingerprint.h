@@ -0,0 +1,51 @@
+#ifndef DHCP_FINGERPRINT_H
+#define DHCP_FINGERPRINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Passive DHCP fingerprinting.
+//
+// Stations send DHCPDISCOVER/REQUEST to the AP's DHCP server through the AP
+// netif input hook. parseDhcpFrame() pulls out the client MAC, hostname
+// (option 12), parameter request list (option 55) and vendor class (option 60);
+// classifyDhcp() matches them against a small built-in fingerprint table.
+// The parameter list is the useful part: every DHCP client asks for its own
+// options in its own order, so it identifies the OS family without sending
+// anything on the network.
+//
+// Like flow_table.h this has no Arduino dependencies, so the parser and the
+// table are tested on a host (test/dhcp_fingerprint_test.cpp).
+
+static const size_t DHCP_HOSTNAME_LEN = 32;
+static const size_t DHCP_VENDOR_CLASS_LEN = 32;
+static const size_t DHCP_MAX_PARAMS = 32;
+
+static const uint8_t DHCP_MSG_RELEASE = 7;  // Option 53: client gives up its lease
+
+// One client request, captured at the AP netif
+struct DhcpEvent {
+    uint8_t mac[6];           // chaddr
+    uint8_t messageType;      // Option 53 (1 = DISCOVER, 3 = REQUEST, 8 = INFORM)
+    uint8_t paramCount;
+    uint8_t params[DHCP_MAX_PARAMS];                 // Option 55, in request order
+    char hostname[DHCP_HOSTNAME_LEN];                // Option 12, printable only
+    char vendorClass[DHCP_VENDOR_CLASS_LEN];         // Option 60, printable only
+};
+
+// Parse an Ethernet frame holding a client->server DHCP message (UDP 68 -> 67).
+// Returns false for anything else; cheap to call on every received frame.
+bool parseDhcpFrame(const uint8_t* frame, uint16_t len, DhcpEvent& out);
+
+// Fingerprint class of a request: index into the built-in table, 0 if unknown
+uint8_t classifyDhcp(const DhcpEvent& evt);
+
+// OS family and device type of a class ("Windows", "Computer", ...);
+// nullptr for class 0
+const char* dhcpOSName(uint8_t cls);
+const char* dhcpDeviceType(uint8_t cls);
+
+// Option 55 as "1,3,6,15" (what the fingerprint table matches on)
+void formatDhcpParams(const DhcpEvent& evt, char* buf, size_t len);
+
+#endif // DHCP_FINGERPRINT_H
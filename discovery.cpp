@@ -0,0 +1,189 @@
+#include "discovery.h"
+#include "device_manager.h"
+#include <WiFi.h>
+#include <lwip/sockets.h>
+
+DiscoveryEngine discovery;
+
+// mDNS service types asked for in every round
+static const char* const DISCOVERY_SERVICES[] = {
+    "http", "workstation", "airplay", "googlecast",
+    "smb", "raop", "spotify-connect"
+};
+static const size_t DISCOVERY_SERVICE_COUNT = sizeof(DISCOVERY_SERVICES) / sizeof(DISCOVERY_SERVICES[0]);
+
+static const uint8_t SSDP_MX = 2;                  // Seconds devices may wait before replying
+static const size_t MAX_HOSTS_PER_ROUND = 32;      // Dedup list size
+static const unsigned long RETRY_OFFLINE_MS = 5000;
+
+// Task only: one packet at a time, kept off the task stack
+static uint8_t _packet[1500];
+
+DiscoveryEngine::DiscoveryEngine() :
+    _results(NULL),
+    _task(NULL),
+    _rounds(0),
+    _responses(0),
+    _dropped(0) {}
+
+bool DiscoveryEngine::begin() {
+    _results = xQueueCreate(DISCOVERY_QUEUE_SIZE, sizeof(DiscoveryResult));
+    if (!_results) {
+        DEBUG_PRINTLN("Discovery: Failed to create result queue");
+        return false;
+    }
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        taskFunc,
+        "discovery",
+        DISCOVERY_TASK_STACK_SIZE,
+        this,
+        DISCOVERY_TASK_PRIORITY,
+        &_task,
+        0  // Core 0, away from the main loop
+    );
+    if (result != pdPASS) {
+        DEBUG_PRINTLN("Discovery: Failed to create task");
+        return false;
+    }
+
+    DEBUG_PRINTF("Discovery: %u mDNS services + SSDP every %lus\n",
+                 (unsigned)DISCOVERY_SERVICE_COUNT, (unsigned long)(DISCOVERY_INTERVAL_MS / 1000));
+    return true;
+}
+
+void DiscoveryEngine::update() {
+    if (!_results) {
+        return;
+    }
+
+    DiscoveryResult res;
+    while (xQueueReceive(_results, &res, 0) == pdTRUE) {
+        DeviceId id = deviceRegistry.findByIP(IPAddress(res.ip));
+        if (id == DEVICE_NONE || deviceRegistry.has(id, DEVICE_CUSTOM_NAME)) {
+            continue;
+        }
+        const char* current = deviceRegistry.getAutoName(id);
+        // SSDP only knows the product, so it just fills in missing names
+        if (res.source == DISCOVERY_SSDP && current[0] != '\0') {
+            continue;
+        }
+        if (strncmp(current, res.name, MAX_DEVICE_NAME - 1) != 0) {
+            deviceManager.updateDeviceHostname(id, res.name);
+        }
+    }
+}
+
+// Runs on core 0 as a separate FreeRTOS task
+void DiscoveryEngine::taskFunc(void* param) {
+    DiscoveryEngine* self = (DiscoveryEngine*)param;
+
+    for (;;) {
+        if (!self->runRound()) {
+            vTaskDelay(pdMS_TO_TICKS(RETRY_OFFLINE_MS));
+            continue;
+        }
+        vTaskDelay(pdMS_TO_TICKS(DISCOVERY_INTERVAL_MS));
+    }
+}
+
+// Both queries out of one interface. Multicast follows the default route
+// (the uplink) unless the socket names the interface address.
+static void sendBurst(int sock, uint32_t ifAddr) {
+    struct in_addr iface;
+    iface.s_addr = ifAddr;
+    if (setsockopt(sock, IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface)) != 0) {
+        DEBUG_PRINTF("Discovery: Cannot send from %s\n", IPAddress(ifAddr).toString().c_str());
+        return;
+    }
+
+    struct sockaddr_in to = {};
+    to.sin_family = AF_INET;
+
+    size_t len = buildMdnsQuery(_packet, sizeof(_packet), DISCOVERY_SERVICES, DISCOVERY_SERVICE_COUNT);
+    to.sin_port = htons(MDNS_PORT);
+    to.sin_addr.s_addr = (uint32_t)IPAddress(224, 0, 0, 251);
+    sendto(sock, _packet, len, 0, (struct sockaddr*)&to, sizeof(to));
+
+    len = buildSsdpSearch((char*)_packet, sizeof(_packet), SSDP_MX);
+    to.sin_port = htons(SSDP_PORT);
+    to.sin_addr.s_addr = (uint32_t)IPAddress(239, 255, 255, 250);
+    sendto(sock, _packet, len, 0, (struct sockaddr*)&to, sizeof(to));
+}
+
+bool DiscoveryEngine::runRound() {
+    // The AP side is asked even while the uplink is down
+    uint32_t apAddr = (uint32_t)WiFi.softAPIP();
+    uint32_t staAddr = WiFi.status() == WL_CONNECTED ? (uint32_t)WiFi.localIP() : 0;
+    if (apAddr == 0 && staAddr == 0) {
+        return false;
+    }
+
+    // Ephemeral port on every address: replies come back by unicast
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0) {
+        DEBUG_PRINTLN("Discovery: Failed to open socket");
+        return false;
+    }
+    struct sockaddr_in local = {};
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(sock, (struct sockaddr*)&local, sizeof(local)) != 0) {
+        DEBUG_PRINTLN("Discovery: Failed to open socket");
+        close(sock);
+        return false;
+    }
+
+    if (apAddr != 0) sendBurst(sock, apAddr);
+    if (staAddr != 0) sendBurst(sock, staAddr);
+
+    // Hosts already reported this round, per source
+    uint32_t seen[MAX_HOSTS_PER_ROUND];
+    uint8_t seenSource[MAX_HOSTS_PER_ROUND];
+    size_t seenCount = 0;
+
+    unsigned long start = millis();
+    while (millis() - start < DISCOVERY_LISTEN_MS) {
+        struct sockaddr_in from;
+        socklen_t fromLen = sizeof(from);
+        int n = recvfrom(sock, _packet, sizeof(_packet), MSG_DONTWAIT, (struct sockaddr*)&from, &fromLen);
+        if (n <= 0) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+            continue;
+        }
+
+        uint32_t src = from.sin_addr.s_addr;
+        DiscoveryResult res;
+        bool ok = (n > 5 && memcmp(_packet, "HTTP/", 5) == 0)
+            ? parseSsdpResponse((const char*)_packet, n, src, res)
+            : parseMdnsResponse(_packet, n, src, res);
+        if (!ok) {
+            continue;
+        }
+        _responses++;
+
+        bool duplicate = false;
+        for (size_t i = 0; i < seenCount; i++) {
+            if (seen[i] == res.ip && seenSource[i] == res.source) {
+                duplicate = true;
+                break;
+            }
+        }
+        // A host that cannot be remembered would be queued for every reply;
+        // it waits for the next round instead
+        if (duplicate || seenCount == MAX_HOSTS_PER_ROUND) {
+            continue;
+        }
+        seen[seenCount] = res.ip;
+        seenSource[seenCount++] = res.source;
+
+        if (xQueueSend(_results, &res, 0) != pdTRUE) {
+            _dropped++;
+        }
+    }
+
+    close(sock);
+    _rounds++;
+    DEBUG_PRINTF("Discovery: Round %u, %u hosts\n", (unsigned)_rounds, (unsigned)seenCount);
+    return true;
+}
@@ -0,0 +1,47 @@
+#ifndef DISCOVERY_H
+#define DISCOVERY_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include "config.h"
+#include "discovery_wire.h"
+
+// LAN name discovery off the main loop.
+//
+// A task on core 0 sends one mDNS query for every service type in
+// DISCOVERY_SERVICES plus one SSDP M-SEARCH out of the AP and (while
+// connected) the STA interface, then parses replies as they arrive for
+// DISCOVERY_LISTEN_MS. Each host is reported once per round
+// and source through a queue; update() in loop() applies the names to
+// the registry, so dataMutex is only held for the short copy, never for
+// the network wait.
+class DiscoveryEngine {
+public:
+    DiscoveryEngine();
+
+    bool begin();
+
+    // Apply queued results to the registry (call in loop, under dataMutex)
+    void update();
+
+    uint32_t getRounds() const { return _rounds; }
+    uint32_t getResponses() const { return _responses; }
+    uint32_t getDropped() const { return _dropped; }
+
+private:
+    QueueHandle_t _results;  // Task -> main loop
+    TaskHandle_t _task;
+
+    volatile uint32_t _rounds;
+    volatile uint32_t _responses;  // Parsed replies, before dedup
+    volatile uint32_t _dropped;    // Results lost to a full queue
+
+    bool runRound();  // false: no interface up yet
+    static void taskFunc(void* param);
+};
+
+extern DiscoveryEngine discovery;
+
+#endif // DISCOVERY_H
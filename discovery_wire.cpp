@@ -0,0 +1,215 @@
+#include "discovery_wire.h"
+#include <string.h>
+#include <strings.h>
+#include <stdio.h>
+
+static uint16_t readBE16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+// --- mDNS ---
+
+static const uint16_t DNS_TYPE_A   = 1;
+static const uint16_t DNS_TYPE_PTR = 12;
+static const uint16_t DNS_TYPE_SRV = 33;
+
+size_t buildMdnsQuery(uint8_t* buf, size_t len, const char* const* services, size_t count) {
+    static const char TCP_LOCAL[] = "\x04_tcp\x05local";  // + terminating 0
+    if (len < 12) return 0;
+
+    memset(buf, 0, 12);  // ID 0, standard query
+    buf[4] = (uint8_t)(count >> 8);
+    buf[5] = (uint8_t)count;
+    size_t pos = 12;
+
+    for (size_t i = 0; i < count; i++) {
+        size_t svcLen = strlen(services[i]);
+        if (svcLen == 0 || svcLen > 62) return 0;
+        size_t need = 2 + svcLen + sizeof(TCP_LOCAL) + 4;  // label, suffix + root, QTYPE/QCLASS
+        if (pos + need > len) return 0;
+
+        buf[pos++] = (uint8_t)(svcLen + 1);
+        buf[pos++] = '_';
+        memcpy(buf + pos, services[i], svcLen);
+        pos += svcLen;
+        memcpy(buf + pos, TCP_LOCAL, sizeof(TCP_LOCAL));  // Includes the root label
+        pos += sizeof(TCP_LOCAL);
+        buf[pos++] = 0;
+        buf[pos++] = DNS_TYPE_PTR;
+        buf[pos++] = 0x80;  // QU: ask for a unicast reply
+        buf[pos++] = 0x01;  // IN
+    }
+    return pos;
+}
+
+// Decode a (possibly compressed) name at off into dotted form. Returns the
+// offset just past the name in the record, or 0 if it is malformed.
+static size_t readName(const uint8_t* pkt, size_t len, size_t off, char* out, size_t outLen) {
+    size_t n = 0;
+    size_t next = 0;  // Where the record continues after the first pointer
+    int jumps = 0;
+
+    if (outLen) out[0] = '\0';
+    for (;;) {
+        if (off >= len) return 0;
+        uint8_t label = pkt[off];
+        if (label == 0) {
+            off++;
+            break;
+        }
+        if ((label & 0xC0) == 0xC0) {
+            if (off + 1 >= len || ++jumps > 16) return 0;
+            if (!next) next = off + 2;
+            off = ((label & 0x3F) << 8) | pkt[off + 1];
+            continue;
+        }
+        if (label & 0xC0) return 0;  // Reserved label types
+        if (off + 1 + label > len) return 0;
+
+        for (uint8_t i = 0; i <= label && outLen; i++) {
+            char c = i == 0 ? '.' : (char)pkt[off + i];
+            if (i == 0 && n == 0) continue;  // No leading dot
+            if (n + 1 < outLen) out[n++] = c;
+        }
+        off += 1 + label;
+    }
+    if (outLen) out[n] = '\0';
+    return next ? next : off;
+}
+
+// "host.local" -> "host"; false if nothing is left
+static bool copyHostName(char* dst, size_t size, const char* name) {
+    size_t n = strlen(name);
+    if (n > 6 && strcasecmp(name + n - 6, ".local") == 0) {
+        n -= 6;
+    }
+    if (n == 0) return false;
+    if (n > size - 1) n = size - 1;
+    memcpy(dst, name, n);
+    dst[n] = '\0';
+    return true;
+}
+
+bool parseMdnsResponse(const uint8_t* pkt, size_t len, uint32_t srcIP, DiscoveryResult& out) {
+    if (len < 12 || !(pkt[2] & 0x80)) return false;  // Responses only
+
+    uint16_t qd = readBE16(pkt + 4);
+    uint16_t records = readBE16(pkt + 6) + readBE16(pkt + 8) + readBE16(pkt + 10);
+    size_t off = 12;
+    char name[128];
+
+    for (uint16_t i = 0; i < qd; i++) {
+        off = readName(pkt, len, off, name, 0);
+        if (!off || off + 4 > len) return false;
+        off += 4;
+    }
+
+    bool haveA = false, haveSrv = false;
+    char srvTarget[DISCOVERY_NAME_LEN] = "";
+    out.ip = srcIP;
+    out.source = DISCOVERY_MDNS;
+    out.name[0] = '\0';
+
+    for (uint16_t i = 0; i < records; i++) {
+        off = readName(pkt, len, off, name, sizeof(name));
+        if (!off || off + 10 > len) break;
+        uint16_t type = readBE16(pkt + off);
+        uint16_t rdLen = readBE16(pkt + off + 8);
+        size_t rdata = off + 10;
+        if (rdata + rdLen > len) break;
+        off = rdata + rdLen;
+
+        if (type == DNS_TYPE_A && rdLen == 4) {
+            uint32_t addr;
+            memcpy(&addr, pkt + rdata, 4);
+            // Prefer the record for the address that answered
+            if ((!haveA || addr == srcIP) && copyHostName(out.name, sizeof(out.name), name)) {
+                out.ip = addr;
+                haveA = true;
+            }
+        } else if (type == DNS_TYPE_SRV && rdLen > 6 && !haveSrv) {
+            char target[128];
+            if (readName(pkt, len, rdata + 6, target, sizeof(target)) &&
+                copyHostName(srvTarget, sizeof(srvTarget), target)) {
+                haveSrv = true;
+            }
+        }
+    }
+
+    if (!haveA && haveSrv) {
+        memcpy(out.name, srvTarget, sizeof(srvTarget));
+    }
+    return out.name[0] != '\0' && out.ip != 0;
+}
+
+// --- SSDP ---
+
+size_t buildSsdpSearch(char* buf, size_t len, uint8_t mx) {
+    int n = snprintf(buf, len,
+                     "M-SEARCH * HTTP/1.1\r\n"
+                     "HOST: 239.255.255.250:1900\r\n"
+                     "MAN: \"ssdp:discover\"\r\n"
+                     "MX: %u\r\n"
+                     "ST: ssdp:all\r\n"
+                     "\r\n", mx);
+    return n > 0 && (size_t)n < len ? (size_t)n : 0;
+}
+
+// Tokens of a SERVER header that say nothing about the product
+static bool isGenericToken(const char* token, size_t len) {
+    static const char* const GENERIC[] = {
+        "dlnadoc", "linux", "microsoft-windows", "windows", "darwin",
+        "freebsd", "android", "ios", "posix", "unix", "os", "http"
+    };
+    if (len == 0) return true;
+    if (len >= 4 && strncasecmp(token, "upnp", 4) == 0) return true;  // UPnP, UPnP-Device-Host
+    for (size_t i = 0; i < sizeof(GENERIC) / sizeof(GENERIC[0]); i++) {
+        if (strlen(GENERIC[i]) == len && strncasecmp(token, GENERIC[i], len) == 0) return true;
+    }
+    return false;
+}
+
+bool parseSsdpResponse(const char* pkt, size_t len, uint32_t srcIP, DiscoveryResult& out) {
+    if (len < 12 || strncmp(pkt, "HTTP/1.1 200", 12) != 0) return false;
+
+    const char* end = pkt + len;
+    const char* line = pkt;
+    while (line < end) {
+        const char* eol = (const char*)memchr(line, '\n', end - line);
+        if (!eol) eol = end;
+        size_t lineLen = eol - line;
+
+        if (lineLen > 7 && strncasecmp(line, "SERVER:", 7) == 0) {
+            // Last product token that is not an OS or protocol name
+            const char* best = nullptr;
+            size_t bestLen = 0;
+            const char* p = line + 7;
+            while (p < eol) {
+                while (p < eol && (*p == ' ' || *p == '\t' || *p == ',')) p++;
+                if (p < eol && *p == '(') {  // Comment, e.g. "(ZPS1)"
+                    while (p < eol && *p != ')') p++;
+                    if (p < eol) p++;
+                    continue;
+                }
+                const char* tok = p;
+                while (p < eol && *p != ' ' && *p != '\t' && *p != ',' && *p != '\r') p++;
+                const char* slash = (const char*)memchr(tok, '/', p - tok);
+                size_t prodLen = (slash ? slash : p) - tok;
+                if (!isGenericToken(tok, prodLen)) {
+                    best = tok;
+                    bestLen = prodLen;
+                }
+                if (p < eol && *p == '\r') break;
+            }
+            if (!best) return false;
+            if (bestLen > sizeof(out.name) - 1) bestLen = sizeof(out.name) - 1;
+            memcpy(out.name, best, bestLen);
+            out.name[bestLen] = '\0';
+            out.ip = srcIP;
+            out.source = DISCOVERY_SSDP;
+            return true;
+        }
+        line = eol + 1;
+    }
+    return false;
+}
@@ -0,0 +1,46 @@
+#ifndef DISCOVERY_WIRE_H
+#define DISCOVERY_WIRE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Wire formats for LAN discovery: one multicast mDNS query that asks for
+// several service types at once, an SSDP M-SEARCH, and parsers for the
+// replies. Queries are sent from an ephemeral port, so responders answer
+// by unicast (RFC 6762 section 6.7 legacy unicast, and SSDP always does).
+//
+// No Arduino dependencies, so the parsers run on a host too
+// (test/discovery_wire_test.cpp).
+
+static const size_t DISCOVERY_NAME_LEN = 32;
+
+static const uint16_t MDNS_PORT = 5353;
+static const uint16_t SSDP_PORT = 1900;
+
+enum DiscoverySource : uint8_t {
+    DISCOVERY_MDNS = 0,  // name is the host name (without .local)
+    DISCOVERY_SSDP = 1   // name is the product from the SERVER header
+};
+
+struct DiscoveryResult {
+    uint32_t ip;         // Network byte order
+    DiscoverySource source;
+    char name[DISCOVERY_NAME_LEN];
+};
+
+// PTR query for "_<service>._tcp.local" for every service, QU bit set.
+// Returns the packet length, 0 if buf is too small.
+size_t buildMdnsQuery(uint8_t* buf, size_t len, const char* const* services, size_t count);
+
+// Host name and address from an mDNS response (A record, else SRV target).
+// srcIP (network byte order) is used when the response has no A record.
+bool parseMdnsResponse(const uint8_t* pkt, size_t len, uint32_t srcIP, DiscoveryResult& out);
+
+// "M-SEARCH * HTTP/1.1" for ssdp:all. Returns the length, 0 if too small.
+size_t buildSsdpSearch(char* buf, size_t len, uint8_t mx);
+
+// Product name from the SERVER header of an M-SEARCH response, e.g.
+// "Linux/4.9 UPnP/1.0 Roku/9.4" -> "Roku" (OS and UPnP tokens skipped)
+bool parseSsdpResponse(const char* pkt, size_t len, uint32_t srcIP, DiscoveryResult& out);
+
+#endif // DISCOVERY_WIRE_H
@@ -1,5 +1,6 @@
 #include "dns_server.h"
 #include "storage_manager.h"
+#include "device_registry.h"
 
 DNSBlockingServer dnsServer;
 
@@ -15,6 +16,8 @@ struct DNSHeader {
 
 DNSBlockingServer::DNSBlockingServer() :
     upstreamDNS(DEFAULT_UPSTREAM_DNS),
+    _blocklistGeneration(0),
+    _blockedClientCount(0),
     queryCount(0),
     blockedCount(0),
     cacheHits(0),
@@ -31,6 +34,7 @@ bool DNSBlockingServer::begin() {
 
     // Load blocked domains from storage
     blockedDomains = storage.loadBlockedDomains();
+    _blocklistGeneration = _blocklistGeneration + 1;
 
     // Start UDP listener on port 53
     if (!udp.begin(DNS_PORT)) {
@@ -158,6 +162,14 @@ void DNSBlockingServer::handleDNSRequest() {
     domain = normalizeDomain(domain);
     DEBUG_PRINTF("DNS: Query for '%s' from %s\n", domain.c_str(), udp.remoteIP().toString().c_str());
 
+    // Devices over a block-DNS quota get nothing resolved
+    if (isClientBlocked(udp.remoteIP())) {
+        DEBUG_PRINTF("DNS: BLOCKED '%s' (client over quota)\n", domain.c_str());
+        blockedCount++;
+        sendBlockedResponse(buffer, len, udp.remoteIP(), udp.remotePort());
+        return;
+    }
+
     // Check if domain is blocked
     if (isBlocked(domain)) {
         DEBUG_PRINTF("DNS: BLOCKED '%s'\n", domain.c_str());
@@ -401,6 +413,7 @@ bool DNSBlockingServer::addBlockedDomain(const String& domain) {
     }
 
     blockedDomains.push_back(normalized);
+    _blocklistGeneration = _blocklistGeneration + 1;
     storage.saveBlockedDomains(blockedDomains);
     DEBUG_PRINTF("DNS: Blocked domain added: %s\n", normalized.c_str());
     return true;
@@ -412,6 +425,7 @@ bool DNSBlockingServer::removeBlockedDomain(const String& domain) {
     for (auto it = blockedDomains.begin(); it != blockedDomains.end(); ++it) {
         if (it->equalsIgnoreCase(normalized)) {
             blockedDomains.erase(it);
+            _blocklistGeneration = _blocklistGeneration + 1;
             storage.saveBlockedDomains(blockedDomains);
             DEBUG_PRINTF("DNS: Blocked domain removed: %s\n", normalized.c_str());
             return true;
@@ -438,6 +452,55 @@ bool DNSBlockingServer::isBlocked(const String& domain) {
     return result;
 }
 
+void DNSBlockingServer::onQuotaExceeded(const uint8_t* mac, const QuotaConfig& cfg) {
+    // Called from the main loop with dataMutex held
+    if (cfg.action != QUOTA_ACTION_BLOCK_DNS) {
+        return;
+    }
+    for (const auto& blocked : _blockedClients) {
+        if (memcmp(blocked.data(), mac, 6) == 0) {
+            return;
+        }
+    }
+    std::array<uint8_t, 6> entry;
+    memcpy(entry.data(), mac, 6);
+    _blockedClients.push_back(entry);
+    _blockedClientCount = _blockedClients.size();
+}
+
+void DNSBlockingServer::onQuotaRestored(const uint8_t* mac) {
+    for (auto it = _blockedClients.begin(); it != _blockedClients.end(); ++it) {
+        if (memcmp(it->data(), mac, 6) == 0) {
+            _blockedClients.erase(it);
+            _blockedClientCount = _blockedClients.size();
+            return;
+        }
+    }
+}
+
+bool DNSBlockingServer::isClientBlocked(const IPAddress& client) {
+    // Nobody over a DNS-block quota (the usual case) or an unknown client:
+    // answered without touching dataMutex
+    if (_blockedClientCount == 0) {
+        return false;
+    }
+    uint8_t mac[6];
+    if (!deviceRegistry.lookupIP(client, mac)) {
+        return false;
+    }
+
+    bool result = false;
+    xSemaphoreTake(dataMutex, portMAX_DELAY);
+    for (const auto& blocked : _blockedClients) {
+        if (memcmp(blocked.data(), mac, 6) == 0) {
+            result = true;
+            break;
+        }
+    }
+    xSemaphoreGive(dataMutex);
+    return result;
+}
+
 bool DNSBlockingServer::domainMatches(const String& queryDomain, const String& blockedDomain) {
     // Exact match
     if (queryDomain.equalsIgnoreCase(blockedDomain)) {
@@ -477,6 +540,7 @@ std::vector<String> DNSBlockingServer::getBlockedDomains() {
 
 void DNSBlockingServer::clearBlockedDomains() {
     blockedDomains.clear();
+    _blocklistGeneration = _blocklistGeneration + 1;
     storage.saveBlockedDomains(blockedDomains);
     DEBUG_PRINTLN("DNS: Cleared all blocked domains");
 }
@@ -4,10 +4,12 @@
 #include <Arduino.h>
 #include <WiFiUdp.h>
 #include <vector>
+#include <array>
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
 #include <freertos/task.h>
 #include "config.h"
+#include "quota.h"
 
 // DNS forward request (main loop -> forwarding task)
 struct DNSForwardRequest {
@@ -36,7 +38,9 @@ struct DNSCacheEntry {
     bool valid;
 };
 
-class DNSBlockingServer {
+// As a QuotaListener, refuses all queries from devices that are over a
+// quota with the block-DNS action.
+class DNSBlockingServer : public QuotaListener {
 public:
     DNSBlockingServer();
 
@@ -51,6 +55,12 @@ public:
     bool isBlocked(const String& domain);
     std::vector<String> getBlockedDomains();
     void clearBlockedDomains();
+    uint32_t getBlocklistGeneration() const { return _blocklistGeneration; }  // Bumped on every change
+
+    // Per-client blocking (quota enforcement)
+    void onQuotaExceeded(const uint8_t* mac, const QuotaConfig& cfg) override;
+    void onQuotaRestored(const uint8_t* mac) override;
+    bool isClientBlocked(const IPAddress& client);
 
     // DNS Configuration
     void setUpstreamDNS(const IPAddress& dns);
@@ -65,6 +75,9 @@ private:
     WiFiUDP udp;
     IPAddress upstreamDNS;
     std::vector<String> blockedDomains;
+    volatile uint32_t _blocklistGeneration;  // Read without the mutex to validate cached responses
+    std::vector<std::array<uint8_t, 6>> _blockedClients;  // MACs, guarded by dataMutex
+    volatile uint8_t _blockedClientCount;  // Read without the mutex as a fast path
     uint32_t queryCount;
     uint32_t blockedCount;
     uint32_t cacheHits;
@@ -3,6 +3,8 @@
  *
  * Features:
  * - Per-device bandwidth tracking
+ * - Per-device upload/download rate limits
+ * - Daily/monthly data quotas (throttle or DNS block)
  * - DNS-based domain blocking
  * - Web dashboard for monitoring and control
  *
@@ -31,15 +33,24 @@
 #include "dns_server.h"
 #include "bandwidth_tracker.h"
 #include "device_manager.h"
+#include "device_registry.h"
+#include "presence.h"
+#include "oui_lookup.h"
 #include "web_server.h"
 #include "network_scanner.h"
+#include "discovery.h"
+#include "traffic_shaper.h"
+#include "spsc_ring.h"
 #include <ESPmDNS.h>
 
 // Forward declarations
 void onClientConnect(uint8_t* mac, IPAddress ip);
 void onClientDisconnect(uint8_t* mac);
 void onPacketReceived(const uint8_t* srcMac, const uint8_t* dstMac, uint16_t length, bool isUpload);
+void onFlowPacket(const FlowEvent& evt);
+void onDhcpRequest(const DhcpEvent& evt);
 void processEventQueues();
+void onVendorResolved(const uint8_t* oui, const char* vendor);
 
 // Event queue for cross-task communication
 // WiFi events run on a different task than loop().
@@ -48,13 +59,16 @@ void processEventQueues();
 struct ConnectEvent {
     uint8_t mac[6];
     IPAddress ip;
+    bool connected;  // false: station left the AP
 };
 
-static const int EVENT_QUEUE_SIZE = 8;
+static const size_t EVENT_QUEUE_SIZE = 8;
 
-static ConnectEvent connectQueue[EVENT_QUEUE_SIZE];
-static volatile int connectHead = 0;
-static volatile int connectTail = 0;
+// Producer: WiFi event task, consumer: loop()
+static SpscRing<ConnectEvent, EVENT_QUEUE_SIZE> connectQueue;
+
+// Producer: WiFi task (AP netif input hook), consumer: loop()
+static SpscRing<DhcpEvent, EVENT_QUEUE_SIZE> dhcpQueue;
 
 // Global mutex for shared data (defined here, declared extern in config.h)
 SemaphoreHandle_t dataMutex = NULL;
@@ -99,21 +113,39 @@ void setup() {
         ESP.restart();
     }
 
+    // Wall clock for daily/monthly quotas (SNTP syncs once the router link is up)
+    configTime(0, 0, NTP_SERVER);
+
     // Step 3: Initialize NAT/routing
     DEBUG_PRINTLN("[3/8] Enabling NAT...");
     delay(1000);  // Wait for interfaces to stabilize
 
+    // Restore rate limits before the forwarding hooks go live
+    trafficShaper.begin();
+
     if (!natEngine.begin()) {
         DEBUG_PRINTLN("WARNING: NAT initialization failed");
         DEBUG_PRINTLN("Internet access may not work for connected devices");
     }
 
-    // Register callback for bandwidth tracking
+    // Register callbacks for bandwidth and flow tracking
     natEngine.setPacketCallback(onPacketReceived);
+    natEngine.setFlowCallback(onFlowPacket);
+    natEngine.setDhcpCallback(onDhcpRequest);
 
     // Step 4: Initialize bandwidth tracker
     DEBUG_PRINTLN("[4/8] Starting bandwidth tracker...");
+    ouiLookup.onResolved(onVendorResolved);
+    ouiLookup.begin();
+    deviceRegistry.addListener(&deviceManager);
+    deviceRegistry.addListener(&bandwidthTracker);
+    deviceRegistry.addListener(&presence);
+    bandwidthTracker.addQuotaListener(&dnsServer);
+    bandwidthTracker.addQuotaListener(&trafficShaper);
     bandwidthTracker.begin();
+    // Static sizes next to the heap, to compare builds with other limits
+    DEBUG_PRINTF("Memory: registry %u B, name pool %u B, free heap %u B\n",
+                 (unsigned)sizeof(DeviceRegistry), (unsigned)sizeof(NamePool), ESP.getFreeHeap());
 
     // Step 5: Initialize DNS server
     DEBUG_PRINTLN("[5/8] Starting DNS server...");
@@ -136,9 +168,12 @@ void setup() {
         DEBUG_PRINTLN("WARNING: mDNS failed to start");
     }
 
-    // Step 8: Initialize network scanner (ARP + mDNS device discovery)
+    // Step 8: Initialize network scanner (ARP) and mDNS/SSDP discovery
     DEBUG_PRINTLN("[8/8] Starting network scanner...");
     networkScanner.begin();
+    if (!discovery.begin()) {
+        DEBUG_PRINTLN("WARNING: Discovery task failed to start");
+    }
 
     // Print summary
     DEBUG_PRINTLN("\n========================================");
@@ -169,9 +204,15 @@ void loop() {
     xSemaphoreTake(dataMutex, portMAX_DELAY);
     processEventQueues();
     bandwidthTracker.update();
+    deviceManager.update();
     networkScanner.update();
+    discovery.update();
+    ouiLookup.update();
     xSemaphoreGive(dataMutex);
 
+    // Dashboard push frame, built under the mutex and sent after it is released
+    webDashboard.update();
+
     // DNS processing runs outside the mutex.
     // The DNS server internally takes the mutex only for brief blocklist checks,
     // so the potentially blocking DNS forwarding (up to 3s) doesn't hold the mutex.
@@ -192,13 +233,20 @@ void loop() {
 
 // Process queued events from other tasks (called from main loop only)
 void processEventQueues() {
-    // Process client connect events (from WiFi event task)
-    while (connectTail != connectHead) {
-        deviceManager.updateDevice(
-            connectQueue[connectTail].mac,
-            connectQueue[connectTail].ip
-        );
-        connectTail = (connectTail + 1) % EVENT_QUEUE_SIZE;
+    // Process client connect/disconnect events (from WiFi event task)
+    ConnectEvent evt;
+    while (connectQueue.pop(evt)) {
+        if (evt.connected) {
+            deviceManager.updateDevice(evt.mac, evt.ip, PRESENCE_AP);
+        } else {
+            deviceManager.deviceOffline(evt.mac, millis());
+        }
+    }
+
+    // Process DHCP requests (from the AP netif hook)
+    DhcpEvent dhcp;
+    while (dhcpQueue.pop(dhcp)) {
+        deviceManager.updateDeviceDHCP(dhcp);
     }
 }
 
@@ -208,18 +256,23 @@ void onClientConnect(uint8_t* mac, IPAddress ip) {
                  mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
 
     // Queue for main loop processing (don't modify DeviceManager here)
-    int next = (connectHead + 1) % EVENT_QUEUE_SIZE;
-    if (next != connectTail) {
-        memcpy(connectQueue[connectHead].mac, mac, 6);
-        connectQueue[connectHead].ip = ip;
-        connectHead = next;
-    }
+    ConnectEvent evt;
+    memcpy(evt.mac, mac, 6);
+    evt.ip = ip;
+    evt.connected = true;
+    connectQueue.push(evt);
 }
 
 // Callback when a client disconnects from AP
 void onClientDisconnect(uint8_t* mac) {
     DEBUG_PRINTF("Client disconnected: %02X:%02X:%02X:%02X:%02X:%02X\n",
                  mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+
+    ConnectEvent evt;
+    memcpy(evt.mac, mac, 6);
+    evt.ip = IPAddress();
+    evt.connected = false;
+    connectQueue.push(evt);
 }
 
 // Callback for packet interception (from WiFi task via promiscuous mode)
@@ -227,3 +280,19 @@ void onPacketReceived(const uint8_t* srcMac, const uint8_t* dstMac, uint16_t len
     // recordPacket uses its own ring buffer - safe from WiFi task
     bandwidthTracker.recordPacket(srcMac, dstMac, length, isUpload);
 }
+
+// Callback for forwarded IPv4 packets (from the AP netif hooks)
+void onFlowPacket(const FlowEvent& evt) {
+    // recordFlow uses one ring per direction - safe from WiFi and lwIP tasks
+    bandwidthTracker.recordFlow(evt);
+}
+
+// Callback for DHCP requests to the AP (WiFi task - queue for main loop)
+void onDhcpRequest(const DhcpEvent& evt) {
+    dhcpQueue.push(evt);
+}
+
+// Callback for online vendor lookups (from ouiLookup.update() in loop, mutex held)
+void onVendorResolved(const uint8_t* oui, const char* vendor) {
+    deviceManager.applyVendor(oui, vendor);
+}
@@ -0,0 +1,310 @@
+#include "flow_table.h"
+#include <string.h>
+#include <new>
+
+// --- Frame parsing ---
+
+static uint16_t readBE16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+bool parseFlowFrame(const uint8_t* frame, uint16_t len, bool isUpload, FlowEvent& out) {
+    const uint16_t ETH_HDR = 14;
+    if (len < ETH_HDR + 20) return false;
+
+    // Unicast only: the station side must be a real device
+    const uint8_t* dstMac = frame;
+    const uint8_t* srcMac = frame + 6;
+    const uint8_t* stationMac = isUpload ? srcMac : dstMac;
+    if (dstMac[0] & 0x01) return false;
+
+    if (readBE16(frame + 12) != 0x0800) return false;  // IPv4 only
+
+    const uint8_t* ip = frame + ETH_HDR;
+    if ((ip[0] >> 4) != 4) return false;
+    uint16_t ihl = (ip[0] & 0x0F) * 4;
+    if (ihl < 20 || ETH_HDR + ihl > len) return false;
+
+    uint16_t totalLen = readBE16(ip + 2);
+    uint16_t fragOffset = readBE16(ip + 6) & 0x1FFF;
+    uint8_t proto = ip[9];
+
+    uint32_t srcIP, dstIP;
+    memcpy(&srcIP, ip + 12, 4);
+    memcpy(&dstIP, ip + 16, 4);
+
+    // Ports only for TCP/UDP first fragments
+    uint16_t srcPort = 0, dstPort = 0;
+    if ((proto == 6 || proto == 17) && fragOffset == 0 && ETH_HDR + ihl + 4 <= len) {
+        srcPort = readBE16(ip + ihl);
+        dstPort = readBE16(ip + ihl + 2);
+    }
+
+    memcpy(out.mac, stationMac, 6);
+    out.proto = proto;
+    out.isUpload = isUpload;
+    out.length = totalLen;
+    if (isUpload) {
+        out.localIP = srcIP;   out.localPort = srcPort;
+        out.remoteIP = dstIP;  out.remotePort = dstPort;
+    } else {
+        out.localIP = dstIP;   out.localPort = dstPort;
+        out.remoteIP = srcIP;  out.remotePort = srcPort;
+    }
+    return true;
+}
+
+// --- FlowTable ---
+
+FlowTable::FlowTable() :
+    _entries(nullptr),
+    _buckets(nullptr),
+    _capacity(0),
+    _bucketMask(0),
+    _free(NIL),
+    _lruHead(NIL),
+    _lruTail(NIL),
+    _count(0),
+    _evictions(0) {}
+
+FlowTable::~FlowTable() {
+    delete[] _entries;
+    delete[] _buckets;
+}
+
+bool FlowTable::begin(uint16_t capacity) {
+    if (_entries || capacity < 2 || capacity > 16384) {
+        return false;
+    }
+
+    uint32_t buckets = 1;
+    while (buckets < (uint32_t)capacity * 2) {
+        buckets <<= 1;
+    }
+
+    _entries = new (std::nothrow) FlowEntry[capacity];
+    _buckets = new (std::nothrow) uint16_t[buckets];
+    if (!_entries || !_buckets) {
+        delete[] _entries;
+        delete[] _buckets;
+        _entries = nullptr;
+        _buckets = nullptr;
+        return false;
+    }
+
+    _capacity = capacity;
+    _bucketMask = (uint16_t)(buckets - 1);
+    clear();
+    return true;
+}
+
+void FlowTable::clear() {
+    if (!_entries) return;
+
+    for (uint32_t i = 0; i <= _bucketMask; i++) {
+        _buckets[i] = NIL;
+    }
+    for (uint16_t i = 0; i < _capacity; i++) {
+        _entries[i].hashNext = (i + 1 < _capacity) ? i + 1 : NIL;
+        _entries[i].lruPrev = NIL;
+        _entries[i].lruNext = NIL;
+    }
+    _free = 0;
+    _lruHead = NIL;
+    _lruTail = NIL;
+    _count = 0;
+}
+
+size_t FlowTable::hashKey(uint32_t localIP, uint32_t remoteIP, uint16_t localPort,
+                          uint16_t remotePort, uint8_t proto) const {
+    // FNV-1a style mix over the tuple words
+    uint32_t h = 2166136261u;
+    h = (h ^ localIP) * 16777619u;
+    h = (h ^ remoteIP) * 16777619u;
+    h = (h ^ (((uint32_t)localPort << 16) | remotePort)) * 16777619u;
+    h = (h ^ proto) * 16777619u;
+    return (h ^ (h >> 16)) & _bucketMask;
+}
+
+bool FlowTable::matches(const FlowEntry& e, const FlowEvent& evt) {
+    return e.localIP == evt.localIP &&
+           e.remoteIP == evt.remoteIP &&
+           e.localPort == evt.localPort &&
+           e.remotePort == evt.remotePort &&
+           e.proto == evt.proto;
+}
+
+void FlowTable::record(const FlowEvent& evt, uint32_t nowMs) {
+    if (!_entries) return;
+
+    size_t bucket = hashKey(evt.localIP, evt.remoteIP, evt.localPort, evt.remotePort, evt.proto);
+
+    uint16_t idx = _buckets[bucket];
+    while (idx != NIL && !matches(_entries[idx], evt)) {
+        idx = _entries[idx].hashNext;
+    }
+
+    if (idx == NIL) {
+        idx = allocate();
+        FlowEntry& e = _entries[idx];
+        memcpy(e.mac, evt.mac, 6);
+        e.proto = evt.proto;
+        e.localIP = evt.localIP;
+        e.remoteIP = evt.remoteIP;
+        e.localPort = evt.localPort;
+        e.remotePort = evt.remotePort;
+        e.uploadBytes = 0;
+        e.downloadBytes = 0;
+        e.uploadPackets = 0;
+        e.downloadPackets = 0;
+        e.firstSeen = nowMs;
+        e.hashNext = _buckets[bucket];
+        _buckets[bucket] = idx;
+        lruPushFront(idx);
+    } else if (idx != _lruHead) {
+        lruUnlink(idx);
+        lruPushFront(idx);
+    }
+
+    FlowEntry& e = _entries[idx];
+    if (evt.isUpload) {
+        e.uploadBytes += evt.length;
+        e.uploadPackets++;
+    } else {
+        e.downloadBytes += evt.length;
+        e.downloadPackets++;
+    }
+    e.lastSeen = nowMs;
+}
+
+size_t FlowTable::expireIdle(uint32_t nowMs, uint32_t timeoutMs) {
+    // LRU tail is always the oldest, so stop at the first live flow
+    size_t removed = 0;
+    while (_lruTail != NIL && nowMs - _entries[_lruTail].lastSeen > timeoutMs) {
+        remove(_lruTail);
+        removed++;
+    }
+    return removed;
+}
+
+uint16_t FlowTable::allocate() {
+    if (_free == NIL) {
+        remove(_lruTail);
+        _evictions++;
+    }
+    uint16_t idx = _free;
+    _free = _entries[idx].hashNext;
+    _count++;
+    return idx;
+}
+
+void FlowTable::remove(uint16_t idx) {
+    FlowEntry& e = _entries[idx];
+    size_t bucket = hashKey(e.localIP, e.remoteIP, e.localPort, e.remotePort, e.proto);
+
+    // Unlink from hash chain
+    uint16_t* link = &_buckets[bucket];
+    while (*link != idx) {
+        link = &_entries[*link].hashNext;
+    }
+    *link = e.hashNext;
+
+    lruUnlink(idx);
+
+    e.hashNext = _free;
+    _free = idx;
+    _count--;
+}
+
+void FlowTable::lruUnlink(uint16_t idx) {
+    FlowEntry& e = _entries[idx];
+    if (e.lruPrev != NIL) _entries[e.lruPrev].lruNext = e.lruNext;
+    else _lruHead = e.lruNext;
+    if (e.lruNext != NIL) _entries[e.lruNext].lruPrev = e.lruPrev;
+    else _lruTail = e.lruPrev;
+    e.lruPrev = NIL;
+    e.lruNext = NIL;
+}
+
+void FlowTable::lruPushFront(uint16_t idx) {
+    FlowEntry& e = _entries[idx];
+    e.lruPrev = NIL;
+    e.lruNext = _lruHead;
+    if (_lruHead != NIL) _entries[_lruHead].lruPrev = idx;
+    _lruHead = idx;
+    if (_lruTail == NIL) _lruTail = idx;
+}
+
+size_t FlowTable::topFlows(const uint8_t* mac, const FlowEntry** out, size_t maxOut) const {
+    // Insertion into a small sorted output array (maxOut is a handful)
+    if (maxOut == 0) return 0;
+
+    size_t n = 0;
+    for (uint16_t idx = _lruHead; idx != NIL; idx = _entries[idx].lruNext) {
+        const FlowEntry* e = &_entries[idx];
+        if (mac && memcmp(e->mac, mac, 6) != 0) continue;
+
+        size_t pos;
+        if (n < maxOut) {
+            pos = n++;
+        } else if (out[n - 1]->totalBytes() < e->totalBytes()) {
+            pos = n - 1;  // Replace the current smallest
+        } else {
+            continue;
+        }
+        while (pos > 0 && out[pos - 1]->totalBytes() < e->totalBytes()) {
+            out[pos] = out[pos - 1];
+            pos--;
+        }
+        out[pos] = e;
+    }
+    return n;
+}
+
+size_t FlowTable::topRemotes(const uint8_t* mac, FlowTalker* out, size_t maxOut) const {
+    // Aggregate per remote IP into the output array, then sort it. With more
+    // than maxOut distinct remotes a newcomer replaces the current smallest
+    // entry, so totals are exact for the top entries but approximate below.
+    if (maxOut == 0) return 0;
+
+    size_t n = 0;
+    for (uint16_t idx = _lruHead; idx != NIL; idx = _entries[idx].lruNext) {
+        const FlowEntry& e = _entries[idx];
+        if (mac && memcmp(e.mac, mac, 6) != 0) continue;
+
+        size_t i = 0;
+        while (i < n && out[i].remoteIP != e.remoteIP) i++;
+
+        if (i == n) {
+            if (n < maxOut) {
+                n++;
+            } else {
+                size_t smallest = 0;
+                for (size_t k = 1; k < n; k++) {
+                    if (out[k].totalBytes() < out[smallest].totalBytes()) smallest = k;
+                }
+                if (out[smallest].totalBytes() >= e.totalBytes()) continue;
+                i = smallest;
+            }
+            out[i].remoteIP = e.remoteIP;
+            out[i].uploadBytes = 0;
+            out[i].downloadBytes = 0;
+            out[i].flows = 0;
+        }
+        out[i].uploadBytes += e.uploadBytes;
+        out[i].downloadBytes += e.downloadBytes;
+        out[i].flows++;
+    }
+
+    // Sort descending by total (insertion sort, n is small)
+    for (size_t i = 1; i < n; i++) {
+        FlowTalker t = out[i];
+        size_t j = i;
+        while (j > 0 && out[j - 1].totalBytes() < t.totalBytes()) {
+            out[j] = out[j - 1];
+            j--;
+        }
+        out[j] = t;
+    }
+    return n;
+}
@@ -0,0 +1,117 @@
+#ifndef FLOW_TABLE_H
+#define FLOW_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 5-tuple flow accounting.
+//
+// Flows are keyed from the local device's point of view (local IP/port,
+// remote IP/port, protocol), so both directions of a connection land in the
+// same entry: upload = local -> remote, download = remote -> local.
+//
+// The table is a fixed array with index-linked hash chains and an LRU list.
+// When full, the least recently used flow is evicted; expireIdle() drops
+// flows that have been quiet longer than the idle timeout. Storage is
+// allocated once in begin(); record() and expireIdle() never allocate.
+// Nothing here depends on the platform, so test/flow_table_pcap.cpp drives
+// it on a PC with Ethernet frames read from a pcap file via parseFlowFrame().
+
+// Captured at the AP netif; one per forwarded IPv4 packet
+struct FlowEvent {
+    uint8_t mac[6];        // Station MAC
+    uint32_t localIP;      // Network byte order
+    uint32_t remoteIP;     // Network byte order
+    uint16_t localPort;    // Host byte order, 0 for non TCP/UDP
+    uint16_t remotePort;
+    uint8_t proto;         // IP protocol number
+    bool isUpload;
+    uint16_t length;       // IP total length
+};
+
+struct FlowEntry {
+    uint8_t mac[6];
+    uint8_t proto;
+    uint32_t localIP;
+    uint32_t remoteIP;
+    uint16_t localPort;
+    uint16_t remotePort;
+    uint64_t uploadBytes;
+    uint64_t downloadBytes;
+    uint32_t uploadPackets;
+    uint32_t downloadPackets;
+    uint32_t firstSeen;
+    uint32_t lastSeen;
+
+    // Table links (indices, NIL when unused)
+    uint16_t hashNext;
+    uint16_t lruPrev;
+    uint16_t lruNext;
+
+    uint64_t totalBytes() const { return uploadBytes + downloadBytes; }
+};
+
+// Aggregated traffic to one remote endpoint
+struct FlowTalker {
+    uint32_t remoteIP;
+    uint64_t uploadBytes;
+    uint64_t downloadBytes;
+    uint16_t flows;
+
+    uint64_t totalBytes() const { return uploadBytes + downloadBytes; }
+};
+
+// Parse an Ethernet II frame carrying IPv4. isUpload selects which side is
+// local: the source for frames received from a station, the destination for
+// frames sent to one. Returns false for anything that is not unicast IPv4.
+bool parseFlowFrame(const uint8_t* frame, uint16_t len, bool isUpload, FlowEvent& out);
+
+class FlowTable {
+public:
+    static const uint16_t NIL = 0xFFFF;
+
+    FlowTable();
+    ~FlowTable();
+
+    // Allocate storage for up to capacity flows (once, at startup)
+    bool begin(uint16_t capacity);
+    void clear();
+
+    // Account one packet; creates or refreshes the flow (evicting the LRU one if full)
+    void record(const FlowEvent& evt, uint32_t nowMs);
+
+    // Drop flows idle for longer than timeoutMs. Returns number removed.
+    size_t expireIdle(uint32_t nowMs, uint32_t timeoutMs);
+
+    size_t size() const { return _count; }
+    size_t capacity() const { return _capacity; }
+    uint32_t evictions() const { return _evictions; }
+
+    // Top flows by total bytes, optionally limited to one device (mac may be null)
+    size_t topFlows(const uint8_t* mac, const FlowEntry** out, size_t maxOut) const;
+
+    // Top remote endpoints by total bytes, optionally limited to one device
+    size_t topRemotes(const uint8_t* mac, FlowTalker* out, size_t maxOut) const;
+
+private:
+    FlowEntry* _entries;
+    uint16_t* _buckets;
+    uint16_t _capacity;
+    uint16_t _bucketMask;  // Bucket count is a power of two >= 2 * capacity
+    uint16_t _free;        // Free list threaded through hashNext
+    uint16_t _lruHead;     // Most recently used
+    uint16_t _lruTail;     // Least recently used
+    uint16_t _count;
+    uint32_t _evictions;
+
+    size_t hashKey(uint32_t localIP, uint32_t remoteIP, uint16_t localPort,
+                   uint16_t remotePort, uint8_t proto) const;
+    static bool matches(const FlowEntry& e, const FlowEvent& evt);
+
+    uint16_t allocate();
+    void remove(uint16_t idx);
+    void lruUnlink(uint16_t idx);
+    void lruPushFront(uint16_t idx);
+};
+
+#endif // FLOW_TABLE_H
@@ -0,0 +1,101 @@
+#ifndef JSON_STREAM_H
+#define JSON_STREAM_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+
+// Largest serialized array element (one device row is ~350 bytes)
+static const size_t JSON_STREAM_ELEMENT_MAX = 512;
+
+// A JSON array written into a chunked HTTP response one element at a time.
+//
+// The subclass owns a snapshot (copied under dataMutex) and turns element i
+// into a small document on demand. fill() is the response's filler: it
+// copies "[", the elements separated by commas, and "]" into each chunk the
+// web server asks for. At most one serialized element is held at a time, so
+// the body is never built in full and the mutex is not held while sending.
+//
+// An element larger than JSON_STREAM_ELEMENT_MAX is never cut: the stream
+// stops before it and failed() is set, leaving the array unterminated so a
+// reader rejects the body instead of trusting a wrong one.
+class JsonArrayStream {
+public:
+    JsonArrayStream() : _next(0), _pendingLen(0), _pendingPos(0), _state(OPEN) {}
+    virtual ~JsonArrayStream() {}
+
+    // AwsResponseFiller: bytes written to buf, 0 when the array is complete
+    // (or the stream failed)
+    size_t fill(uint8_t* buf, size_t maxLen) {
+        size_t written = 0;
+        while (written < maxLen) {
+            if (_pendingPos < _pendingLen) {
+                size_t n = _pendingLen - _pendingPos;
+                if (n > maxLen - written) n = maxLen - written;
+                memcpy(buf + written, _pending + _pendingPos, n);
+                _pendingPos += n;
+                written += n;
+                continue;
+            }
+            if (!nextPiece()) {
+                break;
+            }
+        }
+        return written;
+    }
+
+    bool failed() const { return _state == FAILED; }
+
+protected:
+    virtual size_t count() const = 0;
+    virtual void element(size_t i, JsonDocument& doc) const = 0;
+
+private:
+    enum State : uint8_t { OPEN, ELEMENTS, DONE, FAILED };
+
+    size_t _next;
+    size_t _pendingLen;
+    size_t _pendingPos;
+    State _state;
+    char _pending[JSON_STREAM_ELEMENT_MAX + 2];  // "," + element + NUL
+
+    bool nextPiece() {
+        _pendingPos = 0;
+        if (_state == OPEN) {
+            _pending[0] = '[';
+            _pendingLen = 1;
+            _state = ELEMENTS;
+            return true;
+        }
+        if (_state == DONE || _state == FAILED) {
+            _pendingLen = 0;
+            return false;
+        }
+        if (_next >= count()) {
+            _pending[0] = ']';
+            _pendingLen = 1;
+            _state = DONE;
+            return true;
+        }
+
+        JsonDocument doc;
+        element(_next, doc);
+        size_t len = measureJson(doc);
+        if (len > JSON_STREAM_ELEMENT_MAX) {
+            DEBUG_PRINTF("JSON: Element %u is %u bytes (max %u), response cut\n",
+                         (unsigned)_next, (unsigned)len, (unsigned)JSON_STREAM_ELEMENT_MAX);
+            _pendingLen = 0;
+            _state = FAILED;
+            return false;
+        }
+        size_t pos = 0;
+        if (_next > 0) {
+            _pending[pos++] = ',';
+        }
+        _pendingLen = pos + serializeJson(doc, _pending + pos, JSON_STREAM_ELEMENT_MAX + 1);
+        _next++;
+        return true;
+    }
+};
+
+#endif // JSON_STREAM_H
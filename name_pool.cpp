@@ -0,0 +1,96 @@
+#include "name_pool.h"
+#include <string.h>
+
+NamePool namePool;
+
+NamePool::NamePool() :
+    _end(0),
+    _live(0),
+    _strings(0),
+    _failures(0) {
+    memset(_entries, 0, sizeof(_entries));
+    _arena[0] = '\0';
+}
+
+NameHandle NamePool::intern(const char* s) {
+    size_t len = strnlen(s, MAX_DEVICE_NAME - 1);
+    if (len == 0) {
+        return 0;
+    }
+
+    // Existing string? (Renames are rare; a scan of the table is enough.)
+    // Checked before anything moves, so s may point into the arena.
+    int freeSlot = -1;
+    for (uint16_t i = 0; i < NAME_POOL_ENTRIES; i++) {
+        Entry& e = _entries[i];
+        if (e.refs == 0) {
+            if (freeSlot < 0) freeSlot = i;
+            continue;
+        }
+        if (e.len == len && memcmp(_arena + e.offset, s, len) == 0) {
+            e.refs++;
+            return (NameHandle)(i + 1);
+        }
+    }
+
+    uint16_t need = (uint16_t)(len + 1);
+    if (freeSlot < 0 || _live + need > NAME_POOL_BYTES) {
+        _failures++;
+        return 0;
+    }
+    if (_end + need > NAME_POOL_BYTES) {
+        compact();
+    }
+
+    Entry& e = _entries[freeSlot];
+    e.offset = _end;
+    e.len = (uint8_t)len;
+    e.refs = 1;
+    memcpy(_arena + _end, s, len);
+    _arena[_end + len] = '\0';
+    _end += need;
+    _live += need;
+    _strings++;
+    return (NameHandle)(freeSlot + 1);
+}
+
+void NamePool::release(NameHandle h) {
+    if (h == 0) {
+        return;
+    }
+    Entry& e = _entries[h - 1];
+    if (e.refs == 0 || --e.refs > 0) {
+        return;
+    }
+    _live -= e.len + 1;
+    _strings--;
+    if (_live == 0) {
+        _end = 0;  // Nothing left to move
+    }
+}
+
+void NamePool::compact() {
+    // Live entries by offset, then slide each string down over the holes
+    NameHandle order[NAME_POOL_ENTRIES];
+    uint16_t n = 0;
+    for (uint16_t i = 0; i < NAME_POOL_ENTRIES; i++) {
+        if (_entries[i].refs == 0) continue;
+        uint16_t j = n++;
+        while (j > 0 && _entries[order[j - 1]].offset > _entries[i].offset) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = (NameHandle)i;
+    }
+
+    uint16_t pos = 0;
+    for (uint16_t k = 0; k < n; k++) {
+        Entry& e = _entries[order[k]];
+        if (e.offset != pos) {
+            memmove(_arena + pos, _arena + e.offset, e.len + 1);
+            e.offset = pos;
+        }
+        pos += e.len + 1;
+    }
+    _end = pos;
+}
@@ -0,0 +1,64 @@
+#ifndef NAME_POOL_H
+#define NAME_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "config.h"
+
+// Handle of an interned string, 0 = none (empty name)
+typedef uint16_t NameHandle;
+
+// Device names, each stored once.
+//
+// Many devices share a name (vendor names, "Private Device"), so the
+// registry keeps two-byte handles instead of a fixed buffer per device.
+// Strings live NUL-terminated in one arena of NAME_POOL_BYTES; a handle
+// indexes a small entry table with the offset, length and a reference count.
+// intern() of a string that is already there only bumps its count. Freed
+// strings leave holes that are squeezed out when the arena runs out of room;
+// handles stay the same, only the offsets move.
+//
+// Not thread safe (dataMutex, like the registry). The pointer from str() is
+// valid until the next intern(), which may compact the arena.
+class NamePool {
+public:
+    NamePool();
+
+    // Add a reference to s (cut to MAX_DEVICE_NAME - 1 chars). Returns 0 for
+    // an empty string or when the pool is full.
+    NameHandle intern(const char* s);
+    void release(NameHandle h);
+
+    const char* str(NameHandle h) const {
+        return h ? _arena + _entries[h - 1].offset : "";
+    }
+
+    // Usage, for /api/status
+    uint16_t strings() const { return _strings; }
+    uint16_t bytes() const { return _live; }
+    uint32_t getFailures() const { return _failures; }
+    static constexpr uint16_t capacity() { return NAME_POOL_BYTES; }
+
+private:
+    static_assert(NAME_POOL_ENTRIES <= 0xFFFF, "NameHandle is 16 bits");
+    static_assert(NAME_POOL_BYTES <= 0xFFFF, "Arena offsets are 16 bits");
+
+    struct Entry {
+        uint16_t offset;
+        uint8_t len;    // Without the NUL
+        uint16_t refs;  // 0 = free
+    };
+
+    Entry _entries[NAME_POOL_ENTRIES];
+    char _arena[NAME_POOL_BYTES];
+    uint16_t _end;      // Arena bytes in use, holes included
+    uint16_t _live;     // Bytes of referenced strings
+    uint16_t _strings;
+    uint32_t _failures;
+
+    void compact();
+};
+
+extern NamePool namePool;
+
+#endif // NAME_POOL_H
@@ -1,58 +1,159 @@
 #include "nat_engine.h"
 #include <WiFi.h>
 #include "esp_wifi.h"
+#include "esp_netif.h"
 #include "esp_idf_version.h"
+#include "wifi_frame.h"
+#include "storage_manager.h"
+#include "traffic_shaper.h"
 
 // lwIP includes for NAPT
 extern "C" {
 #include "lwip/lwip_napt.h"
 #include "lwip/tcpip.h"  // For LOCK_TCPIP_CORE
+#include "lwip/netif.h"
+#include "lwip/pbuf.h"
 }
 
 NATEngine natEngine;
 PacketCallback NATEngine::packetCallback = nullptr;
+FlowCallback NATEngine::flowCallback = nullptr;
+DhcpCallback NATEngine::dhcpCallback = nullptr;
+
+static const uint16_t ETH_HEADER_LEN = 14;
+
+// Active accounting backend, read by both capture paths
+static volatile AccountingBackend _backend = (AccountingBackend)DEFAULT_ACCOUNTING_BACKEND;
+
+// Capture cost per backend (each counter has a single writer task)
+static volatile uint32_t _promiscFrames = 0;
+static volatile uint64_t _promiscCycles = 0;
+static volatile uint32_t _netifInFrames = 0;
+static volatile uint64_t _netifInCycles = 0;
+static volatile uint32_t _netifOutFrames = 0;
+static volatile uint64_t _netifOutCycles = 0;
+
+// Original AP netif handlers, wrapped by the hooks below
+static netif_input_fn _apInput = nullptr;
+static netif_linkoutput_fn _apLinkOutput = nullptr;
+
+// IPv4 between a station and the ESP itself (dashboard, DNS, DHCP), not
+// forwarded: neither billed to the station nor shaped, so a throttled or
+// over-quota device keeps DNS and the dashboard. For input the destination
+// is checked (the AP address, broadcast or multicast), for output the source.
+static bool isLocalFrame(const uint8_t* frame, uint16_t len, const struct netif* nif, bool input) {
+    if (len < ETH_HEADER_LEN + 20 || frame[12] != 0x08 || frame[13] != 0x00) {
+        return false;
+    }
+    const uint8_t* ip = frame + ETH_HEADER_LEN + (input ? 16 : 12);
+    uint32_t addr;
+    memcpy(&addr, ip, 4);
+    if (addr == netif_ip4_addr(nif)->addr) {
+        return true;
+    }
+    return input && (addr == 0xFFFFFFFF || (ip[0] & 0xF0) == 0xE0);
+}
+
+// Frames received from a station (WiFi task) - headers are in the first pbuf
+static err_t apInputHook(struct pbuf* p, struct netif* inp) {
+    uint32_t start = ESP.getCycleCount();
+    const uint8_t* frame = (const uint8_t*)p->payload;
+    bool local = isLocalFrame(frame, p->len, inp, true);
+
+    // Police per-device upload limits before the frame is counted or routed
+    if (!local && p->len >= ETH_HEADER_LEN && !trafficShaper.allow(frame + 6, p->tot_len, true)) {
+        pbuf_free(p);
+        return ERR_OK;
+    }
+
+    if (NATEngine::flowCallback) {
+        FlowEvent evt;
+        if (parseFlowFrame(frame, p->len, true, evt)) {
+            NATEngine::flowCallback(evt);
+        }
+    }
+
+    // Client requests to the AP's DHCP server (hostname and fingerprint)
+    if (NATEngine::dhcpCallback) {
+        DhcpEvent evt;
+        if (parseDhcpFrame(frame, p->len, evt)) {
+            NATEngine::dhcpCallback(evt);
+        }
+    }
+
+    if (_backend == ACCOUNTING_NETIF && NATEngine::packetCallback && !local &&
+        p->len >= ETH_HEADER_LEN && p->tot_len > ETH_HEADER_LEN) {
+        NATEngine::packetCallback(frame + 6, frame, p->tot_len - ETH_HEADER_LEN, true);
+        _netifInFrames++;
+        _netifInCycles += ESP.getCycleCount() - start;
+    }
+
+    return _apInput(p, inp);
+}
+
+// Frames sent to a station (lwIP task, after NAPT has restored the local address)
+static err_t apLinkOutputHook(struct netif* nif, struct pbuf* p) {
+    uint32_t start = ESP.getCycleCount();
+    const uint8_t* frame = (const uint8_t*)p->payload;
+    bool local = isLocalFrame(frame, p->len, nif, false);
+
+    // Download limit: the caller owns the pbuf, so dropping is just not sending it
+    if (!local && p->len >= ETH_HEADER_LEN && !trafficShaper.allow(frame, p->tot_len, false)) {
+        return ERR_OK;
+    }
+
+    if (NATEngine::flowCallback) {
+        FlowEvent evt;
+        if (parseFlowFrame(frame, p->len, false, evt)) {
+            NATEngine::flowCallback(evt);
+        }
+    }
+
+    if (_backend == ACCOUNTING_NETIF && NATEngine::packetCallback && !local &&
+        p->len >= ETH_HEADER_LEN && p->tot_len > ETH_HEADER_LEN) {
+        NATEngine::packetCallback(frame + 6, frame, p->tot_len - ETH_HEADER_LEN, false);
+        _netifOutFrames++;
+        _netifOutCycles += ESP.getCycleCount() - start;
+    }
+
+    return _apLinkOutput(nif, p);
+}
+
+// Promiscuous capture state (only touched from the WiFi task callback)
+static uint8_t _bssid[6];
+static WifiSeqDedup<AP_MAX_CONNECTIONS * 2> _seqDedup;
+static volatile uint32_t _retriesDropped = 0;
+static volatile uint32_t _foreignDropped = 0;
 
 // Promiscuous mode callback for packet sniffing - kept minimal for throughput
 static void IRAM_ATTR promiscuousCallback(void* buf, wifi_promiscuous_pkt_type_t type) {
-    if (type != WIFI_PKT_DATA || !NATEngine::packetCallback) {
+    if (type != WIFI_PKT_DATA || !NATEngine::packetCallback || _backend != ACCOUNTING_PROMISCUOUS) {
         return;
     }
+    uint32_t start = ESP.getCycleCount();
 
     wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)buf;
-    uint16_t sig_len = pkt->rx_ctrl.sig_len;
-
-    if (sig_len < 24) return;  // Minimum 802.11 header
-
-    const uint8_t* frame = pkt->payload;
-    uint16_t frameCtrl = frame[0] | (frame[1] << 8);
-
-    // Data frames only (Type = 2)
-    if (((frameCtrl >> 2) & 0x03) != 2) return;
-
-    // Extract To DS and From DS bits
-    bool toDS = (frameCtrl >> 8) & 0x01;
-    bool fromDS = (frameCtrl >> 9) & 0x01;
-
-    const uint8_t* srcMac;
-    const uint8_t* dstMac;
-    bool isUpload;
-
-    if (toDS && !fromDS) {
-        // Client -> AP (upload)
-        dstMac = &frame[4];
-        srcMac = &frame[10];
-        isUpload = true;
-    } else if (!toDS && fromDS) {
-        // AP -> Client (download)
-        dstMac = &frame[4];
-        srcMac = &frame[10];
-        isUpload = false;
-    } else {
+    if (pkt->rx_ctrl.rx_state != 0) return;  // Corrupted frame
+
+    WifiFrameInfo info;
+    WifiFrameResult res = wifiParseDataFrame(pkt->payload, pkt->rx_ctrl.sig_len, _bssid, info);
+    if (res != WIFI_FRAME_OK) {
+        if (res == WIFI_FRAME_FOREIGN_BSS || res == WIFI_FRAME_NOT_INFRA) {
+            _foreignDropped++;
+        }
+        return;
+    }
+
+    if (_seqDedup.isDuplicate(info.station, info.isUpload, info.seqCtrl, info.retry)) {
+        _retriesDropped++;
         return;
     }
 
-    uint16_t payloadLen = sig_len > 36 ? sig_len - 36 : 0;
-    NATEngine::packetCallback(srcMac, dstMac, payloadLen, isUpload);
+    if (info.msduLen == 0) return;
+
+    NATEngine::packetCallback(info.transmitter, info.receiver, info.msduLen, info.isUpload);
+    _promiscFrames++;
+    _promiscCycles += ESP.getCycleCount() - start;
 }
 
 NATEngine::NATEngine() : enabled(false) {}
@@ -70,23 +171,122 @@ bool NATEngine::begin() {
 
     DEBUG_PRINTF("NAT: NAPT enabled on %s\n", apIP.toString().c_str());
 
-    // Enable promiscuous mode for packet counting
-    // This works independently of NAPT
-    esp_err_t err = esp_wifi_set_promiscuous(true);
-    if (err != ESP_OK) {
-        DEBUG_PRINTF("NAT: Failed to enable promiscuous mode: %d\n", err);
-        return false;
+    // Hook the AP netif for IP-level flow accounting
+    if (!installNetifHooks()) {
+        DEBUG_PRINTLN("NAT: Failed to hook AP netif, flow accounting disabled");
     }
 
+    // Only count frames that go through our own BSS
+    WiFi.softAPmacAddress(_bssid);
+
+    // Promiscuous callback and filter are registered once; the backend
+    // switch only turns promiscuous mode on or off
     wifi_promiscuous_filter_t filter = {
         .filter_mask = WIFI_PROMIS_FILTER_MASK_DATA
     };
     esp_wifi_set_promiscuous_filter(&filter);
     esp_wifi_set_promiscuous_rx_cb(promiscuousCallback);
 
-    DEBUG_PRINTLN("NAT: Promiscuous mode enabled for bandwidth tracking");
-
     enabled = true;
+
+    // Restore the saved backend; fall back to sniffing if the hooks are missing
+    AccountingBackend backend = (AccountingBackend)storage.loadAccountingBackend(DEFAULT_ACCOUNTING_BACKEND);
+    if (backend != ACCOUNTING_NETIF || !_apInput) {
+        backend = ACCOUNTING_PROMISCUOUS;
+    }
+    _backend = backend;
+    if (backend == ACCOUNTING_PROMISCUOUS && !setPromiscuous(true)) {
+        return false;
+    }
+
+    DEBUG_PRINTF("NAT: Bandwidth accounting via %s\n", backendName(backend));
+    return true;
+}
+
+bool NATEngine::setAccountingBackend(AccountingBackend backend) {
+    if (backend != ACCOUNTING_PROMISCUOUS && backend != ACCOUNTING_NETIF) {
+        return false;
+    }
+    if (backend == _backend) {
+        return true;
+    }
+
+    // Stop the old producer before starting the new one, so the download
+    // ring never has two producer tasks at once
+    if (backend == ACCOUNTING_NETIF) {
+        if (!_apInput) {
+            DEBUG_PRINTLN("NAT: AP netif not hooked, cannot use netif accounting");
+            return false;
+        }
+        setPromiscuous(false);
+        _backend = ACCOUNTING_NETIF;
+    } else {
+        // apLinkOutputHook runs with the TCPIP core locked, so once the lock
+        // is ours no netif download push is in flight and later ones see the
+        // new backend
+        LOCK_TCPIP_CORE();
+        _backend = ACCOUNTING_PROMISCUOUS;
+        UNLOCK_TCPIP_CORE();
+        if (!setPromiscuous(true)) {
+            _backend = ACCOUNTING_NETIF;
+            return false;
+        }
+    }
+
+    storage.saveAccountingBackend(backend);
+    DEBUG_PRINTF("NAT: Bandwidth accounting via %s\n", backendName(backend));
+    return true;
+}
+
+bool NATEngine::setPromiscuous(bool on) {
+    esp_err_t err = esp_wifi_set_promiscuous(on);
+    if (err != ESP_OK) {
+        DEBUG_PRINTF("NAT: Failed to %s promiscuous mode: %d\n", on ? "enable" : "disable", err);
+        return false;
+    }
+    return true;
+}
+
+AccountingBackend NATEngine::getAccountingBackend() {
+    return _backend;
+}
+
+const char* NATEngine::backendName(AccountingBackend backend) {
+    return backend == ACCOUNTING_NETIF ? "netif" : "promiscuous";
+}
+
+CaptureMetrics NATEngine::getCaptureMetrics(AccountingBackend backend) {
+    CaptureMetrics m;
+    if (backend == ACCOUNTING_NETIF) {
+        m.frames = _netifInFrames + _netifOutFrames;
+        m.cycles = _netifInCycles + _netifOutCycles;
+    } else {
+        m.frames = _promiscFrames;
+        m.cycles = _promiscCycles;
+    }
+    return m;
+}
+
+bool NATEngine::installNetifHooks() {
+    esp_netif_t* apNetif = esp_netif_get_handle_from_ifkey("WIFI_AP_DEF");
+    if (!apNetif) {
+        return false;
+    }
+    struct netif* nif = (struct netif*)esp_netif_get_netif_impl(apNetif);
+    if (!nif) {
+        return false;
+    }
+
+    LOCK_TCPIP_CORE();
+    if (nif->input != apInputHook) {
+        _apInput = nif->input;
+        _apLinkOutput = nif->linkoutput;
+        nif->input = apInputHook;
+        nif->linkoutput = apLinkOutputHook;
+    }
+    UNLOCK_TCPIP_CORE();
+
+    DEBUG_PRINTLN("NAT: AP netif hooked for flow accounting");
     return true;
 }
 
@@ -94,6 +294,22 @@ void NATEngine::setPacketCallback(PacketCallback callback) {
     packetCallback = callback;
 }
 
+void NATEngine::setFlowCallback(FlowCallback callback) {
+    flowCallback = callback;
+}
+
+void NATEngine::setDhcpCallback(DhcpCallback callback) {
+    dhcpCallback = callback;
+}
+
+uint32_t NATEngine::getRetriesDropped() {
+    return _retriesDropped;
+}
+
+uint32_t NATEngine::getForeignFramesDropped() {
+    return _foreignDropped;
+}
+
 bool NATEngine::isEnabled() {
     return enabled;
 }
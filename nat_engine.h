@@ -3,10 +3,31 @@
 
 #include <Arduino.h>
 #include "config.h"
+#include "flow_table.h"
+#include "dhcp_fingerprint.h"
 
 // Callback for packet interception (for bandwidth tracking)
 typedef void (*PacketCallback)(const uint8_t* srcMac, const uint8_t* dstMac, uint16_t length, bool isUpload);
 
+// Callback for IPv4 packets forwarded through the AP netif (for flow accounting).
+// Upload events run on the WiFi task, download events on the lwIP/TCPIP task.
+typedef void (*FlowCallback)(const FlowEvent& evt);
+
+// Callback for DHCP requests from stations to the AP's DHCP server (WiFi task)
+typedef void (*DhcpCallback)(const DhcpEvent& evt);
+
+// Where per-device byte counts come from
+enum AccountingBackend : uint8_t {
+    ACCOUNTING_PROMISCUOUS = 0,  // Sniff 802.11 data frames on the channel
+    ACCOUNTING_NETIF = 1         // Count frames the AP netif actually forwards
+};
+
+// Per-backend capture cost, for comparing the two
+struct CaptureMetrics {
+    uint32_t frames;   // Frames handed to the packet callback
+    uint64_t cycles;   // CPU cycles spent in the capture path
+};
+
 class NATEngine {
 public:
     NATEngine();
@@ -17,14 +38,35 @@ public:
     // Register callback for packet counting
     void setPacketCallback(PacketCallback callback);
 
+    // Register callback for per-flow accounting
+    void setFlowCallback(FlowCallback callback);
+
+    // Register callback for passive DHCP fingerprinting
+    void setDhcpCallback(DhcpCallback callback);
+
+    // Accounting backend (runtime selectable)
+    bool setAccountingBackend(AccountingBackend backend);
+    AccountingBackend getAccountingBackend();
+    static const char* backendName(AccountingBackend backend);
+    CaptureMetrics getCaptureMetrics(AccountingBackend backend);
+
     // Status
     bool isEnabled();
 
+    // Promiscuous capture counters
+    uint32_t getRetriesDropped();
+    uint32_t getForeignFramesDropped();
+
     // Public for callback access
     static PacketCallback packetCallback;
+    static FlowCallback flowCallback;
+    static DhcpCallback dhcpCallback;
 
 private:
     bool enabled;
+
+    bool installNetifHooks();
+    bool setPromiscuous(bool on);
 };
 
 extern NATEngine natEngine;
@@ -1,7 +1,6 @@
 #include "network_scanner.h"
 #include "device_manager.h"
 #include "config.h"
-#include <ESPmDNS.h>
 #include "esp_wifi.h"
 #include "esp_netif.h"
 #include "esp_wifi_ap_get_sta_list.h"
@@ -15,142 +14,291 @@ extern "C" {
 NetworkScanner networkScanner;
 
 // Timing constants
-static const unsigned long ARP_SCAN_INTERVAL = 30000;   // Full scan every 30s
-static const unsigned long ARP_BATCH_DELAY   = 200;     // 200ms between batches
-static const unsigned long ARP_WAIT_DELAY    = 500;     // Wait for ARP replies
-static const unsigned long MDNS_INTERVAL     = 45000;   // mDNS browse every 45s
-static const int           ARP_BATCH_SIZE    = 16;
-
-// mDNS service types to browse (one per cycle)
-static const char* MDNS_SERVICES[] = {
-    "http", "workstation", "airplay", "googlecast",
-    "smb", "raop", "spotify-connect"
-};
-static const int MDNS_SERVICE_COUNT = sizeof(MDNS_SERVICES) / sizeof(MDNS_SERVICES[0]);
+static const unsigned long ARP_BATCH_DELAY      = 200;      // 200ms between batches
+static const unsigned long ARP_LIVE_INTERVAL_MS = 15000;    // Recheck known hosts every 15s
+static const uint32_t      ARP_SWEEP_MIN_MS     = 30000;    // Sweep period after a change
+static const uint32_t      ARP_SWEEP_MAX_MS     = 600000;   // Backed off to 10 min when quiet
+static const uint32_t      ARP_MAX_HOSTS        = 65534;    // Larger subnets: our /16 only
+
+// Replies land in lwIP's small ARP table and are read before the next batch,
+// so a batch never asks more hosts than the table can hold
+static const int ARP_BATCH_SIZE = ARP_TABLE_SIZE < 16 ? ARP_TABLE_SIZE : 16;
+
+// A host that leaves the table is reported gone only if it has not come back
+// by then; live hosts pushed out by a full table return on their next recheck
+static const uint32_t ARP_GONE_GRACE_MS = 2 * ARP_LIVE_INTERVAL_MS;
+
+// Stable STA entries from the last two reads, and hosts that left. With more
+// hosts than table rows, every registry device can be out of the table within
+// one grace period, so the gone list holds as many as the registry.
+static ArpEntry _arpSnapshot[2][ARP_TABLE_SIZE];
+static uint8_t _arpCount[2] = {0, 0};
+static uint8_t _arpCurrent = 0;
+static ArpEntry _gone[MAX_DEVICES];
+static uint16_t _goneCount = 0;
 
 void NetworkScanner::begin() {
+    _sweepPeriod = ARP_SWEEP_MIN_MS;
+    _metrics.liveIntervalMs = ARP_LIVE_INTERVAL_MS;
     DEBUG_PRINTLN("Scanner: Network scanner initialized");
 }
 
 void NetworkScanner::update() {
-    if (WiFi.status() != WL_CONNECTED) return;
+    if (WiFi.status() != WL_CONNECTED) {
+        _staIP = 0;  // Look the interface up again after reconnecting
+        return;
+    }
 
     unsigned long now = millis();
+    if (now - _lastBatch < ARP_BATCH_DELAY) return;
 
-    // ARP scan state machine
-    switch (_state) {
-        case IDLE:
-            if (now - _lastScan >= ARP_SCAN_INTERVAL) {
-                _state = SCANNING;
-                _scanIP = 1;
-                _lastBatch = 0;
-            }
-            break;
-
-        case SCANNING:
-            if (now - _lastBatch >= ARP_BATCH_DELAY) {
-                _lastBatch = now;
-                sendArpBatch();
-                if (_scanIP > 254) {
-                    _state = WAITING;
-                    _waitStart = now;
-                }
-            }
-            break;
-
-        case WAITING:
-            if (now - _waitStart >= ARP_WAIT_DELAY) {
-                readArpTable();
-                readApClients();
-                _state = IDLE;
-                _lastScan = now;
-            }
-            break;
-    }
+    if (!refreshInterface()) return;
+
+    // Replies to the previous batch are in the table by now
+    readArpTable();
+    applyEvents();
 
-    // Periodic mDNS browsing
-    if (now - _lastMdns >= MDNS_INTERVAL) {
-        _lastMdns = now;
-        mdnsBrowse();
+    if (_liveNext >= _liveCount && now - _lastLivePass >= ARP_LIVE_INTERVAL_MS) {
+        _lastLivePass = now;
+        collectLiveHosts();
+        readApClients();
     }
-}
 
-void NetworkScanner::sendArpBatch() {
-    IPAddress staIP = WiFi.localIP();
-    IPAddress subnet = WiFi.subnetMask();
+    sendBatch(now);
+    _lastBatch = now;
+}
 
-    uint32_t ip_raw   = (uint32_t)staIP;
-    uint32_t mask_raw = (uint32_t)subnet;
-    uint32_t net_raw  = ip_raw & mask_raw;
+bool NetworkScanner::refreshInterface() {
+    uint32_t ip = (uint32_t)WiFi.localIP();
+    if (ip == _staIP && _staNetif) {
+        return true;
+    }
 
-    // Only scan /24 or smaller subnets
-    uint32_t host_bits = ntohl(~mask_raw);
-    if (host_bits > 254) {
-        _scanIP = 255;
-        return;
+    esp_netif_t* handle = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+    _staNetif = handle ? (struct netif*)esp_netif_get_netif_impl(handle) : nullptr;
+    if (!_staNetif || ip == 0) {
+        return false;
     }
+    _staIP = ip;
 
-    LOCK_TCPIP_CORE();
+    uint32_t mask = ntohl((uint32_t)WiFi.subnetMask());
+    uint32_t hostBits = ~mask;
+    if (hostBits > ARP_MAX_HOSTS + 1) {
+        mask = 0xFFFF0000;  // Too big to sweep: stay within our own /16
+        hostBits = 0xFFFF;
+    }
+    _netBase = ntohl(ip) & mask;
+    _hostCount = hostBits > 1 ? hostBits - 1 : 0;  // Without network and broadcast
+
+    _sweepOffset = 1;
+    _sweepStart = millis();
+    _sweepPeriod = ARP_SWEEP_MIN_MS;
+    _sweepCredit = 0;
+    _sweepChanges = 0;
+    _liveCount = _liveNext = 0;
+    _lastLivePass = 0;
+    _metrics.hosts = _hostCount;
+    _metrics.sweepPeriodMs = effectiveSweepPeriod();
+
+    DEBUG_PRINTF("Scanner: Sweeping %u addresses from %s\n", _hostCount,
+                 IPAddress(htonl(_netBase)).toString().c_str());
+    return true;
+}
 
-    // Find STA network interface
-    struct netif *sta_nif = NULL;
-    for (struct netif *nif = netif_list; nif != NULL; nif = nif->next) {
-        if (netif_is_up(nif) && ip4_addr_get_u32(netif_ip4_addr(nif)) == ip_raw) {
-            sta_nif = nif;
-            break;
+void NetworkScanner::collectLiveHosts() {
+    _liveCount = _liveNext = 0;
+    for (uint16_t i = 0; i < deviceRegistry.count(); i++) {
+        DeviceId id = deviceRegistry.at(i);
+        uint32_t ip = deviceRegistry.ip[id];
+        uint32_t offset = ntohl(ip) - _netBase;
+        if (deviceRegistry.has(id, DEVICE_ACTIVE) && ip != _staIP &&
+            offset >= 1 && offset <= _hostCount) {
+            _liveIPs[_liveCount++] = ip;
         }
     }
+    _metrics.liveHosts = _liveCount;
+}
 
-    if (!sta_nif) {
-        UNLOCK_TCPIP_CORE();
-        _scanIP = 255;
-        return;
+uint32_t NetworkScanner::effectiveSweepPeriod() const {
+    // Never faster than the batch rate allows
+    uint64_t minPeriod = (uint64_t)_hostCount * ARP_BATCH_DELAY / ARP_BATCH_SIZE;
+    return minPeriod > _sweepPeriod ? (uint32_t)minPeriod : _sweepPeriod;
+}
+
+void NetworkScanner::finishSweep(unsigned long now) {
+    _metrics.sweeps++;
+    _metrics.lastSweepMs = now - _sweepStart;
+
+    // Back off while the network is quiet, react quickly after a change
+    if (_sweepChanges > 0) {
+        _sweepPeriod = ARP_SWEEP_MIN_MS;
+    } else {
+        _sweepPeriod = _sweepPeriod * 2 < ARP_SWEEP_MAX_MS ? _sweepPeriod * 2 : ARP_SWEEP_MAX_MS;
     }
 
-    // Send ARP requests for this batch
-    uint32_t net_host = ntohl(net_raw);
-    int sent = 0;
+    _metrics.sweepPeriodMs = effectiveSweepPeriod();
 
-    while (_scanIP <= 254 && sent < ARP_BATCH_SIZE) {
-        ip4_addr_t target;
-        target.addr = htonl(net_host + _scanIP);
+    _sweepOffset = 1;
+    _sweepStart = now;
+    _sweepChanges = 0;
+}
 
-        // Don't ARP ourselves
-        if (target.addr != ip_raw) {
-            etharp_request(sta_nif, &target);
-        }
+void NetworkScanner::sendBatch(unsigned long now) {
+    ip4_addr_t targets[ARP_BATCH_SIZE];
+    int count = 0;
+
+    // Known hosts first
+    while (count < ARP_BATCH_SIZE && _liveNext < _liveCount) {
+        targets[count++].addr = _liveIPs[_liveNext++];
+    }
 
-        _scanIP++;
-        sent++;
+    // Then the sweep, paced to finish within the sweep period
+    if (_hostCount > 0) {
+        uint32_t elapsed = now - _lastBatch;
+        if (elapsed > ARP_BATCH_DELAY * 2) elapsed = ARP_BATCH_DELAY * 2;
+        _sweepCredit += (uint32_t)((uint64_t)elapsed * _hostCount * 1000 / effectiveSweepPeriod());
+        if (_sweepCredit > ARP_BATCH_SIZE * 1000) _sweepCredit = ARP_BATCH_SIZE * 1000;
+
+        while (count < ARP_BATCH_SIZE && _sweepCredit >= 1000) {
+            uint32_t target = htonl(_netBase + _sweepOffset);
+            if (target != _staIP) {
+                targets[count++].addr = target;
+            }
+            _sweepCredit -= 1000;
+            if (++_sweepOffset > _hostCount) {
+                finishSweep(now);
+                break;
+            }
+        }
     }
 
+    if (count == 0) return;
+
+    uint32_t start = micros();
+    LOCK_TCPIP_CORE();
+    for (int i = 0; i < count; i++) {
+        etharp_request(_staNetif, &targets[i]);
+    }
     UNLOCK_TCPIP_CORE();
+    _metrics.lockMicros += micros() - start;
+    _metrics.probesSent += count;
 }
 
 void NetworkScanner::readArpTable() {
-    LOCK_TCPIP_CORE();
+    uint8_t next = _arpCurrent ^ 1;
+    ArpEntry* snap = _arpSnapshot[next];
+    uint8_t count = 0;
 
+    // Only copy under the lock; everything else happens after it
+    uint32_t start = micros();
+    LOCK_TCPIP_CORE();
     for (size_t i = 0; i < ARP_TABLE_SIZE; i++) {
-        ip4_addr_t *ipaddr = NULL;
-        struct netif *netif = NULL;
-        struct eth_addr *ethaddr = NULL;
-
-        if (etharp_get_entry(i, &ipaddr, &netif, &ethaddr) == 0) {
-            if (ethaddr == NULL || ipaddr == NULL) continue;
-            uint8_t mac[6];
-            memcpy(mac, ethaddr->addr, 6);
-            // Skip entries with no valid MAC (all zeros = pending ARP)
-            if (mac[0] == 0 && mac[1] == 0 && mac[2] == 0 &&
-                mac[3] == 0 && mac[4] == 0 && mac[5] == 0) continue;
-            IPAddress ip(
-                ip4_addr1_16(ipaddr), ip4_addr2_16(ipaddr),
-                ip4_addr3_16(ipaddr), ip4_addr4_16(ipaddr)
-            );
-            deviceManager.updateDevice(mac, ip);
+        ip4_addr_t* ipaddr = NULL;
+        struct netif* nif = NULL;
+        struct eth_addr* ethaddr = NULL;
+
+        // Returns 1 for stable entries (pending ones have no MAC yet)
+        if (etharp_get_entry(i, &ipaddr, &nif, &ethaddr) && nif == _staNetif) {
+            memcpy(snap[count].mac, ethaddr->addr, 6);
+            snap[count].ip = ip4_addr_get_u32(ipaddr);
+            count++;
         }
     }
-
     UNLOCK_TCPIP_CORE();
+    _metrics.lockMicros += micros() - start;
+
+    diffArpSnapshot(_arpSnapshot[_arpCurrent], _arpCount[_arpCurrent], snap, count, millis());
+    _arpCurrent = next;
+    _arpCount[next] = count;
+}
+
+static int findArpEntry(const ArpEntry* entries, uint16_t count, const uint8_t* mac) {
+    for (uint16_t i = 0; i < count; i++) {
+        if (memcmp(entries[i].mac, mac, 6) == 0) return i;
+    }
+    return -1;
+}
+
+void NetworkScanner::diffArpSnapshot(const ArpEntry* prev, uint8_t prevCount,
+                                     const ArpEntry* cur, uint8_t curCount, uint32_t now) {
+    for (uint8_t i = 0; i < curCount; i++) {
+        int p = findArpEntry(prev, prevCount, cur[i].mac);
+        if (p >= 0) {
+            if (prev[p].ip != cur[i].ip) {
+                emit(NEIGHBOR_IP_CHANGE, cur[i].mac, cur[i].ip, now);
+            }
+            continue;
+        }
+
+        // Back within the grace period: it was only pushed out of the table
+        int g = findArpEntry(_gone, _goneCount, cur[i].mac);
+        if (g >= 0) {
+            if (_gone[g].ip != cur[i].ip) {
+                emit(NEIGHBOR_IP_CHANGE, cur[i].mac, cur[i].ip, now);
+            }
+            _gone[g] = _gone[--_goneCount];
+            continue;
+        }
+        emit(NEIGHBOR_APPEAR, cur[i].mac, cur[i].ip, now);
+    }
+
+    for (uint8_t i = 0; i < prevCount; i++) {
+        if (findArpEntry(cur, curCount, prev[i].mac) >= 0) continue;
+        if (_goneCount == MAX_DEVICES) {
+            // Full: report one early rather than lose it
+            emit(NEIGHBOR_DISAPPEAR, _gone[0].mac, _gone[0].ip, _gone[0].since);
+            _gone[0] = _gone[--_goneCount];
+        }
+        memcpy(_gone[_goneCount].mac, prev[i].mac, 6);
+        _gone[_goneCount].ip = prev[i].ip;
+        _gone[_goneCount].since = now;
+        _goneCount++;
+    }
+
+    for (uint16_t i = 0; i < _goneCount;) {
+        if (now - _gone[i].since >= ARP_GONE_GRACE_MS) {
+            emit(NEIGHBOR_DISAPPEAR, _gone[i].mac, _gone[i].ip, _gone[i].since);
+            _gone[i] = _gone[--_goneCount];
+        } else {
+            i++;
+        }
+    }
+}
+
+void NetworkScanner::emit(NeighborEventType type, const uint8_t* mac, uint32_t ip, uint32_t time) {
+    NeighborEvent evt;
+    evt.type = type;
+    memcpy(evt.mac, mac, 6);
+    evt.ip = ip;
+    evt.time = time;
+    if (!_events.push(evt)) {
+        _metrics.eventsDropped++;
+    }
+}
+
+void NetworkScanner::applyEvents() {
+    NeighborEvent evt;
+    while (_events.pop(evt)) {
+        switch (evt.type) {
+            case NEIGHBOR_APPEAR:
+            case NEIGHBOR_IP_CHANGE: {
+                // With more hosts than table rows, known hosts drop out past
+                // the grace period and are found again by the next sweep.
+                // Only a MAC or address the registry does not have is news;
+                // counting the rest would keep the sweep from backing off.
+                DeviceId id = deviceRegistry.find(evt.mac);
+                if (id == DEVICE_NONE || deviceRegistry.ip[id] != evt.ip) {
+                    _sweepChanges++;
+                    _metrics.changes++;
+                }
+                deviceManager.updateDevice(evt.mac, IPAddress(evt.ip), PRESENCE_ARP);
+                break;
+            }
+            case NEIGHBOR_DISAPPEAR:
+                deviceManager.deviceOffline(evt.mac, evt.time);
+                break;
+        }
+    }
 }
 
 void NetworkScanner::readApClients() {
@@ -168,34 +316,6 @@ void NetworkScanner::readApClients() {
             esp_ip4_addr_get_byte(&info.ip, 2),
             esp_ip4_addr_get_byte(&info.ip, 3)
         );
-        deviceManager.updateDevice(info.mac, ip);
-    }
-}
-
-void NetworkScanner::mdnsBrowse() {
-    const char* svc = MDNS_SERVICES[_mdnsIdx];
-    _mdnsIdx = (_mdnsIdx + 1) % MDNS_SERVICE_COUNT;
-
-    int n = MDNS.queryService(svc, "tcp");
-    if (n <= 0) return;
-
-    DEBUG_PRINTF("Scanner: Found %d %s._tcp services\n", n, svc);
-
-    for (int i = 0; i < n; i++) {
-        String hostname = MDNS.hostname(i);
-        IPAddress ip = MDNS.address(i);
-
-        if (hostname.length() == 0 || ip == IPAddress(0, 0, 0, 0)) continue;
-
-        // Find device by IP and update name
-        std::vector<DeviceInfo> devs = deviceManager.getAllDevices();
-        for (auto& d : devs) {
-            if (d.ip == ip && !d.hasCustomName) {
-                deviceManager.updateDeviceHostname(d.mac, hostname);
-                DEBUG_PRINTF("Scanner: mDNS name for %s -> %s\n",
-                             d.getMACString().c_str(), hostname.c_str());
-                break;
-            }
-        }
+        deviceManager.updateDevice(info.mac, ip, PRESENCE_AP);
     }
 }
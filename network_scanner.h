@@ -3,27 +3,104 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
+#include "config.h"
+#include "spsc_ring.h"
 
+struct netif;
+
+// Change in the LAN's ARP table between two reads
+enum NeighborEventType : uint8_t {
+    NEIGHBOR_APPEAR,     // New MAC in the table
+    NEIGHBOR_IP_CHANGE,  // Known MAC, different address
+    NEIGHBOR_DISAPPEAR   // Gone from the table and not back within the grace period
+};
+
+struct NeighborEvent {
+    NeighborEventType type;
+    uint8_t mac[6];
+    uint32_t ip;    // Network byte order
+    uint32_t time;  // millis(); for DISAPPEAR, when it left the table
+};
+
+// One ARP table row: (MAC, IP); for rows that left, when they did
+struct ArpEntry {
+    uint8_t mac[6];
+    uint32_t ip;
+    uint32_t since;
+};
+
+// Scan cost and detection latency, for /api/status
+struct ScanMetrics {
+    uint32_t hosts;          // Addresses in the swept range
+    uint32_t liveHosts;      // Known hosts in the last recheck pass
+    uint32_t probesSent;     // ARP requests, total
+    uint32_t sweeps;         // Completed sweeps of the whole range
+    uint32_t sweepPeriodMs;  // Target for the current sweep (backs off while quiet)
+    uint32_t lastSweepMs;    // Duration of the last sweep: worst case to find a new host
+    uint32_t liveIntervalMs; // Worst case to re-confirm a known host
+    uint32_t lockMicros;     // Time spent holding the TCP/IP core lock, total
+    uint32_t changes;        // ARP replies with a MAC or address new to the registry
+    uint32_t eventsDropped;  // Neighbor events lost to a full queue
+};
+
+// Finds hosts on the router's LAN with ARP.
+//
+// Two kinds of probes share one small batch every ARP_BATCH_DELAY:
+// - Known live devices (in the registry, active, on this subnet) are
+//   rechecked every ARP_LIVE_INTERVAL_MS.
+// - The rest of the address space is swept at a rate that spreads one pass
+//   over the sweep period. The period doubles after every sweep that found
+//   no MAC or address new to the registry and snaps back when one does
+//   (hosts merely cycling through a full ARP table do not count), and is
+//   never shorter than the probe rate allows, so a /16 is covered gradually.
+//
+// Each read copies the stable STA rows of lwIP's ARP table under the TCP/IP
+// lock and diffs them against the previous read. Only appear, IP-change and
+// disappear events reach the registry, after the lock is released.
 class NetworkScanner {
 public:
     void begin();
     void update();  // Call in loop()
 
+    ScanMetrics getMetrics() const { return _metrics; }
+
 private:
-    enum State { IDLE, SCANNING, WAITING };
+    // STA interface, looked up once per address change
+    struct netif* _staNetif = nullptr;
+    uint32_t _staIP = 0;       // Network byte order
+    uint32_t _netBase = 0;     // First address of the swept range, host order
+    uint32_t _hostCount = 0;   // Offsets 1.._hostCount are probed
+
+    // Sweep
+    uint32_t _sweepOffset = 1;
+    uint32_t _sweepStart = 0;
+    uint32_t _sweepPeriod = 0;
+    uint32_t _sweepCredit = 0; // Probes owed, in 1/1000ths
+    uint32_t _sweepChanges = 0;
+
+    // Known live hosts, refreshed from the registry every pass
+    uint32_t _liveIPs[MAX_DEVICES];  // Network byte order
+    uint16_t _liveCount = 0;
+    uint16_t _liveNext = 0;
+    unsigned long _lastLivePass = 0;
 
-    State _state = IDLE;
-    unsigned long _lastScan = 0;
     unsigned long _lastBatch = 0;
-    unsigned long _waitStart = 0;
-    unsigned long _lastMdns = 0;
-    uint16_t _scanIP = 1;
-    uint8_t _mdnsIdx = 0;
+    ScanMetrics _metrics = {};
+
+    // Snapshot diff -> registry (both ends in loop(); keeps lock and NVS apart)
+    SpscRing<NeighborEvent, 32> _events;
 
-    void sendArpBatch();
+    bool refreshInterface();
+    void collectLiveHosts();
+    uint32_t effectiveSweepPeriod() const;
+    void finishSweep(unsigned long now);
+    void sendBatch(unsigned long now);
     void readArpTable();
+    void diffArpSnapshot(const ArpEntry* prev, uint8_t prevCount,
+                         const ArpEntry* cur, uint8_t curCount, uint32_t now);
+    void emit(NeighborEventType type, const uint8_t* mac, uint32_t ip, uint32_t time);
+    void applyEvents();
     void readApClients();
-    void mdnsBrowse();
 };
 
 extern NetworkScanner networkScanner;
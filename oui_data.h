@@ -0,0 +1,152 @@
+// Generated by tools/gen_oui.py - do not edit.
+// Sources: oui_seed.csv
+// 650 MA-L, 0 MA-M, 0 MA-S prefixes, 14 vendors, ~3789 bytes of flash
+
+#ifndef OUI_DATA_H
+#define OUI_DATA_H
+
+#include <Arduino.h>
+
+#define OUI_VENDOR_COUNT 14
+#define OUI_L_COUNT      650
+#define OUI_M_COUNT      0
+#define OUI_S_COUNT      0
+
+static const char OUI_POOL[] PROGMEM =
+    "Amazon\0"
+    "Apple\0"
+    "Dell\0"
+    "Espressif\0"
+    "Google\0"
+    "HP\0"
+    "Huawei\0"
+    "Intel\0"
+    "Microsoft\0"
+    "Raspberry Pi\0"
+    "Realtek\0"
+    "Samsung\0"
+    "TP-Link\0"
+    "Xiaomi\0";
+
+static const uint32_t OUI_VENDOR_OFFSET[] PROGMEM = {
+    0, 7, 13, 18, 28, 35, 38, 45, 51, 61, 74, 82, 90, 98,
+};
+
+// MA-L rows [OUI_L_INDEX[b], OUI_L_INDEX[b + 1]) start with byte b
+static const uint32_t OUI_L_INDEX[257] PROGMEM = {
+    0, 212, 212, 212, 212, 230, 230, 230, 230, 236, 236, 236, 236, 242, 242, 242, 242, 249, 249,
+    249, 249, 253, 253, 253, 253, 258, 258, 258, 258, 260, 260, 260, 260, 262, 262, 262, 262, 268,
+    268, 268, 268, 273, 273, 273, 273, 275, 275, 275, 275, 279, 279, 279, 279, 282, 282, 282, 282,
+    285, 285, 285, 285, 290, 290, 290, 290, 294, 294, 294, 294, 298, 298, 298, 298, 301, 301, 301,
+    301, 303, 303, 303, 303, 309, 309, 309, 309, 317, 317, 317, 317, 320, 320, 320, 320, 324, 324,
+    324, 324, 329, 329, 329, 329, 335, 335, 335, 335, 341, 341, 341, 341, 344, 344, 344, 344, 348,
+    348, 348, 348, 353, 353, 353, 353, 360, 360, 360, 360, 370, 370, 370, 370, 374, 374, 374, 374,
+    383, 383, 383, 383, 387, 387, 387, 387, 394, 394, 394, 394, 400, 400, 400, 400, 406, 406, 406,
+    406, 417, 417, 417, 417, 421, 421, 421, 421, 429, 429, 429, 429, 437, 437, 437, 437, 445, 445,
+    445, 445, 459, 459, 459, 459, 467, 467, 467, 467, 472, 472, 472, 472, 487, 487, 487, 487, 498,
+    498, 498, 498, 508, 508, 508, 508, 515, 515, 515, 515, 527, 527, 527, 527, 535, 535, 535, 535,
+    546, 546, 546, 546, 552, 552, 552, 552, 564, 564, 564, 564, 574, 574, 574, 574, 584, 584, 584,
+    584, 595, 595, 595, 595, 600, 600, 600, 600, 606, 606, 606, 606, 623, 623, 623, 623, 636, 636,
+    636, 636, 641, 641, 641, 641, 650, 650, 650, 650,
+};
+
+static const uint16_t OUI_L_LOW[] PROGMEM = {
+    0x00F0, 0x01E6, 0x01E7, 0x0278, 0x02A5, 0x02B3, 0x0347, 0x0393, 0x03FF, 0x0423, 0x04EA, 0x065B,
+    0x07AB, 0x07E9, 0x0802, 0x0874, 0x0883, 0x0918, 0x0A27, 0x0A57, 0x0BCD, 0x0BDB, 0x0CF1, 0x0D3A,
+    0x0D56, 0x0D93, 0x0D9D, 0x0DAE, 0x0DE5, 0x0E0C, 0x0E35, 0x0E7F, 0x0F1F, 0x0F20, 0x0F61, 0x1083,
+    0x10E3, 0x10FA, 0x110A, 0x1111, 0x1124, 0x1143, 0x1185, 0x123F, 0x1247, 0x125A, 0x1279, 0x12F0,
+    0x12FB, 0x1302, 0x1320, 0x1321, 0x1372, 0x1377, 0x13CE, 0x13E8, 0x1422, 0x1438, 0x1451, 0x14C2,
+    0x1500, 0x1517, 0x155D, 0x1560, 0x1599, 0x15B9, 0x15C5, 0x1632, 0x1635, 0x166B, 0x166C, 0x166F,
+    0x1676, 0x16CB, 0x16EA, 0x16EB, 0x16F0, 0x1708, 0x17A4, 0x17C9, 0x17D5, 0x17F2, 0x17FA, 0x1871,
+    0x1882, 0x188B, 0x18AF, 0x18DE, 0x18FE, 0x19B9, 0x19BB, 0x19D1, 0x19D2, 0x19E3, 0x1A11, 0x1A4B,
+    0x1A4D, 0x1A8A, 0x1AA0, 0x1B21, 0x1B77, 0x1B78, 0x1B98, 0x1C23, 0x1C43, 0x1CB3, 0x1CBF, 0x1CC4,
+    0x1D09, 0x1D25, 0x1D4F, 0x1DB3, 0x1DD8, 0x1DE0, 0x1DE1, 0x1DF6, 0x1E0B, 0x1E10, 0x1E4F, 0x1E52,
+    0x1E64, 0x1E65, 0x1E67, 0x1E7D, 0x1EC2, 0x1EC9, 0x1EE1, 0x1EE2, 0x1F29, 0x1F3B, 0x1F3C, 0x1F5B,
+    0x1FCC, 0x1FF3, 0x20E0, 0x2119, 0x214C, 0x215A, 0x215C, 0x215D, 0x216A, 0x216B, 0x2170, 0x219B,
+    0x21D1, 0x21D2, 0x21E9, 0x2219, 0x2241, 0x2248, 0x2264, 0x22FA, 0x22FB, 0x2312, 0x2332, 0x2339,
+    0x233A, 0x236C, 0x237D, 0x2399, 0x23AE, 0x23D6, 0x23D7, 0x23DF, 0x2436, 0x2454, 0x2481, 0x2490,
+    0x2491, 0x24D6, 0x24D7, 0x24E8, 0x24E9, 0x2500, 0x254B, 0x2564, 0x2566, 0x2567, 0x2568, 0x259E,
+    0x25AE, 0x25B3, 0x25BC, 0x2608, 0x2637, 0x264A, 0x2655, 0x265D, 0x265F, 0x26B0, 0x26B9, 0x26BB,
+    0x26C6, 0x26C7, 0x2710, 0x2719, 0x34FE, 0x464B, 0x50E4, 0x50F2, 0x5A13, 0x6171, 0x664B, 0x7147,
+    0x8865, 0x9ACD, 0x9EC8, 0xC610, 0xE04C, 0xE0FC, 0xF81C, 0xFC8B, 0x021F, 0x0CCE, 0x1552, 0x1E64,
+    0x2665, 0x489A, 0x4BED, 0x4E5A, 0x52F3, 0x5453, 0xB0E7, 0xC06F, 0xCF8C, 0xD3CF, 0xDB56, 0xE536,
+    0xF13E, 0xF938, 0x19A6, 0x3AF2, 0x6361, 0x6698, 0x7A4C, 0xE84F, 0x1DAF, 0x37DC, 0x45BA, 0x47C9,
+    0x74C2, 0x96BF, 0x1B54, 0x2AB3, 0x447F, 0x4780, 0x521C, 0x9ADD, 0xCEA9, 0x99E2, 0xCC20, 0xCF92,
+    0xF65A, 0x5936, 0x742E, 0x9EFC, 0xA6F7, 0xFE34, 0x36BB, 0x3BF3, 0x34FB, 0x78F0, 0x0AC4, 0x62AB,
+    0x6968, 0x6F28, 0xA074, 0xB2DE, 0x1878, 0x6ABA, 0x6C07, 0xCFDA, 0xE31F, 0x3AE8, 0xBE08, 0x59B7,
+    0x90AB, 0xAEA4, 0xB5C2, 0x08BC, 0x80B3, 0xD270, 0x0F4A, 0xA4ED, 0xC986, 0x0630, 0x5AB4, 0x6105,
+    0x71BF, 0xBD3E, 0x6C8F, 0xA6D9, 0xB4CD, 0xF520, 0x237C, 0x2A60, 0x650D, 0xD884, 0x3FDA, 0x60BC,
+    0xD705, 0x11AE, 0x7525, 0x1AC5, 0x642B, 0xC7BF, 0xDCE7, 0xEAD6, 0xF5DA, 0x2696, 0x43B2, 0x5AA6,
+    0x6009, 0x724F, 0x9F13, 0xC80F, 0xE43A, 0x4498, 0x55CA, 0xBF25, 0x5948, 0x899A, 0x969D, 0xCF7F,
+    0x0194, 0x0308, 0x45BD, 0xE327, 0xFEC5, 0x200C, 0x5601, 0x7002, 0xA3CB, 0xB473, 0xCC2E, 0x0927,
+    0x37E9, 0x54FD, 0x5B35, 0xC63A, 0xDFDD, 0x4008, 0x709F, 0xB0CE, 0x039F, 0x1124, 0x5681, 0xDEE2,
+    0x2344, 0x51BA, 0x7548, 0xC246, 0xE2F5, 0x02F8, 0x11DC, 0x31C1, 0x6C1C, 0x8CB5, 0xCA39, 0xE103,
+    0x04D0, 0x11BE, 0x1DD9, 0x1E52, 0x6D62, 0x9EBD, 0xD1C3, 0xDFA1, 0xED8D, 0xF05F, 0x006E, 0x4971,
+    0x7D3A, 0xBE05, 0x093F, 0x0D8E, 0x3835, 0x788B, 0x850A, 0xCCA8, 0xD6D0, 0xF3EB, 0xFCFE, 0x5395,
+    0x66A3, 0xC663, 0xE87F, 0x006D, 0x2937, 0x5877, 0x7B9D, 0x8590, 0xAAB5, 0xBEBE, 0x7240, 0x8D6C,
+    0x97D5, 0xB21F, 0xB931, 0xFD61, 0x9426, 0xB555, 0xB97E, 0xE96A, 0xEB2C, 0xF6A3, 0x01A7, 0x03D8,
+    0x9E63, 0xB8E3, 0xCDAC, 0xD6BB, 0xDED0, 0xF0AB, 0xF4AB, 0xFAE3, 0xFE94, 0x207B, 0x35EB, 0x84BF,
+    0x99A0, 0x02DC, 0x1828, 0x20A6, 0x86C6, 0x999B, 0xD795, 0xEDCD, 0xF3C1, 0x5E60, 0x6706, 0x7B9D,
+    0x83E7, 0xB197, 0xC361, 0xCF12, 0xD18C, 0x5C2C, 0x667F, 0x86DD, 0x8E24, 0x968A, 0xBBCF, 0xF274,
+    0xFAD8, 0x293A, 0x3C0B, 0x61EA, 0x63BE, 0x67B2, 0x7F3E, 0x84C6, 0x87A3, 0xBC32, 0xC1EE, 0xCF5C,
+    0xD074, 0xF7F3, 0xFDEC, 0x19C6, 0x3495, 0x4E26, 0x65BD, 0x702D, 0x958E, 0x9FBA, 0xE235, 0x18D1,
+    0x7C9C, 0x8B19, 0xE62D, 0xF0AB, 0x098A, 0x17C2, 0x27EB, 0x41A4, 0x44D9, 0x53AC, 0x634D, 0x782E,
+    0x8D12, 0xC111, 0xC75D, 0xE856, 0xF009, 0xF6B1, 0xFF61, 0x3BAF, 0x52B7, 0x5436, 0x6778, 0x6C21,
+    0x8CCD, 0x926B, 0xA920, 0xDDC2, 0xEC5D, 0xFF4D, 0x1ADA, 0x25E9, 0x4A00, 0x6394, 0x847A, 0x9F42,
+    0xA53E, 0xCCF8, 0xD012, 0xF2FB, 0x0BCB, 0x2C03, 0x4202, 0x4F33, 0x5BBE, 0x731E, 0xB301, 0x1EE7,
+    0x2A14, 0x2B96, 0x334B, 0x3F26, 0x6F1D, 0x8550, 0xB5B7, 0xBCC8, 0xD719, 0xE0EB, 0xF650, 0x088D,
+    0x208C, 0x25EF, 0x29F5, 0x4463, 0x50E3, 0x785F, 0xC760, 0x034B, 0x22BE, 0x23DB, 0x2598, 0x3311,
+    0x4F7E, 0x817A, 0xA637, 0xC5F3, 0xD2B0, 0xE140, 0x619D, 0x6E0E, 0x970B, 0x9A20, 0xDCCD, 0xF46F,
+    0x004D, 0x07B6, 0x1D72, 0x3062, 0x8F76, 0x9695, 0x9E3F, 0xA01D, 0xA25E, 0xBB2C, 0xBFC0, 0xCF9C,
+    0x2B2A, 0x3714, 0x415F, 0x4F22, 0x56E7, 0x86D8, 0x9B9C, 0xA4CA, 0xA632, 0xB4C4, 0x5F45, 0x6678,
+    0x9806, 0xACCB, 0xB52D, 0xB9BA, 0xC767, 0xC97A, 0xF5C6, 0xF847, 0x25E7, 0x46DA, 0x58B8, 0x5F01,
+    0x8B7F, 0x98D6, 0x9A79, 0xB2FB, 0xC63D, 0xCE8F, 0xE4AB, 0x040B, 0x0688, 0x802E, 0x8D28, 0xDB84,
+    0x086B, 0x172F, 0x3586, 0x852F, 0xD09F, 0xFABC, 0x08D1, 0x1898, 0x2475, 0x272D, 0x5CD5, 0x7959,
+    0x8175, 0x99B6, 0x99BF, 0xB014, 0xB429, 0xC1F1, 0xCBA1, 0xD1A9, 0xDBE2, 0xDCE2, 0xF61C, 0x1BA1,
+    0x31C3, 0x37B7, 0x5C89, 0x5EAB, 0x7B5E, 0x8B32, 0xCFA2, 0xF15A, 0xF26D, 0xF5D8, 0xF5E8, 0xF951,
+    0x1A67, 0x2793, 0x3880, 0x62AB, 0xA45F, 0x253F, 0x64BA, 0x65DE, 0xA13E, 0xA183, 0xD848, 0xE998,
+    0xF5C4, 0xFC48,
+};
+
+static const uint16_t OUI_L_VENDOR[] PROGMEM = {
+    11, 5, 5, 11, 5, 7, 7, 1, 8, 7, 5, 2, 11, 7, 5, 2, 5, 11, 1, 5, 5, 2, 7, 8, 2, 1, 5, 11, 11, 7,
+    7, 5, 2, 5, 5, 5, 5, 1, 5, 7, 1, 2, 5, 2, 11, 8, 5, 7, 11, 7, 7, 5, 2, 11, 7, 7, 2, 5, 1, 5, 7,
+    7, 8, 5, 11, 11, 2, 11, 5, 11, 11, 7, 7, 1, 7, 7, 2, 5, 5, 11, 11, 1, 8, 5, 6, 2, 11, 7, 5, 2,
+    5, 7, 7, 1, 4, 5, 7, 11, 2, 7, 7, 5, 11, 2, 11, 1, 7, 5, 2, 11, 1, 5, 8, 7, 7, 11, 5, 6, 2, 1,
+    7, 7, 7, 11, 1, 2, 11, 11, 5, 7, 7, 1, 11, 1, 7, 11, 11, 5, 7, 7, 7, 7, 2, 2, 11, 11, 1, 2, 1,
+    8, 5, 7, 7, 1, 1, 11, 11, 1, 5, 11, 2, 11, 11, 1, 1, 11, 5, 11, 11, 7, 7, 2, 11, 1, 1, 2, 11,
+    11, 6, 6, 8, 5, 1, 1, 11, 1, 5, 11, 11, 1, 2, 1, 7, 7, 7, 12, 6, 6, 1, 8, 6, 1, 6, 0, 1, 6, 13,
+    1, 10, 6, 6, 0, 6, 1, 1, 1, 1, 1, 1, 0, 1, 1, 6, 6, 13, 1, 1, 1, 1, 6, 6, 3, 6, 1, 6, 6, 13, 6,
+    6, 0, 1, 6, 6, 13, 6, 6, 3, 1, 0, 1, 12, 12, 13, 13, 0, 1, 12, 3, 1, 12, 13, 1, 3, 3, 12, 3, 1,
+    3, 8, 1, 13, 1, 13, 3, 1, 8, 1, 3, 12, 1, 13, 0, 1, 13, 1, 1, 4, 3, 3, 13, 1, 1, 0, 3, 13, 1,
+    0, 1, 3, 1, 1, 3, 3, 8, 13, 12, 0, 1, 0, 1, 3, 3, 4, 1, 1, 12, 1, 13, 1, 3, 1, 12, 1, 3, 3, 1,
+    8, 12, 1, 1, 12, 12, 1, 13, 13, 1, 0, 0, 1, 3, 13, 1, 1, 12, 3, 1, 1, 1, 13, 13, 0, 0, 1, 13,
+    13, 1, 1, 12, 1, 0, 1, 1, 13, 8, 1, 3, 1, 3, 8, 1, 1, 1, 3, 1, 13, 3, 1, 1, 1, 3, 0, 3, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 3, 13, 1, 1, 3, 1, 1, 1, 1, 3, 3, 1, 4, 1, 1, 1, 1, 1, 3, 1, 12, 1, 3,
+    13, 1, 1, 1, 1, 13, 0, 1, 3, 13, 1, 1, 1, 12, 1, 1, 3, 1, 1, 1, 3, 1, 1, 1, 1, 1, 1, 1, 11, 1,
+    1, 1, 1, 0, 3, 1, 12, 1, 1, 13, 1, 3, 13, 1, 1, 1, 12, 1, 1, 12, 1, 13, 1, 0, 1, 3, 1, 1, 1, 9,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 3, 1, 1, 1, 1, 1, 1, 1, 11, 1, 1, 3, 1, 3, 1, 12, 12, 1, 1, 1, 1, 1,
+    1, 1, 13, 1, 11, 3, 3, 11, 1, 1, 1, 3, 1, 8, 1, 1, 1, 1, 13, 1, 1, 1, 1, 1, 1, 1, 3, 1, 1, 1,
+    11, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 12, 13, 1, 1, 1, 1, 12, 1, 1, 1, 1, 1, 3, 1, 1, 3, 1, 1, 1,
+    1, 3, 1, 1, 1, 1, 9, 8, 1, 1, 3, 1, 1, 1, 1, 1, 1, 1, 1, 13, 11, 9, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 3, 12, 12, 1, 1, 13, 3, 3, 1, 1, 0, 11, 1, 0, 1, 1, 1, 13, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 11, 13, 3, 1, 12, 4, 4, 1, 12, 1, 1, 1, 13, 1, 13, 0, 11, 0, 1, 1, 3, 1,
+};
+
+static const uint8_t OUI_M_PREFIX[][4] PROGMEM = {
+    0
+};
+
+static const uint16_t OUI_M_VENDOR[] PROGMEM = {
+    0
+};
+
+static const uint8_t OUI_S_PREFIX[][5] PROGMEM = {
+    0
+};
+
+static const uint16_t OUI_S_VENDOR[] PROGMEM = {
+    0
+};
+
+#endif // OUI_DATA_H
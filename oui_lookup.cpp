@@ -1,708 +1,98 @@
 #include "oui_lookup.h"
+#include <WiFi.h>
+#include "storage_manager.h"
 
 OUILookup ouiLookup;
 
-// Common OUI database - add more as needed
-// Format: {OUI prefix (3 bytes), "Vendor Name"}
-static const OUIEntry ouiDatabase[] PROGMEM = {
-    // Apple
-    {{0x00, 0x1C, 0xB3}, "Apple"},
-    {{0x00, 0x03, 0x93}, "Apple"},
-    {{0x00, 0x0A, 0x27}, "Apple"},
-    {{0x00, 0x0D, 0x93}, "Apple"},
-    {{0x00, 0x10, 0xFA}, "Apple"},
-    {{0x00, 0x11, 0x24}, "Apple"},
-    {{0x00, 0x14, 0x51}, "Apple"},
-    {{0x00, 0x16, 0xCB}, "Apple"},
-    {{0x00, 0x17, 0xF2}, "Apple"},
-    {{0x00, 0x19, 0xE3}, "Apple"},
-    {{0x00, 0x1D, 0x4F}, "Apple"},
-    {{0x00, 0x1E, 0x52}, "Apple"},
-    {{0x00, 0x1E, 0xC2}, "Apple"},
-    {{0x00, 0x1F, 0x5B}, "Apple"},
-    {{0x00, 0x1F, 0xF3}, "Apple"},
-    {{0x00, 0x21, 0xE9}, "Apple"},
-    {{0x00, 0x22, 0x41}, "Apple"},
-    {{0x00, 0x23, 0x12}, "Apple"},
-    {{0x00, 0x23, 0x32}, "Apple"},
-    {{0x00, 0x23, 0x6C}, "Apple"},
-    {{0x00, 0x23, 0xDF}, "Apple"},
-    {{0x00, 0x24, 0x36}, "Apple"},
-    {{0x00, 0x25, 0x00}, "Apple"},
-    {{0x00, 0x25, 0x4B}, "Apple"},
-    {{0x00, 0x25, 0xBC}, "Apple"},
-    {{0x00, 0x26, 0x08}, "Apple"},
-    {{0x00, 0x26, 0x4A}, "Apple"},
-    {{0x00, 0x26, 0xB0}, "Apple"},
-    {{0x00, 0x26, 0xBB}, "Apple"},
-    {{0x00, 0x50, 0xE4}, "Apple"},
-    {{0x00, 0x61, 0x71}, "Apple"},
-    {{0x00, 0x88, 0x65}, "Apple"},
-    {{0x00, 0xC6, 0x10}, "Apple"},
-    {{0x04, 0x0C, 0xCE}, "Apple"},
-    {{0x04, 0x15, 0x52}, "Apple"},
-    {{0x04, 0x1E, 0x64}, "Apple"},
-    {{0x04, 0x26, 0x65}, "Apple"},
-    {{0x04, 0x48, 0x9A}, "Apple"},
-    {{0x04, 0x4B, 0xED}, "Apple"},
-    {{0x04, 0x52, 0xF3}, "Apple"},
-    {{0x04, 0x54, 0x53}, "Apple"},
-    {{0x04, 0xD3, 0xCF}, "Apple"},
-    {{0x04, 0xDB, 0x56}, "Apple"},
-    {{0x04, 0xE5, 0x36}, "Apple"},
-    {{0x04, 0xF1, 0x3E}, "Apple"},
-    {{0x08, 0x66, 0x98}, "Apple"},
-    {{0x0C, 0x74, 0xC2}, "Apple"},
-    {{0x10, 0x9A, 0xDD}, "Apple"},
-    {{0x14, 0x99, 0xE2}, "Apple"},
-    {{0x18, 0x9E, 0xFC}, "Apple"},
-    {{0x1C, 0x36, 0xBB}, "Apple"},
-    {{0x20, 0x78, 0xF0}, "Apple"},
-    {{0x24, 0xA0, 0x74}, "Apple"},
-    {{0x28, 0x6A, 0xBA}, "Apple"},
-    {{0x28, 0xCF, 0xDA}, "Apple"},
-    {{0x2C, 0xBE, 0x08}, "Apple"},
-    {{0x30, 0x90, 0xAB}, "Apple"},
-    {{0x34, 0x08, 0xBC}, "Apple"},
-    {{0x38, 0x0F, 0x4A}, "Apple"},
-    {{0x38, 0xC9, 0x86}, "Apple"},
-    {{0x3C, 0x06, 0x30}, "Apple"},
-    {{0x40, 0x6C, 0x8F}, "Apple"},
-    {{0x40, 0xA6, 0xD9}, "Apple"},
-    {{0x44, 0x2A, 0x60}, "Apple"},
-    {{0x44, 0xD8, 0x84}, "Apple"},
-    {{0x48, 0x60, 0xBC}, "Apple"},
-    {{0x48, 0xD7, 0x05}, "Apple"},
-    {{0x50, 0xEA, 0xD6}, "Apple"},
-    {{0x54, 0x26, 0x96}, "Apple"},
-    {{0x54, 0x72, 0x4F}, "Apple"},
-    {{0x54, 0x9F, 0x13}, "Apple"},
-    {{0x54, 0xE4, 0x3A}, "Apple"},
-    {{0x58, 0x55, 0xCA}, "Apple"},
-    {{0x5C, 0x59, 0x48}, "Apple"},
-    {{0x5C, 0x96, 0x9D}, "Apple"},
-    {{0x60, 0x03, 0x08}, "Apple"},
-    {{0x60, 0xFE, 0xC5}, "Apple"},
-    {{0x64, 0x20, 0x0C}, "Apple"},
-    {{0x64, 0xA3, 0xCB}, "Apple"},
-    {{0x68, 0x09, 0x27}, "Apple"},
-    {{0x68, 0x5B, 0x35}, "Apple"},
-    {{0x6C, 0x40, 0x08}, "Apple"},
-    {{0x6C, 0x70, 0x9F}, "Apple"},
-    {{0x70, 0x11, 0x24}, "Apple"},
-    {{0x70, 0x56, 0x81}, "Apple"},
-    {{0x70, 0xDE, 0xE2}, "Apple"},
-    {{0x74, 0xE2, 0xF5}, "Apple"},
-    {{0x78, 0x31, 0xC1}, "Apple"},
-    {{0x78, 0x6C, 0x1C}, "Apple"},
-    {{0x78, 0xCA, 0x39}, "Apple"},
-    {{0x7C, 0x04, 0xD0}, "Apple"},
-    {{0x7C, 0x11, 0xBE}, "Apple"},
-    {{0x7C, 0x6D, 0x62}, "Apple"},
-    {{0x7C, 0xD1, 0xC3}, "Apple"},
-    {{0x7C, 0xF0, 0x5F}, "Apple"},
-    {{0x80, 0x00, 0x6E}, "Apple"},
-    {{0x80, 0x49, 0x71}, "Apple"},
-    {{0x80, 0xBE, 0x05}, "Apple"},
-    {{0x84, 0x38, 0x35}, "Apple"},
-    {{0x84, 0x78, 0x8B}, "Apple"},
-    {{0x84, 0x85, 0x0A}, "Apple"},
-    {{0x84, 0xFC, 0xFE}, "Apple"},
-    {{0x88, 0x53, 0x95}, "Apple"},
-    {{0x88, 0x66, 0xA3}, "Apple"},
-    {{0x88, 0xC6, 0x63}, "Apple"},
-    {{0x88, 0xE8, 0x7F}, "Apple"},
-    {{0x8C, 0x00, 0x6D}, "Apple"},
-    {{0x8C, 0x29, 0x37}, "Apple"},
-    {{0x8C, 0x58, 0x77}, "Apple"},
-    {{0x8C, 0x7B, 0x9D}, "Apple"},
-    {{0x8C, 0x85, 0x90}, "Apple"},
-    {{0x90, 0x72, 0x40}, "Apple"},
-    {{0x90, 0x8D, 0x6C}, "Apple"},
-    {{0x90, 0xB2, 0x1F}, "Apple"},
-    {{0x90, 0xB9, 0x31}, "Apple"},
-    {{0x90, 0xFD, 0x61}, "Apple"},
-    {{0x94, 0x94, 0x26}, "Apple"},
-    {{0x94, 0xE9, 0x6A}, "Apple"},
-    {{0x94, 0xF6, 0xA3}, "Apple"},
-    {{0x98, 0x01, 0xA7}, "Apple"},
-    {{0x98, 0x03, 0xD8}, "Apple"},
-    {{0x98, 0x9E, 0x63}, "Apple"},
-    {{0x98, 0xB8, 0xE3}, "Apple"},
-    {{0x98, 0xD6, 0xBB}, "Apple"},
-    {{0x98, 0xF0, 0xAB}, "Apple"},
-    {{0x98, 0xFE, 0x94}, "Apple"},
-    {{0x9C, 0x20, 0x7B}, "Apple"},
-    {{0x9C, 0x35, 0xEB}, "Apple"},
-    {{0x9C, 0x84, 0xBF}, "Apple"},
-    {{0xA0, 0x18, 0x28}, "Apple"},
-    {{0xA0, 0x99, 0x9B}, "Apple"},
-    {{0xA0, 0xD7, 0x95}, "Apple"},
-    {{0xA0, 0xED, 0xCD}, "Apple"},
-    {{0xA4, 0x5E, 0x60}, "Apple"},
-    {{0xA4, 0x67, 0x06}, "Apple"},
-    {{0xA4, 0x83, 0xE7}, "Apple"},
-    {{0xA4, 0xB1, 0x97}, "Apple"},
-    {{0xA4, 0xC3, 0x61}, "Apple"},
-    {{0xA4, 0xD1, 0x8C}, "Apple"},
-    {{0xA8, 0x5C, 0x2C}, "Apple"},
-    {{0xA8, 0x66, 0x7F}, "Apple"},
-    {{0xA8, 0x86, 0xDD}, "Apple"},
-    {{0xA8, 0x8E, 0x24}, "Apple"},
-    {{0xA8, 0x96, 0x8A}, "Apple"},
-    {{0xA8, 0xBB, 0xCF}, "Apple"},
-    {{0xA8, 0xFA, 0xD8}, "Apple"},
-    {{0xAC, 0x29, 0x3A}, "Apple"},
-    {{0xAC, 0x3C, 0x0B}, "Apple"},
-    {{0xAC, 0x61, 0xEA}, "Apple"},
-    {{0xAC, 0x7F, 0x3E}, "Apple"},
-    {{0xAC, 0x87, 0xA3}, "Apple"},
-    {{0xAC, 0xBC, 0x32}, "Apple"},
-    {{0xAC, 0xCF, 0x5C}, "Apple"},
-    {{0xAC, 0xFD, 0xEC}, "Apple"},
-    {{0xB0, 0x19, 0xC6}, "Apple"},
-    {{0xB0, 0x34, 0x95}, "Apple"},
-    {{0xB0, 0x65, 0xBD}, "Apple"},
-    {{0xB0, 0x70, 0x2D}, "Apple"},
-    {{0xB0, 0x9F, 0xBA}, "Apple"},
-    {{0xB4, 0x18, 0xD1}, "Apple"},
-    {{0xB4, 0x8B, 0x19}, "Apple"},
-    {{0xB4, 0xF0, 0xAB}, "Apple"},
-    {{0xB8, 0x09, 0x8A}, "Apple"},
-    {{0xB8, 0x17, 0xC2}, "Apple"},
-    {{0xB8, 0x41, 0xA4}, "Apple"},
-    {{0xB8, 0x44, 0xD9}, "Apple"},
-    {{0xB8, 0x53, 0xAC}, "Apple"},
-    {{0xB8, 0x63, 0x4D}, "Apple"},
-    {{0xB8, 0x78, 0x2E}, "Apple"},
-    {{0xB8, 0x8D, 0x12}, "Apple"},
-    {{0xB8, 0xC1, 0x11}, "Apple"},
-    {{0xB8, 0xC7, 0x5D}, "Apple"},
-    {{0xB8, 0xE8, 0x56}, "Apple"},
-    {{0xB8, 0xF6, 0xB1}, "Apple"},
-    {{0xB8, 0xFF, 0x61}, "Apple"},
-    {{0xBC, 0x3B, 0xAF}, "Apple"},
-    {{0xBC, 0x52, 0xB7}, "Apple"},
-    {{0xBC, 0x54, 0x36}, "Apple"},
-    {{0xBC, 0x67, 0x78}, "Apple"},
-    {{0xBC, 0x6C, 0x21}, "Apple"},
-    {{0xBC, 0x92, 0x6B}, "Apple"},
-    {{0xBC, 0xA9, 0x20}, "Apple"},
-    {{0xBC, 0xEC, 0x5D}, "Apple"},
-    {{0xC0, 0x1A, 0xDA}, "Apple"},
-    {{0xC0, 0x63, 0x94}, "Apple"},
-    {{0xC0, 0x84, 0x7A}, "Apple"},
-    {{0xC0, 0x9F, 0x42}, "Apple"},
-    {{0xC0, 0xA5, 0x3E}, "Apple"},
-    {{0xC0, 0xCC, 0xF8}, "Apple"},
-    {{0xC0, 0xD0, 0x12}, "Apple"},
-    {{0xC0, 0xF2, 0xFB}, "Apple"},
-    {{0xC4, 0x2C, 0x03}, "Apple"},
-    {{0xC4, 0xB3, 0x01}, "Apple"},
-    {{0xC8, 0x1E, 0xE7}, "Apple"},
-    {{0xC8, 0x2A, 0x14}, "Apple"},
-    {{0xC8, 0x33, 0x4B}, "Apple"},
-    {{0xC8, 0x6F, 0x1D}, "Apple"},
-    {{0xC8, 0x85, 0x50}, "Apple"},
-    {{0xC8, 0xB5, 0xB7}, "Apple"},
-    {{0xC8, 0xBC, 0xC8}, "Apple"},
-    {{0xC8, 0xE0, 0xEB}, "Apple"},
-    {{0xC8, 0xF6, 0x50}, "Apple"},
-    {{0xCC, 0x08, 0x8D}, "Apple"},
-    {{0xCC, 0x20, 0x8C}, "Apple"},
-    {{0xCC, 0x25, 0xEF}, "Apple"},
-    {{0xCC, 0x29, 0xF5}, "Apple"},
-    {{0xCC, 0x44, 0x63}, "Apple"},
-    {{0xCC, 0x78, 0x5F}, "Apple"},
-    {{0xCC, 0xC7, 0x60}, "Apple"},
-    {{0xD0, 0x03, 0x4B}, "Apple"},
-    {{0xD0, 0x23, 0xDB}, "Apple"},
-    {{0xD0, 0x25, 0x98}, "Apple"},
-    {{0xD0, 0x33, 0x11}, "Apple"},
-    {{0xD0, 0x4F, 0x7E}, "Apple"},
-    {{0xD0, 0x81, 0x7A}, "Apple"},
-    {{0xD0, 0xA6, 0x37}, "Apple"},
-    {{0xD0, 0xC5, 0xF3}, "Apple"},
-    {{0xD0, 0xD2, 0xB0}, "Apple"},
-    {{0xD0, 0xE1, 0x40}, "Apple"},
-    {{0xD4, 0x61, 0x9D}, "Apple"},
-    {{0xD4, 0x9A, 0x20}, "Apple"},
-    {{0xD4, 0xDC, 0xCD}, "Apple"},
-    {{0xD4, 0xF4, 0x6F}, "Apple"},
-    {{0xD8, 0x00, 0x4D}, "Apple"},
-    {{0xD8, 0x1D, 0x72}, "Apple"},
-    {{0xD8, 0x30, 0x62}, "Apple"},
-    {{0xD8, 0x8F, 0x76}, "Apple"},
-    {{0xD8, 0x96, 0x95}, "Apple"},
-    {{0xD8, 0x9E, 0x3F}, "Apple"},
-    {{0xD8, 0xA2, 0x5E}, "Apple"},
-    {{0xD8, 0xBB, 0x2C}, "Apple"},
-    {{0xD8, 0xCF, 0x9C}, "Apple"},
-    {{0xDC, 0x2B, 0x2A}, "Apple"},
-    {{0xDC, 0x37, 0x14}, "Apple"},
-    {{0xDC, 0x41, 0x5F}, "Apple"},
-    {{0xDC, 0x56, 0xE7}, "Apple"},
-    {{0xDC, 0x86, 0xD8}, "Apple"},
-    {{0xDC, 0x9B, 0x9C}, "Apple"},
-    {{0xDC, 0xA4, 0xCA}, "Apple"},
-    {{0xE0, 0x5F, 0x45}, "Apple"},
-    {{0xE0, 0x66, 0x78}, "Apple"},
-    {{0xE0, 0xAC, 0xCB}, "Apple"},
-    {{0xE0, 0xB5, 0x2D}, "Apple"},
-    {{0xE0, 0xB9, 0xBA}, "Apple"},
-    {{0xE0, 0xC7, 0x67}, "Apple"},
-    {{0xE0, 0xC9, 0x7A}, "Apple"},
-    {{0xE0, 0xF5, 0xC6}, "Apple"},
-    {{0xE0, 0xF8, 0x47}, "Apple"},
-    {{0xE4, 0x25, 0xE7}, "Apple"},
-    {{0xE4, 0x8B, 0x7F}, "Apple"},
-    {{0xE4, 0x98, 0xD6}, "Apple"},
-    {{0xE4, 0x9A, 0x79}, "Apple"},
-    {{0xE4, 0xB2, 0xFB}, "Apple"},
-    {{0xE4, 0xC6, 0x3D}, "Apple"},
-    {{0xE4, 0xCE, 0x8F}, "Apple"},
-    {{0xE4, 0xE4, 0xAB}, "Apple"},
-    {{0xE8, 0x04, 0x0B}, "Apple"},
-    {{0xE8, 0x06, 0x88}, "Apple"},
-    {{0xE8, 0x80, 0x2E}, "Apple"},
-    {{0xE8, 0x8D, 0x28}, "Apple"},
-    {{0xEC, 0x35, 0x86}, "Apple"},
-    {{0xEC, 0x85, 0x2F}, "Apple"},
-    {{0xF0, 0x18, 0x98}, "Apple"},
-    {{0xF0, 0x24, 0x75}, "Apple"},
-    {{0xF0, 0x79, 0x59}, "Apple"},
-    {{0xF0, 0x99, 0xB6}, "Apple"},
-    {{0xF0, 0x99, 0xBF}, "Apple"},
-    {{0xF0, 0xB0, 0x14}, "Apple"},
-    {{0xF0, 0xC1, 0xF1}, "Apple"},
-    {{0xF0, 0xCB, 0xA1}, "Apple"},
-    {{0xF0, 0xD1, 0xA9}, "Apple"},
-    {{0xF0, 0xDB, 0xE2}, "Apple"},
-    {{0xF0, 0xDC, 0xE2}, "Apple"},
-    {{0xF0, 0xF6, 0x1C}, "Apple"},
-    {{0xF4, 0x1B, 0xA1}, "Apple"},
-    {{0xF4, 0x31, 0xC3}, "Apple"},
-    {{0xF4, 0x37, 0xB7}, "Apple"},
-    {{0xF4, 0x5C, 0x89}, "Apple"},
-    {{0xF4, 0x5E, 0xAB}, "Apple"},
-    {{0xF4, 0xF1, 0x5A}, "Apple"},
-    {{0xF4, 0xF9, 0x51}, "Apple"},
-    {{0xF8, 0x27, 0x93}, "Apple"},
-    {{0xF8, 0x38, 0x80}, "Apple"},
-    {{0xF8, 0x62, 0xAB}, "Apple"},
-    {{0xFC, 0x25, 0x3F}, "Apple"},
-    {{0xFC, 0xD8, 0x48}, "Apple"},
-    {{0xFC, 0xE9, 0x98}, "Apple"},
-    {{0xFC, 0xFC, 0x48}, "Apple"},
-
-    // Samsung
-    {{0x00, 0x00, 0xF0}, "Samsung"},
-    {{0x00, 0x02, 0x78}, "Samsung"},
-    {{0x00, 0x07, 0xAB}, "Samsung"},
-    {{0x00, 0x09, 0x18}, "Samsung"},
-    {{0x00, 0x0D, 0xAE}, "Samsung"},
-    {{0x00, 0x0D, 0xE5}, "Samsung"},
-    {{0x00, 0x12, 0x47}, "Samsung"},
-    {{0x00, 0x12, 0xFB}, "Samsung"},
-    {{0x00, 0x13, 0x77}, "Samsung"},
-    {{0x00, 0x15, 0x99}, "Samsung"},
-    {{0x00, 0x15, 0xB9}, "Samsung"},
-    {{0x00, 0x16, 0x32}, "Samsung"},
-    {{0x00, 0x16, 0x6B}, "Samsung"},
-    {{0x00, 0x16, 0x6C}, "Samsung"},
-    {{0x00, 0x17, 0xC9}, "Samsung"},
-    {{0x00, 0x17, 0xD5}, "Samsung"},
-    {{0x00, 0x18, 0xAF}, "Samsung"},
-    {{0x00, 0x1A, 0x8A}, "Samsung"},
-    {{0x00, 0x1B, 0x98}, "Samsung"},
-    {{0x00, 0x1C, 0x43}, "Samsung"},
-    {{0x00, 0x1D, 0x25}, "Samsung"},
-    {{0x00, 0x1D, 0xF6}, "Samsung"},
-    {{0x00, 0x1E, 0x7D}, "Samsung"},
-    {{0x00, 0x1E, 0xE1}, "Samsung"},
-    {{0x00, 0x1E, 0xE2}, "Samsung"},
-    {{0x00, 0x1F, 0xCC}, "Samsung"},
-    {{0x00, 0x21, 0x19}, "Samsung"},
-    {{0x00, 0x21, 0x4C}, "Samsung"},
-    {{0x00, 0x21, 0xD1}, "Samsung"},
-    {{0x00, 0x21, 0xD2}, "Samsung"},
-    {{0x00, 0x23, 0x39}, "Samsung"},
-    {{0x00, 0x23, 0x3A}, "Samsung"},
-    {{0x00, 0x23, 0x99}, "Samsung"},
-    {{0x00, 0x23, 0xD6}, "Samsung"},
-    {{0x00, 0x23, 0xD7}, "Samsung"},
-    {{0x00, 0x24, 0x54}, "Samsung"},
-    {{0x00, 0x24, 0x90}, "Samsung"},
-    {{0x00, 0x24, 0x91}, "Samsung"},
-    {{0x00, 0x24, 0xE9}, "Samsung"},
-    {{0x00, 0x25, 0x66}, "Samsung"},
-    {{0x00, 0x25, 0x67}, "Samsung"},
-    {{0x00, 0x26, 0x37}, "Samsung"},
-    {{0x00, 0x26, 0x5D}, "Samsung"},
-    {{0x00, 0x26, 0x5F}, "Samsung"},
-    {{0xA8, 0xF2, 0x74}, "Samsung"},
-    {{0xBC, 0x8C, 0xCD}, "Samsung"},
-    {{0xC4, 0x42, 0x02}, "Samsung"},
-    {{0xC4, 0x73, 0x1E}, "Samsung"},
-    {{0xD0, 0x22, 0xBE}, "Samsung"},
-    {{0xE4, 0x58, 0xB8}, "Samsung"},
-    {{0xF0, 0x5C, 0xD5}, "Samsung"},
-    {{0xF4, 0x7B, 0x5E}, "Samsung"},
-    {{0xFC, 0xA1, 0x3E}, "Samsung"},
-
-    // Google/Android
-    {{0x00, 0x1A, 0x11}, "Google"},
-    {{0x3C, 0x5A, 0xB4}, "Google"},
-    {{0x54, 0x60, 0x09}, "Google"},
-    {{0x94, 0xEB, 0x2C}, "Google"},
-    {{0xF4, 0xF5, 0xD8}, "Google"},
-    {{0xF4, 0xF5, 0xE8}, "Google"},
-
-    // Xiaomi
-    {{0x00, 0x9E, 0xC8}, "Xiaomi"},
-    {{0x04, 0xCF, 0x8C}, "Xiaomi"},
-    {{0x0C, 0x1D, 0xAF}, "Xiaomi"},
-    {{0x10, 0x2A, 0xB3}, "Xiaomi"},
-    {{0x14, 0xF6, 0x5A}, "Xiaomi"},
-    {{0x18, 0x59, 0x36}, "Xiaomi"},
-    {{0x20, 0x34, 0xFB}, "Xiaomi"},
-    {{0x28, 0x6C, 0x07}, "Xiaomi"},
-    {{0x28, 0xE3, 0x1F}, "Xiaomi"},
-    {{0x34, 0x80, 0xB3}, "Xiaomi"},
-    {{0x38, 0xA4, 0xED}, "Xiaomi"},
-    {{0x3C, 0xBD, 0x3E}, "Xiaomi"},
-    {{0x44, 0x23, 0x7C}, "Xiaomi"},
-    {{0x50, 0x64, 0x2B}, "Xiaomi"},
-    {{0x58, 0x44, 0x98}, "Xiaomi"},
-    {{0x64, 0xB4, 0x73}, "Xiaomi"},
-    {{0x64, 0xCC, 0x2E}, "Xiaomi"},
-    {{0x68, 0xDF, 0xDD}, "Xiaomi"},
-    {{0x74, 0x23, 0x44}, "Xiaomi"},
-    {{0x74, 0x51, 0xBA}, "Xiaomi"},
-    {{0x78, 0x02, 0xF8}, "Xiaomi"},
-    {{0x78, 0x11, 0xDC}, "Xiaomi"},
-    {{0x7C, 0x1D, 0xD9}, "Xiaomi"},
-    {{0x84, 0x09, 0x3F}, "Xiaomi"},
-    {{0x8C, 0xBE, 0xBE}, "Xiaomi"},
-    {{0x98, 0xFA, 0xE3}, "Xiaomi"},
-    {{0x9C, 0x99, 0xA0}, "Xiaomi"},
-    {{0xA0, 0x86, 0xC6}, "Xiaomi"},
-    {{0xAC, 0xC1, 0xEE}, "Xiaomi"},
-    {{0xAC, 0xF7, 0xF3}, "Xiaomi"},
-    {{0xB0, 0xE2, 0x35}, "Xiaomi"},
-    {{0xC4, 0x0B, 0xCB}, "Xiaomi"},
-    {{0xC8, 0xD7, 0x19}, "Xiaomi"},
-    {{0xD4, 0x97, 0x0B}, "Xiaomi"},
-    {{0xE4, 0x46, 0xDA}, "Xiaomi"},
-    {{0xEC, 0xD0, 0x9F}, "Xiaomi"},
-    {{0xF0, 0xB4, 0x29}, "Xiaomi"},
-    {{0xF4, 0x8B, 0x32}, "Xiaomi"},
-    {{0xF8, 0xA4, 0x5F}, "Xiaomi"},
-    {{0xFC, 0x64, 0xBA}, "Xiaomi"},
-
-    // Huawei
-    {{0x00, 0x18, 0x82}, "Huawei"},
-    {{0x00, 0x1E, 0x10}, "Huawei"},
-    {{0x00, 0x25, 0x68}, "Huawei"},
-    {{0x00, 0x25, 0x9E}, "Huawei"},
-    {{0x00, 0x34, 0xFE}, "Huawei"},
-    {{0x00, 0x46, 0x4B}, "Huawei"},
-    {{0x00, 0x5A, 0x13}, "Huawei"},
-    {{0x00, 0x66, 0x4B}, "Huawei"},
-    {{0x00, 0x9A, 0xCD}, "Huawei"},
-    {{0x00, 0xE0, 0xFC}, "Huawei"},
-    {{0x00, 0xF8, 0x1C}, "Huawei"},
-    {{0x04, 0x02, 0x1F}, "Huawei"},
-    {{0x04, 0xB0, 0xE7}, "Huawei"},
-    {{0x04, 0xC0, 0x6F}, "Huawei"},
-    {{0x04, 0xF9, 0x38}, "Huawei"},
-    {{0x08, 0x19, 0xA6}, "Huawei"},
-    {{0x08, 0x63, 0x61}, "Huawei"},
-    {{0x08, 0x7A, 0x4C}, "Huawei"},
-    {{0x08, 0xE8, 0x4F}, "Huawei"},
-    {{0x0C, 0x37, 0xDC}, "Huawei"},
-    {{0x0C, 0x45, 0xBA}, "Huawei"},
-    {{0x0C, 0x96, 0xBF}, "Huawei"},
-    {{0x10, 0x1B, 0x54}, "Huawei"},
-    {{0x10, 0x44, 0x7F}, "Huawei"},
-    {{0x10, 0x47, 0x80}, "Huawei"},
-
-    // Intel
-    {{0x00, 0x02, 0xB3}, "Intel"},
-    {{0x00, 0x03, 0x47}, "Intel"},
-    {{0x00, 0x04, 0x23}, "Intel"},
-    {{0x00, 0x07, 0xE9}, "Intel"},
-    {{0x00, 0x0C, 0xF1}, "Intel"},
-    {{0x00, 0x0E, 0x0C}, "Intel"},
-    {{0x00, 0x0E, 0x35}, "Intel"},
-    {{0x00, 0x11, 0x11}, "Intel"},
-    {{0x00, 0x12, 0xF0}, "Intel"},
-    {{0x00, 0x13, 0x02}, "Intel"},
-    {{0x00, 0x13, 0x20}, "Intel"},
-    {{0x00, 0x13, 0xCE}, "Intel"},
-    {{0x00, 0x13, 0xE8}, "Intel"},
-    {{0x00, 0x15, 0x00}, "Intel"},
-    {{0x00, 0x15, 0x17}, "Intel"},
-    {{0x00, 0x16, 0x6F}, "Intel"},
-    {{0x00, 0x16, 0x76}, "Intel"},
-    {{0x00, 0x16, 0xEA}, "Intel"},
-    {{0x00, 0x16, 0xEB}, "Intel"},
-    {{0x00, 0x18, 0xDE}, "Intel"},
-    {{0x00, 0x19, 0xD1}, "Intel"},
-    {{0x00, 0x19, 0xD2}, "Intel"},
-    {{0x00, 0x1A, 0x4D}, "Intel"},
-    {{0x00, 0x1B, 0x21}, "Intel"},
-    {{0x00, 0x1B, 0x77}, "Intel"},
-    {{0x00, 0x1C, 0xBF}, "Intel"},
-    {{0x00, 0x1D, 0xE0}, "Intel"},
-    {{0x00, 0x1D, 0xE1}, "Intel"},
-    {{0x00, 0x1E, 0x64}, "Intel"},
-    {{0x00, 0x1E, 0x65}, "Intel"},
-    {{0x00, 0x1E, 0x67}, "Intel"},
-    {{0x00, 0x1F, 0x3B}, "Intel"},
-    {{0x00, 0x1F, 0x3C}, "Intel"},
-    {{0x00, 0x20, 0xE0}, "Intel"},
-    {{0x00, 0x21, 0x5C}, "Intel"},
-    {{0x00, 0x21, 0x5D}, "Intel"},
-    {{0x00, 0x21, 0x6A}, "Intel"},
-    {{0x00, 0x21, 0x6B}, "Intel"},
-    {{0x00, 0x22, 0xFA}, "Intel"},
-    {{0x00, 0x22, 0xFB}, "Intel"},
-    {{0x00, 0x24, 0xD6}, "Intel"},
-    {{0x00, 0x24, 0xD7}, "Intel"},
-    {{0x00, 0x26, 0xC6}, "Intel"},
-    {{0x00, 0x26, 0xC7}, "Intel"},
-    {{0x00, 0x27, 0x10}, "Intel"},
-
-    // Dell
-    {{0x00, 0x06, 0x5B}, "Dell"},
-    {{0x00, 0x08, 0x74}, "Dell"},
-    {{0x00, 0x0B, 0xDB}, "Dell"},
-    {{0x00, 0x0D, 0x56}, "Dell"},
-    {{0x00, 0x0F, 0x1F}, "Dell"},
-    {{0x00, 0x11, 0x43}, "Dell"},
-    {{0x00, 0x12, 0x3F}, "Dell"},
-    {{0x00, 0x13, 0x72}, "Dell"},
-    {{0x00, 0x14, 0x22}, "Dell"},
-    {{0x00, 0x15, 0xC5}, "Dell"},
-    {{0x00, 0x16, 0xF0}, "Dell"},
-    {{0x00, 0x18, 0x8B}, "Dell"},
-    {{0x00, 0x19, 0xB9}, "Dell"},
-    {{0x00, 0x1A, 0xA0}, "Dell"},
-    {{0x00, 0x1C, 0x23}, "Dell"},
-    {{0x00, 0x1D, 0x09}, "Dell"},
-    {{0x00, 0x1E, 0x4F}, "Dell"},
-    {{0x00, 0x1E, 0xC9}, "Dell"},
-    {{0x00, 0x21, 0x70}, "Dell"},
-    {{0x00, 0x21, 0x9B}, "Dell"},
-    {{0x00, 0x22, 0x19}, "Dell"},
-    {{0x00, 0x23, 0xAE}, "Dell"},
-    {{0x00, 0x24, 0xE8}, "Dell"},
-    {{0x00, 0x25, 0x64}, "Dell"},
-    {{0x00, 0x26, 0xB9}, "Dell"},
-
-    // HP
-    {{0x00, 0x01, 0xE6}, "HP"},
-    {{0x00, 0x01, 0xE7}, "HP"},
-    {{0x00, 0x02, 0xA5}, "HP"},
-    {{0x00, 0x04, 0xEA}, "HP"},
-    {{0x00, 0x08, 0x02}, "HP"},
-    {{0x00, 0x08, 0x83}, "HP"},
-    {{0x00, 0x0A, 0x57}, "HP"},
-    {{0x00, 0x0B, 0xCD}, "HP"},
-    {{0x00, 0x0D, 0x9D}, "HP"},
-    {{0x00, 0x0E, 0x7F}, "HP"},
-    {{0x00, 0x0F, 0x20}, "HP"},
-    {{0x00, 0x0F, 0x61}, "HP"},
-    {{0x00, 0x10, 0x83}, "HP"},
-    {{0x00, 0x10, 0xE3}, "HP"},
-    {{0x00, 0x11, 0x0A}, "HP"},
-    {{0x00, 0x11, 0x85}, "HP"},
-    {{0x00, 0x12, 0x79}, "HP"},
-    {{0x00, 0x13, 0x21}, "HP"},
-    {{0x00, 0x14, 0x38}, "HP"},
-    {{0x00, 0x14, 0xC2}, "HP"},
-    {{0x00, 0x15, 0x60}, "HP"},
-    {{0x00, 0x16, 0x35}, "HP"},
-    {{0x00, 0x17, 0x08}, "HP"},
-    {{0x00, 0x17, 0xA4}, "HP"},
-    {{0x00, 0x18, 0x71}, "HP"},
-    {{0x00, 0x18, 0xFE}, "HP"},
-    {{0x00, 0x19, 0xBB}, "HP"},
-    {{0x00, 0x1A, 0x4B}, "HP"},
-    {{0x00, 0x1B, 0x78}, "HP"},
-    {{0x00, 0x1C, 0xC4}, "HP"},
-    {{0x00, 0x1D, 0xB3}, "HP"},
-    {{0x00, 0x1E, 0x0B}, "HP"},
-    {{0x00, 0x1F, 0x29}, "HP"},
-    {{0x00, 0x21, 0x5A}, "HP"},
-    {{0x00, 0x22, 0x64}, "HP"},
-    {{0x00, 0x23, 0x7D}, "HP"},
-    {{0x00, 0x24, 0x81}, "HP"},
-    {{0x00, 0x25, 0xB3}, "HP"},
-    {{0x00, 0x26, 0x55}, "HP"},
-
-    // Microsoft
-    {{0x00, 0x03, 0xFF}, "Microsoft"},
-    {{0x00, 0x0D, 0x3A}, "Microsoft"},
-    {{0x00, 0x12, 0x5A}, "Microsoft"},
-    {{0x00, 0x15, 0x5D}, "Microsoft"},
-    {{0x00, 0x17, 0xFA}, "Microsoft"},
-    {{0x00, 0x1D, 0xD8}, "Microsoft"},
-    {{0x00, 0x22, 0x48}, "Microsoft"},
-    {{0x00, 0x25, 0xAE}, "Microsoft"},
-    {{0x00, 0x50, 0xF2}, "Microsoft"},
-    {{0x28, 0x18, 0x78}, "Microsoft"},
-    {{0x30, 0x59, 0xB7}, "Microsoft"},
-    {{0x50, 0x1A, 0xC5}, "Microsoft"},
-    {{0x60, 0x45, 0xBD}, "Microsoft"},
-    {{0x7C, 0x1E, 0x52}, "Microsoft"},
-    {{0x7C, 0xED, 0x8D}, "Microsoft"},
-    {{0xC8, 0x3F, 0x26}, "Microsoft"},
-    {{0xDC, 0xB4, 0xC4}, "Microsoft"},
-
-    // Amazon
-    {{0x00, 0x71, 0x47}, "Amazon"},
-    {{0x00, 0xFC, 0x8B}, "Amazon"},
-    {{0x04, 0x4E, 0x5A}, "Amazon"},
-    {{0x0C, 0x47, 0xC9}, "Amazon"},
-    {{0x10, 0xCE, 0xA9}, "Amazon"},
-    {{0x18, 0x74, 0x2E}, "Amazon"},
-    {{0x34, 0xD2, 0x70}, "Amazon"},
-    {{0x40, 0xB4, 0xCD}, "Amazon"},
-    {{0x44, 0x65, 0x0D}, "Amazon"},
-    {{0x50, 0xDC, 0xE7}, "Amazon"},
-    {{0x50, 0xF5, 0xDA}, "Amazon"},
-    {{0x68, 0x37, 0xE9}, "Amazon"},
-    {{0x68, 0x54, 0xFD}, "Amazon"},
-    {{0x74, 0x75, 0x48}, "Amazon"},
-    {{0x74, 0xC2, 0x46}, "Amazon"},
-    {{0x78, 0xE1, 0x03}, "Amazon"},
-    {{0x84, 0xD6, 0xD0}, "Amazon"},
-    {{0xA0, 0x02, 0xDC}, "Amazon"},
-    {{0xAC, 0x63, 0xBE}, "Amazon"},
-    {{0xB4, 0x7C, 0x9C}, "Amazon"},
-    {{0xF0, 0x27, 0x2D}, "Amazon"},
-    {{0xF0, 0x81, 0x75}, "Amazon"},
-    {{0xFC, 0x65, 0xDE}, "Amazon"},
-    {{0xFC, 0xA1, 0x83}, "Amazon"},
-
-    // TP-Link
-    {{0x00, 0x27, 0x19}, "TP-Link"},
-    {{0x14, 0xCC, 0x20}, "TP-Link"},
-    {{0x14, 0xCF, 0x92}, "TP-Link"},
-    {{0x18, 0xA6, 0xF7}, "TP-Link"},
-    {{0x1C, 0x3B, 0xF3}, "TP-Link"},
-    {{0x24, 0x69, 0x68}, "TP-Link"},
-    {{0x30, 0xB5, 0xC2}, "TP-Link"},
-    {{0x50, 0xC7, 0xBF}, "TP-Link"},
-    {{0x54, 0xC8, 0x0F}, "TP-Link"},
-    {{0x5C, 0x89, 0x9A}, "TP-Link"},
-    {{0x60, 0xE3, 0x27}, "TP-Link"},
-    {{0x64, 0x56, 0x01}, "TP-Link"},
-    {{0x64, 0x70, 0x02}, "TP-Link"},
-    {{0x6C, 0xB0, 0xCE}, "TP-Link"},
-    {{0x78, 0x8C, 0xB5}, "TP-Link"},
-    {{0x98, 0xDE, 0xD0}, "TP-Link"},
-    {{0xA0, 0xF3, 0xC1}, "TP-Link"},
-    {{0xAC, 0x84, 0xC6}, "TP-Link"},
-    {{0xB0, 0x4E, 0x26}, "TP-Link"},
-    {{0xB0, 0x95, 0x8E}, "TP-Link"},
-    {{0xC0, 0x25, 0xE9}, "TP-Link"},
-    {{0xC0, 0x4A, 0x00}, "TP-Link"},
-    {{0xD4, 0x6E, 0x0E}, "TP-Link"},
-    {{0xD8, 0x07, 0xB6}, "TP-Link"},
-    {{0xEC, 0x08, 0x6B}, "TP-Link"},
-    {{0xEC, 0x17, 0x2F}, "TP-Link"},
-    {{0xF4, 0xF2, 0x6D}, "TP-Link"},
-    {{0xF8, 0x1A, 0x67}, "TP-Link"},
-
-    // Espressif (ESP32/ESP8266)
-    {{0x08, 0x3A, 0xF2}, "Espressif"},
-    {{0x10, 0x52, 0x1C}, "Espressif"},
-    {{0x18, 0xFE, 0x34}, "Espressif"},
-    {{0x24, 0x0A, 0xC4}, "Espressif"},
-    {{0x24, 0x62, 0xAB}, "Espressif"},
-    {{0x24, 0x6F, 0x28}, "Espressif"},
-    {{0x24, 0xB2, 0xDE}, "Espressif"},
-    {{0x2C, 0x3A, 0xE8}, "Espressif"},
-    {{0x30, 0xAE, 0xA4}, "Espressif"},
-    {{0x3C, 0x61, 0x05}, "Espressif"},
-    {{0x3C, 0x71, 0xBF}, "Espressif"},
-    {{0x40, 0xF5, 0x20}, "Espressif"},
-    {{0x48, 0x3F, 0xDA}, "Espressif"},
-    {{0x4C, 0x11, 0xAE}, "Espressif"},
-    {{0x4C, 0x75, 0x25}, "Espressif"},
-    {{0x54, 0x43, 0xB2}, "Espressif"},
-    {{0x54, 0x5A, 0xA6}, "Espressif"},
-    {{0x58, 0xBF, 0x25}, "Espressif"},
-    {{0x5C, 0xCF, 0x7F}, "Espressif"},
-    {{0x60, 0x01, 0x94}, "Espressif"},
-    {{0x68, 0xC6, 0x3A}, "Espressif"},
-    {{0x70, 0x03, 0x9F}, "Espressif"},
-    {{0x7C, 0x9E, 0xBD}, "Espressif"},
-    {{0x7C, 0xDF, 0xA1}, "Espressif"},
-    {{0x80, 0x7D, 0x3A}, "Espressif"},
-    {{0x84, 0x0D, 0x8E}, "Espressif"},
-    {{0x84, 0xCC, 0xA8}, "Espressif"},
-    {{0x84, 0xF3, 0xEB}, "Espressif"},
-    {{0x8C, 0xAA, 0xB5}, "Espressif"},
-    {{0x90, 0x97, 0xD5}, "Espressif"},
-    {{0x94, 0xB5, 0x55}, "Espressif"},
-    {{0x94, 0xB9, 0x7E}, "Espressif"},
-    {{0x98, 0xCD, 0xAC}, "Espressif"},
-    {{0x98, 0xF4, 0xAB}, "Espressif"},
-    {{0xA0, 0x20, 0xA6}, "Espressif"},
-    {{0xA4, 0x7B, 0x9D}, "Espressif"},
-    {{0xA4, 0xCF, 0x12}, "Espressif"},
-    {{0xAC, 0x67, 0xB2}, "Espressif"},
-    {{0xAC, 0xD0, 0x74}, "Espressif"},
-    {{0xB4, 0xE6, 0x2D}, "Espressif"},
-    {{0xB8, 0xF0, 0x09}, "Espressif"},
-    {{0xBC, 0xDD, 0xC2}, "Espressif"},
-    {{0xBC, 0xFF, 0x4D}, "Espressif"},
-    {{0xC4, 0x4F, 0x33}, "Espressif"},
-    {{0xC4, 0x5B, 0xBE}, "Espressif"},
-    {{0xC8, 0x2B, 0x96}, "Espressif"},
-    {{0xCC, 0x50, 0xE3}, "Espressif"},
-    {{0xD8, 0xA0, 0x1D}, "Espressif"},
-    {{0xD8, 0xBF, 0xC0}, "Espressif"},
-    {{0xDC, 0x4F, 0x22}, "Espressif"},
-    {{0xE0, 0x98, 0x06}, "Espressif"},
-    {{0xE8, 0xDB, 0x84}, "Espressif"},
-    {{0xEC, 0xFA, 0xBC}, "Espressif"},
-    {{0xF0, 0x08, 0xD1}, "Espressif"},
-    {{0xF4, 0xCF, 0xA2}, "Espressif"},
-    {{0xFC, 0xF5, 0xC4}, "Espressif"},
-
-    // Raspberry Pi
-    {{0xB8, 0x27, 0xEB}, "Raspberry Pi"},
-    {{0xDC, 0xA6, 0x32}, "Raspberry Pi"},
-    {{0xE4, 0x5F, 0x01}, "Raspberry Pi"},
-
-    // Realtek (common in USB WiFi adapters)
-    {{0x00, 0xE0, 0x4C}, "Realtek"},
-
-    // End marker
-    {{0x00, 0x00, 0x00}, nullptr}
-};
-
-OUILookup::OUILookup() : _onlineEnabled(false), _lastOnlineCheck(0), _hasPendingLookup(false) {
-    memset(_pendingMAC, 0, 6);
+// Packed prefix tables, generated by tools/gen_oui.py
+#include "oui_data.h"
+
+static const char* vendorName(uint16_t index) {
+    return OUI_POOL + OUI_VENDOR_OFFSET[index];
+}
+
+// Binary search over sorted, fixed-width big-endian keys
+static int findPrefix(const uint8_t* table, size_t count, size_t width, const uint8_t* key) {
+    size_t lo = 0, hi = count;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        int cmp = memcmp(table + mid * width, key, width);
+        if (cmp == 0) {
+            return (int)mid;
+        }
+        if (cmp < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return -1;
+}
+
+OUILookup::OUILookup() :
+    _onlineEnabled(false),
+    _callback(nullptr),
+    _requests(NULL),
+    _results(NULL),
+    _task(NULL),
+    _pendingCount(0),
+    _missNext(0),
+    _urlLock(portMUX_INITIALIZER_UNLOCKED),
+    _urlGeneration(0),
+    _resolver(nullptr),
+    _resolverGeneration(0),
+    _cacheCount(0),
+    _lastRequest(0),
+    _uplinkDown(false),
+    _resolved(0),
+    _failed(0) {
+    memset(_misses, 0, sizeof(_misses));
+    _url[0] = '\0';
+}
+
+bool OUILookup::begin() {
+    bool enabled;
+    String url;
+    storage.loadOUISettings(enabled, url, OUI_ONLINE_DEFAULT, OUI_RESOLVER_URL);
+    setOnline(enabled, url);
+
+    _requests = xQueueCreate(OUI_QUEUE_SIZE, sizeof(Request));
+    _results = xQueueCreate(OUI_QUEUE_SIZE, sizeof(Result));
+    if (!_requests || !_results) {
+        DEBUG_PRINTLN("OUI: Failed to create lookup queues");
+        return false;
+    }
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        taskFunc,
+        "oui_lookup",
+        OUI_TASK_STACK_SIZE,
+        this,
+        OUI_TASK_PRIORITY,
+        &_task,
+        0  // Core 0, away from the main loop
+    );
+    if (result != pdPASS) {
+        DEBUG_PRINTLN("OUI: Failed to create lookup task");
+        return false;
+    }
+
+    DEBUG_PRINTF("OUI: Online lookups %s (%s)\n", enabled ? "on" : "off", url.c_str());
+    return true;
 }
 
-String OUILookup::lookupVendor(const uint8_t* mac) {
+const char* OUILookup::lookupVendor(const uint8_t* mac) {
     return lookupLocal(mac);
 }
 
-String OUILookup::lookupVendor(const String& macStr) {
+const char* OUILookup::lookupVendor(const String& macStr) {
     uint8_t mac[6];
     String clean = macStr;
     clean.replace(":", "");
     clean.replace("-", "");
 
     if (clean.length() != 12) {
-        return "";
+        return nullptr;
     }
 
     for (int i = 0; i < 6; i++) {
@@ -713,27 +103,208 @@ String OUILookup::lookupVendor(const String& macStr) {
     return lookupVendor(mac);
 }
 
-String OUILookup::lookupLocal(const uint8_t* mac) {
-    // Search through the OUI database
-    for (int i = 0; ouiDatabase[i].vendor != nullptr; i++) {
-        if (mac[0] == ouiDatabase[i].prefix[0] &&
-            mac[1] == ouiDatabase[i].prefix[1] &&
-            mac[2] == ouiDatabase[i].prefix[2]) {
-            return String(ouiDatabase[i].vendor);
+const char* OUILookup::lookupLocal(const uint8_t* mac) {
+    // Longest prefix first: MA-S (36 bits), MA-M (28 bits), then MA-L
+    uint8_t key[5] = { mac[0], mac[1], mac[2], mac[3], (uint8_t)(mac[4] & 0xF0) };
+    int i = findPrefix(&OUI_S_PREFIX[0][0], OUI_S_COUNT, 5, key);
+    if (i >= 0) {
+        return vendorName(OUI_S_VENDOR[i]);
+    }
+    key[3] &= 0xF0;
+    i = findPrefix(&OUI_M_PREFIX[0][0], OUI_M_COUNT, 4, key);
+    if (i >= 0) {
+        return vendorName(OUI_M_VENDOR[i]);
+    }
+
+    // MA-L rows starting with mac[0], searched on the next two bytes
+    uint16_t low = ((uint16_t)mac[1] << 8) | mac[2];
+    uint32_t lo = OUI_L_INDEX[mac[0]];
+    uint32_t hi = OUI_L_INDEX[mac[0] + 1];
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (OUI_L_LOW[mid] == low) {
+            return vendorName(OUI_L_VENDOR[mid]);
+        }
+        if (OUI_L_LOW[mid] < low) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
     }
-    return "";
+    return nullptr;
 }
 
-void OUILookup::lookupOnline(const uint8_t* mac) {
-    // Online lookup not implemented (would require HTTP client)
-    // Could be added later using macvendors.com API
-}
+void OUILookup::resolveAsync(const uint8_t* mac) {
+    if (!_onlineEnabled || !_requests) {
+        return;
+    }
+    // Locally administered (random) addresses have no vendor
+    if ((mac[0] & 0x02) || isPending(mac) || isMiss(mac) || _pendingCount >= OUI_QUEUE_SIZE) {
+        return;
+    }
 
-void OUILookup::getOUIPrefix(const uint8_t* mac, char* prefix, size_t len) {
-    snprintf(prefix, len, "%02X:%02X:%02X", mac[0], mac[1], mac[2]);
+    Request req;
+    memcpy(req.oui, mac, 3);
+    if (xQueueSend(_requests, &req, 0) == pdTRUE) {
+        memcpy(_pending[_pendingCount++], mac, 3);
+    }
 }
 
 void OUILookup::update() {
-    // Process any pending online lookups (not implemented)
+    if (!_results) {
+        return;
+    }
+    Result res;
+    while (xQueueReceive(_results, &res, 0) == pdTRUE) {
+        removePending(res.oui);
+        if (!res.found) {
+            memcpy(_misses[_missNext], res.oui, 3);
+            _missNext = (_missNext + 1) % OUI_MISS_CACHE_SIZE;
+            continue;
+        }
+        if (_callback) {
+            _callback(res.oui, res.vendor);
+        }
+    }
+}
+
+bool OUILookup::setOnline(bool enabled, const String& url) {
+    if (url.length() >= OUI_URL_MAX_LEN) {
+        return false;
+    }
+    if (url.length() > 0 && !url.startsWith("file:") &&
+        !url.startsWith("http://") && !url.startsWith("https://")) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&_urlLock);
+    strncpy(_url, url.c_str(), OUI_URL_MAX_LEN - 1);
+    _url[OUI_URL_MAX_LEN - 1] = '\0';
+    _urlGeneration++;
+    portEXIT_CRITICAL(&_urlLock);
+
+    _onlineEnabled = enabled && url.length() > 0;
+    memset(_misses, 0, sizeof(_misses));  // A new backend may know them
+    storage.saveOUISettings(enabled, url);
+    return true;
+}
+
+String OUILookup::getResolverURL() {
+    char url[OUI_URL_MAX_LEN];
+    portENTER_CRITICAL(&_urlLock);
+    memcpy(url, _url, sizeof(url));
+    portEXIT_CRITICAL(&_urlLock);
+    return String(url);
+}
+
+bool OUILookup::isPending(const uint8_t* oui) const {
+    for (uint8_t i = 0; i < _pendingCount; i++) {
+        if (memcmp(_pending[i], oui, 3) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool OUILookup::isMiss(const uint8_t* oui) const {
+    for (uint8_t i = 0; i < OUI_MISS_CACHE_SIZE; i++) {
+        if (memcmp(_misses[i], oui, 3) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void OUILookup::removePending(const uint8_t* oui) {
+    for (uint8_t i = 0; i < _pendingCount; i++) {
+        if (memcmp(_pending[i], oui, 3) == 0) {
+            memcpy(_pending[i], _pending[--_pendingCount], 3);
+            return;
+        }
+    }
+}
+
+// Runs on core 0 as a separate FreeRTOS task
+void OUILookup::taskFunc(void* param) {
+    OUILookup* self = (OUILookup*)param;
+    self->_cache.begin(NVS_NAMESPACE_OUI, false);
+    self->_cacheCount = self->_cache.getUShort("n", 0);
+
+    for (;;) {
+        Request req;
+        if (xQueueReceive(self->_requests, &req, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        Result res;
+        self->resolve(req, res);
+        if (res.found) {
+            self->_resolved++;
+        } else {
+            self->_failed++;
+        }
+        xQueueSend(self->_results, &res, portMAX_DELAY);
+    }
+}
+
+void OUILookup::resolve(const Request& req, Result& res) {
+    memcpy(res.oui, req.oui, 3);
+    res.found = false;
+    res.vendor[0] = '\0';
+
+    char key[7];
+    snprintf(key, sizeof(key), "%02X%02X%02X", req.oui[0], req.oui[1], req.oui[2]);
+    if (_cache.getString(key, res.vendor, sizeof(res.vendor)) > 0 && res.vendor[0] != '\0') {
+        res.found = true;
+        return;
+    }
+
+    // (Re)build the backend if the URL changed
+    if (_urlGeneration != _resolverGeneration) {
+        char url[OUI_URL_MAX_LEN];
+        portENTER_CRITICAL(&_urlLock);
+        memcpy(url, _url, sizeof(url));
+        _resolverGeneration = _urlGeneration;
+        portEXIT_CRITICAL(&_urlLock);
+        delete _resolver;
+        _resolver = createOUIResolver(String(url));
+    }
+    if (!_resolver || !_onlineEnabled) {
+        return;
+    }
+
+    if (_resolver->usesNetwork()) {
+        // Hold the request a while for the uplink (e.g. right after boot).
+        // In AP-only mode it times out as a miss, and later requests miss
+        // straight away until the uplink is back, so the queue keeps moving.
+        uint32_t waitStart = millis();
+        while (WiFi.status() != WL_CONNECTED) {
+            if (_uplinkDown || millis() - waitStart >= OUI_UPLINK_WAIT_MS) {
+                _uplinkDown = true;
+                return;
+            }
+            vTaskDelay(pdMS_TO_TICKS(1000));
+        }
+        _uplinkDown = false;
+
+        // Public APIs allow about one request per second
+        uint32_t since = millis() - _lastRequest;
+        if (since < OUI_REQUEST_INTERVAL_MS) {
+            vTaskDelay(pdMS_TO_TICKS(OUI_REQUEST_INTERVAL_MS - since));
+        }
+    }
+    res.found = _resolver->resolve(req.oui, res.vendor, sizeof(res.vendor));
+    _lastRequest = millis();
+    if (!res.found) {
+        return;
+    }
+
+    // Bounded cache: when full it starts over
+    if (_cacheCount >= OUI_CACHE_MAX) {
+        _cache.clear();
+        _cacheCount = 0;
+    }
+    if (_cache.putString(key, res.vendor) > 0) {
+        _cache.putUShort("n", ++_cacheCount);
+    }
+    DEBUG_PRINTF("OUI: %s -> %s\n", key, res.vendor);
 }
@@ -2,52 +2,111 @@
 #define OUI_LOOKUP_H
 
 #include <Arduino.h>
+#include <Preferences.h>
 #include <stdint.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include "config.h"
+#include "oui_resolver.h"
 
 // Maximum length of vendor name
 #define OUI_NAME_MAX_LEN 32
 
-// OUI (Organizationally Unique Identifier) entry structure
-struct OUIEntry {
-    uint8_t prefix[3];      // First 3 bytes of MAC address
-    const char* vendor;     // Vendor name
-};
+// Called from update() for every finished online lookup that found a vendor
+typedef void (*VendorCallback)(const uint8_t* oui, const char* vendor);
 
-// OUI Lookup class - provides vendor identification from MAC addresses
+// OUI Lookup class - provides vendor identification from MAC addresses.
+//
+// The vendor table (oui_data.h) is generated by tools/gen_oui.py from the
+// IEEE MA-L/MA-M/MA-S registries: sorted prefixes with 16-bit vendor indexes
+// into a pool where each name is stored once. MA-L rows are bucketed by the
+// first prefix byte and binary searched on the next two; MA-S (36-bit) and
+// MA-M (28-bit) blocks are tried first, so the longest prefix wins.
+//
+// Prefixes not in the table can be resolved online: requests go through a
+// queue to a low-priority task that checks an NVS cache, then asks the
+// configured OUIResolver (rate limited) and caches what it finds.
 class OUILookup {
 public:
     OUILookup();
 
+    // Load the online settings and start the resolver task
+    bool begin();
+
     // Look up vendor from MAC address
-    // Returns vendor name if found, empty string if not found
-    String lookupVendor(const uint8_t* mac);
+    // Returns the vendor name (in flash, never freed) or nullptr if unknown
+    const char* lookupVendor(const uint8_t* mac);
 
     // Look up vendor from MAC address string
-    String lookupVendor(const String& macStr);
-
-    // Check if online lookup is available
-    bool isOnlineAvailable() const { return _onlineEnabled; }
+    const char* lookupVendor(const String& macStr);
 
-    // Enable/disable online lookups
-    void setOnlineEnabled(bool enabled) { _onlineEnabled = enabled; }
+    // Queue an online lookup for a prefix the table does not know. Never
+    // blocks: repeats of a queued or recently failed prefix are ignored, and
+    // the request is dropped if the queue is full. Main loop only.
+    void resolveAsync(const uint8_t* mac);
 
-    // Process online lookup results (call in loop)
+    // Hand finished lookups to the callback (call in loop, under dataMutex)
     void update();
+    void onResolved(VendorCallback callback) { _callback = callback; }
+
+    // Online lookups through an OUIResolver picked by URL scheme
+    // (http(s) template with %s, or file:/path on LittleFS); persisted
+    bool setOnline(bool enabled, const String& url);
+    bool isOnlineEnabled() const { return _onlineEnabled; }
+    String getResolverURL();
+
+    uint32_t getResolvedCount() const { return _resolved; }
+    uint32_t getFailedCount() const { return _failed; }
 
 private:
-    bool _onlineEnabled;
-    unsigned long _lastOnlineCheck;
-    uint8_t _pendingMAC[6];
-    bool _hasPendingLookup;
+    struct Request {
+        uint8_t oui[3];
+    };
+    struct Result {
+        uint8_t oui[3];
+        bool found;
+        char vendor[OUI_NAME_MAX_LEN];
+    };
+
+    volatile bool _onlineEnabled;
+    VendorCallback _callback;
+    QueueHandle_t _requests;  // Main loop -> task
+    QueueHandle_t _results;   // Task -> main loop
+    TaskHandle_t _task;
+
+    // Main loop only: prefixes in flight and recent misses (dedup)
+    uint8_t _pending[OUI_QUEUE_SIZE][3];
+    uint8_t _pendingCount;
+    uint8_t _misses[OUI_MISS_CACHE_SIZE][3];
+    uint8_t _missNext;
+
+    // Resolver URL; the task rebuilds its backend when the generation changes
+    portMUX_TYPE _urlLock;
+    char _url[OUI_URL_MAX_LEN];
+    volatile uint32_t _urlGeneration;
+
+    // Task only
+    OUIResolver* _resolver;
+    uint32_t _resolverGeneration;
+    Preferences _cache;  // NVS_NAMESPACE_OUI: "AABBCC" -> vendor
+    uint16_t _cacheCount;
+    uint32_t _lastRequest;
+    bool _uplinkDown;  // Last wait for the uplink timed out
+
+    volatile uint32_t _resolved;
+    volatile uint32_t _failed;
 
     // Local OUI database lookup
-    String lookupLocal(const uint8_t* mac);
+    const char* lookupLocal(const uint8_t* mac);
 
-    // Online API lookup (macvendors.com or similar)
-    void lookupOnline(const uint8_t* mac);
+    bool isPending(const uint8_t* oui) const;
+    bool isMiss(const uint8_t* oui) const;
+    void removePending(const uint8_t* oui);
 
-    // Extract OUI prefix from MAC address
-    void getOUIPrefix(const uint8_t* mac, char* prefix, size_t len);
+    // Task side
+    void resolve(const Request& req, Result& res);
+    static void taskFunc(void* param);
 };
 
 extern OUILookup ouiLookup;
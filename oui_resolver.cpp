@@ -0,0 +1,100 @@
+#include "oui_resolver.h"
+#include "config.h"
+#include <WiFiClient.h>
+#include <WiFiClientSecure.h>
+#include <HTTPClient.h>
+#include <LittleFS.h>
+
+// Copy a name, dropping surrounding whitespace and quotes
+static bool copyVendor(const char* src, size_t srcLen, char* vendor, size_t len) {
+    while (srcLen > 0 && (isspace((unsigned char)*src) || *src == '"')) {
+        src++;
+        srcLen--;
+    }
+    while (srcLen > 0 && (isspace((unsigned char)src[srcLen - 1]) || src[srcLen - 1] == '"')) {
+        srcLen--;
+    }
+    if (srcLen == 0) {
+        return false;
+    }
+    if (srcLen > len - 1) {
+        srcLen = len - 1;
+    }
+    memcpy(vendor, src, srcLen);
+    vendor[srcLen] = '\0';
+    return true;
+}
+
+bool HttpOUIResolver::resolve(const uint8_t* oui, char* vendor, size_t len) {
+    char prefix[9];
+    snprintf(prefix, sizeof(prefix), "%02X:%02X:%02X", oui[0], oui[1], oui[2]);
+    String url = _url;
+    url.replace("%s", prefix);
+
+    WiFiClient plain;
+    WiFiClientSecure secure;
+    bool https = url.startsWith("https://");
+    if (https) {
+        secure.setInsecure();  // Vendor names are not worth a CA bundle
+    }
+
+    HTTPClient http;
+    http.setConnectTimeout(OUI_HTTP_TIMEOUT_MS);
+    http.setTimeout(OUI_HTTP_TIMEOUT_MS);
+    if (!http.begin(https ? (WiFiClient&)secure : plain, url)) {
+        return false;
+    }
+
+    bool found = false;
+    int code = http.GET();
+    if (code == HTTP_CODE_OK) {
+        String body = http.getString();
+        int eol = body.indexOf('\n');
+        found = copyVendor(body.c_str(), eol < 0 ? body.length() : eol, vendor, len);
+    } else if (code != HTTP_CODE_NOT_FOUND) {
+        DEBUG_PRINTF("OUI: %s returned %d\n", prefix, code);
+    }
+    http.end();
+    return found;
+}
+
+bool FileOUIResolver::resolve(const uint8_t* oui, char* vendor, size_t len) {
+    if (!_mounted) {
+        _mounted = LittleFS.begin(false);
+        if (!_mounted) {
+            DEBUG_PRINTLN("OUI: LittleFS not mounted");
+            return false;
+        }
+    }
+
+    File file = LittleFS.open(_path.c_str(), "r");
+    if (!file) {
+        return false;
+    }
+
+    char want[7];
+    snprintf(want, sizeof(want), "%02X%02X%02X", oui[0], oui[1], oui[2]);
+
+    char line[80];
+    bool found = false;
+    while (file.available()) {
+        size_t n = file.readBytesUntil('\n', line, sizeof(line) - 1);
+        line[n] = '\0';
+        if (n > 7 && strncasecmp(line, want, 6) == 0 && (line[6] == ',' || line[6] == '\t')) {
+            found = copyVendor(line + 7, n - 7, vendor, len);
+            break;
+        }
+    }
+    file.close();
+    return found;
+}
+
+OUIResolver* createOUIResolver(const String& url) {
+    if (url.startsWith("file:")) {
+        return new FileOUIResolver(url.substring(5));
+    }
+    if (url.startsWith("http://") || url.startsWith("https://")) {
+        return new HttpOUIResolver(url);
+    }
+    return nullptr;
+}
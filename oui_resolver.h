@@ -0,0 +1,50 @@
+#ifndef OUI_RESOLVER_H
+#define OUI_RESOLVER_H
+
+#include <Arduino.h>
+
+// Backend that maps a 24-bit OUI to a vendor name for prefixes missing from
+// the built-in table. Called only from the OUI lookup task, so it may block.
+class OUIResolver {
+public:
+    virtual ~OUIResolver() {}
+
+    // Fills vendor (NUL terminated, at most len - 1 chars) and returns true if
+    // the OUI is known; false if it is unknown or the backend is unreachable.
+    virtual bool resolve(const uint8_t* oui, char* vendor, size_t len) = 0;
+
+    // True if resolve() needs the uplink (the task waits for it first and
+    // keeps to the request rate limit)
+    virtual bool usesNetwork() const { return false; }
+};
+
+// HTTP(S) GET of a URL template where "%s" becomes "AA:BB:CC", e.g.
+// https://api.macvendors.com/%s. A 200 response body (first line) is the
+// vendor name, anything else is a miss. Certificates are not verified.
+class HttpOUIResolver : public OUIResolver {
+public:
+    explicit HttpOUIResolver(const String& urlTemplate) : _url(urlTemplate) {}
+    bool resolve(const uint8_t* oui, char* vendor, size_t len) override;
+    bool usesNetwork() const override { return true; }
+
+private:
+    String _url;
+};
+
+// Text file on LittleFS with one "AABBCC<tab or comma>Vendor" line per prefix
+class FileOUIResolver : public OUIResolver {
+public:
+    explicit FileOUIResolver(const String& path) : _path(path), _mounted(false) {}
+    bool resolve(const uint8_t* oui, char* vendor, size_t len) override;
+
+private:
+    String _path;
+    bool _mounted;
+};
+
+// Backend for a resolver URL: "file:/path" or an http(s) template. An http
+// URL can point at a stand-in server, as test/oui_lookup_test.cpp does.
+// Returns nullptr for an empty or unsupported URL.
+OUIResolver* createOUIResolver(const String& url);
+
+#endif // OUI_RESOLVER_H
@@ -0,0 +1,125 @@
+#include "presence.h"
+#include "bandwidth_tracker.h"
+
+PresenceTracker presence;
+
+// millis() timestamp -> uptimeSeconds()
+static uint32_t toUptime(uint32_t ms) {
+    uint32_t ago = (millis() - ms) / 1000;
+    uint32_t up = uptimeSeconds();
+    return ago < up ? up - ago : 0;
+}
+
+PresenceTracker::PresenceTracker() :
+    _head(0),
+    _count(0),
+    _total(0),
+    _online(0) {
+    memset(_sessions, 0, sizeof(_sessions));
+    memset(_baseBytes, 0, sizeof(_baseBytes));
+    memset(_start, 0, sizeof(_start));
+    memset(_source, 0, sizeof(_source));
+}
+
+void PresenceTracker::seen(DeviceId id, PresenceSource source, uint32_t now) {
+    DeviceRegistry& reg = deviceRegistry;
+    if (reg.has(id, DEVICE_ONLINE)) {
+        return;
+    }
+    if (source == PRESENCE_TRAFFIC && reg.presenceSince[id] != 0 &&
+        now - reg.presenceSince[id] < PRESENCE_REJOIN_GUARD_MS) {
+        return;
+    }
+
+    reg.set(id, DEVICE_ONLINE, true);
+    reg.presenceSince[id] = now;
+    _baseBytes[id] = reg.totalBytes(id);
+    _start[id] = toUptime(now);
+    _source[id] = source;
+    _online++;
+
+    const uint8_t* mac = reg.mac[id];
+    DEBUG_PRINTF("Presence: %02X:%02X:%02X:%02X:%02X:%02X online (%s)\n",
+                 mac[0], mac[1], mac[2], mac[3], mac[4], mac[5], sourceName(source));
+}
+
+void PresenceTracker::left(DeviceId id, uint32_t when) {
+    DeviceRegistry& reg = deviceRegistry;
+    if (!reg.has(id, DEVICE_ONLINE)) {
+        return;
+    }
+    close(id, toUptime(when));
+    reg.set(id, DEVICE_ONLINE, false);
+    reg.presenceSince[id] = when;
+    reg.lastSeen[id] = when;
+
+    const uint8_t* mac = reg.mac[id];
+    DEBUG_PRINTF("Presence: %02X:%02X:%02X:%02X:%02X:%02X offline\n",
+                 mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+}
+
+void PresenceTracker::close(DeviceId id, uint32_t endSec) {
+    PresenceSession& s = _sessions[_head];
+    memcpy(s.mac, deviceRegistry.mac[id], 6);
+    s.source = _source[id];
+    s.start = _start[id];
+    s.end = endSec > _start[id] ? endSec : _start[id];
+    s.bytes = sessionBytes(id);
+
+    _head = (_head + 1) % PRESENCE_SESSION_HISTORY;
+    if (_count < PRESENCE_SESSION_HISTORY) {
+        _count++;
+    }
+    _total++;
+    _online--;
+}
+
+uint64_t PresenceTracker::sessionBytes(DeviceId id) const {
+    // Counters reset from the dashboard can drop below the baseline
+    uint64_t total = deviceRegistry.totalBytes(id);
+    return total > _baseBytes[id] ? total - _baseBytes[id] : 0;
+}
+
+uint8_t PresenceTracker::getSessions(const uint8_t* mac, PresenceSession* out, uint8_t max) const {
+    uint8_t n = 0;
+
+    DeviceId id = deviceRegistry.find(mac);
+    if (id != DEVICE_NONE && deviceRegistry.has(id, DEVICE_ONLINE) && n < max) {
+        PresenceSession& s = out[n++];
+        memcpy(s.mac, mac, 6);
+        s.source = _source[id];
+        s.start = _start[id];
+        s.end = 0;
+        s.bytes = sessionBytes(id);
+    }
+
+    for (uint16_t i = 0; i < _count && n < max; i++) {
+        uint16_t slot = (_head + PRESENCE_SESSION_HISTORY - 1 - i) % PRESENCE_SESSION_HISTORY;
+        if (memcmp(_sessions[slot].mac, mac, 6) == 0) {
+            out[n++] = _sessions[slot];
+        }
+    }
+    return n;
+}
+
+const char* PresenceTracker::sourceName(PresenceSource source) {
+    switch (source) {
+        case PRESENCE_AP:      return "ap";
+        case PRESENCE_ARP:     return "arp";
+        case PRESENCE_DHCP:    return "dhcp";
+        case PRESENCE_TRAFFIC: return "traffic";
+    }
+    return "unknown";
+}
+
+void PresenceTracker::onDeviceAdded(DeviceId id) {
+    _baseBytes[id] = 0;
+    _start[id] = 0;
+}
+
+void PresenceTracker::onDeviceRemoved(DeviceId id) {
+    // Eviction only takes inactive devices, but keep the count exact anyway
+    if (deviceRegistry.has(id, DEVICE_ONLINE)) {
+        close(id, uptimeSeconds());
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef PRESENCE_H
+#define PRESENCE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "device_registry.h"
+
+// What told us a device is there
+enum PresenceSource : uint8_t {
+    PRESENCE_AP = 0,    // Associated to the AP (event or station list)
+    PRESENCE_ARP,       // In the LAN's ARP table
+    PRESENCE_DHCP,      // DHCP request at the AP
+    PRESENCE_TRAFFIC    // Counted a packet from or to it
+};
+
+// One online period. end == 0 while the session is still open.
+struct PresenceSession {
+    uint8_t mac[6];       // Kept by MAC: a DeviceId is reused after eviction
+    PresenceSource source;
+    uint32_t start;       // uptimeSeconds()
+    uint32_t end;         // uptimeSeconds(), 0 = open
+    uint64_t bytes;       // Upload + download during the session
+};
+
+// Online/offline state of every device, as DEVICE_ONLINE plus presenceSince
+// in the registry.
+//
+// OFFLINE -> ONLINE on any sighting (seen()); ONLINE -> OFFLINE only on an
+// explicit departure (left(): AP disassociation, ARP disappearance). Traffic
+// right after a departure is not a new sighting for PRESENCE_REJOIN_GUARD_MS,
+// so packets still in the capture rings cannot reopen a session.
+//
+// Closed sessions go into a ring of PRESENCE_SESSION_HISTORY entries shared
+// by all devices; the online count is kept up to date on every transition.
+// Main loop or dataMutex only, like the registry.
+class PresenceTracker : public DeviceListener {
+public:
+    PresenceTracker();
+
+    // now and when are millis()
+    void seen(DeviceId id, PresenceSource source, uint32_t now);
+    void left(DeviceId id, uint32_t when);
+
+    uint16_t onlineCount() const { return _online; }
+    uint32_t sessionCount() const { return _total; }
+
+    // Sessions of one device, newest first, the open one (if online) included.
+    // Returns how many were written to out.
+    uint8_t getSessions(const uint8_t* mac, PresenceSession* out, uint8_t max) const;
+
+    static const char* sourceName(PresenceSource source);
+
+    // DeviceListener: a row being reused closes its session
+    void onDeviceAdded(DeviceId id) override;
+    void onDeviceRemoved(DeviceId id) override;
+
+private:
+    PresenceSession _sessions[PRESENCE_SESSION_HISTORY];
+    uint16_t _head;    // Next slot to write
+    uint16_t _count;
+    uint32_t _total;   // Sessions closed since boot
+
+    uint16_t _online;
+    uint64_t _baseBytes[MAX_DEVICES];    // totalBytes() when the session opened
+    uint32_t _start[MAX_DEVICES];        // uptimeSeconds() when it opened
+    PresenceSource _source[MAX_DEVICES];
+
+    void close(DeviceId id, uint32_t endSec);
+    uint64_t sessionBytes(DeviceId id) const;
+};
+
+extern PresenceTracker presence;
+
+#endif // PRESENCE_H
@@ -0,0 +1,91 @@
+#ifndef QUOTA_H
+#define QUOTA_H
+
+#include <stdint.h>
+
+// Per-device daily / monthly data caps.
+//
+// Usage counters are bumped alongside the byte counters as packets are
+// drained, and tagged with the day and month they belong to. Rollover is a
+// comparison of those tags with the current period - no history is scanned.
+// Periods come from the wall clock (local time via the configured UTC
+// offset); until the clock has been set there is no rollover at all.
+
+enum QuotaAction : uint8_t {
+    QUOTA_ACTION_THROTTLE = 0,   // Rate limit the device to throttleKbps
+    QUOTA_ACTION_BLOCK_DNS = 1   // Refuse the device's DNS queries
+};
+
+struct QuotaConfig {
+    uint64_t dailyBytes;    // 0 = no daily cap
+    uint64_t monthlyBytes;  // 0 = no monthly cap
+    uint32_t throttleKbps;  // Rate while over quota (throttle action)
+    uint8_t action;         // QuotaAction
+
+    bool enabled() const { return dailyBytes > 0 || monthlyBytes > 0; }
+};
+
+struct QuotaUsage {
+    uint32_t day;    // Days since 1970-01-01 (local), 0 = clock never set
+    uint32_t month;  // year * 12 + (month - 1)
+    uint64_t dayBytes;
+    uint64_t monthBytes;
+
+    void add(uint32_t bytes) {
+        dayBytes += bytes;
+        monthBytes += bytes;
+    }
+
+    // Move to the current period. Counters collected before the clock was
+    // first set are kept rather than thrown away.
+    void roll(uint32_t nowDay, uint32_t nowMonth) {
+        if (nowDay == 0) return;
+        if (day != 0 && day != nowDay) dayBytes = 0;
+        if (month != 0 && month != nowMonth) monthBytes = 0;
+        day = nowDay;
+        month = nowMonth;
+    }
+
+    bool exceeds(const QuotaConfig& cfg) const {
+        return (cfg.dailyBytes > 0 && dayBytes >= cfg.dailyBytes) ||
+               (cfg.monthlyBytes > 0 && monthBytes >= cfg.monthlyBytes);
+    }
+};
+
+// Month index for a day count (days since 1970-01-01), using the
+// days-to-civil conversion from H. Hinnant's date algorithms
+static inline uint32_t quotaMonthIndex(uint32_t dayIndex) {
+    uint32_t z = dayIndex + 719468;
+    uint32_t era = z / 146097;
+    uint32_t doe = z - era * 146097;
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp = (5 * doy + 2) / 153;
+    uint32_t m = mp < 10 ? mp + 3 : mp - 9;
+    uint32_t y = yoe + era * 400 + (m <= 2 ? 1 : 0);
+    return y * 12 + (m - 1);
+}
+
+// Current day / month for a Unix time. Returns false (and zeros) while the
+// clock has not been set yet.
+static inline bool quotaPeriod(int64_t unixSec, int32_t utcOffsetSec, uint32_t& day, uint32_t& month) {
+    const int64_t CLOCK_VALID_AFTER = 1577836800;  // 2020-01-01
+    if (unixSec < CLOCK_VALID_AFTER) {
+        day = month = 0;
+        return false;
+    }
+    day = (uint32_t)((unixSec + utcOffsetSec) / 86400);
+    month = quotaMonthIndex(day);
+    return true;
+}
+
+// Notified by BandwidthTracker when a device crosses or leaves its quota
+// (from the main loop, with dataMutex held)
+class QuotaListener {
+public:
+    virtual ~QuotaListener() {}
+    virtual void onQuotaExceeded(const uint8_t* mac, const QuotaConfig& cfg) = 0;
+    virtual void onQuotaRestored(const uint8_t* mac) = 0;
+};
+
+#endif // QUOTA_H
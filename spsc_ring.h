@@ -0,0 +1,121 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+// Lock-free single-producer / single-consumer ring buffer.
+//
+// One task calls push()/pushBatch(), one other task calls pop()/popBatch().
+// The producer publishes entries with a release store of _head and the
+// consumer frees slots with a release store of _tail, so entry data is always
+// visible before the index that exposes it (safe across both ESP32 cores).
+//
+// Indices are free-running counters masked into the buffer, so Capacity must
+// be a power of two and every slot is usable (no "one empty slot" rule).
+// Each side keeps a cached copy of the other side's index and only reloads
+// it when the ring looks full/empty, which keeps cross-core traffic low.
+//
+// Header-only and free of Arduino dependencies so it can be built on a host.
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2, "SpscRing capacity must be at least 2");
+    static_assert((Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    static const size_t CACHE_LINE = 64;
+
+    SpscRing() : _head(0), _tailCache(0), _tail(0), _headCache(0) {}
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    // --- Producer side ---
+
+    bool push(const T& item) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tailCache >= Capacity) {
+            _tailCache = _tail.load(std::memory_order_acquire);
+            if (head - _tailCache >= Capacity) {
+                return false;  // Full
+            }
+        }
+        _buf[head & MASK] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Push up to count items with a single publish. Returns number pushed.
+    size_t pushBatch(const T* items, size_t count) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        size_t space = Capacity - (head - _tailCache);
+        if (space < count) {
+            _tailCache = _tail.load(std::memory_order_acquire);
+            space = Capacity - (head - _tailCache);
+        }
+        size_t n = count < space ? count : space;
+        for (size_t i = 0; i < n; i++) {
+            _buf[(head + i) & MASK] = items[i];
+        }
+        if (n > 0) {
+            _head.store(head + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // --- Consumer side ---
+
+    bool pop(T& out) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _headCache) {
+            _headCache = _head.load(std::memory_order_acquire);
+            if (tail == _headCache) {
+                return false;  // Empty
+            }
+        }
+        out = _buf[tail & MASK];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pop up to maxCount items with a single release. Returns number popped.
+    size_t popBatch(T* out, size_t maxCount) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t avail = _headCache - tail;
+        if (avail < maxCount) {
+            _headCache = _head.load(std::memory_order_acquire);
+            avail = _headCache - tail;
+        }
+        size_t n = maxCount < avail ? maxCount : avail;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = _buf[(tail + i) & MASK];
+        }
+        if (n > 0) {
+            _tail.store(tail + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // Approximate fill level (exact only when called from one of the two sides
+    // while the other is idle). Intended for metrics.
+    size_t size() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+private:
+    static const size_t MASK = Capacity - 1;
+
+    // Producer-owned line: write index + cached consumer index
+    alignas(CACHE_LINE) std::atomic<size_t> _head;
+    size_t _tailCache;
+
+    // Consumer-owned line: read index + cached producer index
+    alignas(CACHE_LINE) std::atomic<size_t> _tail;
+    size_t _headCache;
+
+    alignas(CACHE_LINE) T _buf[Capacity];
+};
+
+#endif // SPSC_RING_H
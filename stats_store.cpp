@@ -0,0 +1,234 @@
+#include "stats_store.h"
+#include <stddef.h>
+#include "nvs.h"
+
+StatsStore statsStore;
+
+static const size_t SNAPSHOT_HEADER = offsetof(StatsSnapshot, records);
+static const size_t NVS_ENTRY_SIZE = 32;
+
+// Record layout written by the previous firmware under the bare MAC key
+struct LegacyStatsRecord {
+    uint64_t uploadBytes;
+    uint64_t downloadBytes;
+    QuotaConfig quotaConfig;
+    QuotaUsage quota;
+};
+
+static bool keyToMAC(const char* key, uint8_t* mac) {
+    for (int i = 0; i < 6; i++) {
+        char hex[3] = { key[i * 2], key[i * 2 + 1], '\0' };
+        if (!isxdigit((unsigned char)hex[0]) || !isxdigit((unsigned char)hex[1])) {
+            return false;
+        }
+        mac[i] = (uint8_t)strtoul(hex, nullptr, 16);
+    }
+    return true;
+}
+
+StatsStore::StatsStore() :
+    _task(NULL),
+    _writing(false),
+    _generation(0),
+    _journalCount(0),
+    _needsFull(false),
+    _bytesWritten(0),
+    _saves(0) {}
+
+bool StatsStore::begin(std::vector<DeviceStatsRecord>& out) {
+    out.clear();
+    _prefs.begin(NVS_NAMESPACE_STATS, false);  // Kept open for the writer task
+
+    if (_prefs.isKey("base")) {
+        readBlob("base", out, 0);
+    } else {
+        migrateLegacy(out);
+        _needsFull = true;
+    }
+
+    // Replay journal blobs while their generations keep increasing; the
+    // first stale or missing one ends the journal
+    for (uint8_t i = 0; i < STATS_JOURNAL_MAX + 1; i++) {
+        char key[8];
+        snprintf(key, sizeof(key), "j%u", i);
+        if (!readBlob(key, out, _generation + 1)) {
+            break;
+        }
+        _journalCount = i + 1;
+    }
+
+    DEBUG_PRINTF("Stats: Loaded %d devices (generation %u, %d journal blobs)\n",
+                 out.size(), _generation, _journalCount);
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        taskFunc,
+        "stats_save",
+        STATS_TASK_STACK_SIZE,
+        this,
+        STATS_TASK_PRIORITY,
+        &_task,
+        0  // Core 0, away from the main loop
+    );
+    if (result != pdPASS) {
+        DEBUG_PRINTLN("Stats: Failed to create save task");
+        _task = NULL;
+        return false;
+    }
+    return true;
+}
+
+StatsSnapshot* StatsStore::acquire() {
+    return busy() ? nullptr : &_snapshot;
+}
+
+bool StatsStore::submit() {
+    if (busy()) {
+        return false;
+    }
+    _writing.store(true, std::memory_order_release);
+    xTaskNotifyGive(_task);
+    return true;
+}
+
+// Runs on core 0 as a separate FreeRTOS task
+void StatsStore::taskFunc(void* param) {
+    StatsStore* self = (StatsStore*)param;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!self->_writing.load(std::memory_order_acquire)) {
+            continue;
+        }
+        self->write(self->_snapshot);
+        self->_writing.store(false, std::memory_order_release);
+    }
+}
+
+void StatsStore::write(StatsSnapshot& snapshot) {
+    if (snapshot.full) {
+        if (!putBlob("base", snapshot)) {
+            return;
+        }
+        _journalCount = 0;
+        _needsFull = false;
+
+        // Older per-device keys are only dropped once the base holds their data
+        for (const auto& key : _legacyKeys) {
+            _prefs.remove(key.c_str());
+        }
+        _legacyKeys.clear();
+    } else {
+        char key[8];
+        snprintf(key, sizeof(key), "j%u", _journalCount);
+        if (!putBlob(key, snapshot)) {
+            _needsFull = true;  // Those changes are lost unless everything is rewritten
+            return;
+        }
+        _journalCount++;
+    }
+    _saves++;
+}
+
+bool StatsStore::putBlob(const char* key, StatsSnapshot& snapshot) {
+    snapshot.generation = _generation + 1;
+    snapshot.recordSize = sizeof(DeviceStatsRecord);
+
+    size_t len = SNAPSHOT_HEADER + snapshot.count * sizeof(DeviceStatsRecord);
+    if (_prefs.putBytes(key, &snapshot, len) != len) {
+        DEBUG_PRINTF("Stats: Failed to write %s\n", key);
+        return false;
+    }
+    _generation = snapshot.generation;
+    countWrite(len);
+    return true;
+}
+
+bool StatsStore::readBlob(const char* key, std::vector<DeviceStatsRecord>& out, uint32_t minGeneration) {
+    size_t len = _prefs.getBytesLength(key);
+    if (len < SNAPSHOT_HEADER || len > sizeof(_snapshot) ||
+        _prefs.getBytes(key, &_snapshot, len) != len) {
+        return false;
+    }
+    if (_snapshot.recordSize != sizeof(DeviceStatsRecord) ||
+        len != SNAPSHOT_HEADER + _snapshot.count * sizeof(DeviceStatsRecord) ||
+        _snapshot.generation < minGeneration) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < _snapshot.count; i++) {
+        merge(out, _snapshot.records[i]);
+    }
+    _generation = _snapshot.generation;
+    return true;
+}
+
+// Keys written by earlier firmware: "aabbccddeeff", "aabbccddeeff_up", "aabbccddeeff_dn"
+static bool isLegacyKey(const char* key) {
+    uint8_t mac[6];
+    size_t len = strlen(key);
+    if (len < 12 || !keyToMAC(key, mac)) {
+        return false;
+    }
+    return len == 12 || strcmp(key + 12, "_up") == 0 || strcmp(key + 12, "_dn") == 0;
+}
+
+void StatsStore::migrateLegacy(std::vector<DeviceStatsRecord>& out) {
+    // Earlier firmware kept one blob (or two counters) per device. Collect
+    // just those keys: anything else in the namespace (journal blobs left
+    // without a base) is not ours to delete and is replayed by begin().
+    nvs_iterator_t it = NULL;
+    esp_err_t res = nvs_entry_find(NVS_DEFAULT_PART_NAME, NVS_NAMESPACE_STATS, NVS_TYPE_ANY, &it);
+    while (res == ESP_OK) {
+        nvs_entry_info_t info;
+        nvs_entry_info(it, &info);
+        if (isLegacyKey(info.key)) {
+            _legacyKeys.push_back(String(info.key));
+        }
+        res = nvs_entry_next(&it);
+    }
+    nvs_release_iterator(it);
+
+    for (const auto& key : _legacyKeys) {
+        DeviceStatsRecord record;
+        memset(&record, 0, sizeof(record));
+        keyToMAC(key.c_str(), record.mac);
+
+        if (key.length() == 12) {
+            LegacyStatsRecord legacy;
+            if (_prefs.getBytes(key.c_str(), &legacy, sizeof(legacy)) != sizeof(legacy)) {
+                continue;
+            }
+            record.uploadBytes = legacy.uploadBytes;
+            record.downloadBytes = legacy.downloadBytes;
+            record.quotaConfig = legacy.quotaConfig;
+            record.quota = legacy.quota;
+            merge(out, record);
+        } else if (key.endsWith("_up")) {
+            String base = key.substring(0, 12);
+            if (_prefs.isKey(base.c_str())) {
+                continue;  // Newer blob for this device wins
+            }
+            record.uploadBytes = _prefs.getULong64(key.c_str(), 0);
+            record.downloadBytes = _prefs.getULong64((base + "_dn").c_str(), 0);
+            merge(out, record);
+        }
+    }
+
+    if (!_legacyKeys.empty()) {
+        DEBUG_PRINTF("Stats: Migrating %d devices from per-device keys\n", out.size());
+    }
+}
+
+void StatsStore::merge(std::vector<DeviceStatsRecord>& out, const DeviceStatsRecord& record) {
+    for (auto& existing : out) {
+        if (memcmp(existing.mac, record.mac, 6) == 0) {
+            existing = record;
+            return;
+        }
+    }
+    out.push_back(record);
+}
+
+void StatsStore::countWrite(size_t len) {
+    // NVS blob: one index entry, one chunk header entry, then 32-byte data entries
+    _bytesWritten += (2 + (len + NVS_ENTRY_SIZE - 1) / NVS_ENTRY_SIZE) * NVS_ENTRY_SIZE;
+}
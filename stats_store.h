@@ -0,0 +1,98 @@
+#ifndef STATS_STORE_H
+#define STATS_STORE_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <atomic>
+#include <vector>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "config.h"
+#include "quota.h"
+
+// Persisted per-device counters and quota state
+struct DeviceStatsRecord {
+    uint8_t mac[6];
+    uint8_t reserved[2];
+    uint64_t uploadBytes;
+    uint64_t downloadBytes;
+    QuotaConfig quotaConfig;
+    QuotaUsage quota;
+};
+
+// Devices in the table plus the archived ones evicted from it
+static const uint16_t STATS_MAX_RECORDS = MAX_DEVICES + STATS_ARCHIVE_MAX;
+static_assert(STATS_MAX_RECORDS <= 255, "StatsSnapshot::count is 8 bits");
+
+// One save: only the devices that changed, or every device (full rewrite).
+// Stored as-is, header plus the first count records, as one NVS blob.
+struct StatsSnapshot {
+    uint32_t generation;  // Filled in by the writer
+    uint16_t recordSize;  // Filled in by the writer
+    uint8_t count;
+    uint8_t full;
+    DeviceStatsRecord records[STATS_MAX_RECORDS];
+};
+
+// Wear-aware stats persistence.
+//
+// NVS holds a base blob with every device plus a short journal of blobs that
+// each carry just the devices that changed in one save. A save is therefore a
+// single blob write no matter how many devices there are, and idle devices
+// cost nothing. After STATS_JOURNAL_MAX journal blobs the next save rewrites
+// the base and the journal starts over. Every blob carries a generation
+// number, so journal blobs older than the base are never replayed after an
+// interrupted compaction.
+//
+// Writes run on a background task. There is a single snapshot buffer: the
+// caller fills it in place between acquire() and submit(), the task writes it
+// and then hands it back, so the main loop never waits for flash and the
+// ~7 KB buffer exists once.
+class StatsStore {
+public:
+    StatsStore();
+
+    // Read all saved records (base + journal, migrating the older per-device
+    // keys) and start the writer task
+    bool begin(std::vector<DeviceStatsRecord>& out);
+
+    // The buffer to fill for the next save, or null while the previous one is
+    // still being written; the caller keeps its dirty state and retries.
+    StatsSnapshot* acquire();
+
+    // Hand the buffer from acquire() to the writer task
+    bool submit();
+    bool busy() const { return !_task || _writing.load(std::memory_order_acquire); }
+
+    // True when the next snapshot should contain every device
+    bool needsFull() const { return _needsFull || _journalCount >= STATS_JOURNAL_MAX; }
+
+    // Estimated flash bytes written since boot (32-byte NVS entries incl. headers)
+    uint32_t getBytesWritten() const { return _bytesWritten; }
+    uint32_t getSaveCount() const { return _saves; }
+
+private:
+    Preferences _prefs;  // Own handle: used by begin() and then only the writer task
+    TaskHandle_t _task;
+    StatsSnapshot _snapshot;  // Save buffer (also the read buffer in begin())
+    std::atomic<bool> _writing;  // Set by submit(), cleared by the task once written
+    uint32_t _generation;
+    volatile uint8_t _journalCount;
+    volatile bool _needsFull;
+    volatile uint32_t _bytesWritten;
+    volatile uint32_t _saves;
+    std::vector<String> _legacyKeys;  // Removed after the first full write
+
+    void write(StatsSnapshot& snapshot);
+    bool putBlob(const char* key, StatsSnapshot& snapshot);
+    bool readBlob(const char* key, std::vector<DeviceStatsRecord>& out, uint32_t minGeneration);
+    void migrateLegacy(std::vector<DeviceStatsRecord>& out);
+    void countWrite(size_t len);
+
+    static void merge(std::vector<DeviceStatsRecord>& out, const DeviceStatsRecord& record);
+    static void taskFunc(void* param);
+};
+
+extern StatsStore statsStore;
+
+#endif // STATS_STORE_H
@@ -45,6 +45,52 @@ IPAddress StorageManager::loadUpstreamDNS() {
     return IPAddress(dnsVal);
 }
 
+// Accounting Backend
+bool StorageManager::saveAccountingBackend(uint8_t backend) {
+    prefs.begin(NVS_NAMESPACE_NET, false);
+    bool ok = prefs.putUChar("acct", backend) > 0;
+    prefs.end();
+    return ok;
+}
+
+uint8_t StorageManager::loadAccountingBackend(uint8_t defaultBackend) {
+    prefs.begin(NVS_NAMESPACE_NET, true);
+    uint8_t backend = prefs.getUChar("acct", defaultBackend);
+    prefs.end();
+    return backend;
+}
+
+// Dashboard push interval
+bool StorageManager::savePushInterval(uint32_t ms) {
+    prefs.begin(NVS_NAMESPACE_NET, false);
+    bool ok = prefs.putUInt("pushMs", ms) > 0;
+    prefs.end();
+    return ok;
+}
+
+uint32_t StorageManager::loadPushInterval(uint32_t defaultMs) {
+    prefs.begin(NVS_NAMESPACE_NET, true);
+    uint32_t ms = prefs.getUInt("pushMs", defaultMs);
+    prefs.end();
+    return ms;
+}
+
+// Online vendor lookup
+bool StorageManager::saveOUISettings(bool enabled, const String& url) {
+    prefs.begin(NVS_NAMESPACE_NET, false);
+    bool ok = prefs.putBool("ouiOn", enabled) > 0;
+    ok &= prefs.putString("ouiUrl", url) > 0 || url.length() == 0;
+    prefs.end();
+    return ok;
+}
+
+void StorageManager::loadOUISettings(bool& enabled, String& url, bool defaultEnabled, const char* defaultURL) {
+    prefs.begin(NVS_NAMESPACE_NET, true);
+    enabled = prefs.getBool("ouiOn", defaultEnabled);
+    url = prefs.getString("ouiUrl", defaultURL);
+    prefs.end();
+}
+
 // Device Names
 bool StorageManager::saveDeviceName(const uint8_t* mac, const String& name) {
     String key = macToKey(mac);
@@ -71,6 +117,34 @@ bool StorageManager::deleteDeviceName(const uint8_t* mac) {
     return ok;
 }
 
+// Device rate limits - one blob in the devices namespace
+bool StorageManager::saveDeviceLimits(const std::vector<DeviceLimit>& limits) {
+    prefs.begin(NVS_NAMESPACE_DEVICES, false);
+    bool ok;
+    if (limits.empty()) {
+        prefs.remove("limits");
+        ok = true;
+    } else {
+        size_t len = limits.size() * sizeof(DeviceLimit);
+        ok = prefs.putBytes("limits", limits.data(), len) == len;
+    }
+    prefs.end();
+    DEBUG_PRINTF("Storage: Saved %d device limits\n", limits.size());
+    return ok;
+}
+
+std::vector<DeviceLimit> StorageManager::loadDeviceLimits() {
+    std::vector<DeviceLimit> limits;
+    prefs.begin(NVS_NAMESPACE_DEVICES, true);
+    size_t len = prefs.getBytesLength("limits");
+    if (len > 0 && len % sizeof(DeviceLimit) == 0) {
+        limits.resize(len / sizeof(DeviceLimit));
+        prefs.getBytes("limits", limits.data(), len);
+    }
+    prefs.end();
+    return limits;
+}
+
 // Blocked Domains
 bool StorageManager::saveBlockedDomains(const std::vector<String>& domains) {
     prefs.begin(NVS_NAMESPACE_DNS, false);
@@ -107,42 +181,6 @@ std::vector<String> StorageManager::loadBlockedDomains() {
     return domains;
 }
 
-// Bandwidth Stats
-bool StorageManager::saveDeviceStats(const uint8_t* mac, uint64_t upload, uint64_t download) {
-    String key = macToKey(mac);
-    prefs.begin(NVS_NAMESPACE_STATS, false);
-
-    String upKey = key + "_up";
-    String downKey = key + "_dn";
-
-    prefs.putULong64(upKey.c_str(), upload);
-    prefs.putULong64(downKey.c_str(), download);
-
-    prefs.end();
-    return true;
-}
-
-bool StorageManager::loadDeviceStats(const uint8_t* mac, uint64_t& upload, uint64_t& download) {
-    String key = macToKey(mac);
-    prefs.begin(NVS_NAMESPACE_STATS, true);
-
-    String upKey = key + "_up";
-    String downKey = key + "_dn";
-
-    upload = prefs.getULong64(upKey.c_str(), 0);
-    download = prefs.getULong64(downKey.c_str(), 0);
-
-    prefs.end();
-    return true;
-}
-
-void StorageManager::clearAllStats() {
-    prefs.begin(NVS_NAMESPACE_STATS, false);
-    prefs.clear();
-    prefs.end();
-    DEBUG_PRINTLN("Storage: Cleared all stats");
-}
-
 void StorageManager::clearAll() {
     prefs.begin(NVS_NAMESPACE_WIFI, false);
     prefs.clear();
@@ -160,5 +198,13 @@ void StorageManager::clearAll() {
     prefs.clear();
     prefs.end();
 
+    prefs.begin(NVS_NAMESPACE_NET, false);
+    prefs.clear();
+    prefs.end();
+
+    prefs.begin(NVS_NAMESPACE_OUI, false);
+    prefs.clear();
+    prefs.end();
+
     DEBUG_PRINTLN("Storage: Cleared all data");
 }
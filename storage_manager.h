@@ -5,6 +5,7 @@
 #include <Preferences.h>
 #include <vector>
 #include "config.h"
+#include "traffic_shaper.h"
 
 class StorageManager {
 public:
@@ -18,19 +19,32 @@ public:
     bool saveUpstreamDNS(const IPAddress& dns);
     IPAddress loadUpstreamDNS();
 
+    // Accounting Backend
+    bool saveAccountingBackend(uint8_t backend);
+    uint8_t loadAccountingBackend(uint8_t defaultBackend);
+
+    // Dashboard push interval
+    bool savePushInterval(uint32_t ms);
+    uint32_t loadPushInterval(uint32_t defaultMs);
+
+    // Online vendor lookup
+    bool saveOUISettings(bool enabled, const String& url);
+    void loadOUISettings(bool& enabled, String& url, bool defaultEnabled, const char* defaultURL);
+
     // Device Names
     bool saveDeviceName(const uint8_t* mac, const String& name);
     String loadDeviceName(const uint8_t* mac);
     bool deleteDeviceName(const uint8_t* mac);
 
+    // Device rate limits
+    bool saveDeviceLimits(const std::vector<DeviceLimit>& limits);
+    std::vector<DeviceLimit> loadDeviceLimits();
+
     // Blocked Domains
     bool saveBlockedDomains(const std::vector<String>& domains);
     std::vector<String> loadBlockedDomains();
 
-    // Bandwidth Stats (optional persistence)
-    bool saveDeviceStats(const uint8_t* mac, uint64_t upload, uint64_t download);
-    bool loadDeviceStats(const uint8_t* mac, uint64_t& upload, uint64_t& download);
-    void clearAllStats();
+    // Bandwidth stats live in StatsStore (stats_store.h)
 
     // Utility
     void clearAll();
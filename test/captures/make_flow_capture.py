@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""Write flow_sample.pcap for test/flow_table_pcap.cpp.
+
+The frames are built here from the Ethernet II / IPv4 / TCP / UDP / ICMP
+header layouts rather than recorded off the air, so the expected flow totals
+in the harness follow directly from this file. Each frame is what the AP
+netif sees: uploads come from a station to the AP's MAC, downloads go from
+the AP's MAC to a station.
+
+    python3 make_flow_capture.py [output.pcap]
+"""
+
+import struct
+import sys
+
+AP_MAC = bytes.fromhex("020000000001")
+STA_A = bytes.fromhex("3c0754a10b01")
+STA_B = bytes.fromhex("a4c138220c02")
+BROADCAST = b"\xff" * 6
+
+AP_IP = "192.168.4.1"
+A_IP = "192.168.4.2"
+B_IP = "192.168.4.3"
+
+
+def ip4(addr):
+    return bytes(int(x) for x in addr.split("."))
+
+
+def checksum(data):
+    if len(data) % 2:
+        data += b"\0"
+    total = sum(struct.unpack("!%dH" % (len(data) // 2), data))
+    while total >> 16:
+        total = (total & 0xFFFF) + (total >> 16)
+    return ~total & 0xFFFF
+
+
+def ipv4(src, dst, proto, payload, ident=0, frag=0, more=False):
+    flags = (0x2000 if more else 0) | (frag // 8)
+    hdr = struct.pack("!BBHHHBBH4s4s", 0x45, 0, 20 + len(payload), ident, flags,
+                      64, proto, 0, ip4(src), ip4(dst))
+    hdr = hdr[:10] + struct.pack("!H", checksum(hdr)) + hdr[12:]
+    return hdr + payload
+
+
+def tcp(sport, dport, payload_len, flags=0x18):
+    return struct.pack("!HHIIBBHHH", sport, dport, 1, 1, 0x50, flags,
+                       65535, 0, 0) + b"\0" * payload_len
+
+
+def udp(sport, dport, payload_len):
+    return struct.pack("!HHHH", sport, dport, 8 + payload_len, 0) + b"\0" * payload_len
+
+
+def icmp_echo(reply, payload_len):
+    body = struct.pack("!BBHHH", 0 if reply else 8, 0, 0, 0x1234, 1) + b"\0" * payload_len
+    return body[:2] + struct.pack("!H", checksum(body)) + body[4:]
+
+
+def eth(dst, src, ethertype, payload):
+    return dst + src + struct.pack("!H", ethertype) + payload
+
+
+def up(sta, ip_packet):
+    return eth(AP_MAC, sta, 0x0800, ip_packet)
+
+
+def down(sta, ip_packet):
+    return eth(sta, AP_MAC, 0x0800, ip_packet)
+
+
+WEB = "93.184.216.34"
+DNS = "8.8.8.8"
+PING = "1.1.1.1"
+NTP = "162.159.200.1"
+
+# (milliseconds, frame)
+FRAMES = [
+    # Station A: HTTPS to WEB, 3 up / 2 down
+    (0,    up(STA_A, ipv4(A_IP, WEB, 6, tcp(50000, 443, 0, 0x02)))),
+    (12,   down(STA_A, ipv4(WEB, A_IP, 6, tcp(443, 50000, 0, 0x12)))),
+    (13,   up(STA_A, ipv4(A_IP, WEB, 6, tcp(50000, 443, 0, 0x10)))),
+    (14,   up(STA_A, ipv4(A_IP, WEB, 6, tcp(50000, 443, 517)))),
+    (30,   down(STA_A, ipv4(WEB, A_IP, 6, tcp(443, 50000, 1460)))),
+    # Station A: DNS query and answer
+    (40,   up(STA_A, ipv4(A_IP, DNS, 17, udp(53000, 53, 32)))),
+    (55,   down(STA_A, ipv4(DNS, A_IP, 17, udp(53, 53000, 96)))),
+    # Station B: ping
+    (100,  up(STA_B, ipv4(B_IP, PING, 1, icmp_echo(False, 56)))),
+    (118,  down(STA_B, ipv4(PING, B_IP, 1, icmp_echo(True, 56)))),
+    # Station B: UDP datagram split in two fragments; only the first has ports
+    (200,  up(STA_B, ipv4(B_IP, NTP, 17, udp(40000, 123, 1472), ident=7, more=True))),
+    (201,  up(STA_B, ipv4(B_IP, NTP, 17, b"\0" * 100, ident=7, frag=1480))),
+    # Station B: HTTPS to WEB, one of each direction
+    (300,  up(STA_B, ipv4(B_IP, WEB, 6, tcp(51000, 443, 100)))),
+    (320,  down(STA_B, ipv4(WEB, B_IP, 6, tcp(443, 51000, 900)))),
+    # Not accounted: broadcast DHCP, ARP, IPv6
+    (400,  eth(BROADCAST, STA_B, 0x0800, ipv4("0.0.0.0", "255.255.255.255", 17, udp(68, 67, 300)))),
+    (401,  eth(BROADCAST, STA_A, 0x0806, struct.pack("!HHBBH", 1, 0x0800, 6, 4, 1)
+                                         + STA_A + ip4(A_IP) + b"\0" * 6 + ip4(AP_IP))),
+    (402,  eth(AP_MAC, STA_A, 0x86DD, b"\x60" + b"\0" * 39)),
+    # Station A: HTTPS flow goes quiet; a late DNS packet at 130 s
+    (130055, up(STA_A, ipv4(A_IP, DNS, 17, udp(53000, 53, 32)))),
+]
+
+
+def write_pcap(path):
+    with open(path, "wb") as f:
+        # Classic pcap, microsecond timestamps, LINKTYPE_ETHERNET
+        f.write(struct.pack("<IHHiIII", 0xA1B2C3D4, 2, 4, 0, 0, 65535, 1))
+        for ms, frame in FRAMES:
+            sec, usec = 1700000000 + ms // 1000, (ms % 1000) * 1000
+            f.write(struct.pack("<IIII", sec, usec, len(frame), len(frame)))
+            f.write(frame)
+
+
+if __name__ == "__main__":
+    write_pcap(sys.argv[1] if len(sys.argv) > 1 else "flow_sample.pcap")
@@ -0,0 +1,35 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <stdio.h>
+
+// Minimal assertions for the host tests: a failed CHECK is reported and
+// counted, and testResult() turns the count into the exit status.
+static int testFailures = 0;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            testFailures++; \
+        } \
+    } while (0)
+
+#define CHECK_EQ(a, b) do { \
+        long long _a = (long long)(a), _b = (long long)(b); \
+        if (_a != _b) { \
+            fprintf(stderr, "%s:%d: CHECK_EQ failed: %s == %s (%lld != %lld)\n", \
+                    __FILE__, __LINE__, #a, #b, _a, _b); \
+            testFailures++; \
+        } \
+    } while (0)
+
+static inline int testResult(const char* name) {
+    if (testFailures) {
+        fprintf(stderr, "%s: %d check(s) failed\n", name, testFailures);
+        return 1;
+    }
+    printf("%s: ok\n", name);
+    return 0;
+}
+
+#endif // TEST_CHECK_H
@@ -0,0 +1,221 @@
+// DeviceRegistry on the host: which row makes room when the table is full,
+// the listener veto on eviction, lookupIP() from another thread while the
+// main loop moves addresses around under dataMutex, names for a full table
+// in the shared pool, and an address handed from one row to another showing
+// up in the delta for both.
+
+#include "device_registry.h"
+#include "check.h"
+#include <atomic>
+#include <thread>
+
+SemaphoreHandle_t dataMutex = xSemaphoreCreateMutex();
+
+static void macFor(uint8_t* mac, int n) {
+    const uint8_t base[6] = {0x3c, 0x07, 0x54, 0xa1, 0x00, 0x00};
+    memcpy(mac, base, 6);
+    mac[4] = (uint8_t)(n >> 8);
+    mac[5] = (uint8_t)n;
+}
+
+static DeviceId add(DeviceRegistry& reg, int n, uint32_t lastSeen = 0) {
+    uint8_t mac[6];
+    macFor(mac, n);
+    DeviceId id = reg.acquire(mac);
+    if (id != DEVICE_NONE) reg.lastSeen[id] = lastSeen;
+    return id;
+}
+
+static DeviceId find(const DeviceRegistry& reg, int n) {
+    uint8_t mac[6];
+    macFor(mac, n);
+    return reg.find(mac);
+}
+
+// Records removals; with keepStats set it refuses to let rows with stats go
+struct EvictionListener : DeviceListener {
+    int removed = -1;
+    bool keepStats = false;
+
+    void onDeviceAdded(DeviceId) override {}
+    void onDeviceRemoved(DeviceId id) override { removed = deviceRegistry.mac[id][5]; }
+    bool canEvict(DeviceId id) override { return !(keepStats && deviceRegistry.hasStats(id)); }
+};
+
+// Table full: rows 0..MAX_DEVICES-1, odd ones with saved totals and
+// lastSeen 0 (as loaded at boot), even ones seen later without traffic
+static void fill(DeviceRegistry& reg) {
+    for (int n = 0; n < MAX_DEVICES; n++) {
+        DeviceId id = add(reg, n, n % 2 ? 0 : 5000 + n);
+        CHECK(id != DEVICE_NONE);
+        if (id != DEVICE_NONE && n % 2) {
+            reg.uploadBytes[id] = 1000 + n;
+        }
+    }
+    CHECK(reg.full());
+}
+
+static void testEvictsRowsWithoutStatsFirst() {
+    DeviceRegistry& reg = deviceRegistry;
+    EvictionListener listener;
+    reg.addListener(&listener);
+    fill(reg);
+
+    // Oldest row without stats goes, not the never-seen loaded ones
+    CHECK(add(reg, 300, 9000) != DEVICE_NONE);
+    CHECK_EQ(listener.removed, 0);
+    CHECK(find(reg, 0) == DEVICE_NONE);
+    CHECK(find(reg, 1) != DEVICE_NONE);
+
+    // A quota alone is worth keeping too
+    DeviceId id = find(reg, 2);
+    CHECK(id != DEVICE_NONE);
+    if (id != DEVICE_NONE) reg.quotaConfig[id].dailyBytes = 1;
+    CHECK(add(reg, 301, 9001) != DEVICE_NONE);
+    CHECK_EQ(listener.removed, 4);
+
+    // Active rows are never evicted: with every row without stats active,
+    // an inactive row with stats has to go
+    for (uint16_t i = 0; i < reg.count(); i++) {
+        reg.set(reg.at(i), DEVICE_ACTIVE, !reg.hasStats(reg.at(i)));
+    }
+    CHECK(add(reg, 302, 9002) != DEVICE_NONE);
+    CHECK(listener.removed % 2 == 1);
+    CHECK(find(reg, 2) != DEVICE_NONE);  // Seen more recently than the loaded ones
+
+    // With the veto on, rows with stats stay and the new device is refused
+    reg.set(find(reg, 302), DEVICE_ACTIVE, true);
+    listener.keepStats = true;
+    listener.removed = -1;
+    CHECK_EQ(add(reg, 303), DEVICE_NONE);
+    CHECK_EQ(listener.removed, -1);
+    CHECK_EQ(reg.count(), MAX_DEVICES);
+}
+
+// Reader without the mutex (like the DNS task) against a writer that holds
+// it in bursts, so reads land mid-write and some fall back to the mutex.
+// The fixed device keeps its address while others churn through the index
+// around it; no read may miss it or return another device's MAC.
+static void testLookupIPAgainstWriter() {
+    static DeviceRegistry reg;
+    const int churning = 16;
+    const uint32_t fixedIP = IPAddress(192, 168, 4, 10);
+    uint8_t fixedMac[6];
+    macFor(fixedMac, 1000);
+
+    xSemaphoreTake(dataMutex, portMAX_DELAY);
+    DeviceId fixed = reg.acquire(fixedMac);
+    reg.setIP(fixed, IPAddress(fixedIP));
+    DeviceId ids[churning];
+    for (int n = 0; n < churning; n++) {
+        uint8_t mac[6];
+        macFor(mac, 1001 + n);
+        ids[n] = reg.acquire(mac);
+    }
+    xSemaphoreGive(dataMutex);
+
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> rounds(0);
+    std::thread writer([&] {
+        for (uint32_t round = 0; !done; round = ++rounds) {
+            xSemaphoreTake(dataMutex, portMAX_DELAY);
+            for (int n = 0; n < churning; n++) {
+                // Addresses 11..42: an address taken by another row moves over
+                reg.setIP(ids[n], IPAddress(192, 168, 4, 11 + (round * 7 + n * 3) % 32));
+            }
+            xSemaphoreGive(dataMutex);
+        }
+    });
+
+    uint32_t reads = 0, misses = 0, wrong = 0;
+    for (; reads < 200000 || rounds < 100; reads++) {
+        uint8_t mac[6];
+        if (!reg.lookupIP(IPAddress(fixedIP), mac)) {
+            misses++;
+        } else if (memcmp(mac, fixedMac, 6) != 0) {
+            wrong++;
+        }
+
+        // A churning address is found or not, but never as the fixed device
+        if (reg.lookupIP(IPAddress(192, 168, 4, 11 + reads % 32), mac)) {
+            if (memcmp(mac, fixedMac, 6) == 0) wrong++;
+        }
+    }
+    done = true;
+    writer.join();
+
+    printf("lookupIP: %u reads against %u writer rounds, %u misses, %u wrong\n",
+           reads, (uint32_t)rounds, misses, wrong);
+    CHECK_EQ(misses, 0);
+    CHECK_EQ(wrong, 0);
+    uint8_t mac[6];
+    CHECK(!reg.lookupIP(IPAddress(192, 168, 4, 200), mac));
+}
+
+// Every row with its own hostname and custom name, each 15 chars (half of
+// MAX_DEVICE_NAME with the NUL): the pool holds them all, and a name that
+// does not fit is refused without losing the one the row had
+static void testNamesForFullTable() {
+    static DeviceRegistry reg;
+    DeviceId ids[MAX_DEVICES];
+    char name[MAX_DEVICE_NAME];
+    for (int n = 0; n < MAX_DEVICES; n++) {
+        uint8_t mac[6];
+        macFor(mac, 2000 + n);
+        ids[n] = reg.acquire(mac);
+        CHECK(ids[n] != DEVICE_NONE);
+        if (ids[n] == DEVICE_NONE) return;
+        snprintf(name, sizeof(name), "hostname-%06d", n);
+        CHECK(reg.setAutoName(ids[n], name));
+        snprintf(name, sizeof(name), "custom-na-%05d", n);
+        CHECK(reg.setCustomName(ids[n], name));
+        reg.set(ids[n], DEVICE_CUSTOM_NAME, true);
+    }
+    CHECK_EQ(namePool.strings(), 2 * MAX_DEVICES);
+    CHECK_EQ(namePool.bytes(), NamePool::capacity());
+    CHECK_EQ(namePool.getFailures(), 0);
+
+    // Full: a new string fails, a shared one still fits, "" always does
+    CHECK(!reg.setCustomName(ids[0], "Living Room TV"));
+    CHECK(strcmp(reg.displayName(ids[0]), "custom-na-00000") == 0);
+    CHECK_EQ(namePool.getFailures(), 1);
+    CHECK(reg.setCustomName(ids[0], "custom-na-00001"));
+    CHECK(reg.setAutoName(ids[1], ""));
+
+    // The freed text makes room again
+    CHECK(reg.setCustomName(ids[0], "Living Room TV"));
+    CHECK(strcmp(reg.displayName(ids[0]), "Living Room TV") == 0);
+
+    printf("names: %d rows x 2 names in %u bytes; sizeof NamePool %zu, DeviceRegistry %zu (host build)\n",
+           MAX_DEVICES, (unsigned)NamePool::capacity(), sizeof(NamePool), sizeof(DeviceRegistry));
+}
+
+// An address moving from one row to another changes both rows, so a delta
+// reader learns that the first one no longer has it
+static void testIPHandoverInDelta() {
+    static DeviceRegistry reg;
+    DeviceId a = add(reg, 3000);
+    DeviceId b = add(reg, 3001);
+    reg.setIP(a, IPAddress(192, 168, 4, 50));
+    uint32_t since = reg.seal();
+
+    reg.setIP(b, IPAddress(192, 168, 4, 50));
+    uint32_t now = reg.seal();
+    CHECK(now > since);
+    CHECK(reg.changed[a] > since);
+    CHECK(reg.changed[b] > since);
+    CHECK_EQ(reg.ip[a], 0);
+    CHECK_EQ(reg.findByIP(IPAddress(192, 168, 4, 50)), b);
+
+    // Nothing moved since: neither row is in the next delta
+    CHECK_EQ(reg.seal(), now);
+    CHECK(reg.changed[a] <= now && reg.changed[b] <= now);
+}
+
+int main() {
+    testEvictsRowsWithoutStatsFirst();
+    testLookupIPAgainstWriter();
+    testNamesForFullTable();
+    testIPHandoverInDelta();
+    return testResult("device_registry_test");
+}
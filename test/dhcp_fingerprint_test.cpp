@@ -0,0 +1,298 @@
+// parseDhcpFrame() and classifyDhcp() against client DHCP messages as the
+// AP netif input hook receives them (Ethernet frame, no FCS).
+//
+// The frames are built here from RFC 2131/2132: Ethernet and IPv4/UDP
+// headers, the 236-byte BOOTP header with chaddr, the magic cookie, then the
+// options the way the named clients send them (option 53 first, option 55
+// lists as in the fingerprint table, padding before the end option). None
+// were captured on a network; each one's expected result is next to it.
+
+#include "dhcp_fingerprint.h"
+#include "check.h"
+#include <string.h>
+#include <string>
+#include <vector>
+
+typedef std::vector<uint8_t> Bytes;
+
+static const uint8_t STA[6] = {0x3c, 0x07, 0x54, 0xa1, 0x0b, 0x01};
+
+// An option: code, length, value
+static Bytes opt(uint8_t code, const Bytes& value) {
+    Bytes o = {code, (uint8_t)value.size()};
+    o.insert(o.end(), value.begin(), value.end());
+    return o;
+}
+
+static Bytes str(const char* s) {
+    return Bytes(s, s + strlen(s));
+}
+
+static Bytes type(uint8_t messageType) {
+    return opt(53, {messageType});
+}
+
+// Client broadcast 0.0.0.0:68 -> 255.255.255.255:67 carrying options
+// (followed by the end option unless raw)
+static Bytes dhcpFrame(const std::vector<Bytes>& options, bool raw = false, uint8_t ipOptionWords = 0) {
+    Bytes f(14, 0xff);
+    memcpy(&f[6], STA, 6);
+    f[12] = 0x08;
+    f[13] = 0x00;
+
+    // IPv4: version 4, IHL, total length patched below, DF, TTL 64, UDP
+    size_t ip = f.size();
+    Bytes ipHdr = {(uint8_t)(0x45 + ipOptionWords), 0x10, 0, 0, 0, 0, 0x40, 0x00, 64, 17, 0, 0,
+                   0, 0, 0, 0, 255, 255, 255, 255};
+    f.insert(f.end(), ipHdr.begin(), ipHdr.end());
+    for (uint8_t i = 0; i < ipOptionWords; i++) {
+        Bytes rtrAlert = {0x94, 0x04, 0x00, 0x00};
+        f.insert(f.end(), rtrAlert.begin(), rtrAlert.end());
+    }
+
+    size_t udp = f.size();
+    Bytes udpHdr = {0, 68, 0, 67, 0, 0, 0, 0};
+    f.insert(f.end(), udpHdr.begin(), udpHdr.end());
+
+    // BOOTREQUEST, Ethernet, hlen 6, xid, chaddr at 28, sname/file zero
+    Bytes bootp(236, 0);
+    bootp[0] = 1;
+    bootp[1] = 1;
+    bootp[2] = 6;
+    bootp[4] = 0x3a;
+    bootp[5] = 0x1f;
+    bootp[6] = 0x92;
+    bootp[7] = 0x04;
+    memcpy(&bootp[28], STA, 6);
+    f.insert(f.end(), bootp.begin(), bootp.end());
+    Bytes cookie = {0x63, 0x82, 0x53, 0x63};
+    f.insert(f.end(), cookie.begin(), cookie.end());
+
+    for (const Bytes& o : options) {
+        f.insert(f.end(), o.begin(), o.end());
+    }
+    if (!raw) {
+        f.push_back(0);  // Pad, as many clients send
+        f.push_back(255);
+    }
+
+    size_t ipLen = f.size() - ip;
+    f[ip + 2] = (uint8_t)(ipLen >> 8);
+    f[ip + 3] = (uint8_t)ipLen;
+    size_t udpLen = f.size() - udp;
+    f[udp + 4] = (uint8_t)(udpLen >> 8);
+    f[udp + 5] = (uint8_t)udpLen;
+    return f;
+}
+
+static bool parse(const Bytes& f, DhcpEvent& evt) {
+    return parseDhcpFrame(f.data(), (uint16_t)f.size(), evt);
+}
+
+static std::string params(const DhcpEvent& evt) {
+    char buf[DHCP_MAX_PARAMS * 4];
+    formatDhcpParams(evt, buf, sizeof(buf));
+    return buf;
+}
+
+static void testWindowsDiscover() {
+    Bytes f = dhcpFrame({type(1),
+                         opt(61, {0x01, 0x3c, 0x07, 0x54, 0xa1, 0x0b, 0x01}),
+                         opt(12, str("DESKTOP-7QK2M1L")),
+                         opt(60, str("MSFT 5.0")),
+                         opt(55, {1, 3, 6, 15, 31, 33, 43, 44, 46, 47, 119, 121, 249, 252})});
+    DhcpEvent evt;
+    CHECK(parse(f, evt));
+    CHECK(memcmp(evt.mac, STA, 6) == 0);
+    CHECK_EQ(evt.messageType, 1);
+    CHECK(strcmp(evt.hostname, "DESKTOP-7QK2M1L") == 0);
+    CHECK(strcmp(evt.vendorClass, "MSFT 5.0") == 0);
+    CHECK(params(evt) == "1,3,6,15,31,33,43,44,46,47,119,121,249,252");
+
+    uint8_t cls = classifyDhcp(evt);
+    CHECK(cls != 0);
+    CHECK(strcmp(dhcpOSName(cls), "Windows") == 0);
+    CHECK(strcmp(dhcpDeviceType(cls), "Computer") == 0);
+}
+
+static void testAndroidRequest() {
+    // REQUEST with requested address and server identifier
+    Bytes f = dhcpFrame({type(3),
+                         opt(50, {192, 168, 4, 23}),
+                         opt(54, {192, 168, 4, 1}),
+                         opt(57, {0x05, 0xdc}),
+                         opt(60, str("android-dhcp-13")),
+                         opt(12, str("Pixel-7")),
+                         opt(55, {1, 3, 6, 15, 26, 28, 51, 58, 59, 43, 114})});
+    DhcpEvent evt;
+    CHECK(parse(f, evt));
+    CHECK_EQ(evt.messageType, 3);
+    CHECK(strcmp(evt.hostname, "Pixel-7") == 0);
+    uint8_t cls = classifyDhcp(evt);
+    CHECK(strcmp(dhcpOSName(cls), "Android") == 0);
+    CHECK(strcmp(dhcpDeviceType(cls), "Mobile") == 0);
+}
+
+static void testParameterListMatches() {
+    struct Case {
+        Bytes list;
+        const char* os;  // nullptr: no row
+    };
+    const Case cases[] = {
+        {{1, 121, 3, 6, 15, 114, 119, 252}, "iOS"},
+        {{1, 121, 3, 6, 15, 119, 252, 95, 44, 46}, "macOS"},
+        {{1, 3, 28, 6}, "lwIP"},
+        {{1, 3, 6, 12, 15, 28, 42}, "Linux"},
+        {{1, 121, 3, 6, 15, 119, 252, 95}, nullptr},  // Extra option: exact lists only
+        {{3, 1, 28, 6}, nullptr},                     // Same options, other order
+    };
+    for (const Case& c : cases) {
+        DhcpEvent evt;
+        CHECK(parse(dhcpFrame({type(1), opt(55, c.list)}), evt));
+        uint8_t cls = classifyDhcp(evt);
+        if (!c.os) {
+            CHECK_EQ(cls, 0);
+            continue;
+        }
+        CHECK(cls != 0);
+        if (cls) CHECK(strcmp(dhcpOSName(cls), c.os) == 0);
+    }
+
+    // Option 60 wins over the list
+    DhcpEvent evt;
+    CHECK(parse(dhcpFrame({type(1), opt(60, str("udhcp 1.36.1")), opt(55, {1, 121, 3, 6, 15, 119, 252})}), evt));
+    uint8_t cls = classifyDhcp(evt);
+    CHECK(strcmp(dhcpOSName(cls), "Linux") == 0);
+    CHECK(strcmp(dhcpDeviceType(cls), "Embedded") == 0);
+
+    // Nothing to go on
+    CHECK(parse(dhcpFrame({type(8)}), evt));
+    CHECK_EQ(classifyDhcp(evt), 0);
+    CHECK(dhcpOSName(0) == nullptr);
+    CHECK(dhcpOSName(255) == nullptr);
+}
+
+static void testReleaseAndIpOptions() {
+    // RELEASE from a client whose IP header carries a Router Alert option
+    DhcpEvent evt;
+    CHECK(parse(dhcpFrame({type(DHCP_MSG_RELEASE), opt(54, {192, 168, 4, 1})}, false, 1), evt));
+    CHECK_EQ(evt.messageType, DHCP_MSG_RELEASE);
+    CHECK(memcmp(evt.mac, STA, 6) == 0);
+}
+
+static void testOverlongOptions() {
+    DhcpEvent evt;
+
+    // Hostname and vendor class longer than the event: cut, NUL terminated
+    std::string longName(60, 'h');
+    std::string longVendor(80, 'v');
+    CHECK(parse(dhcpFrame({type(1), opt(12, str(longName.c_str())), opt(60, str(longVendor.c_str()))}), evt));
+    CHECK_EQ(strlen(evt.hostname), DHCP_HOSTNAME_LEN - 1);
+    CHECK_EQ(strlen(evt.vendorClass), DHCP_VENDOR_CLASS_LEN - 1);
+
+    // Control bytes and high bytes are dropped from names
+    CHECK(parse(dhcpFrame({type(1), opt(12, {'a', 0x1b, '[', '2', 'J', 0xc3, 0xa9, 'b', 0x00})}), evt));
+    CHECK(strcmp(evt.hostname, "a[2Jb") == 0);
+
+    // A 255-entry parameter list keeps the first DHCP_MAX_PARAMS and matches nothing
+    Bytes list(255);
+    for (int i = 0; i < 255; i++) list[i] = (uint8_t)(i + 1);
+    CHECK(parse(dhcpFrame({type(1), opt(55, list)}), evt));
+    CHECK_EQ(evt.paramCount, DHCP_MAX_PARAMS);
+    CHECK_EQ(evt.params[DHCP_MAX_PARAMS - 1], DHCP_MAX_PARAMS);
+    CHECK_EQ(classifyDhcp(evt), 0);
+
+    // A formatted list cut by a short buffer ends on a whole number
+    char small[8];
+    formatDhcpParams(evt, small, sizeof(small));
+    CHECK(strcmp(small, "1,2,3,4") == 0);
+}
+
+static void testTruncatedOptions() {
+    DhcpEvent evt;
+
+    // Each of 12, 55 and 60 claiming more bytes than the frame has: parsing
+    // stops there, what came before is kept, nothing is read past the end
+    for (uint8_t code : {12, 55, 60}) {
+        Bytes f = dhcpFrame({type(3), opt(code, str("abcdefgh"))}, true);
+        f.resize(f.size() - 4);  // Option header says 8, 4 bytes left
+        CHECK(parse(f, evt));
+        CHECK_EQ(evt.messageType, 3);
+        CHECK_EQ(evt.hostname[0], '\0');
+        CHECK_EQ(evt.vendorClass[0], '\0');
+        CHECK_EQ(evt.paramCount, 0);
+    }
+
+    // Length byte itself missing
+    Bytes f = dhcpFrame({type(1)}, true);
+    f.push_back(12);
+    CHECK(parse(f, evt));
+    CHECK_EQ(evt.hostname[0], '\0');
+
+    // No end option: the options run to the end of the frame
+    CHECK(parse(dhcpFrame({type(1), opt(12, str("nas"))}, true), evt));
+    CHECK(strcmp(evt.hostname, "nas") == 0);
+
+    // Options after the end option are ignored
+    f = dhcpFrame({type(1)});
+    Bytes extra = opt(12, str("ignored"));
+    f.insert(f.end(), extra.begin(), extra.end());
+    CHECK(parse(f, evt));
+    CHECK_EQ(evt.hostname[0], '\0');
+}
+
+static void testNotAClientRequest() {
+    DhcpEvent evt;
+
+    // No option 53: BOOTP, not DHCP
+    CHECK(!parse(dhcpFrame({opt(12, str("printer")), opt(55, {1, 3, 6})}), evt));
+    // Option 53 with no value
+    CHECK(!parse(dhcpFrame({opt(53, {})}), evt));
+
+    Bytes good = dhcpFrame({type(1)});
+    CHECK(parse(good, evt));
+
+    Bytes f = good;
+    f[12] = 0x86;  // IPv6 ethertype
+    f[13] = 0xdd;
+    CHECK(!parse(f, evt));
+
+    f = good;
+    f[14 + 9] = 6;  // TCP
+    CHECK(!parse(f, evt));
+
+    f = good;
+    f[14 + 6] = 0x20;  // More fragments
+    CHECK(!parse(f, evt));
+
+    f = good;
+    f[14 + 20 + 1] = 67;  // Server -> client ports (67 -> 68)
+    f[14 + 20 + 3] = 68;
+    CHECK(!parse(f, evt));
+
+    f = good;
+    f[14 + 28] = 2;  // BOOTREPLY
+    CHECK(!parse(f, evt));
+
+    f = good;
+    f[14 + 28 + 236] = 0;  // Magic cookie
+    CHECK(!parse(f, evt));
+
+    f = good;
+    f[14] = 0x4f;  // IHL of 60 bytes: the BOOTP header runs past the frame end
+    f.resize(14 + 20 + 8 + 236 + 4 + 10);
+    CHECK(!parse(f, evt));
+
+    CHECK(!parseDhcpFrame(good.data(), 14 + 20 + 8 + 236 + 3, evt));
+}
+
+int main() {
+    testWindowsDiscover();
+    testAndroidRequest();
+    testParameterListMatches();
+    testReleaseAndIpOptions();
+    testOverlongOptions();
+    testTruncatedOptions();
+    testNotAClientRequest();
+    return testResult("dhcp_fingerprint_test");
+}
@@ -0,0 +1,231 @@
+// discovery_wire.cpp against mDNS and SSDP replies as the discovery socket
+// receives them (UDP payload only).
+//
+// The mDNS packets are written out byte by byte from RFC 1035/6762: header,
+// then records with name compression the way responders use it (pointers to
+// the service name, the instance name and the ".local" label). The SSDP
+// replies carry SERVER headers in the forms common devices send. None of it
+// was captured on a network; each packet's expected result is next to it.
+
+#include "discovery_wire.h"
+#include "check.h"
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+typedef std::vector<uint8_t> Bytes;
+
+static Bytes hex(const char* s) {
+    Bytes out;
+    while (*s) {
+        char* end;
+        unsigned long v = strtoul(s, &end, 16);
+        if (end == s) break;
+        out.push_back((uint8_t)v);
+        s = end;
+    }
+    return out;
+}
+
+static uint32_t ipv4(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+    uint8_t bytes[4] = {a, b, c, d};
+    uint32_t addr;
+    memcpy(&addr, bytes, 4);  // Network byte order
+    return addr;
+}
+
+static const uint32_t SRC_IP = ipv4(192, 168, 4, 23);
+
+// --- mDNS ---
+
+static void testMdnsQuery() {
+    const char* const services[] = {"googlecast", "ipp"};
+    uint8_t buf[128];
+    size_t len = buildMdnsQuery(buf, sizeof(buf), services, 2);
+
+    // ID 0, QDCOUNT 2; each question a PTR with the QU bit (0x8001)
+    Bytes expected = hex("00 00 00 00 00 02 00 00 00 00 00 00"
+                         " 0b 5f 67 6f 6f 67 6c 65 63 61 73 74 04 5f 74 63 70 05 6c 6f 63 61 6c 00"
+                         " 00 0c 80 01"
+                         " 04 5f 69 70 70 04 5f 74 63 70 05 6c 6f 63 61 6c 00"
+                         " 00 0c 80 01");
+    CHECK_EQ(len, expected.size());
+    CHECK(memcmp(buf, expected.data(), expected.size()) == 0);
+
+    // A query is not a response
+    DiscoveryResult res;
+    CHECK(!parseMdnsResponse(buf, len, SRC_IP, res));
+
+    CHECK_EQ(buildMdnsQuery(buf, 40, services, 2), 0);
+}
+
+static void testMdnsPtrSrvA() {
+    // Answer: PTR _googlecast._tcp.local -> Living-Room-TV._googlecast...
+    // Additional: SRV for the instance (pointer 0x2e) with target
+    // Living-Room-TV + pointer to "local" (0x1d), A for the target (0x51)
+    Bytes p = hex("00 00 84 00 00 00 00 01 00 00 00 02"
+                  " 0b 5f 67 6f 6f 67 6c 65 63 61 73 74 04 5f 74 63 70 05 6c 6f 63 61 6c 00"
+                  " 00 0c 00 01 00 00 11 94 00 11"
+                  " 0e 4c 69 76 69 6e 67 2d 52 6f 6f 6d 2d 54 56 c0 0c"
+                  " c0 2e 00 21 80 01 00 00 00 78 00 17"
+                  " 00 00 00 00 1f 49 0e 4c 69 76 69 6e 67 2d 52 6f 6f 6d 2d 54 56 c0 1d"
+                  " c0 51 00 01 80 01 00 00 00 78 00 04 c0 a8 04 17");
+    DiscoveryResult res;
+    CHECK(parseMdnsResponse(p.data(), p.size(), 0, res));
+    CHECK_EQ(res.source, DISCOVERY_MDNS);
+    CHECK(strcmp(res.name, "Living-Room-TV") == 0);
+    CHECK_EQ(res.ip, SRC_IP);
+
+    // Cut inside the A record: the SRV target is still a name, the address
+    // comes from the sender
+    CHECK(parseMdnsResponse(p.data(), p.size() - 3, ipv4(192, 168, 4, 99), res));
+    CHECK(strcmp(res.name, "Living-Room-TV") == 0);
+    CHECK_EQ(res.ip, ipv4(192, 168, 4, 99));
+}
+
+static void testMdnsSrvOnly() {
+    // SRV for "Office Printer._ipp._tcp.local" -> brother-hl.local:631, no A
+    Bytes p = hex("00 00 84 00 00 00 00 01 00 00 00 00"
+                  " 0e 4f 66 66 69 63 65 20 50 72 69 6e 74 65 72 04 5f 69 70 70"
+                  " 04 5f 74 63 70 05 6c 6f 63 61 6c 00"
+                  " 00 21 80 01 00 00 00 78 00 18"
+                  " 00 00 00 00 02 77 0a 62 72 6f 74 68 65 72 2d 68 6c 05 6c 6f 63 61 6c 00");
+    DiscoveryResult res;
+    CHECK(parseMdnsResponse(p.data(), p.size(), SRC_IP, res));
+    CHECK(strcmp(res.name, "brother-hl") == 0);
+    CHECK_EQ(res.ip, SRC_IP);
+
+    // Without a sender address there is nothing to attach the name to
+    CHECK(!parseMdnsResponse(p.data(), p.size(), 0, res));
+}
+
+static void testMdnsPrefersSenderAddress() {
+    // Legacy unicast reply: question echoed, then A nas.local 10.0.0.5 and
+    // A nas.local 192.168.4.40 (a host on two networks)
+    Bytes p = hex("00 00 84 00 00 01 00 02 00 00 00 00"
+                  " 03 6e 61 73 05 6c 6f 63 61 6c 00 00 01 00 01"
+                  " c0 0c 00 01 80 01 00 00 00 78 00 04 0a 00 00 05"
+                  " c0 0c 00 01 80 01 00 00 00 78 00 04 c0 a8 04 28");
+    DiscoveryResult res;
+    CHECK(parseMdnsResponse(p.data(), p.size(), ipv4(192, 168, 4, 40), res));
+    CHECK(strcmp(res.name, "nas") == 0);
+    CHECK_EQ(res.ip, ipv4(192, 168, 4, 40));
+
+    // From another address the first record wins
+    CHECK(parseMdnsResponse(p.data(), p.size(), ipv4(192, 168, 4, 41), res));
+    CHECK_EQ(res.ip, ipv4(10, 0, 0, 5));
+}
+
+static void testMdnsMalformed() {
+    DiscoveryResult res;
+
+    // Name pointer to itself
+    Bytes loop = hex("00 00 84 00 00 00 00 01 00 00 00 00"
+                     " c0 0c 00 01 80 01 00 00 00 78 00 04 c0 a8 04 17");
+    CHECK(!parseMdnsResponse(loop.data(), loop.size(), SRC_IP, res));
+
+    // Label running past the end, and a header alone
+    Bytes past = hex("00 00 84 00 00 00 00 01 00 00 00 00 3f 61 62");
+    CHECK(!parseMdnsResponse(past.data(), past.size(), SRC_IP, res));
+    CHECK(!parseMdnsResponse(past.data(), 12, SRC_IP, res));
+
+    // Counts larger than the packet: the records that are there still count
+    Bytes extra = hex("00 00 84 00 00 00 00 05 00 00 00 00"
+                      " 03 6e 61 73 05 6c 6f 63 61 6c 00"
+                      " 00 01 80 01 00 00 00 78 00 04 c0 a8 04 28");
+    CHECK(parseMdnsResponse(extra.data(), extra.size(), SRC_IP, res));
+    CHECK(strcmp(res.name, "nas") == 0);
+}
+
+// --- SSDP ---
+
+static bool ssdp(const char* pkt, DiscoveryResult& res) {
+    return parseSsdpResponse(pkt, strlen(pkt), SRC_IP, res);
+}
+
+static void testSsdpSearch() {
+    char buf[160];
+    size_t len = buildSsdpSearch(buf, sizeof(buf), 2);
+    const char* expected = "M-SEARCH * HTTP/1.1\r\n"
+                           "HOST: 239.255.255.250:1900\r\n"
+                           "MAN: \"ssdp:discover\"\r\n"
+                           "MX: 2\r\n"
+                           "ST: ssdp:all\r\n"
+                           "\r\n";
+    CHECK_EQ(len, strlen(expected));
+    CHECK(strcmp(buf, expected) == 0);
+    CHECK_EQ(buildSsdpSearch(buf, 40, 2), 0);
+}
+
+static void testSsdpServerHeaders() {
+    struct Case {
+        const char* server;
+        const char* product;  // nullptr: nothing but OS and protocol tokens
+    };
+    const Case cases[] = {
+        {"Roku/9.4.0 UPnP/1.0 Roku/9.4.0", "Roku"},
+        {"Linux UPnP/1.0 Sonos/63.2-88230 (ZPS1)", "Sonos"},
+        {"Linux/3.14.0 UPnP/1.0 IpBridge/1.26.0", "IpBridge"},
+        {"Synology/DSM/192.168.4.60", "Synology"},
+        {"Microsoft-Windows/10.0 UPnP/1.0 UPnP-Device-Host/1.0", nullptr},
+        {"Linux/5.4 UPnP/1.0", nullptr},
+    };
+
+    for (const Case& c : cases) {
+        std::string pkt = "HTTP/1.1 200 OK\r\n"
+                          "CACHE-CONTROL: max-age=1800\r\n"
+                          "EXT:\r\n"
+                          "LOCATION: http://192.168.4.23:8060/\r\n"
+                          "SERVER: ";
+        pkt += c.server;
+        pkt += "\r\nST: upnp:rootdevice\r\n"
+               "USN: uuid:2f402f80-da50-11e1-9b23-001788102201::upnp:rootdevice\r\n\r\n";
+
+        DiscoveryResult res;
+        bool ok = ssdp(pkt.c_str(), res);
+        if (!c.product) {
+            CHECK(!ok);
+            continue;
+        }
+        CHECK(ok);
+        if (ok) {
+            if (strcmp(res.name, c.product) != 0) {
+                printf("SERVER: %s -> %s, expected %s\n", c.server, res.name, c.product);
+            }
+            CHECK(strcmp(res.name, c.product) == 0);
+            CHECK_EQ(res.source, DISCOVERY_SSDP);
+            CHECK_EQ(res.ip, SRC_IP);
+        }
+    }
+}
+
+static void testSsdpOtherReplies() {
+    DiscoveryResult res;
+
+    // Lower-case header name, bare LF line ends
+    CHECK(ssdp("HTTP/1.1 200 OK\nserver: Roku/9.4.0 UPnP/1.0 Roku/9.4.0\n\n", res));
+    CHECK(strcmp(res.name, "Roku") == 0);
+
+    // Notifications and errors are not search replies; no SERVER, no name
+    CHECK(!ssdp("NOTIFY * HTTP/1.1\r\nSERVER: Roku/9.4.0 UPnP/1.0 Roku/9.4.0\r\n\r\n", res));
+    CHECK(!ssdp("HTTP/1.1 404 Not Found\r\n\r\n", res));
+    CHECK(!ssdp("HTTP/1.1 200 OK\r\nST: upnp:rootdevice\r\n\r\n", res));
+
+    // A product name longer than the result is cut, not overrun
+    CHECK(ssdp("HTTP/1.1 200 OK\r\nSERVER: Linux UPnP/1.0 "
+               "AVeryLongProductNameThatDoesNotFitTheResult/1.0\r\n\r\n", res));
+    CHECK_EQ(strlen(res.name), DISCOVERY_NAME_LEN - 1);
+}
+
+int main() {
+    testMdnsQuery();
+    testMdnsPtrSrvA();
+    testMdnsSrvOnly();
+    testMdnsPrefersSenderAddress();
+    testMdnsMalformed();
+    testSsdpSearch();
+    testSsdpServerHeaders();
+    testSsdpOtherReplies();
+    return testResult("discovery_wire_test");
+}
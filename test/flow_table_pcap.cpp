@@ -0,0 +1,266 @@
+// Replays an Ethernet pcap through parseFlowFrame() and FlowTable the way
+// BandwidthTracker does on the AP netif, then prints the flows and the
+// parse + record throughput.
+//
+//     ./flow_table_pcap <capture.pcap> [ap-mac] [--check]
+//
+// Frames sent by ap-mac (default 02:00:00:00:00:01) are downloads to a
+// station, everything else is an upload. --check compares the result with
+// the totals expected for captures/flow_sample.pcap, which
+// captures/make_flow_capture.py writes; ctest runs it that way.
+
+#include "flow_table.h"
+#include "check.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+// Same values as config.h, which needs FreeRTOS headers
+static const uint16_t FLOW_CAPACITY = 128;
+static const uint32_t IDLE_TIMEOUT_MS = 120000;
+
+struct Frame {
+    uint32_t ms;  // Relative to the first frame
+    std::vector<uint8_t> data;
+};
+
+static bool readPcap(const char* path, std::vector<Frame>& frames) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+
+    uint32_t hdr[6];
+    if (fread(hdr, sizeof(hdr), 1, f) != 1 || hdr[0] != 0xA1B2C3D4 || hdr[5] != 1) {
+        fprintf(stderr, "%s: not a little-endian microsecond Ethernet pcap\n", path);
+        fclose(f);
+        return false;
+    }
+
+    uint64_t firstUs = 0;
+    uint32_t rec[4];
+    while (fread(rec, sizeof(rec), 1, f) == 1) {
+        Frame frame;
+        frame.data.resize(rec[2]);
+        if (rec[2] && fread(frame.data.data(), rec[2], 1, f) != 1) break;
+        uint64_t us = (uint64_t)rec[0] * 1000000 + rec[1];
+        if (frames.empty()) firstUs = us;
+        frame.ms = (uint32_t)((us - firstUs) / 1000);
+        frames.push_back(std::move(frame));
+    }
+    fclose(f);
+    return true;
+}
+
+static bool parseMac(const char* s, uint8_t mac[6]) {
+    unsigned v[6];
+    if (sscanf(s, "%x:%x:%x:%x:%x:%x", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) != 6) {
+        return false;
+    }
+    for (int i = 0; i < 6; i++) mac[i] = (uint8_t)v[i];
+    return true;
+}
+
+// Feed frames [from, to) to the table; returns how many were accounted
+static size_t replay(const std::vector<Frame>& frames, size_t from, size_t to,
+                     const uint8_t apMac[6], FlowTable& table) {
+    size_t accounted = 0;
+    for (size_t i = from; i < to; i++) {
+        const Frame& frame = frames[i];
+        if (frame.data.size() < 12) continue;
+        bool isUpload = memcmp(frame.data.data() + 6, apMac, 6) != 0;
+
+        // The tracker expires once a second; per frame gives the same result
+        table.expireIdle(frame.ms, IDLE_TIMEOUT_MS);
+
+        FlowEvent evt;
+        if (parseFlowFrame(frame.data.data(), (uint16_t)frame.data.size(), isUpload, evt)) {
+            table.record(evt, frame.ms);
+            accounted++;
+        }
+    }
+    return accounted;
+}
+
+static const char* ipString(uint32_t ip, char* buf) {
+    return inet_ntop(AF_INET, &ip, buf, INET_ADDRSTRLEN);
+}
+
+static void printFlows(const FlowTable& table) {
+    const FlowEntry* flows[FLOW_CAPACITY];
+    size_t n = table.topFlows(nullptr, flows, FLOW_CAPACITY);
+    for (size_t i = 0; i < n; i++) {
+        const FlowEntry* e = flows[i];
+        char local[INET_ADDRSTRLEN], remote[INET_ADDRSTRLEN];
+        printf("  %02x:%02x:%02x:%02x:%02x:%02x  proto %-2u  %s:%u -> %s:%u  "
+               "up %llu B/%u  down %llu B/%u\n",
+               e->mac[0], e->mac[1], e->mac[2], e->mac[3], e->mac[4], e->mac[5],
+               e->proto, ipString(e->localIP, local), e->localPort,
+               ipString(e->remoteIP, remote), e->remotePort,
+               (unsigned long long)e->uploadBytes, e->uploadPackets,
+               (unsigned long long)e->downloadBytes, e->downloadPackets);
+    }
+}
+
+static uint32_t ipv4(const char* s) {
+    uint32_t ip = 0;
+    inet_pton(AF_INET, s, &ip);
+    return ip;
+}
+
+static const FlowEntry* findFlow(const FlowTable& table, const char* local, uint16_t localPort,
+                                 const char* remote, uint16_t remotePort, uint8_t proto) {
+    const FlowEntry* flows[FLOW_CAPACITY];
+    size_t n = table.topFlows(nullptr, flows, FLOW_CAPACITY);
+    for (size_t i = 0; i < n; i++) {
+        const FlowEntry* e = flows[i];
+        if (e->localIP == ipv4(local) && e->localPort == localPort &&
+            e->remoteIP == ipv4(remote) && e->remotePort == remotePort && e->proto == proto) {
+            return e;
+        }
+    }
+    return nullptr;
+}
+
+#define CHECK_FLOW(table, local, lport, remote, rport, proto, up, upPkts, down, downPkts) do { \
+        const FlowEntry* _e = findFlow(table, local, lport, remote, rport, proto); \
+        CHECK(_e != nullptr); \
+        if (_e) { \
+            CHECK_EQ(_e->uploadBytes, up); \
+            CHECK_EQ(_e->uploadPackets, upPkts); \
+            CHECK_EQ(_e->downloadBytes, down); \
+            CHECK_EQ(_e->downloadPackets, downPkts); \
+        } \
+    } while (0)
+
+// Expected totals for flow_sample.pcap (IP total lengths)
+static void checkSample(const std::vector<Frame>& frames, const uint8_t apMac[6]) {
+    CHECK_EQ(frames.size(), 17);
+    if (frames.size() != 17) return;
+
+    FlowTable table;
+    CHECK(table.begin(FLOW_CAPACITY));
+
+    // Everything but the late DNS query; broadcast, ARP and IPv6 are skipped
+    CHECK_EQ(replay(frames, 0, 16, apMac, table), 13);
+    CHECK_EQ(table.size(), 6);
+    CHECK_FLOW(table, "192.168.4.2", 50000, "93.184.216.34", 443, 6, 637, 3, 1540, 2);
+    CHECK_FLOW(table, "192.168.4.2", 53000, "8.8.8.8", 53, 17, 60, 1, 124, 1);
+    CHECK_FLOW(table, "192.168.4.3", 0, "1.1.1.1", 0, 1, 84, 1, 84, 1);
+    CHECK_FLOW(table, "192.168.4.3", 51000, "93.184.216.34", 443, 6, 140, 1, 940, 1);
+    // Only the first fragment carries the UDP ports
+    CHECK_FLOW(table, "192.168.4.3", 40000, "162.159.200.1", 123, 17, 1500, 1, 0, 0);
+    CHECK_FLOW(table, "192.168.4.3", 0, "162.159.200.1", 0, 17, 120, 1, 0, 0);
+
+    FlowTalker talkers[8];
+    size_t n = table.topRemotes(nullptr, talkers, 8);
+    CHECK_EQ(n, 4);
+    if (n == 4) {
+        CHECK_EQ(talkers[0].remoteIP, ipv4("93.184.216.34"));
+        CHECK_EQ(talkers[0].totalBytes(), 637 + 1540 + 140 + 940);
+        CHECK_EQ(talkers[0].flows, 2);
+        CHECK_EQ(talkers[1].remoteIP, ipv4("162.159.200.1"));
+        CHECK_EQ(talkers[1].totalBytes(), 1620);
+        CHECK_EQ(talkers[2].remoteIP, ipv4("8.8.8.8"));
+        CHECK_EQ(talkers[3].remoteIP, ipv4("1.1.1.1"));
+    }
+
+    // Per-device filter
+    const uint8_t staA[6] = {0x3c, 0x07, 0x54, 0xa1, 0x0b, 0x01};
+    n = table.topRemotes(staA, talkers, 8);
+    CHECK_EQ(n, 2);
+    if (n == 2) {
+        CHECK_EQ(talkers[0].totalBytes(), 2177);
+        CHECK_EQ(talkers[1].totalBytes(), 184);
+    }
+
+    // 130 s later every flow has been idle past the timeout; the late query
+    // starts a new DNS flow instead of adding to the expired one
+    CHECK_EQ(replay(frames, 16, 17, apMac, table), 1);
+    CHECK_EQ(table.size(), 1);
+    CHECK_FLOW(table, "192.168.4.2", 53000, "8.8.8.8", 53, 17, 60, 1, 0, 0);
+    CHECK_EQ(table.evictions(), 0);
+}
+
+// Replays the accounted frames over and over, shifting the local port on
+// each pass so new flows keep arriving and the LRU eviction path runs too
+static void bench(const std::vector<Frame>& frames, const uint8_t apMac[6]) {
+    std::vector<FlowEvent> events;
+    for (const Frame& frame : frames) {
+        FlowEvent evt;
+        bool isUpload = frame.data.size() >= 12 &&
+                        memcmp(frame.data.data() + 6, apMac, 6) != 0;
+        if (parseFlowFrame(frame.data.data(), (uint16_t)frame.data.size(), isUpload, evt)) {
+            events.push_back(evt);
+        }
+    }
+    if (events.empty()) return;
+
+    FlowTable table;
+    table.begin(FLOW_CAPACITY);
+
+    const size_t packets = 2000000;
+    size_t passes = packets / events.size() + 1;
+    size_t done = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t pass = 0; pass < passes; pass++) {
+        for (const FlowEvent& base : events) {
+            FlowEvent evt = base;
+            evt.localPort = (uint16_t)(evt.localPort + (pass % 64));
+            table.record(evt, (uint32_t)done);
+            done++;
+        }
+    }
+    double recordSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t parsed = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t pass = 0; pass < passes; pass++) {
+        for (const Frame& frame : frames) {
+            FlowEvent evt;
+            parsed += parseFlowFrame(frame.data.data(), (uint16_t)frame.data.size(), true, evt);
+        }
+    }
+    double parseSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("record: %.1f M packets/s (%zu packets, %zu flows, %u evictions)\n",
+           done / recordSec / 1e6, done, table.size(), table.evictions());
+    printf("parse:  %.1f M frames/s\n", passes * frames.size() / parseSec / 1e6);
+    (void)parsed;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <capture.pcap> [ap-mac] [--check]\n", argv[0]);
+        return 2;
+    }
+
+    uint8_t apMac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+    bool check = false;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--check") == 0) {
+            check = true;
+        } else if (!parseMac(argv[i], apMac)) {
+            fprintf(stderr, "bad MAC address: %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    std::vector<Frame> frames;
+    if (!readPcap(argv[1], frames)) return 2;
+
+    FlowTable table;
+    table.begin(FLOW_CAPACITY);
+    size_t accounted = replay(frames, 0, frames.size(), apMac, table);
+    printf("%zu frames, %zu accounted, %zu flows at the end:\n",
+           frames.size(), accounted, table.size());
+    printFlows(table);
+    bench(frames, apMac);
+
+    if (!check) return 0;
+    checkSample(frames, apMac);
+    return testResult("flow_table_pcap");
+}
@@ -0,0 +1,83 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+// Host stand-in for the parts of the Arduino core that sketch sources under
+// test use. Serial output is discarded. millis() is a simulated clock that
+// tests set and vTaskDelay() (freertos/task.h) advances.
+
+#include <atomic>
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+class String {
+public:
+    String() {}
+    String(const char* s) : _s(s ? s : "") {}
+    String(const std::string& s) : _s(s) {}
+
+    const char* c_str() const { return _s.c_str(); }
+    unsigned length() const { return (unsigned)_s.size(); }
+
+    String substring(unsigned from) const { return String(_s.substr(from)); }
+    String substring(unsigned from, unsigned to) const { return String(_s.substr(from, to - from)); }
+    int indexOf(char c) const {
+        size_t pos = _s.find(c);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    bool startsWith(const String& prefix) const { return _s.compare(0, prefix._s.size(), prefix._s) == 0; }
+    void replace(const String& from, const String& to) {
+        if (from._s.empty()) return;
+        for (size_t pos = 0; (pos = _s.find(from._s, pos)) != std::string::npos; pos += to._s.size()) {
+            _s.replace(pos, from._s.size(), to._s);
+        }
+    }
+    bool endsWith(const String& suffix) const {
+        return _s.size() >= suffix._s.size() &&
+               _s.compare(_s.size() - suffix._s.size(), suffix._s.size(), suffix._s) == 0;
+    }
+
+    bool operator==(const String& other) const { return _s == other._s; }
+    String operator+(const char* other) const { return String(_s + other); }
+    String& operator+=(const char* other) {
+        _s += other;
+        return *this;
+    }
+
+private:
+    std::string _s;
+};
+
+class IPAddress {
+public:
+    IPAddress() : _addr(0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+        uint8_t bytes[4] = {a, b, c, d};
+        memcpy(&_addr, bytes, 4);
+    }
+    IPAddress(uint32_t addr) : _addr(addr) {}  // Network byte order, as on the ESP32
+    operator uint32_t() const { return _addr; }
+
+private:
+    uint32_t _addr;
+};
+
+class HostSerial {
+public:
+    void begin(unsigned long) {}
+    size_t print(const char*) { return 0; }
+    size_t println(const char* = "") { return 0; }
+    size_t printf(const char*, ...) { return 0; }
+};
+
+inline HostSerial Serial;
+
+#define PROGMEM
+
+inline std::atomic<uint32_t> hostMillis(0);
+inline uint32_t millis() { return hostMillis; }
+
+#endif // ARDUINO_H
@@ -0,0 +1,80 @@
+#ifndef HTTPCLIENT_H
+#define HTTPCLIENT_H
+
+#include <Arduino.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "WiFiClient.h"
+
+// Host stand-in for the Arduino HTTPClient: a blocking GET over a plain
+// socket to a numeric IPv4 address, enough to run resolvers against a
+// stand-in server on loopback. https URLs fail in begin().
+
+#define HTTP_CODE_OK 200
+#define HTTP_CODE_NOT_FOUND 404
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+
+class HTTPClient {
+public:
+    void setConnectTimeout(int32_t ms) { _timeoutMs = ms; }
+    void setTimeout(uint16_t ms) { _timeoutMs = ms; }
+
+    bool begin(WiFiClient& client, const String& url) {
+        std::string u = url.c_str();
+        if (client.secure() || u.compare(0, 7, "http://") != 0) return false;
+        size_t slash = u.find('/', 7);
+        std::string hostPort = u.substr(7, slash == std::string::npos ? std::string::npos : slash - 7);
+        _path = slash == std::string::npos ? "/" : u.substr(slash);
+        size_t colon = hostPort.find(':');
+        _host = hostPort.substr(0, colon);
+        _port = colon == std::string::npos ? 80 : (uint16_t)atoi(hostPort.c_str() + colon + 1);
+        return true;
+    }
+
+    int GET() {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) return HTTPC_ERROR_CONNECTION_REFUSED;
+        timeval tv = {_timeoutMs / 1000, (_timeoutMs % 1000) * 1000};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(_port);
+        if (inet_pton(AF_INET, _host.c_str(), &addr.sin_addr) != 1 ||
+            connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+            close(fd);
+            return HTTPC_ERROR_CONNECTION_REFUSED;
+        }
+
+        std::string req = "GET " + _path + " HTTP/1.1\r\nHost: " + _host + "\r\nConnection: close\r\n\r\n";
+        send(fd, req.data(), req.size(), 0);
+        std::string resp;
+        char buf[512];
+        ssize_t n;
+        while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+            resp.append(buf, n);
+        }
+        close(fd);
+
+        size_t body = resp.find("\r\n\r\n");
+        if (resp.compare(0, 9, "HTTP/1.1 ") != 0 && resp.compare(0, 9, "HTTP/1.0 ") != 0) {
+            return HTTPC_ERROR_CONNECTION_REFUSED;
+        }
+        _body = body == std::string::npos ? "" : resp.substr(body + 4);
+        return atoi(resp.c_str() + 9);
+    }
+
+    String getString() { return String(_body); }
+    void end() {}
+
+private:
+    std::string _host;
+    std::string _path;
+    std::string _body;
+    uint16_t _port = 80;
+    int32_t _timeoutMs = 5000;
+};
+
+#endif // HTTPCLIENT_H
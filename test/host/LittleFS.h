@@ -0,0 +1,51 @@
+#ifndef LITTLEFS_H
+#define LITTLEFS_H
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <string>
+
+// Host stand-in for LittleFS: paths are taken relative to root, a host
+// directory the test picks; begin() fails while root is empty
+
+class File {
+public:
+    File(FILE* f = nullptr) : _f(f) {}
+    explicit operator bool() const { return _f != nullptr; }
+
+    int available() {
+        int c = fgetc(_f);
+        if (c == EOF) return 0;
+        ungetc(c, _f);
+        return 1;
+    }
+
+    size_t readBytesUntil(char terminator, char* buf, size_t len) {
+        size_t n = 0;
+        int c;
+        while (n < len && (c = fgetc(_f)) != EOF && c != terminator) {
+            buf[n++] = (char)c;
+        }
+        return n;
+    }
+
+    void close() {
+        if (_f) fclose(_f);
+        _f = nullptr;
+    }
+
+private:
+    FILE* _f;
+};
+
+class HostLittleFS {
+public:
+    std::string root;
+
+    bool begin(bool) { return !root.empty(); }
+    File open(const char* path, const char* mode) { return File(fopen((root + path).c_str(), mode)); }
+};
+
+inline HostLittleFS LittleFS;
+
+#endif // LITTLEFS_H
@@ -0,0 +1,103 @@
+#ifndef PREFERENCES_H
+#define PREFERENCES_H
+
+#include <Arduino.h>
+#include <string.h>
+#include "fake_nvs.h"
+
+// Host stand-in for the Arduino Preferences API, backed by fakeNvs
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false) {
+        _ns = name;
+        _readOnly = readOnly;
+        return true;
+    }
+    void end() {}
+
+    bool isKey(const char* key) {
+        return entries().count(key) > 0;
+    }
+
+    bool remove(const char* key) {
+        return !_readOnly && entries().erase(key) > 0;
+    }
+
+    size_t putBytes(const char* key, const void* value, size_t len) {
+        if (_readOnly || !fakeNvs.write(_ns, key, value, len, true)) return 0;
+        return len;
+    }
+
+    size_t getBytesLength(const char* key) {
+        auto it = entries().find(key);
+        return it == entries().end() ? 0 : it->second.size();
+    }
+
+    size_t getBytes(const char* key, void* buf, size_t maxLen) {
+        auto it = entries().find(key);
+        if (it == entries().end() || it->second.size() > maxLen) return 0;
+        memcpy(buf, it->second.data(), it->second.size());
+        return it->second.size();
+    }
+
+    size_t putULong64(const char* key, uint64_t value) {
+        if (_readOnly || !fakeNvs.write(_ns, key, &value, sizeof(value), false)) return 0;
+        return sizeof(value);
+    }
+
+    uint64_t getULong64(const char* key, uint64_t defaultValue = 0) {
+        auto it = entries().find(key);
+        if (it == entries().end() || it->second.size() != sizeof(uint64_t)) return defaultValue;
+        uint64_t value;
+        memcpy(&value, it->second.data(), sizeof(value));
+        return value;
+    }
+
+    // Strings are stored with their NUL, as NVS does (charged like a blob)
+    size_t putString(const char* key, const char* value) {
+        size_t len = strlen(value) + 1;
+        if (_readOnly || !fakeNvs.write(_ns, key, value, len, true)) return 0;
+        return len - 1;
+    }
+    size_t putString(const char* key, const String& value) { return putString(key, value.c_str()); }
+
+    size_t getString(const char* key, char* value, size_t maxLen) {
+        auto it = entries().find(key);
+        if (it == entries().end() || it->second.size() > maxLen) return 0;
+        memcpy(value, it->second.data(), it->second.size());
+        return it->second.size();
+    }
+
+    String getString(const char* key, const String& defaultValue = String()) {
+        auto it = entries().find(key);
+        if (it == entries().end()) return defaultValue;
+        return String((const char*)it->second.data());
+    }
+
+    size_t putUShort(const char* key, uint16_t value) {
+        if (_readOnly || !fakeNvs.write(_ns, key, &value, sizeof(value), false)) return 0;
+        return sizeof(value);
+    }
+
+    uint16_t getUShort(const char* key, uint16_t defaultValue = 0) {
+        auto it = entries().find(key);
+        if (it == entries().end() || it->second.size() != sizeof(uint16_t)) return defaultValue;
+        uint16_t value;
+        memcpy(&value, it->second.data(), sizeof(value));
+        return value;
+    }
+
+    bool clear() {
+        if (_readOnly) return false;
+        entries().clear();
+        return true;
+    }
+
+private:
+    std::string _ns;
+    bool _readOnly = false;
+
+    FakeNvs::Namespace& entries() { return fakeNvs.namespaces[_ns]; }
+};
+
+#endif // PREFERENCES_H
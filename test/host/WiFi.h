@@ -0,0 +1,19 @@
+#ifndef WIFI_H
+#define WIFI_H
+
+#include <Arduino.h>
+
+// Host stand-in for the station status; tests set hostWiFiStatus
+
+typedef enum { WL_IDLE_STATUS = 0, WL_CONNECTED = 3, WL_DISCONNECTED = 6 } wl_status_t;
+
+inline std::atomic<int> hostWiFiStatus(WL_CONNECTED);
+
+class HostWiFi {
+public:
+    wl_status_t status() { return (wl_status_t)hostWiFiStatus.load(); }
+};
+
+inline HostWiFi WiFi;
+
+#endif // WIFI_H
@@ -0,0 +1,12 @@
+#ifndef WIFICLIENT_H
+#define WIFICLIENT_H
+
+// Host stand-in: HTTPClient (host/HTTPClient.h) opens its own socket, so the
+// client only carries the plain/TLS choice
+class WiFiClient {
+public:
+    virtual ~WiFiClient() {}
+    virtual bool secure() const { return false; }
+};
+
+#endif // WIFICLIENT_H
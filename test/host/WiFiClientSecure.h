@@ -0,0 +1,12 @@
+#ifndef WIFICLIENTSECURE_H
+#define WIFICLIENTSECURE_H
+
+#include "WiFiClient.h"
+
+class WiFiClientSecure : public WiFiClient {
+public:
+    void setInsecure() {}
+    bool secure() const override { return true; }
+};
+
+#endif // WIFICLIENTSECURE_H
@@ -0,0 +1,52 @@
+#ifndef FAKE_NVS_H
+#define FAKE_NVS_H
+
+#include <map>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// In-memory NVS partition behind the Preferences and nvs.h stand-ins.
+//
+// Writes are also charged the way NVS lays them out in flash, in 32-byte
+// entries: a primitive value takes one entry, a blob takes an index entry,
+// a chunk header entry and its data rounded up to whole entries.
+struct FakeNvs {
+    static const size_t ENTRY_SIZE = 32;
+
+    typedef std::map<std::string, std::vector<uint8_t>> Namespace;
+    std::map<std::string, Namespace> namespaces;
+
+    uint32_t flashBytes = 0;  // Entry bytes written since the last reset()
+    uint32_t writes = 0;
+    int failWrites = 0;       // Fail this many upcoming writes
+
+    void reset() {
+        namespaces.clear();
+        resetCounters();
+    }
+
+    void resetCounters() {
+        flashBytes = 0;
+        writes = 0;
+        failWrites = 0;
+    }
+
+    bool write(const std::string& ns, const char* key, const void* data, size_t len, bool blob) {
+        if (failWrites > 0) {
+            failWrites--;
+            return false;
+        }
+        const uint8_t* p = (const uint8_t*)data;
+        namespaces[ns][key].assign(p, p + len);
+        size_t entries = blob ? 2 + (len + ENTRY_SIZE - 1) / ENTRY_SIZE : 1;
+        flashBytes += entries * ENTRY_SIZE;
+        writes++;
+        return true;
+    }
+};
+
+inline FakeNvs fakeNvs;
+
+#endif // FAKE_NVS_H
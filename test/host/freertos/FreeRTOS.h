@@ -0,0 +1,78 @@
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+// Host stand-in for the FreeRTOS types and the task calls the sketch uses.
+// A task is a detached std::thread; direct-to-task notifications are a
+// counter and a condition variable per task. A critical section is a spin
+// on a flag (one lock for all of them would do as well on a host).
+
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY 0xFFFFFFFFu
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))  // 1 ms ticks
+
+struct portMUX_TYPE {
+    volatile bool locked;
+};
+#define portMUX_INITIALIZER_UNLOCKED {false}
+
+inline void portENTER_CRITICAL(portMUX_TYPE* mux) {
+    while (__atomic_test_and_set(&mux->locked, __ATOMIC_ACQUIRE)) {
+        std::this_thread::yield();
+    }
+}
+
+inline void portEXIT_CRITICAL(portMUX_TYPE* mux) {
+    __atomic_clear(&mux->locked, __ATOMIC_RELEASE);
+}
+
+struct HostTask {
+    std::mutex lock;
+    std::condition_variable wake;
+    uint32_t notifications = 0;
+};
+typedef HostTask* TaskHandle_t;
+
+inline thread_local HostTask* hostCurrentTask = nullptr;
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char*, uint32_t, void* param,
+                                          UBaseType_t, TaskHandle_t* handle, BaseType_t) {
+    HostTask* task = new HostTask();  // Lives as long as the process, like the task
+    if (handle) *handle = task;
+    std::thread([fn, param, task] {
+        hostCurrentTask = task;
+        fn(param);
+    }).detach();
+    return pdPASS;
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    std::lock_guard<std::mutex> guard(task->lock);
+    task->notifications++;
+    task->wake.notify_one();
+    return pdPASS;
+}
+
+// Only the blocking form (portMAX_DELAY) is supported
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t) {
+    HostTask* task = hostCurrentTask;
+    std::unique_lock<std::mutex> guard(task->lock);
+    task->wake.wait(guard, [task] { return task->notifications > 0; });
+    uint32_t value = task->notifications;
+    task->notifications = clearOnExit ? 0 : value - 1;
+    return value;
+}
+
+#endif // FREERTOS_H
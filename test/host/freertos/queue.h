@@ -0,0 +1,48 @@
+#ifndef FREERTOS_QUEUE_H
+#define FREERTOS_QUEUE_H
+
+#include <deque>
+#include <string.h>
+#include <vector>
+#include "FreeRTOS.h"
+
+// Host stand-in for FreeRTOS queues: items copied by value, bounded. Only
+// a zero timeout and portMAX_DELAY are supported.
+
+struct HostQueue {
+    std::mutex lock;
+    std::condition_variable changed;
+    std::deque<std::vector<uint8_t>> items;
+    size_t length;
+    size_t itemSize;
+};
+typedef HostQueue* QueueHandle_t;
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    HostQueue* q = new HostQueue();
+    q->length = length;
+    q->itemSize = itemSize;
+    return q;
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t wait) {
+    std::unique_lock<std::mutex> guard(q->lock);
+    if (wait == 0 && q->items.size() >= q->length) return pdFALSE;
+    q->changed.wait(guard, [q] { return q->items.size() < q->length; });
+    const uint8_t* p = (const uint8_t*)item;
+    q->items.emplace_back(p, p + q->itemSize);
+    q->changed.notify_all();
+    return pdTRUE;
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t wait) {
+    std::unique_lock<std::mutex> guard(q->lock);
+    if (wait == 0 && q->items.empty()) return pdFALSE;
+    q->changed.wait(guard, [q] { return !q->items.empty(); });
+    memcpy(item, q->items.front().data(), q->itemSize);
+    q->items.pop_front();
+    q->changed.notify_all();
+    return pdTRUE;
+}
+
+#endif // FREERTOS_QUEUE_H
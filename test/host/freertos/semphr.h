@@ -0,0 +1,27 @@
+#ifndef FREERTOS_SEMPHR_H
+#define FREERTOS_SEMPHR_H
+
+#include "FreeRTOS.h"
+
+// A mutex semaphore is a std::mutex; only blocking takes are supported
+
+struct HostSemaphore {
+    std::mutex lock;
+};
+typedef HostSemaphore* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return new HostSemaphore();
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t) {
+    sem->lock.lock();
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    sem->lock.unlock();
+    return pdTRUE;
+}
+
+#endif // FREERTOS_SEMPHR_H
@@ -0,0 +1,18 @@
+#ifndef FREERTOS_TASK_H
+#define FREERTOS_TASK_H
+
+#include <Arduino.h>
+#include "FreeRTOS.h"
+
+inline void taskYIELD() {
+    std::this_thread::yield();
+}
+
+// Advances the simulated millis() instead of sleeping, so waits of seconds
+// in the code under test take no real time
+inline void vTaskDelay(TickType_t ticks) {
+    hostMillis += ticks;
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+}
+
+#endif // FREERTOS_TASK_H
@@ -0,0 +1,62 @@
+#ifndef NVS_H
+#define NVS_H
+
+#include <string.h>
+#include "fake_nvs.h"
+
+// Host stand-in for the NVS entry iterator (ESP-IDF 5 signatures), over fakeNvs
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_ERR_NVS_NOT_FOUND 0x1102
+#define NVS_DEFAULT_PART_NAME "nvs"
+
+typedef enum { NVS_TYPE_ANY = 0xff } nvs_type_t;
+
+typedef struct {
+    char namespace_name[16];
+    char key[16];
+    nvs_type_t type;
+} nvs_entry_info_t;
+
+struct FakeNvsIterator {
+    std::string ns;
+    std::vector<std::string> keys;
+    size_t pos;
+};
+typedef FakeNvsIterator* nvs_iterator_t;
+
+inline esp_err_t nvs_entry_find(const char*, const char* ns, nvs_type_t, nvs_iterator_t* it) {
+    FakeNvsIterator* iter = new FakeNvsIterator{ns, {}, 0};
+    for (const auto& entry : fakeNvs.namespaces[ns]) {
+        iter->keys.push_back(entry.first);
+    }
+    if (iter->keys.empty()) {
+        delete iter;
+        *it = nullptr;
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    *it = iter;
+    return ESP_OK;
+}
+
+inline esp_err_t nvs_entry_next(nvs_iterator_t* it) {
+    if (++(*it)->pos < (*it)->keys.size()) return ESP_OK;
+    delete *it;
+    *it = nullptr;
+    return ESP_ERR_NVS_NOT_FOUND;
+}
+
+inline esp_err_t nvs_entry_info(nvs_iterator_t it, nvs_entry_info_t* info) {
+    memset(info, 0, sizeof(*info));
+    strncpy(info->namespace_name, it->ns.c_str(), sizeof(info->namespace_name) - 1);
+    strncpy(info->key, it->keys[it->pos].c_str(), sizeof(info->key) - 1);
+    info->type = NVS_TYPE_ANY;
+    return ESP_OK;
+}
+
+inline void nvs_release_iterator(nvs_iterator_t it) {
+    delete it;
+}
+
+#endif // NVS_H
@@ -0,0 +1,267 @@
+// Online vendor lookups on the host: createOUIResolver(), FileOUIResolver on
+// a host directory standing in for LittleFS, HttpOUIResolver against a
+// stand-in vendor API on loopback, and OUILookup's task end to end (dedup of
+// queued prefixes, the NVS cache, the miss cache and the bounded wait for the
+// uplink).
+//
+// millis() is simulated and vTaskDelay() advances it (test/host), so the
+// 30 s uplink wait and the request interval take no real time.
+
+#include "oui_lookup.h"
+#include "storage_manager.h"
+#include "check.h"
+#include <LittleFS.h>
+#include <WiFi.h>
+#include <arpa/inet.h>
+#include <map>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+// --- StorageManager: only the OUI settings, kept in memory ---
+
+StorageManager storage;
+StorageManager::StorageManager() {}
+
+static String savedURL;
+
+bool StorageManager::saveOUISettings(bool, const String& url) {
+    savedURL = url;
+    return true;
+}
+
+void StorageManager::loadOUISettings(bool& enabled, String& url, bool, const char*) {
+    enabled = false;
+    url = savedURL;
+}
+
+// --- Stand-in vendor API: GET /v/AA:BB:CC ---
+
+class VendorServer {
+public:
+    std::map<std::string, std::pair<int, std::string>> routes;  // path -> status, body
+    std::atomic<int> requests{0};
+    std::string lastPath;
+    uint16_t port = 0;
+
+    bool start() {
+        _fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(addr);
+        if (bind(_fd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(_fd, 8) != 0 ||
+            getsockname(_fd, (sockaddr*)&addr, &len) != 0) {
+            return false;
+        }
+        port = ntohs(addr.sin_port);
+        std::thread([this] { serve(); }).detach();
+        return true;
+    }
+
+    std::string url() const {
+        return "http://127.0.0.1:" + std::to_string(port) + "/v/%s";
+    }
+
+private:
+    int _fd = -1;
+
+    void serve() {
+        for (;;) {
+            int c = accept(_fd, nullptr, nullptr);
+            if (c < 0) return;
+            char buf[1024];
+            ssize_t n = recv(c, buf, sizeof(buf) - 1, 0);
+            buf[n > 0 ? n : 0] = '\0';
+            std::string req(buf);
+            std::string path = req.substr(4, req.find(' ', 4) - 4);  // "GET <path> HTTP/1.1"
+            lastPath = path;
+            auto it = routes.find(path);
+            int status = it == routes.end() ? 404 : it->second.first;
+            std::string body = it == routes.end() ? "{\"errors\":{\"detail\":\"Not Found\"}}" : it->second.second;
+            std::string resp = "HTTP/1.1 " + std::to_string(status) + " X\r\nContent-Length: " +
+                               std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+            requests++;
+            send(c, resp.data(), resp.size(), 0);
+            close(c);
+        }
+    }
+};
+
+static VendorServer server;
+
+static const uint8_t APPLE[6] = {0x3c, 0x07, 0x54, 0x11, 0x22, 0x33};
+static const uint8_t TELINK[6] = {0xa4, 0xc1, 0x38, 0x11, 0x22, 0x33};
+static const uint8_t UNKNOWN[6] = {0x00, 0x50, 0xc2, 0x11, 0x22, 0x33};
+static const uint8_t BROKEN[6] = {0x00, 0x1b, 0x63, 0x11, 0x22, 0x33};
+
+// --- Resolvers on their own ---
+
+static void testCreateResolver() {
+    OUIResolver* r = createOUIResolver("file:/oui.txt");
+    CHECK(r != nullptr && !r->usesNetwork());
+    delete r;
+    r = createOUIResolver("http://127.0.0.1/%s");
+    CHECK(r != nullptr && r->usesNetwork());
+    delete r;
+    r = createOUIResolver("https://api.macvendors.com/%s");
+    CHECK(r != nullptr && r->usesNetwork());
+    delete r;
+    CHECK(createOUIResolver("ftp://example.com/%s") == nullptr);
+    CHECK(createOUIResolver("") == nullptr);
+}
+
+static void testFileResolver() {
+    char vendor[OUI_NAME_MAX_LEN];
+    FileOUIResolver notMounted("/oui.txt");
+    std::string root = LittleFS.root;
+    LittleFS.root = "";
+    CHECK(!notMounted.resolve(APPLE, vendor, sizeof(vendor)));
+    LittleFS.root = root;
+
+    FileOUIResolver file("/oui.txt");
+    CHECK(file.resolve(APPLE, vendor, sizeof(vendor)));
+    CHECK(strcmp(vendor, "Apple, Inc.") == 0);
+    CHECK(file.resolve(TELINK, vendor, sizeof(vendor)));  // Lower case, tab, quotes
+    CHECK(strcmp(vendor, "Telink Semiconductor") == 0);
+    CHECK(!file.resolve(UNKNOWN, vendor, sizeof(vendor)));
+    CHECK(!file.resolve(BROKEN, vendor, sizeof(vendor)));  // Empty name
+
+    // Cut to the buffer
+    char small[6];
+    CHECK(file.resolve(APPLE, small, sizeof(small)));
+    CHECK(strcmp(small, "Apple") == 0);
+
+    FileOUIResolver missing("/none.txt");
+    CHECK(!missing.resolve(APPLE, vendor, sizeof(vendor)));
+}
+
+static void testHttpResolver() {
+    char vendor[OUI_NAME_MAX_LEN];
+    HttpOUIResolver http(server.url().c_str());
+    int before = server.requests;
+
+    CHECK(http.resolve(APPLE, vendor, sizeof(vendor)));
+    CHECK(strcmp(vendor, "Apple, Inc.") == 0);  // First line of the body only
+    CHECK(server.lastPath == "/v/3C:07:54");
+    CHECK(!http.resolve(UNKNOWN, vendor, sizeof(vendor)));  // 404
+    CHECK(!http.resolve(BROKEN, vendor, sizeof(vendor)));   // 500
+    CHECK_EQ(server.requests - before, 3);
+
+    HttpOUIResolver closed("http://127.0.0.1:1/v/%s");
+    CHECK(!closed.resolve(APPLE, vendor, sizeof(vendor)));
+}
+
+// --- OUILookup: queue, task and main-loop side ---
+
+static int callbacks = 0;
+static char lastVendor[OUI_NAME_MAX_LEN];
+
+static void onVendor(const uint8_t*, const char* vendor) {
+    callbacks++;
+    strncpy(lastVendor, vendor, sizeof(lastVendor) - 1);
+}
+
+// Run the main loop side until the task has answered `answers` more lookups
+static void settle(uint32_t answers) {
+    uint32_t target = ouiLookup.getResolvedCount() + ouiLookup.getFailedCount() + answers;
+    for (int i = 0; i < 5000 && ouiLookup.getResolvedCount() + ouiLookup.getFailedCount() < target; i++) {
+        ouiLookup.update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK_EQ(ouiLookup.getResolvedCount() + ouiLookup.getFailedCount(), target);
+    for (int i = 0; i < 20; i++) {  // The result is queued just after the count
+        ouiLookup.update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+static void testLookupTask() {
+    savedURL = server.url().c_str();
+    ouiLookup.onResolved(onVendor);
+    CHECK(ouiLookup.begin());
+    CHECK(ouiLookup.setOnline(true, server.url().c_str()));
+    hostWiFiStatus = WL_CONNECTED;
+
+    // A prefix already queued is not asked twice
+    int requests = server.requests;
+    ouiLookup.resolveAsync(APPLE);
+    ouiLookup.resolveAsync(APPLE);
+    settle(1);
+    CHECK_EQ(server.requests - requests, 1);
+    CHECK_EQ(callbacks, 1);
+    CHECK(strcmp(lastVendor, "Apple, Inc.") == 0);
+
+    // Asked again later, the NVS cache answers
+    ouiLookup.resolveAsync(APPLE);
+    settle(1);
+    CHECK_EQ(server.requests - requests, 1);
+    CHECK_EQ(callbacks, 2);
+
+    // A miss is remembered and not asked again
+    uint32_t failed = ouiLookup.getFailedCount();
+    ouiLookup.resolveAsync(UNKNOWN);
+    settle(1);
+    CHECK_EQ(server.requests - requests, 2);
+    CHECK_EQ(ouiLookup.getFailedCount(), failed + 1);
+    ouiLookup.resolveAsync(UNKNOWN);
+    ouiLookup.update();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ouiLookup.update();
+    CHECK_EQ(server.requests - requests, 2);
+    CHECK_EQ(ouiLookup.getFailedCount(), failed + 1);
+
+    // No uplink: the HTTP lookup waits OUI_UPLINK_WAIT_MS, then is a miss
+    hostWiFiStatus = WL_DISCONNECTED;
+    uint32_t start = millis();
+    ouiLookup.resolveAsync(TELINK);
+    settle(1);
+    uint32_t waited = millis() - start;
+    CHECK(waited >= OUI_UPLINK_WAIT_MS && waited < OUI_UPLINK_WAIT_MS + 2000);
+    CHECK_EQ(server.requests - requests, 2);
+    CHECK_EQ(ouiLookup.getFailedCount(), failed + 2);
+
+    // While it stays down, the next one misses at once
+    start = millis();
+    ouiLookup.resolveAsync(BROKEN);
+    settle(1);
+    CHECK(millis() - start < 1000);
+    CHECK_EQ(ouiLookup.getFailedCount(), failed + 3);
+
+    // A file: backend never waits for the uplink (and a new URL forgets misses)
+    CHECK(ouiLookup.setOnline(true, "file:/oui.txt"));
+    start = millis();
+    ouiLookup.resolveAsync(TELINK);
+    settle(1);
+    CHECK(millis() - start < OUI_REQUEST_INTERVAL_MS);
+    CHECK(strcmp(lastVendor, "Telink Semiconductor") == 0);
+
+    // Uplink back: HTTP lookups go out again
+    hostWiFiStatus = WL_CONNECTED;
+    CHECK(ouiLookup.setOnline(true, server.url().c_str()));
+    ouiLookup.resolveAsync(BROKEN);
+    settle(1);
+    CHECK_EQ(server.requests - requests, 3);
+}
+
+int main() {
+    char dir[] = "/tmp/oui_lookup_testXXXXXX";
+    CHECK(mkdtemp(dir) != nullptr);
+    LittleFS.root = dir;
+    FILE* f = fopen((LittleFS.root + "/oui.txt").c_str(), "w");
+    fputs("3C0754,Apple, Inc.\n"
+          "a4c138\t\"Telink Semiconductor\"  \n"
+          "001B63,\n", f);
+    fclose(f);
+
+    server.routes["/v/3C:07:54"] = {200, "Apple, Inc.\nsecond line\n"};
+    server.routes["/v/00:1B:63"] = {500, "Internal error"};
+    CHECK(server.start());
+
+    testCreateResolver();
+    testFileResolver();
+    testHttpResolver();
+    testLookupTask();
+    return testResult("oui_lookup_test");
+}
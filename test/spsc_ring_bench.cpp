@@ -0,0 +1,111 @@
+// Throughput of SpscRing against the ring it replaced (volatile int indices,
+// % RING_SIZE on every step), one producer and one consumer thread moving
+// PacketEvent-sized items. Not a ctest; run by hand:
+//
+//     ./spsc_ring_bench [millions of items]
+//
+// The old ring has no fences and is only correct on x86-like hardware;
+// it is here for the timing, not as a reference for behaviour.
+
+#include "spsc_ring.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+struct PacketEvent {
+    uint8_t mac[6];
+    uint16_t length;
+    bool isUpload;
+};
+
+static const size_t RING_SIZE = 256;
+
+// The baseline BandwidthTracker ring
+class VolatileRing {
+public:
+    bool push(const PacketEvent& e) {
+        int next = (_head + 1) % RING_SIZE;
+        if (next == _tail) return false;
+        _ring[_head] = e;
+        _head = next;
+        return true;
+    }
+    bool pop(PacketEvent& out) {
+        if (_tail == _head) return false;
+        out = _ring[_tail];
+        _tail = (_tail + 1) % RING_SIZE;
+        return true;
+    }
+private:
+    PacketEvent _ring[RING_SIZE];
+    volatile int _head = 0;
+    volatile int _tail = 0;
+};
+
+template <typename Push, typename Drain>
+static double run(size_t items, Push push, Drain drain) {
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([&] {
+        PacketEvent e;
+        memset(&e, 0, sizeof(e));
+        for (size_t i = 0; i < items; i++) {
+            e.length = (uint16_t)i;
+            while (!push(e)) {
+                std::this_thread::yield();  // Also keeps a single-core host moving
+            }
+        }
+    });
+    size_t got = 0;
+    uint64_t sum = 0;
+    while (got < items) {
+        size_t n = drain(sum);
+        if (n == 0) std::this_thread::yield();
+        got += n;
+    }
+    producer.join();
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (sum == 0 && items > 1) printf("(checksum %llu)\n", (unsigned long long)sum);
+    return items / s / 1e6;
+}
+
+int main(int argc, char** argv) {
+    size_t items = (argc > 1 ? strtoul(argv[1], nullptr, 10) : 20) * 1000000UL;
+
+    static VolatileRing oldRing;
+    double oldRate = run(items,
+        [](const PacketEvent& e) { return oldRing.push(e); },
+        [](uint64_t& sum) -> size_t {
+            PacketEvent e;
+            size_t n = 0;
+            while (oldRing.pop(e)) { sum += e.length; n++; }
+            return n;
+        });
+
+    static SpscRing<PacketEvent, RING_SIZE> newRing;
+    double newRate = run(items,
+        [](const PacketEvent& e) { return newRing.push(e); },
+        [](uint64_t& sum) -> size_t {
+            PacketEvent e;
+            size_t n = 0;
+            while (newRing.pop(e)) { sum += e.length; n++; }
+            return n;
+        });
+
+    static SpscRing<PacketEvent, RING_SIZE> batchRing;
+    double batchRate = run(items,
+        [](const PacketEvent& e) { return batchRing.push(e); },
+        [](uint64_t& sum) -> size_t {
+            PacketEvent batch[32];  // As BandwidthTracker drains
+            size_t n = batchRing.popBatch(batch, 32);
+            for (size_t i = 0; i < n; i++) sum += batch[i].length;
+            return n;
+        });
+
+    printf("%zu M items, 1 producer + 1 consumer thread\n", items / 1000000);
+    printf("volatile int ring, %% RING_SIZE   %7.1f M items/s\n", oldRate);
+    printf("SpscRing push/pop               %7.1f M items/s\n", newRate);
+    printf("SpscRing push/popBatch(32)      %7.1f M items/s\n", batchRate);
+    return 0;
+}
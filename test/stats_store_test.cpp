@@ -0,0 +1,244 @@
+// StatsStore on an in-memory NVS (test/host): write amplification of the
+// journal against rewriting every device, reload after the journal and after
+// an interrupted compaction, a failed journal write, and migration of the
+// per-device keys older firmware wrote.
+//
+// Each "boot" is a fresh StatsStore over the same fakeNvs contents. The
+// writer task is a real thread, so saves go through acquire()/submit() and
+// the test waits for busy() to clear, as the main loop would.
+
+#include "stats_store.h"
+#include "check.h"
+#include <thread>
+
+// Record layout of the older per-device blobs (stats_store.cpp)
+struct LegacyStatsRecord {
+    uint64_t uploadBytes;
+    uint64_t downloadBytes;
+    QuotaConfig quotaConfig;
+    QuotaUsage quota;
+};
+
+// Bytes the original firmware wrote per device on every save: the "_up"
+// and "_dn" counters, one entry each
+static const uint32_t LEGACY_BYTES_PER_DEVICE = 2 * FakeNvs::ENTRY_SIZE;
+
+static void deviceMac(uint8_t* mac, int n) {
+    const uint8_t base[6] = {0x3c, 0x07, 0x54, 0xa1, 0x00, 0x00};
+    memcpy(mac, base, 6);
+    mac[4] = (uint8_t)(n >> 8);
+    mac[5] = (uint8_t)n;
+}
+
+static void fillRecord(DeviceStatsRecord& r, int n, uint64_t bytes) {
+    memset(&r, 0, sizeof(r));
+    deviceMac(r.mac, n);
+    r.uploadBytes = bytes;
+    r.downloadBytes = bytes * 2;
+}
+
+// A new store, as after a reboot (the old one's task stays parked)
+static StatsStore* boot(std::vector<DeviceStatsRecord>& out) {
+    StatsStore* store = new StatsStore();
+    CHECK(store->begin(out));
+    return store;
+}
+
+static void waitIdle(StatsStore* store) {
+    while (store->busy()) {
+        std::this_thread::yield();
+    }
+}
+
+// Save devices [first, first + count) with the given counter value
+static bool save(StatsStore* store, int first, int count, uint64_t bytes, bool full) {
+    StatsSnapshot* snapshot = store->acquire();
+    CHECK(snapshot != nullptr);
+    if (!snapshot) return false;
+    snapshot->full = full;
+    snapshot->count = (uint8_t)count;
+    for (int i = 0; i < count; i++) {
+        fillRecord(snapshot->records[i], first + i, bytes);
+    }
+    bool ok = store->submit();
+    waitIdle(store);
+    return ok;
+}
+
+static uint64_t uploadOf(const std::vector<DeviceStatsRecord>& records, int n) {
+    uint8_t mac[6];
+    deviceMac(mac, n);
+    for (const auto& r : records) {
+        if (memcmp(r.mac, mac, 6) == 0) return r.uploadBytes;
+    }
+    return UINT64_MAX;
+}
+
+// devices saved in full once, then saves rounds of 2 changed devices each,
+// every journal-full save being a base rewrite. Returns average flash bytes per save.
+static uint32_t runSaves(int devices, int saves) {
+    fakeNvs.reset();
+    std::vector<DeviceStatsRecord> out;
+    StatsStore* store = boot(out);
+    CHECK(out.empty());
+    CHECK(store->needsFull());
+    save(store, 0, devices, 1, true);
+    CHECK(!store->needsFull());
+
+    fakeNvs.resetCounters();
+    uint32_t before = store->getBytesWritten();
+    for (int s = 0; s < saves; s++) {
+        if (store->needsFull()) {
+            save(store, 0, devices, 100 + s, true);
+        } else {
+            uint32_t flash = fakeNvs.flashBytes;
+            save(store, (2 * s) % devices, 2, 100 + s, false);
+            // One journal blob: header + 2 records (152 bytes) = 7 entries
+            CHECK_EQ(fakeNvs.flashBytes - flash, 7 * FakeNvs::ENTRY_SIZE);
+        }
+    }
+
+    // The store's own estimate matches what the fake partition counted
+    CHECK_EQ(store->getBytesWritten() - before, fakeNvs.flashBytes);
+    CHECK_EQ(fakeNvs.writes, (uint32_t)saves);
+    return fakeNvs.flashBytes / saves;
+}
+
+static void testWriteAmplification() {
+    const int saves = 90;
+    for (int devices : {16, MAX_DEVICES}) {
+        uint32_t perSave = runSaves(devices, saves);
+        uint32_t legacy = devices * LEGACY_BYTES_PER_DEVICE;
+        printf("%2d devices, 2 changed per save: %u flash bytes/save, %u rewriting every device (%.1fx)\n",
+               devices, perSave, legacy, (double)legacy / perSave);
+        CHECK(perSave * 2 < legacy);
+
+        // The README quotes about 340 bytes per save for 16 devices
+        if (devices == 16) CHECK(perSave >= 330 && perSave <= 350);
+    }
+}
+
+static void testReloadReplaysJournal() {
+    fakeNvs.reset();
+    std::vector<DeviceStatsRecord> out;
+    StatsStore* store = boot(out);
+    save(store, 0, 8, 10, true);
+    save(store, 0, 1, 20, false);
+    save(store, 1, 2, 30, false);
+    save(store, 0, 1, 40, false);
+
+    StatsStore* again = boot(out);
+    CHECK_EQ(out.size(), 8);
+    CHECK_EQ(uploadOf(out, 0), 40);
+    CHECK_EQ(uploadOf(out, 1), 30);
+    CHECK_EQ(uploadOf(out, 2), 30);
+    CHECK_EQ(uploadOf(out, 3), 10);
+    CHECK(!again->needsFull());
+
+    // The next journal blob continues after the three replayed ones
+    save(again, 5, 1, 50, false);
+    CHECK(fakeNvs.namespaces[NVS_NAMESPACE_STATS].count("j3") == 1);
+    boot(out);
+    CHECK_EQ(uploadOf(out, 5), 50);
+    CHECK_EQ(uploadOf(out, 0), 40);
+}
+
+static void testStaleJournalAfterCompaction() {
+    fakeNvs.reset();
+    std::vector<DeviceStatsRecord> out;
+    StatsStore* store = boot(out);
+    save(store, 0, 4, 10, true);
+    save(store, 0, 1, 20, false);  // j0
+    save(store, 1, 1, 30, false);  // j1
+
+    // Base rewritten with older values (e.g. after a reset); j0/j1 are still
+    // in flash with lower generations and must not be replayed over it
+    save(store, 0, 4, 5, true);
+    boot(out);
+    CHECK_EQ(uploadOf(out, 0), 5);
+    CHECK_EQ(uploadOf(out, 1), 5);
+}
+
+static void testFailedJournalWrite() {
+    fakeNvs.reset();
+    std::vector<DeviceStatsRecord> out;
+    StatsStore* store = boot(out);
+    save(store, 0, 4, 10, true);
+
+    fakeNvs.failWrites = 1;
+    save(store, 2, 1, 20, false);
+    CHECK(store->needsFull());  // Lost change: everything is rewritten next
+    save(store, 0, 4, 30, true);
+    CHECK(!store->needsFull());
+    boot(out);
+    CHECK_EQ(uploadOf(out, 2), 30);
+}
+
+static void testLegacyMigration() {
+    fakeNvs.reset();
+    Preferences prefs;
+    prefs.begin(NVS_NAMESPACE_STATS);
+
+    LegacyStatsRecord legacy;
+    memset(&legacy, 0, sizeof(legacy));
+    legacy.uploadBytes = 1111;
+    legacy.downloadBytes = 2222;
+    legacy.quotaConfig.dailyBytes = 5000000;
+    prefs.putBytes("3c0754a10001", &legacy, sizeof(legacy));
+
+    // Oldest format: two counters per device
+    prefs.putULong64("3c0754a10002_up", 333);
+    prefs.putULong64("3c0754a10002_dn", 444);
+
+    // A journal blob left without a base, and an unrelated key
+    StatsSnapshot journal;
+    memset(&journal, 0, sizeof(journal));
+    journal.generation = 1;
+    journal.recordSize = sizeof(DeviceStatsRecord);
+    journal.count = 1;
+    fillRecord(journal.records[0], 3, 777);
+    prefs.putBytes("j0", &journal, offsetof(StatsSnapshot, records) + sizeof(DeviceStatsRecord));
+    prefs.putULong64("version", 2);
+
+    std::vector<DeviceStatsRecord> out;
+    StatsStore* store = boot(out);
+    CHECK_EQ(out.size(), 3);
+    CHECK_EQ(uploadOf(out, 1), 1111);
+    CHECK_EQ(uploadOf(out, 2), 333);
+    CHECK_EQ(uploadOf(out, 3), 777);
+    for (const auto& r : out) {
+        if (r.uploadBytes == 1111) CHECK_EQ(r.quotaConfig.dailyBytes, 5000000);
+        if (r.uploadBytes == 333) CHECK_EQ(r.downloadBytes, 444);
+    }
+    CHECK(store->needsFull());
+
+    // The first full write drops only the per-device keys
+    StatsSnapshot* snapshot = store->acquire();
+    CHECK(snapshot != nullptr);
+    if (!snapshot) return;
+    snapshot->full = true;
+    snapshot->count = (uint8_t)out.size();
+    for (size_t i = 0; i < out.size(); i++) snapshot->records[i] = out[i];
+    store->submit();
+    waitIdle(store);
+
+    FakeNvs::Namespace& ns = fakeNvs.namespaces[NVS_NAMESPACE_STATS];
+    CHECK_EQ(ns.count("3c0754a10001"), 0);
+    CHECK_EQ(ns.count("3c0754a10002_up"), 0);
+    CHECK_EQ(ns.count("3c0754a10002_dn"), 0);
+    CHECK_EQ(ns.count("version"), 1);
+    CHECK_EQ(ns.count("base"), 1);
+
+    boot(out);
+    CHECK_EQ(out.size(), 3);
+    CHECK_EQ(uploadOf(out, 3), 777);
+}
+
+int main() {
+    testWriteAmplification();
+    testReloadReplaysJournal();
+    testStaleJournalAfterCompaction();
+    testFailedJournalWrite();
+    testLegacyMigration();
+    return testResult("stats_store_test");
+}
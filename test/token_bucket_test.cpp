@@ -0,0 +1,135 @@
+// TokenBucket against a simulated microsecond clock: the achieved rate at
+// the shaper's 100 / 1000 / 10000 kbit/s settings, the initial burst, the
+// burst cap after idling, and the refill edge cases.
+
+#include "token_bucket.h"
+#include "check.h"
+
+// Same as config.h / TrafficShaper::burstFor(), which need Arduino headers
+static const uint32_t SHAPER_BURST_MS = 250;
+static const uint32_t SHAPER_MIN_BURST = 3028;
+
+static uint32_t bytesPerSec(uint32_t kbps) {
+    return kbps * 1000 / 8;
+}
+
+static uint32_t burstFor(uint32_t bps) {
+    uint32_t burst = (uint32_t)((uint64_t)bps * SHAPER_BURST_MS / 1000);
+    return burst < SHAPER_MIN_BURST ? SHAPER_MIN_BURST : burst;
+}
+
+// Deterministic frame sizes (LCG), 64..1514 bytes
+static uint32_t nextSize(uint32_t& seed) {
+    seed = seed * 1664525u + 1013904223u;
+    return 64 + (seed >> 8) % (1514 - 64 + 1);
+}
+
+// A sender offering far more than the limit, one frame attempt every stepUs
+// for durationUs. Returns the bytes the bucket let through.
+static uint64_t offer(TokenBucket& bucket, uint64_t& nowUs, uint64_t durationUs,
+                      uint64_t stepUs, uint32_t& seed, uint32_t& largest) {
+    uint64_t passed = 0;
+    uint64_t end = nowUs + durationUs;
+    for (; nowUs < end; nowUs += stepUs) {
+        uint32_t size = nextSize(seed);
+        if (size > largest) largest = size;
+        if (bucket.consume(size, nowUs)) passed += size;
+    }
+    return passed;
+}
+
+static void testRate(uint32_t kbps) {
+    const uint32_t bps = bytesPerSec(kbps);
+    const uint32_t burst = burstFor(bps);
+    const uint64_t stepUs = 50;
+    const uint64_t seconds = 60;
+
+    TokenBucket bucket;
+    uint64_t nowUs = 1000;
+    bucket.configure(bps, burst, nowUs);
+
+    // The first attempts drain the full bucket at once
+    uint32_t seed = kbps, largest = 0;
+    uint64_t first = offer(bucket, nowUs, stepUs, stepUs, seed, largest);
+    CHECK(first > 0 && first <= burst);
+
+    // Over a minute of saturation at most burst + rate * time gets through,
+    // and the shortfall is at most one frame plus one step of refill
+    uint64_t passed = first + offer(bucket, nowUs, seconds * 1000000 - stepUs, stepUs, seed, largest);
+    uint64_t ceiling = burst + (uint64_t)bps * seconds;
+    uint64_t slack = largest + bps * stepUs / 1000000 + 1;
+    CHECK(passed <= ceiling);
+    CHECK(passed + slack >= ceiling);
+
+    // Steady state, bucket already drained (less than a frame carried over):
+    // achieved rate within 0.5%
+    uint64_t steady = offer(bucket, nowUs, seconds * 1000000, stepUs, seed, largest);
+    double achieved = (double)steady / seconds;
+    CHECK(steady <= (uint64_t)bps * seconds + largest);
+    CHECK(achieved >= bps * 0.995);
+    CHECK(achieved <= bps * 1.005);
+
+    printf("%5u kbit/s: limit %u B/s, achieved %.1f B/s (%.3f%%), burst %u B\n",
+           kbps, bps, achieved, achieved * 100.0 / bps, burst);
+}
+
+static void testIdleRefillCapsAtBurst() {
+    const uint32_t bps = bytesPerSec(1000);
+    const uint32_t burst = burstFor(bps);
+    TokenBucket bucket;
+    bucket.configure(bps, burst, 0);
+
+    CHECK_EQ(bucket.available(0), burst);
+    CHECK(bucket.consume(burst, 0));
+    CHECK(!bucket.consume(1, 0));
+
+    // Half the burst period refills half the burst
+    CHECK_EQ(bucket.available(125000), burst / 2);
+
+    // An hour idle fills it only to the burst size
+    CHECK_EQ(bucket.available(3600ULL * 1000000), burst);
+    CHECK(!bucket.consume(burst + 1, 3600ULL * 1000000));
+
+    // A clock that goes backwards credits nothing
+    CHECK(bucket.consume(burst, 3600ULL * 1000000));
+    CHECK_EQ(bucket.available(1000), 0);
+}
+
+static void testRefillIsExact() {
+    // 100 kbit/s = 12500 B/s = 1 byte per 80 us, refilled over many tiny steps
+    TokenBucket bucket;
+    bucket.configure(bytesPerSec(100), 100, 0);
+    CHECK(bucket.consume(100, 0));
+    uint64_t now = 0;
+    for (int i = 0; i < 80; i++) {
+        now += 1;
+        bucket.available(now);
+    }
+    CHECK_EQ(bucket.available(now), 1);
+    CHECK(bucket.consume(1, now));
+    CHECK(!bucket.consume(1, now + 79));
+    CHECK(bucket.consume(1, now + 80));
+}
+
+static void testUnlimitedAndHighRates() {
+    TokenBucket bucket;
+    bucket.configure(0, 0, 0);
+    CHECK(bucket.unlimited());
+    CHECK(bucket.consume(UINT32_MAX, 0));
+
+    // 1 Gbit/s after a very long idle must not overflow elapsed * rate
+    const uint32_t bps = bytesPerSec(1000000);
+    bucket.configure(bps, burstFor(bps), 0);
+    CHECK(bucket.consume(burstFor(bps), 0));
+    CHECK_EQ(bucket.available(UINT64_MAX / 2), burstFor(bps));
+}
+
+int main() {
+    testRate(100);
+    testRate(1000);
+    testRate(10000);
+    testIdleRefillCapsAtBurst();
+    testRefillIsExact();
+    testUnlimitedAndHighRates();
+    return testResult("token_bucket_test");
+}
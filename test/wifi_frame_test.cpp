@@ -0,0 +1,206 @@
+// wifiParseDataFrame() and WifiSeqDedup against 802.11 frames as the
+// promiscuous callback receives them (MAC header through FCS).
+//
+// The frames are written out byte by byte from the IEEE 802.11 frame
+// formats: frame control, duration, addresses, sequence control, QoS/HT
+// control, then the WEP/TKIP/CCMP header, an LLC/SNAP + IPv4 payload, the
+// MIC/ICV and the FCS. The payload bytes are zero-filled to a known length
+// so the expected MSDU size is exact.
+
+#include "wifi_frame.h"
+#include "check.h"
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+static const uint8_t BSSID[6] = {0x24, 0x0a, 0xc4, 0x11, 0x22, 0x33};
+static const uint8_t STA[6] = {0x3c, 0x07, 0x54, 0xa1, 0x0b, 0x01};
+static const uint8_t OTHER_STA[6] = {0xa4, 0xc1, 0x38, 0x22, 0x0c, 0x02};
+
+typedef std::vector<uint8_t> Bytes;
+
+static Bytes hex(const char* s) {
+    Bytes out;
+    while (*s) {
+        char* end;
+        unsigned long v = strtoul(s, &end, 16);
+        if (end == s) break;
+        out.push_back((uint8_t)v);
+        s = end;
+    }
+    return out;
+}
+
+// head, then payloadLen bytes of MSDU (starting with LLC/SNAP for IPv4), then tail
+static Bytes frame(const char* head, uint16_t payloadLen, const char* tail) {
+    Bytes f = hex(head);
+    Bytes snap = hex("aa aa 03 00 00 00 08 00");
+    for (uint16_t i = 0; i < payloadLen; i++) {
+        f.push_back(i < snap.size() ? snap[i] : 0);
+    }
+    Bytes t = hex(tail);
+    f.insert(f.end(), t.begin(), t.end());
+    return f;
+}
+
+static WifiFrameResult parse(const Bytes& f, const uint8_t* bssid, WifiFrameInfo& info) {
+    return wifiParseDataFrame(f.data(), (uint16_t)f.size(), bssid, info);
+}
+
+static void testCcmpQosUpload() {
+    // QoS data, To-DS + Protected, TID 0; CCMP header PN 0x000000000105, key 0
+    Bytes f = frame("88 41 2c 00"
+                    " 24 0a c4 11 22 33  3c 07 54 a1 0b 01  24 0a c4 11 22 33"
+                    " 50 1c  00 00"
+                    " 05 01 00 20 00 00 00 00",
+                    112,
+                    "de ad be ef de ad be ef  12 34 56 78");  // MIC, FCS
+    WifiFrameInfo info;
+    CHECK_EQ(parse(f, BSSID, info), WIFI_FRAME_OK);
+    CHECK_EQ(info.headerLen, 26);
+    CHECK_EQ(info.msduLen, 112);
+    CHECK(info.isUpload);
+    CHECK(!info.retry);
+    CHECK(memcmp(info.station, STA, 6) == 0);
+    CHECK(memcmp(info.receiver, BSSID, 6) == 0);
+    CHECK_EQ(info.seqCtrl, 0x1c50);
+}
+
+static void testOpenDownload() {
+    // Plain data, From-DS, no protection: addr1 = station, addr2 = BSSID
+    Bytes f = frame("08 02 3a 01"
+                    " 3c 07 54 a1 0b 01  24 0a c4 11 22 33  c0 a8 04 01 00 00"
+                    " 10 00",
+                    60,
+                    "9a bc de f0");
+    WifiFrameInfo info;
+    CHECK_EQ(parse(f, BSSID, info), WIFI_FRAME_OK);
+    CHECK_EQ(info.headerLen, 24);
+    CHECK_EQ(info.msduLen, 60);
+    CHECK(!info.isUpload);
+    CHECK(memcmp(info.station, STA, 6) == 0);
+    CHECK(memcmp(info.transmitter, BSSID, 6) == 0);
+}
+
+static void testTkip() {
+    // QoS data, To-DS + Protected; TKIP IV: TSC1, WEPSeed = (TSC1 | 0x20) & 0x7F,
+    // TSC0, key id | ExtIV, then TSC2..5
+    Bytes f = frame("88 41 2c 00"
+                    " 24 0a c4 11 22 33  3c 07 54 a1 0b 01  24 0a c4 11 22 33"
+                    " 60 1c  00 00"
+                    " 00 20 07 20 00 00 00 00",
+                    50,
+                    "01 02 03 04 05 06 07 08  a1 a2 a3 a4  12 34 56 78");  // MIC, ICV, FCS
+    WifiFrameInfo info;
+    CHECK_EQ(parse(f, BSSID, info), WIFI_FRAME_OK);
+    CHECK_EQ(info.msduLen, 50);
+
+    // Same frame whose second IV byte is not the TKIP WEPSeed reads as CCMP
+    f[27] = 0x00;
+    CHECK_EQ(parse(f, BSSID, info), WIFI_FRAME_OK);
+    CHECK_EQ(info.msduLen, 54);
+}
+
+static void testWep() {
+    // Data, To-DS + Protected; WEP IV (3 bytes) + key id, ICV
+    Bytes f = frame("08 41 2c 00"
+                    " 24 0a c4 11 22 33  3c 07 54 a1 0b 01  24 0a c4 11 22 33"
+                    " 70 1c"
+                    " 11 22 33 00",
+                    40,
+                    "a1 a2 a3 a4  12 34 56 78");
+    WifiFrameInfo info;
+    CHECK_EQ(parse(f, BSSID, info), WIFI_FRAME_OK);
+    CHECK_EQ(info.headerLen, 24);
+    CHECK_EQ(info.msduLen, 40);
+}
+
+static void testHtControl() {
+    // QoS data, To-DS + Order: 4 bytes of HT control after QoS control
+    Bytes f = frame("88 81 2c 00"
+                    " 24 0a c4 11 22 33  3c 07 54 a1 0b 01  24 0a c4 11 22 33"
+                    " 80 1c  05 00  00 00 00 00",
+                    20,
+                    "12 34 56 78");
+    WifiFrameInfo info;
+    CHECK_EQ(parse(f, BSSID, info), WIFI_FRAME_OK);
+    CHECK_EQ(info.headerLen, 30);
+    CHECK_EQ(info.msduLen, 20);
+}
+
+static void testRejected() {
+    WifiFrameInfo info;
+    const char* addrs = " 24 0a c4 11 22 33  3c 07 54 a1 0b 01  24 0a c4 11 22 33 90 1c";
+
+    // Null data and QoS null (power save signalling, no MSDU)
+    Bytes nullData = frame((std::string("48 11 2c 00") + addrs).c_str(), 0, "12 34 56 78");
+    CHECK_EQ(parse(nullData, BSSID, info), WIFI_FRAME_NO_PAYLOAD);
+    Bytes qosNull = frame((std::string("c8 01 2c 00") + addrs + " 00 00").c_str(), 0, "12 34 56 78");
+    CHECK_EQ(parse(qosNull, BSSID, info), WIFI_FRAME_NO_PAYLOAD);
+
+    // Beacon (management)
+    Bytes beacon = frame("80 00 00 00  ff ff ff ff ff ff  24 0a c4 11 22 33  24 0a c4 11 22 33 a0 1c",
+                         36, "12 34 56 78");
+    CHECK_EQ(parse(beacon, BSSID, info), WIFI_FRAME_NOT_DATA);
+
+    // IBSS (no DS bits) and WDS (both DS bits)
+    Bytes ibss = frame((std::string("08 00 2c 00") + addrs).c_str(), 40, "12 34 56 78");
+    CHECK_EQ(parse(ibss, BSSID, info), WIFI_FRAME_NOT_INFRA);
+    Bytes wds = frame((std::string("08 03 2c 00") + addrs + " 3c 07 54 a1 0b 09").c_str(), 40,
+                      "12 34 56 78");
+    CHECK_EQ(parse(wds, BSSID, info), WIFI_FRAME_NOT_INFRA);
+
+    // A neighbouring network's upload; accepted when no BSSID filter is given
+    Bytes foreign = frame("08 01 2c 00  de ad be ef 00 01  3c 07 54 a1 0b 01  de ad be ef 00 01 b0 1c",
+                          40, "12 34 56 78");
+    CHECK_EQ(parse(foreign, BSSID, info), WIFI_FRAME_FOREIGN_BSS);
+    CHECK_EQ(parse(foreign, nullptr, info), WIFI_FRAME_OK);
+
+    // Truncated: header without FCS, and a CCMP frame too short for its header and MIC
+    Bytes shortFrame = hex("08 01 2c 00  24 0a c4 11 22 33  3c 07 54 a1 0b 01  24 0a c4 11 22 33 c0 1c");
+    CHECK_EQ(parse(shortFrame, BSSID, info), WIFI_FRAME_SHORT);
+    Bytes cutCcmp = hex("88 41 2c 00  24 0a c4 11 22 33  3c 07 54 a1 0b 01  24 0a c4 11 22 33"
+                        " d0 1c  00 00  05 01 00 20 00 00 00 00  12 34 56 78");
+    CHECK_EQ(parse(cutCcmp, BSSID, info), WIFI_FRAME_SHORT);
+}
+
+static void testRetryDedup() {
+    // The CCMP upload above, then the same frame retransmitted (Retry bit set)
+    Bytes first = frame("88 41 2c 00"
+                        " 24 0a c4 11 22 33  3c 07 54 a1 0b 01  24 0a c4 11 22 33"
+                        " 50 1c  00 00  05 01 00 20 00 00 00 00",
+                        112, "de ad be ef de ad be ef  12 34 56 78");
+    Bytes retry = first;
+    retry[1] |= 0x08;
+
+    WifiSeqDedup<2> dedup;
+    WifiFrameInfo info;
+    CHECK_EQ(parse(first, BSSID, info), WIFI_FRAME_OK);
+    CHECK(!dedup.isDuplicate(info.station, info.isUpload, info.seqCtrl, info.retry));
+    CHECK_EQ(parse(retry, BSSID, info), WIFI_FRAME_OK);
+    CHECK(info.retry);
+    CHECK(dedup.isDuplicate(info.station, info.isUpload, info.seqCtrl, info.retry));
+
+    // Same sequence number without the retry bit (sequence wrap) is counted
+    CHECK(!dedup.isDuplicate(STA, true, 0x1c50, false));
+    // Directions and stations are tracked separately
+    CHECK(!dedup.isDuplicate(STA, false, 0x1c50, true));
+    CHECK(!dedup.isDuplicate(OTHER_STA, true, 0x1c50, true));
+    CHECK(dedup.isDuplicate(OTHER_STA, true, 0x1c50, true));
+
+    // A third station takes the oldest slot; STA starts over and its retry counts
+    const uint8_t third[6] = {1, 2, 3, 4, 5, 6};
+    CHECK(!dedup.isDuplicate(third, true, 0x0010, false));
+    CHECK(!dedup.isDuplicate(STA, true, 0x1c50, true));
+}
+
+int main() {
+    testCcmpQosUpload();
+    testOpenDownload();
+    testTkip();
+    testWep();
+    testHtControl();
+    testRejected();
+    testRetryDedup();
+    return testResult("wifi_frame_test");
+}
@@ -0,0 +1,70 @@
+#ifndef TOKEN_BUCKET_H
+#define TOKEN_BUCKET_H
+
+#include <stdint.h>
+
+// Token bucket rate limiter with lazy, timestamp based refill.
+//
+// Nothing runs periodically: every consume() first credits the tokens earned
+// since the previous call (elapsed time * rate, capped at the burst size) and
+// then spends them. Tokens are kept in byte-microseconds so the refill is
+// exact integer math at any rate. The caller supplies the clock in
+// microseconds, which keeps the bucket platform independent;
+// test/token_bucket_test.cpp runs it against a simulated clock.
+class TokenBucket {
+public:
+    TokenBucket() : _rate(0), _capacity(0), _tokens(0), _lastUs(0) {}
+
+    // rateBytesPerSec = 0 means unlimited. The bucket starts full.
+    void configure(uint32_t rateBytesPerSec, uint32_t burstBytes, uint64_t nowUs) {
+        _rate = rateBytesPerSec;
+        _capacity = (uint64_t)burstBytes * US_PER_SEC;
+        _tokens = _capacity;
+        _lastUs = nowUs;
+    }
+
+    bool unlimited() const { return _rate == 0; }
+    uint32_t rate() const { return _rate; }
+
+    // Take bytes from the bucket; false means the packet is over the limit
+    bool consume(uint32_t bytes, uint64_t nowUs) {
+        if (_rate == 0) return true;
+        refill(nowUs);
+        uint64_t cost = (uint64_t)bytes * US_PER_SEC;
+        if (_tokens < cost) return false;
+        _tokens -= cost;
+        return true;
+    }
+
+    // Whole bytes currently available
+    uint32_t available(uint64_t nowUs) {
+        if (_rate == 0) return UINT32_MAX;
+        refill(nowUs);
+        return (uint32_t)(_tokens / US_PER_SEC);
+    }
+
+private:
+    static const uint64_t US_PER_SEC = 1000000ULL;
+
+    uint32_t _rate;      // Bytes per second
+    uint64_t _capacity;  // Burst, in byte-microseconds
+    uint64_t _tokens;    // Byte-microseconds
+    uint64_t _lastUs;
+
+    void refill(uint64_t nowUs) {
+        if (nowUs <= _lastUs) return;
+        uint64_t elapsed = nowUs - _lastUs;
+        _lastUs = nowUs;
+
+        // Long enough idle to fill completely (also keeps elapsed * rate from overflowing)
+        uint64_t missing = _capacity - _tokens;
+        if (elapsed >= missing / _rate + 1) {
+            _tokens = _capacity;
+        } else {
+            _tokens += elapsed * _rate;
+            if (_tokens > _capacity) _tokens = _capacity;
+        }
+    }
+};
+
+#endif // TOKEN_BUCKET_H
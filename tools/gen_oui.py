@@ -0,0 +1,265 @@
+#!/usr/bin/env python3
+"""Generate oui_data.h, the packed MAC vendor table used by oui_lookup.cpp.
+
+Input is one or more CSV files in the IEEE registry format
+(Registry,Assignment,Organization Name,Organization Address), as published at
+
+    https://standards-oui.ieee.org/oui/oui.csv        (MA-L, 24-bit prefixes)
+    https://standards-oui.ieee.org/oui28/mam.csv      (MA-M, 28-bit prefixes)
+    https://standards-oui.ieee.org/oui36/oui36.csv    (MA-S, 36-bit prefixes)
+
+Usage:
+    tools/gen_oui.py                          # tools/oui_seed.csv -> oui_data.h
+    tools/gen_oui.py oui.csv mam.csv oui36.csv
+    tools/gen_oui.py --download               # fetch the three files above first
+
+Output layout (all PROGMEM):
+    OUI_POOL           vendor names, NUL separated, each stored once
+    OUI_VENDOR_OFFSET  vendor index -> offset into OUI_POOL
+    OUI_L_INDEX        first prefix byte -> [start, end) range of MA-L rows
+    OUI_L_LOW          MA-L rows: prefix bytes 2-3, sorted within each range
+    OUI_L_VENDOR       MA-L rows: vendor index
+    OUI_M_PREFIX       MA-M rows: 4 bytes (28 bits, low nibble 0), sorted
+    OUI_S_PREFIX       MA-S rows: 5 bytes (36 bits, low nibble 0), sorted
+    OUI_M_VENDOR / OUI_S_VENDOR
+
+MA-M and MA-S blocks sit inside MA-L prefixes registered to the IEEE
+Registration Authority; the firmware tries the longest prefix first. Those
+placeholder MA-L rows (and "Private" ones) are left out.
+"""
+
+import argparse
+import csv
+import os
+import re
+import sys
+import urllib.request
+
+IEEE_URLS = [
+    "https://standards-oui.ieee.org/oui/oui.csv",
+    "https://standards-oui.ieee.org/oui28/mam.csv",
+    "https://standards-oui.ieee.org/oui36/oui36.csv",
+]
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.dirname(HERE)
+DEFAULT_SEED = os.path.join(HERE, "oui_seed.csv")
+DEFAULT_OUT = os.path.join(ROOT, "oui_data.h")
+
+# Prefix length in hex digits per registry
+REGISTRY_DIGITS = {"MA-L": 6, "MA-M": 7, "MA-S": 9}
+
+SKIP_NAMES = {"ieee registration authority", "private"}
+
+# Legal-form suffixes dropped from organization names (repeatedly, longest first)
+SUFFIXES = sorted([
+    "co., ltd.", "co., ltd", "co.,ltd.", "co.,ltd", "co ltd", "co. ltd.",
+    "company limited", "corporation", "corp.", "corp", "incorporated",
+    "inc.", "inc", "ltd.", "ltd", "limited", "llc", "l.l.c.", "gmbh",
+    "gmbh & co. kg", "ag", "s.a.", "sa", "s.p.a.", "spa", "b.v.", "bv",
+    "n.v.", "oy", "ab", "a/s", "as", "pty", "pty.", "plc", "k.k.", "kg",
+    "s.r.l.", "srl", "sas", "s.a.s.", "co.", "co",
+], key=len, reverse=True)
+
+
+def clean_name(name, max_len):
+    name = re.sub(r"\s+", " ", name).strip().strip(",").strip()
+    changed = True
+    while changed:
+        changed = False
+        lower = name.lower()
+        for suffix in SUFFIXES:
+            if lower.endswith(" " + suffix) or lower.endswith("," + suffix):
+                name = name[:-len(suffix)].rstrip(" ,")
+                changed = True
+                break
+    if len(name.encode("utf-8")) > max_len:
+        name = name.encode("utf-8")[:max_len].decode("utf-8", "ignore").rstrip(" ,")
+    return name
+
+
+def read_registry(path, max_len):
+    rows = []
+    with open(path, newline="", encoding="utf-8-sig") as f:
+        for rec in csv.DictReader(f):
+            registry = (rec.get("Registry") or "").strip()
+            digits = REGISTRY_DIGITS.get(registry)
+            assignment = (rec.get("Assignment") or "").strip().upper()
+            org = (rec.get("Organization Name") or "").strip()
+            if not digits or len(assignment) != digits or not org:
+                continue
+            if org.lower() in SKIP_NAMES:
+                continue
+            rows.append((registry, int(assignment, 16), clean_name(org, max_len)))
+    return rows
+
+
+def download(dest_dir):
+    os.makedirs(dest_dir, exist_ok=True)
+    paths = []
+    for url in IEEE_URLS:
+        path = os.path.join(dest_dir, os.path.basename(url))
+        print("Fetching %s" % url, file=sys.stderr)
+        req = urllib.request.Request(url, headers={"User-Agent": "gen_oui.py"})
+        with urllib.request.urlopen(req, timeout=60) as resp, open(path, "wb") as out:
+            out.write(resp.read())
+        paths.append(path)
+    return paths
+
+
+def c_string(s):
+    out = []
+    for b in s.encode("utf-8"):
+        if b in (0x22, 0x5C):
+            out.append("\\" + chr(b))
+        elif 0x20 <= b < 0x7F:
+            out.append(chr(b))
+        else:
+            out.append("\\%03o" % b)
+    return "".join(out)
+
+
+def wrap(items, indent="    ", width=100):
+    lines, line = [], indent
+    for item in items:
+        if len(line) + len(item) + 2 > width and line.strip():
+            lines.append(line.rstrip())
+            line = indent
+        line += item + ", "
+    if line.strip():
+        lines.append(line.rstrip())
+    return "\n".join(lines) if lines else indent + "0"
+
+
+def generate(rows, sources):
+    # First registration wins if a prefix appears twice
+    tables = {"MA-L": {}, "MA-M": {}, "MA-S": {}}
+    for registry, prefix, name in rows:
+        tables[registry].setdefault(prefix, name)
+
+    vendors = sorted({name for t in tables.values() for name in t.values()})
+    vendor_index = {name: i for i, name in enumerate(vendors)}
+    if len(vendors) > 0xFFFF:
+        sys.exit("too many vendors for 16-bit indexes")
+
+    offsets, pool = [], []
+    pos = 0
+    for name in vendors:
+        offsets.append(pos)
+        pool.append(name)
+        pos += len(name.encode("utf-8")) + 1
+    pool_bytes = pos
+
+    mal = sorted(tables["MA-L"].items())
+    index = [0] * 257
+    for prefix, _ in mal:
+        index[(prefix >> 16) + 1] += 1
+    for i in range(256):
+        index[i + 1] += index[i]
+
+    mam = sorted(tables["MA-M"].items())
+    mas = sorted(tables["MA-S"].items())
+
+    def key_bytes(prefix, digits, width):
+        value = prefix << (width * 8 - digits * 4)
+        return ["0x%02X" % ((value >> (8 * (width - 1 - i))) & 0xFF) for i in range(width)]
+
+    flash = (pool_bytes + 4 * len(vendors) + 4 * 257 + 4 * len(mal) +
+             6 * len(mam) + 7 * len(mas))
+
+    out = []
+    out.append("// Generated by tools/gen_oui.py - do not edit.")
+    out.append("// Sources: %s" % ", ".join(os.path.basename(s) for s in sources))
+    out.append("// %d MA-L, %d MA-M, %d MA-S prefixes, %d vendors, ~%d bytes of flash"
+               % (len(mal), len(mam), len(mas), len(vendors), flash))
+    out.append("")
+    out.append("#ifndef OUI_DATA_H")
+    out.append("#define OUI_DATA_H")
+    out.append("")
+    out.append("#include <Arduino.h>")
+    out.append("")
+    out.append("#define OUI_VENDOR_COUNT %d" % len(vendors))
+    out.append("#define OUI_L_COUNT      %d" % len(mal))
+    out.append("#define OUI_M_COUNT      %d" % len(mam))
+    out.append("#define OUI_S_COUNT      %d" % len(mas))
+    out.append("")
+    out.append("static const char OUI_POOL[] PROGMEM =")
+    for name in pool:
+        out.append('    "%s\\0"' % c_string(name))
+    if not pool:
+        out.append('    ""')
+    out[-1] += ";"
+    out.append("")
+    out.append("static const uint32_t OUI_VENDOR_OFFSET[] PROGMEM = {")
+    out.append(wrap([str(o) for o in offsets]))
+    out.append("};")
+    out.append("")
+    out.append("// MA-L rows [OUI_L_INDEX[b], OUI_L_INDEX[b + 1]) start with byte b")
+    out.append("static const uint32_t OUI_L_INDEX[257] PROGMEM = {")
+    out.append(wrap([str(i) for i in index]))
+    out.append("};")
+    out.append("")
+    out.append("static const uint16_t OUI_L_LOW[] PROGMEM = {")
+    out.append(wrap(["0x%04X" % (p & 0xFFFF) for p, _ in mal]))
+    out.append("};")
+    out.append("")
+    out.append("static const uint16_t OUI_L_VENDOR[] PROGMEM = {")
+    out.append(wrap([str(vendor_index[n]) for _, n in mal]))
+    out.append("};")
+    out.append("")
+    out.append("static const uint8_t OUI_M_PREFIX[][4] PROGMEM = {")
+    out.append(wrap(["{%s}" % ", ".join(key_bytes(p, 7, 4)) for p, _ in mam]))
+    out.append("};")
+    out.append("")
+    out.append("static const uint16_t OUI_M_VENDOR[] PROGMEM = {")
+    out.append(wrap([str(vendor_index[n]) for _, n in mam]))
+    out.append("};")
+    out.append("")
+    out.append("static const uint8_t OUI_S_PREFIX[][5] PROGMEM = {")
+    out.append(wrap(["{%s}" % ", ".join(key_bytes(p, 9, 5)) for p, _ in mas]))
+    out.append("};")
+    out.append("")
+    out.append("static const uint16_t OUI_S_VENDOR[] PROGMEM = {")
+    out.append(wrap([str(vendor_index[n]) for _, n in mas]))
+    out.append("};")
+    out.append("")
+    out.append("#endif // OUI_DATA_H")
+    out.append("")
+
+    stats = (len(mal), len(mam), len(mas), len(vendors), pool_bytes, flash)
+    return "\n".join(out), stats
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("csv", nargs="*", help="IEEE registry CSV files (default: tools/oui_seed.csv)")
+    parser.add_argument("--download", action="store_true",
+                        help="fetch the IEEE MA-L/MA-M/MA-S CSVs into tools/ieee/ first")
+    parser.add_argument("--out", default=DEFAULT_OUT, help="output header (default: oui_data.h)")
+    parser.add_argument("--max-name", type=int, default=31,
+                        help="longest vendor name in bytes (default: 31, fits MAX_DEVICE_NAME)")
+    args = parser.parse_args()
+
+    sources = list(args.csv)
+    if args.download:
+        sources += download(os.path.join(HERE, "ieee"))
+    if not sources:
+        sources = [DEFAULT_SEED]
+
+    rows = []
+    for path in sources:
+        rows += read_registry(path, args.max_name)
+
+    text, stats = generate(rows, sources)
+    with open(args.out, "w", newline="\n") as f:
+        f.write(text)
+
+    out = args.out
+    if os.path.abspath(out).startswith(ROOT + os.sep):
+        out = os.path.relpath(out, ROOT)
+    print("%s: %d MA-L, %d MA-M, %d MA-S, %d vendors (%d byte pool), ~%d bytes of flash"
+          % ((out,) + stats), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+"""Generate web_content.h, the gzip-compressed dashboard served by web_server.cpp.
+
+Input is the dashboard in tools/web/:
+
+    index.html   the page; "{{app.css}}" and "{{app.js}}" are replaced with
+                 the content hash of that file, so its URL changes with it
+    app.css
+    app.js
+
+Each file is minified, gzipped and written out as a PROGMEM byte array,
+together with its content-hash ETag. The firmware sends the bytes as they
+are with "Content-Encoding: gzip": app.css and app.js are cacheable for a
+year (their URLs carry the hash), index.html is revalidated with its ETag.
+
+The minifier is deliberately conservative: it drops comments, indentation
+and blank lines but keeps line breaks, so JavaScript semantics (automatic
+semicolon insertion) and whitespace between inline HTML elements survive.
+gzip takes care of most of the rest.
+
+Usage:
+    tools/gen_web.py                 # tools/web/* -> web_content.h
+    tools/gen_web.py --baseline FILE # also compare with an older page
+"""
+
+import argparse
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.dirname(HERE)
+WEB_DIR = os.path.join(HERE, "web")
+DEFAULT_OUT = os.path.join(ROOT, "web_content.h")
+
+# URL path, source file, content type, C name, immutable
+ASSETS = [
+    ("/app.css", "app.css", "text/css", "APP_CSS", True),
+    ("/app.js", "app.js", "application/javascript", "APP_JS", True),
+    ("/", "index.html", "text/html", "INDEX_HTML", False),  # Last: refers to the others
+]
+
+
+def strip_lines(text, comment=None):
+    lines = []
+    for line in text.splitlines():
+        line = line.strip()
+        if not line or (comment and line.startswith(comment)):
+            continue
+        lines.append(line)
+    return "\n".join(lines)
+
+
+def minify_css(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"\s+", " ", text)
+    text = re.sub(r"\s*([{};:,>])\s*", r"\1", text)
+    return text.replace(";}", "}").strip()
+
+
+def minify_js(text):
+    # Whole-line comments only: "//" also occurs inside strings ("http://")
+    return strip_lines(text, "//")
+
+
+def minify_html(text):
+    text = re.sub(r"<!--.*?-->", "", text, flags=re.S)
+    return strip_lines(text)
+
+
+MINIFIERS = {".css": minify_css, ".js": minify_js, ".html": minify_html}
+
+
+def content_hash(data):
+    return hashlib.sha256(data).hexdigest()[:16]
+
+
+def wrap_bytes(data, indent="    ", per_line=16):
+    lines = []
+    for i in range(0, len(data), per_line):
+        lines.append(indent + ", ".join("0x%02X" % b for b in data[i:i + per_line]) + ",")
+    return "\n".join(lines) if lines else indent + "0"
+
+
+def build():
+    built = []  # (path, source, type, name, immutable, raw, minified, gz, hash)
+    hashes = {}
+    for path, source, ctype, name, immutable in ASSETS:
+        with open(os.path.join(WEB_DIR, source), encoding="utf-8") as f:
+            raw = f.read()
+        text = raw
+        for other, digest in hashes.items():
+            text = text.replace("{{%s}}" % other, digest)
+        if "{{" in text:
+            sys.exit("%s: unresolved placeholder %s" % (source, re.search(r"\{\{.*?\}\}", text).group(0)))
+        minified = MINIFIERS[os.path.splitext(source)[1]](text).encode("utf-8")
+        gz = gzip.compress(minified, compresslevel=9, mtime=0)
+        digest = content_hash(minified)
+        hashes[source] = digest
+        built.append((path, source, ctype, name, immutable, len(raw.encode("utf-8")),
+                      len(minified), gz, digest))
+    return built
+
+
+def generate(built):
+    out = []
+    out.append("// Generated by tools/gen_web.py - do not edit.")
+    out.append("// Sources: %s" % ", ".join("tools/web/" + b[1] for b in built))
+    for b in built:
+        out.append("// %-10s %6d bytes, %6d minified, %6d gzip" % (b[1], b[5], b[6], len(b[7])))
+    out.append("")
+    out.append("#ifndef WEB_CONTENT_H")
+    out.append("#define WEB_CONTENT_H")
+    out.append("")
+    out.append("#include <Arduino.h>")
+    out.append("")
+    out.append("// One dashboard file, stored gzip-compressed")
+    out.append("struct WebAsset {")
+    out.append("    const char* path;")
+    out.append("    const char* contentType;")
+    out.append("    const uint8_t* data;")
+    out.append("    size_t length;")
+    out.append("    const char* etag;  // Quoted content hash")
+    out.append("    bool immutable;    // URL carries the hash; cache for good")
+    out.append("};")
+    out.append("")
+    for b in built:
+        out.append("static const uint8_t %s_GZ[] PROGMEM = {" % b[3])
+        out.append(wrap_bytes(b[7]))
+        out.append("};")
+        out.append("")
+    out.append("static const WebAsset WEB_ASSETS[] = {")
+    for b in built:
+        out.append('    { "%s", "%s", %s_GZ, sizeof(%s_GZ), "\\"%s\\"", %s },'
+                   % (b[0], b[2], b[3], b[3], b[8], "true" if b[4] else "false"))
+    out.append("};")
+    out.append("static const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);")
+    out.append("")
+    out.append("#endif // WEB_CONTENT_H")
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--out", default=DEFAULT_OUT, help="output header (default: web_content.h)")
+    parser.add_argument("--baseline", help="uncompressed single-file page to compare against")
+    args = parser.parse_args()
+
+    built = build()
+    with open(args.out, "w", newline="\n") as f:
+        f.write(generate(built))
+
+    for b in built:
+        print("%-10s %6d -> %6d minified -> %6d gzip" % (b[1], b[5], b[6], len(b[7])), file=sys.stderr)
+    total_raw = sum(b[5] for b in built)
+    total_gz = sum(len(b[7]) for b in built)
+    print("total      %6d -> %6d gzip (first visit)" % (total_raw, total_gz), file=sys.stderr)
+    page = next(b for b in built if b[0] == "/")
+    print("repeat visit: %d gzip bytes, or a 304 when the page is unchanged" % len(page[7]),
+          file=sys.stderr)
+    if args.baseline:
+        with open(args.baseline, "rb") as f:
+            base = len(f.read())
+        print("baseline   %6d bytes uncompressed on every visit (%.1fx more than first visit)"
+              % (base, base / total_gz), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
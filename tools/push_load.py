@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""Load test for the dashboard push stream, run from a host on the AP or LAN.
+
+Opens N simulated dashboards against a running monitor and reports what each
+one received, together with the device's own counters from /api/status
+(push frames and bytes, free heap, main loop rate) before and after.
+
+    tools/push_load.py 192.168.4.1                   # 8 SSE clients, 60 s
+    tools/push_load.py 192.168.4.1 -n 16 -t 120
+    tools/push_load.py 192.168.4.1 -n 8 --poll       # old behaviour: every
+                                                     # client polls 3 endpoints
+                                                     # every 5 s
+
+Clients past PUSH_MAX_CLIENTS get a "busy" event and are counted as such.
+Standard library only.
+"""
+
+import argparse
+import json
+import socket
+import threading
+import time
+import urllib.request
+
+POLL_PATHS = ("/api/devices", "/api/blockedDomains", "/api/status")
+POLL_INTERVAL = 5.0
+
+
+class Result:
+    def __init__(self):
+        self.frames = 0
+        self.bytes = 0
+        self.busy = False
+        self.error = None
+        self.max_gap = 0.0
+        self.requests = 0
+
+
+def get_status(host, port):
+    with urllib.request.urlopen(f"http://{host}:{port}/api/status", timeout=10) as r:
+        return json.load(r)
+
+
+def sse_client(host, port, deadline, res):
+    try:
+        sock = socket.create_connection((host, port), timeout=10)
+        sock.sendall((f"GET /api/events HTTP/1.1\r\nHost: {host}\r\n"
+                      "Accept: text/event-stream\r\nCache-Control: no-cache\r\n\r\n").encode())
+        buf = b""
+        last = time.monotonic()
+        while time.monotonic() < deadline:
+            sock.settimeout(max(0.1, deadline - time.monotonic()))
+            try:
+                chunk = sock.recv(4096)
+            except socket.timeout:
+                break
+            if not chunk:
+                break
+            res.bytes += len(chunk)
+            buf += chunk
+            while b"\n\n" in buf:
+                event, buf = buf.split(b"\n\n", 1)
+                if b"event: update" in event:
+                    now = time.monotonic()
+                    if res.frames:
+                        res.max_gap = max(res.max_gap, now - last)
+                    last = now
+                    res.frames += 1
+                elif b"event: busy" in event:
+                    res.busy = True
+                    return
+        sock.close()
+    except OSError as e:
+        res.error = str(e)
+
+
+def poll_client(host, port, deadline, res):
+    while time.monotonic() < deadline:
+        start = time.monotonic()
+        for path in POLL_PATHS:
+            try:
+                with urllib.request.urlopen(f"http://{host}:{port}{path}", timeout=10) as r:
+                    res.bytes += len(r.read())
+                    res.requests += 1
+            except OSError as e:
+                res.error = str(e)
+        time.sleep(max(0.0, POLL_INTERVAL - (time.monotonic() - start)))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("host")
+    ap.add_argument("--port", type=int, default=80)
+    ap.add_argument("-n", "--clients", type=int, default=8)
+    ap.add_argument("-t", "--duration", type=float, default=60.0)
+    ap.add_argument("--poll", action="store_true", help="poll the REST API instead of using the push stream")
+    args = ap.parse_args()
+
+    before = get_status(args.host, args.port)
+    deadline = time.monotonic() + args.duration
+    results = [Result() for _ in range(args.clients)]
+    worker = poll_client if args.poll else sse_client
+    threads = [threading.Thread(target=worker, args=(args.host, args.port, deadline, r), daemon=True)
+               for r in results]
+    for t in threads:
+        t.start()
+        time.sleep(0.05)
+    for t in threads:
+        t.join(args.duration + 15)
+    after = get_status(args.host, args.port)
+
+    mode = "poll" if args.poll else "push"
+    print(f"{args.clients} {mode} clients for {args.duration:.0f} s")
+    for i, r in enumerate(results):
+        state = "busy" if r.busy else (f"error: {r.error}" if r.error else "ok")
+        if args.poll:
+            print(f"  client {i:2}: {r.requests:4} requests {r.bytes:9} bytes  {state}")
+        else:
+            print(f"  client {i:2}: {r.frames:4} frames {r.bytes:9} bytes  max gap {r.max_gap:5.2f} s  {state}")
+
+    total = sum(r.bytes for r in results)
+    print(f"bytes received, all clients: {total} ({total / args.duration:.0f} B/s)")
+    if not args.poll:
+        pb, pa = before.get("push", {}), after.get("push", {})
+        print(f"device: {pa.get('frames', 0) - pb.get('frames', 0)} frames built, "
+              f"{pa.get('bytes', 0) - pb.get('bytes', 0)} bytes serialized, "
+              f"interval {pa.get('intervalMs')} ms")
+    print(f"device: free heap {before.get('freeHeap')} -> {after.get('freeHeap')}, "
+          f"min {after.get('minFreeHeap')}, loop {before.get('loopFreq')} -> {after.get('loopFreq')} /s")
+
+
+if __name__ == "__main__":
+    main()
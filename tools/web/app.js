@@ -0,0 +1,340 @@
+function formatBytes(bytes) {
+    if (bytes === 0) return '0 B';
+    const k = 1024;
+    const sizes = ['B', 'KB', 'MB', 'GB', 'TB'];
+    const i = Math.floor(Math.log(bytes) / Math.log(k));
+    return parseFloat((bytes / Math.pow(k, i)).toFixed(2)) + ' ' + sizes[i];
+}
+
+function formatRate(bytesPerSec) {
+    return formatBytes(bytesPerSec || 0) + '/s';
+}
+
+function formatUptime(seconds) {
+    const d = Math.floor(seconds / 86400);
+    const h = Math.floor((seconds % 86400) / 3600);
+    const m = Math.floor((seconds % 3600) / 60);
+    const s = seconds % 60;
+    if (d > 0) return d + 'd ' + h + 'h';
+    if (h > 0) return h + 'h ' + m + 'm';
+    if (m > 0) return m + 'm ' + s + 's';
+    return s + 's';
+}
+
+// Device rows by MAC, as of the device's table generation deviceGen.
+// Changes arrive as deltas (rows changed since a generation, MACs
+// removed) and only the affected table rows are touched.
+const deviceRows = new Map();
+const deviceEls = new Map();
+let deviceGen = null;
+let deviceBoot = null;
+
+async function fetchDevices() {
+    const q = deviceGen === null ? 'since=0' : 'since=' + deviceGen + '&boot=' + deviceBoot;
+    applyDeviceChanges(await fetch('/api/devices?' + q).then(r => r.json()), true);
+}
+
+async function fetchData() {
+    try {
+        const [, domains, status] = await Promise.all([
+            fetchDevices(),
+            fetch('/api/blockedDomains').then(r => r.json()),
+            fetch('/api/status').then(r => r.json())
+        ]);
+        updateDomains(domains);
+        updateStatus(status);
+    } catch (e) {
+        console.error('Fetch error:', e);
+    }
+}
+
+// Live updates: a frame holds only the sections that changed.
+// Without EventSource, or when the device is busy, poll instead.
+let pollTimer = null;
+
+function startPolling() {
+    if (!pollTimer) pollTimer = setInterval(fetchData, 5000);
+}
+
+function applyUpdate(u) {
+    if (u.deviceChanges) applyDeviceChanges(u.deviceChanges, false);
+    if (u.domains) updateDomains(u.domains);
+    if (u.status) updateStatus(u.status);
+}
+
+function startPush() {
+    if (!window.EventSource) {
+        startPolling();
+        return;
+    }
+    const es = new EventSource('/api/events');
+    es.addEventListener('update', e => applyUpdate(JSON.parse(e.data)));
+    es.addEventListener('busy', () => {
+        es.close();
+        startPolling();
+    });
+    es.onerror = () => {
+        if (es.readyState === EventSource.CLOSED) startPolling();
+    };
+}
+
+function applyDeviceChanges(c, fetched) {
+    if (!c.full && c.since !== deviceGen) {
+        // Missed a frame (or an older reply): catch up from our generation
+        if (!fetched) fetchDevices();
+        return;
+    }
+    if (c.full) deviceRows.clear();
+    c.removed.forEach(mac => deviceRows.delete(mac));
+    c.devices.forEach(d => deviceRows.set(d.mac, d));
+    deviceGen = c.generation;
+    deviceBoot = c.boot;
+    renderDevices(c.full ? null : c.devices);
+}
+
+function setText(el, text) {
+    if (el.textContent !== text) el.textContent = text;
+}
+
+function createDeviceRow(mac) {
+    const tr = document.createElement('tr');
+    tr.innerHTML = `
+        <td><span class="device-name"></span><span class="mac"></span></td>
+        <td class="bytes"></td>
+        <td class="bytes"></td>
+        <td class="bytes"></td>
+        <td class="bytes"><span></span><br><span></span></td>
+        <td><button class="btn btn-sm">Reset</button></td>`;
+    tr.querySelector('.device-name').onclick = () => openRename(mac, deviceRows.get(mac).name);
+    tr.querySelector('button').onclick = () => resetDevice(mac);
+    return tr;
+}
+
+function fillDeviceRow(tr, d) {
+    const c = tr.cells;
+    tr.className = d.active ? 'active' : 'inactive';
+    setText(c[0].firstElementChild, d.name);
+    setText(c[0].lastElementChild, d.mac + (d.os ? ' \u00b7 ' + d.os + ' ' + d.type : ''));
+    setText(c[1], formatBytes(d.download));
+    setText(c[2], formatBytes(d.upload));
+    setText(c[3], formatBytes(d.total));
+    setText(c[4].firstElementChild, '\u2193 ' + formatRate(d.downloadRate));
+    setText(c[4].lastElementChild, '\u2191 ' + formatRate(d.uploadRate));
+}
+
+// Fill the changed rows (all if null), drop removed ones, and move
+// rows only where the busiest-first order changed
+function renderDevices(changed) {
+    const tbody = document.getElementById('deviceTable');
+    for (const [mac, tr] of deviceEls) {
+        if (!deviceRows.has(mac)) {
+            tr.remove();
+            deviceEls.delete(mac);
+        }
+    }
+    (changed || [...deviceRows.values()]).forEach(d => {
+        let tr = deviceEls.get(d.mac);
+        if (!tr) {
+            tr = createDeviceRow(d.mac);
+            deviceEls.set(d.mac, tr);
+        }
+        fillDeviceRow(tr, d);
+    });
+    const order = [...deviceRows.values()].sort((a, b) => b.total - a.total);
+    order.forEach((d, i) => {
+        const tr = deviceEls.get(d.mac);
+        if (tbody.children[i] !== tr) tbody.insertBefore(tr, tbody.children[i] || null);
+    });
+}
+
+function updateDomains(domains) {
+    const list = document.getElementById('blockedDomains');
+    list.innerHTML = domains.map(d => `
+        <div class="domain-item">
+            <span>${d}</span>
+            <button class="btn btn-danger btn-sm" onclick="unblockDomain('${d}')">Unblock</button>
+        </div>
+    `).join('');
+}
+
+function updateStatus(status) {
+    document.getElementById('routerStatus').textContent = status.connected ? 'Connected' : 'Disconnected';
+    document.getElementById('routerStatus').className = status.connected ? 'status-online' : 'status-offline';
+    const staIPEl = document.getElementById('staIP');
+    const mdnsEl = document.getElementById('mdnsLink');
+    if (status.staIP && status.connected) {
+        staIPEl.innerHTML = '<a href="http://' + status.staIP + '" style="color:#00d4ff;">' + status.staIP + '</a>';
+        if (status.mdnsHost) {
+            mdnsEl.innerHTML = '<a href="http://' + status.mdnsHost + '.local" style="color:#00d4ff;">' + status.mdnsHost + '.local</a>';
+        }
+    } else {
+        staIPEl.textContent = '-';
+        mdnsEl.textContent = '';
+    }
+    document.getElementById('deviceCount').textContent = status.online;
+    document.getElementById('uptime').textContent = formatUptime(status.uptime);
+    document.getElementById('freeHeap').textContent = formatBytes(status.freeHeap);
+    if (status.minFreeHeap) {
+        document.getElementById('minFreeHeap').textContent = 'Min: ' + formatBytes(status.minFreeHeap);
+    }
+    if (status.loopFreq !== undefined) {
+        const freq = status.loopFreq;
+        const el = document.getElementById('cpuLoad');
+        const freqEl = document.getElementById('loopFreq');
+        // Estimate load: with 1ms delay, max ~1000 loops/sec when idle
+        const maxLoops = 1000;
+        const load = Math.max(0, Math.min(100, Math.round((1 - freq / maxLoops) * 100)));
+        el.textContent = load + '%';
+        el.style.color = load < 50 ? '#00ff88' : load < 80 ? '#ffaa00' : '#ff4444';
+        freqEl.textContent = freq + ' loops/s @ ' + (status.cpuFreq || 240) + 'MHz';
+    }
+    document.getElementById('dnsQueries').textContent = status.dnsQueries || 0;
+    document.getElementById('dnsBlocked').textContent = status.dnsBlocked || 0;
+    document.getElementById('dnsInput').placeholder = status.upstreamDNS || '1.1.1.1';
+    const acct = document.getElementById('accountingSelect');
+    if (status.accounting && document.activeElement !== acct) acct.value = status.accounting;
+}
+
+function openRename(mac, name) {
+    document.getElementById('renameMAC').value = mac;
+    document.getElementById('newDeviceName').value = name === 'Unknown Device' ? '' : name;
+    document.getElementById('renameModal').classList.add('active');
+    document.getElementById('newDeviceName').focus();
+}
+
+function closeModal() {
+    document.getElementById('renameModal').classList.remove('active');
+}
+
+async function saveDeviceName() {
+    const mac = document.getElementById('renameMAC').value;
+    const name = document.getElementById('newDeviceName').value;
+    const res = await fetch('/api/devices/' + encodeURIComponent(mac) + '/name', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/json'},
+        body: JSON.stringify({name})
+    });
+    if (!res.ok) {
+        alert((await res.json()).error);
+        return;
+    }
+    closeModal();
+    fetchData();
+}
+
+async function resetDevice(mac) {
+    await fetch('/api/devices/' + encodeURIComponent(mac) + '/reset', {method: 'POST'});
+    fetchData();
+}
+
+async function resetAllStats() {
+    if (confirm('Reset bandwidth stats for all devices?')) {
+        await fetch('/api/stats/reset', {method: 'POST'});
+        fetchData();
+    }
+}
+
+async function blockDomain() {
+    const domain = document.getElementById('domainInput').value.trim();
+    if (!domain) return;
+    await fetch('/api/blockDomain', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/json'},
+        body: JSON.stringify({domain})
+    });
+    document.getElementById('domainInput').value = '';
+    fetchData();
+}
+
+async function unblockDomain(domain) {
+    await fetch('/api/unblockDomain', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/json'},
+        body: JSON.stringify({domain})
+    });
+    fetchData();
+}
+
+async function saveDNS() {
+    const dns = document.getElementById('dnsInput').value.trim();
+    if (!dns) return;
+    await fetch('/api/settings/dns', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/json'},
+        body: JSON.stringify({dns})
+    });
+    fetchData();
+}
+
+async function saveAccounting() {
+    const backend = document.getElementById('accountingSelect').value;
+    await fetch('/api/settings/accounting', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/json'},
+        body: JSON.stringify({backend})
+    });
+    fetchData();
+}
+
+async function loadSettings() {
+    try {
+        const settings = await fetch('/api/settings').then(r => r.json());
+        if (settings.vendorLookup) {
+            document.getElementById('vendorOnline').checked = settings.vendorLookup.online;
+            document.getElementById('vendorURL').value = settings.vendorLookup.url || '';
+        }
+        if (settings.pushIntervalMs) {
+            document.getElementById('pushInterval').value = settings.pushIntervalMs;
+        }
+    } catch (e) {
+        console.error('Settings error:', e);
+    }
+}
+
+async function saveVendorLookup() {
+    const online = document.getElementById('vendorOnline').checked;
+    const url = document.getElementById('vendorURL').value.trim();
+    const res = await fetch('/api/settings/vendor', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/json'},
+        body: JSON.stringify({online, url})
+    });
+    if (!res.ok) alert((await res.json()).error);
+    loadSettings();
+}
+
+async function savePushInterval() {
+    const intervalMs = parseInt(document.getElementById('pushInterval').value, 10);
+    const res = await fetch('/api/settings/push', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/json'},
+        body: JSON.stringify({intervalMs})
+    });
+    if (!res.ok) alert((await res.json()).error);
+    loadSettings();
+}
+
+async function saveWiFi() {
+    const ssid = document.getElementById('wifiSSID').value.trim();
+    const password = document.getElementById('wifiPassword').value;
+    if (!ssid) return;
+    document.getElementById('routerStatus').textContent = 'Connecting...';
+    await fetch('/api/settings/wifi', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/json'},
+        body: JSON.stringify({ssid, password})
+    });
+    setTimeout(fetchData, 5000);
+}
+
+document.getElementById('domainInput').addEventListener('keypress', e => {
+    if (e.key === 'Enter') blockDomain();
+});
+
+document.getElementById('newDeviceName').addEventListener('keypress', e => {
+    if (e.key === 'Enter') saveDeviceName();
+});
+
+loadSettings();
+fetchData();
+startPush();
@@ -0,0 +1,102 @@
+#ifndef TRAFFIC_RATE_H
+#define TRAFFIC_RATE_H
+
+#include <stdint.h>
+#include <math.h>
+
+// Exponentially weighted upload/download byte and packet rates for one device.
+//
+// add() accumulates the current second; when the clock moves on, advance()
+// folds the finished second into the averages and decays them for any fully
+// idle seconds in between:
+//
+//   rate += alpha * (sample - rate)        (one step per second)
+//
+// alpha = 1 - exp(-1 / tau) gives a time constant of tau seconds. Rates are
+// per second and platform independent; the caller supplies the clock.
+class TrafficRate {
+public:
+    static float alphaForTau(float tauSec) {
+        return 1.0f - expf(-1.0f / tauSec);
+    }
+
+    void reset(uint32_t nowSec) {
+        _lastSec = nowSec;
+        _bytesUp = _bytesDown = 0;
+        _pktsUp = _pktsDown = 0;
+        _upBps = _downBps = 0.0f;
+        _upPps = _downPps = 0.0f;
+    }
+
+    void add(uint32_t nowSec, uint32_t bytes, bool isUpload, float alpha) {
+        if (nowSec != _lastSec) {
+            advance(nowSec, alpha);
+        }
+        if (isUpload) {
+            _bytesUp += bytes;
+            _pktsUp++;
+        } else {
+            _bytesDown += bytes;
+            _pktsDown++;
+        }
+    }
+
+    void advance(uint32_t nowSec, float alpha) {
+        if (nowSec <= _lastSec) {
+            return;
+        }
+
+        // Fold the completed second
+        _upBps   += alpha * ((float)_bytesUp   - _upBps);
+        _downBps += alpha * ((float)_bytesDown - _downBps);
+        _upPps   += alpha * ((float)_pktsUp    - _upPps);
+        _downPps += alpha * ((float)_pktsDown  - _downPps);
+        _bytesUp = _bytesDown = 0;
+        _pktsUp = _pktsDown = 0;
+
+        // Decay across idle seconds with no traffic at all
+        uint32_t idle = nowSec - _lastSec - 1;
+        if (idle > 0) {
+            float decay = powf(1.0f - alpha, (float)idle);
+            _upBps *= decay;
+            _downBps *= decay;
+            _upPps *= decay;
+            _downPps *= decay;
+        }
+
+        _lastSec = nowSec;
+    }
+
+    float uploadBytesPerSec() const   { return _upBps; }
+    float downloadBytesPerSec() const { return _downBps; }
+    float uploadPacketsPerSec() const   { return _upPps; }
+    float downloadPacketsPerSec() const { return _downPps; }
+
+    // The rates as the API reports them: whole bytes/s, packets/s in tenths.
+    // The averages decay forever; these stop changing once they round to 0.
+    struct Shown {
+        uint32_t upBps, downBps, upPps10, downPps10;
+        bool operator==(const Shown& o) const {
+            return upBps == o.upBps && downBps == o.downBps &&
+                   upPps10 == o.upPps10 && downPps10 == o.downPps10;
+        }
+        bool operator!=(const Shown& o) const { return !(*this == o); }
+    };
+    Shown shown() const {
+        return { (uint32_t)_upBps, (uint32_t)_downBps,
+                 (uint32_t)(_upPps * 10.0f + 0.5f), (uint32_t)(_downPps * 10.0f + 0.5f) };
+    }
+
+private:
+    uint32_t _lastSec;
+    uint32_t _bytesUp;
+    uint32_t _bytesDown;
+    uint32_t _pktsUp;
+    uint32_t _pktsDown;
+    float _upBps;
+    float _downBps;
+    float _upPps;
+    float _downPps;
+};
+
+#endif // TRAFFIC_RATE_H
@@ -0,0 +1,185 @@
+#include "traffic_shaper.h"
+#include "storage_manager.h"
+#include "esp_timer.h"
+
+TrafficShaper trafficShaper;
+
+TrafficShaper::TrafficShaper() : _count(0), _totalDropped(0) {
+    _lock = portMUX_INITIALIZER_UNLOCKED;
+}
+
+void TrafficShaper::begin() {
+    std::vector<DeviceLimit> limits = storage.loadDeviceLimits();
+    for (const auto& l : limits) {
+        uint32_t limit[2] = { l.uploadKbps, l.downloadKbps };
+        apply(l.mac, limit, nullptr);
+    }
+    DEBUG_PRINTF("Shaper: %d device limits loaded\n", _count);
+}
+
+bool TrafficShaper::allow(const uint8_t* mac, uint32_t bytes, bool isUpload) {
+    if (_count == 0) {
+        return true;
+    }
+
+    bool ok = true;
+    portENTER_CRITICAL(&_lock);
+    int i = find(mac);
+    if (i >= 0) {
+        Entry& e = _entries[i];
+        uint64_t nowUs = (uint64_t)esp_timer_get_time();
+        if (isUpload) {
+            ok = e.up.consume(bytes, nowUs);
+            if (!ok) e.droppedUp++;
+        } else {
+            ok = e.down.consume(bytes, nowUs);
+            if (!ok) e.droppedDown++;
+        }
+        if (!ok) _totalDropped++;
+    }
+    portEXIT_CRITICAL(&_lock);
+    return ok;
+}
+
+bool TrafficShaper::setLimit(const uint8_t* mac, uint32_t uploadKbps, uint32_t downloadKbps) {
+    uint32_t limit[2] = { uploadKbps, downloadKbps };
+    if (!apply(mac, limit, nullptr)) {
+        return false;
+    }
+    save();
+    DEBUG_PRINTF("Shaper: %02X:%02X:%02X:%02X:%02X:%02X limited to %u/%u kbit/s\n",
+                 mac[0], mac[1], mac[2], mac[3], mac[4], mac[5], uploadKbps, downloadKbps);
+    return true;
+}
+
+bool TrafficShaper::getLimit(const uint8_t* mac, uint32_t& uploadKbps, uint32_t& downloadKbps) {
+    uploadKbps = downloadKbps = 0;
+    portENTER_CRITICAL(&_lock);
+    int i = find(mac);
+    if (i >= 0) {
+        uploadKbps = _entries[i].limit.uploadKbps;
+        downloadKbps = _entries[i].limit.downloadKbps;
+    }
+    portEXIT_CRITICAL(&_lock);
+    return uploadKbps > 0 || downloadKbps > 0;
+}
+
+void TrafficShaper::getDropped(const uint8_t* mac, uint32_t& uploadDropped, uint32_t& downloadDropped) {
+    uploadDropped = downloadDropped = 0;
+    portENTER_CRITICAL(&_lock);
+    int i = find(mac);
+    if (i >= 0) {
+        uploadDropped = _entries[i].droppedUp;
+        downloadDropped = _entries[i].droppedDown;
+    }
+    portEXIT_CRITICAL(&_lock);
+}
+
+uint32_t TrafficShaper::getTotalDropped() {
+    return _totalDropped;
+}
+
+void TrafficShaper::onQuotaExceeded(const uint8_t* mac, const QuotaConfig& cfg) {
+    if (cfg.action != QUOTA_ACTION_THROTTLE) {
+        return;
+    }
+    uint32_t throttle = cfg.throttleKbps > 0 ? cfg.throttleKbps : QUOTA_DEFAULT_THROTTLE_KBPS;
+    apply(mac, nullptr, &throttle);
+}
+
+void TrafficShaper::onQuotaRestored(const uint8_t* mac) {
+    uint32_t none = 0;
+    apply(mac, nullptr, &none);
+}
+
+// Update the configured limit and/or the quota throttle (null = unchanged).
+// An entry lives while either is set.
+bool TrafficShaper::apply(const uint8_t* mac, const uint32_t* limitKbps, const uint32_t* throttleKbps) {
+    bool ok = true;
+    uint64_t nowUs = (uint64_t)esp_timer_get_time();
+
+    portENTER_CRITICAL(&_lock);
+    int i = find(mac);
+    if (i < 0) {
+        bool adding = (limitKbps && (limitKbps[0] > 0 || limitKbps[1] > 0)) ||
+                      (throttleKbps && *throttleKbps > 0);
+        if (adding && _count < SHAPER_MAX_DEVICES) {
+            i = _count;
+            _entries[i] = Entry();
+            memcpy(_entries[i].limit.mac, mac, 6);
+            _count++;
+        } else {
+            ok = !adding;
+        }
+    }
+    if (i >= 0) {
+        Entry& e = _entries[i];
+        if (limitKbps) {
+            e.limit.uploadKbps = limitKbps[0];
+            e.limit.downloadKbps = limitKbps[1];
+        }
+        if (throttleKbps) {
+            e.throttleKbps = *throttleKbps;
+        }
+
+        if (e.limit.uploadKbps == 0 && e.limit.downloadKbps == 0 && e.throttleKbps == 0) {
+            // Remove: move the last entry into the hole to keep the table dense
+            _count--;
+            if (i != _count) {
+                _entries[i] = _entries[_count];
+            }
+        } else {
+            configure(e, nowUs);
+        }
+    }
+    portEXIT_CRITICAL(&_lock);
+
+    if (!ok) {
+        DEBUG_PRINTLN("Shaper: Limit table full");
+    }
+    return ok;
+}
+
+void TrafficShaper::save() {
+    // Copy under the lock, allocate and write to NVS outside it
+    DeviceLimit snapshot[SHAPER_MAX_DEVICES];
+    uint8_t n = 0;
+    portENTER_CRITICAL(&_lock);
+    for (uint8_t i = 0; i < _count; i++) {
+        const DeviceLimit& l = _entries[i].limit;
+        if (l.uploadKbps > 0 || l.downloadKbps > 0) {
+            snapshot[n++] = l;
+        }
+    }
+    portEXIT_CRITICAL(&_lock);
+    storage.saveDeviceLimits(std::vector<DeviceLimit>(snapshot, snapshot + n));
+}
+
+int TrafficShaper::find(const uint8_t* mac) {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (memcmp(_entries[i].limit.mac, mac, 6) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void TrafficShaper::configure(Entry& e, uint64_t nowUs) {
+    uint32_t upBps = effectiveKbps(e.limit.uploadKbps, e.throttleKbps) * 1000 / 8;
+    uint32_t downBps = effectiveKbps(e.limit.downloadKbps, e.throttleKbps) * 1000 / 8;
+    e.up.configure(upBps, burstFor(upBps), nowUs);
+    e.down.configure(downBps, burstFor(downBps), nowUs);
+}
+
+uint32_t TrafficShaper::effectiveKbps(uint32_t limitKbps, uint32_t throttleKbps) {
+    // 0 means unlimited, so take the smaller non-zero value
+    if (limitKbps == 0) return throttleKbps;
+    if (throttleKbps == 0) return limitKbps;
+    return limitKbps < throttleKbps ? limitKbps : throttleKbps;
+}
+
+uint32_t TrafficShaper::burstFor(uint32_t bytesPerSec) {
+    // SHAPER_BURST_MS worth of traffic, but always room for a full frame
+    uint32_t burst = (uint32_t)((uint64_t)bytesPerSec * SHAPER_BURST_MS / 1000);
+    return burst < SHAPER_MIN_BURST ? SHAPER_MIN_BURST : burst;
+}
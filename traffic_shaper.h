@@ -0,0 +1,72 @@
+#ifndef TRAFFIC_SHAPER_H
+#define TRAFFIC_SHAPER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "token_bucket.h"
+#include "quota.h"
+
+// Per-device upload/download limit (kbit/s, 0 = unlimited)
+struct DeviceLimit {
+    uint8_t mac[6];
+    uint32_t uploadKbps;
+    uint32_t downloadKbps;
+};
+
+// Per-MAC token bucket policing on the AP forwarding path.
+//
+// allow() is called from the AP netif hooks: uploads on the WiFi task,
+// downloads on the lwIP task. Limits are changed from the web handlers, so the
+// table is guarded by a spinlock held only for the lookup and bucket update.
+// With no limits configured allow() returns without taking the lock.
+//
+// As a QuotaListener it also applies a temporary throttle to devices that are
+// over their data cap; the throttle is never saved and the tighter of the
+// throttle and the configured limit wins.
+class TrafficShaper : public QuotaListener {
+public:
+    TrafficShaper();
+
+    // Restore saved limits
+    void begin();
+
+    // Returns false if the frame is over the device's limit and must be dropped
+    bool allow(const uint8_t* mac, uint32_t bytes, bool isUpload);
+
+    // Configure limits (both 0 removes the device); persisted to NVS
+    bool setLimit(const uint8_t* mac, uint32_t uploadKbps, uint32_t downloadKbps);
+    bool getLimit(const uint8_t* mac, uint32_t& uploadKbps, uint32_t& downloadKbps);
+    void getDropped(const uint8_t* mac, uint32_t& uploadDropped, uint32_t& downloadDropped);
+    uint32_t getTotalDropped();
+
+    // QuotaListener
+    void onQuotaExceeded(const uint8_t* mac, const QuotaConfig& cfg) override;
+    void onQuotaRestored(const uint8_t* mac) override;
+
+private:
+    struct Entry {
+        DeviceLimit limit;
+        uint32_t throttleKbps;  // Quota throttle, 0 = none
+        TokenBucket up;
+        TokenBucket down;
+        uint32_t droppedUp;
+        uint32_t droppedDown;
+    };
+
+    Entry _entries[SHAPER_MAX_DEVICES];  // [0, _count) in use
+    volatile uint8_t _count;
+    uint32_t _totalDropped;
+    portMUX_TYPE _lock;
+
+    int find(const uint8_t* mac);
+    bool apply(const uint8_t* mac, const uint32_t* limitKbps, const uint32_t* throttleKbps);
+    void save();
+
+    static void configure(Entry& e, uint64_t nowUs);
+    static uint32_t effectiveKbps(uint32_t limitKbps, uint32_t throttleKbps);
+    static uint32_t burstFor(uint32_t bytesPerSec);
+};
+
+extern TrafficShaper trafficShaper;
+
+#endif // TRAFFIC_SHAPER_H
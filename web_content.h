@@ -1,380 +1,367 @@
+// Generated by tools/gen_web.py - do not edit.
+// Sources: tools/web/app.css, tools/web/app.js, tools/web/index.html
+// app.css      2966 bytes,   2472 minified,    976 gzip
+// app.js      11978 bytes,  10022 minified,   2902 gzip
+// index.html   6406 bytes,   4335 minified,   1361 gzip
+
 #ifndef WEB_CONTENT_H
 #define WEB_CONTENT_H
 
-const char INDEX_HTML[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<html lang="en">
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>ESP32 Network Monitor</title>
-    <style>
-        * { margin: 0; padding: 0; box-sizing: border-box; }
-        body {
-            font-family: -apple-system, BlinkMacSystemFont, 'Segoe UI', Roboto, sans-serif;
-            background: #1a1a2e;
-            color: #eee;
-            min-height: 100vh;
-            padding: 20px;
-        }
-        .container { max-width: 1200px; margin: 0 auto; }
-        h1 { color: #00d4ff; margin-bottom: 20px; font-size: 1.8rem; }
-        h2 { color: #00d4ff; margin: 20px 0 15px; font-size: 1.3rem; }
-        .status-bar {
-            display: flex; flex-wrap: wrap; gap: 15px;
-            background: #16213e; padding: 15px; border-radius: 10px; margin-bottom: 20px;
-        }
-        .status-item { flex: 1; min-width: 150px; }
-        .status-item label { color: #888; font-size: 0.85rem; display: block; }
-        .status-item span { font-size: 1.1rem; font-weight: bold; }
-        .status-online { color: #00ff88; }
-        .status-offline { color: #ff4444; }
-        .card {
-            background: #16213e; border-radius: 10px; padding: 20px; margin-bottom: 20px;
-        }
-        table { width: 100%; border-collapse: collapse; }
-        th, td { padding: 12px 8px; text-align: left; border-bottom: 1px solid #2a2a4a; }
-        th { color: #00d4ff; font-weight: 600; font-size: 0.9rem; }
-        td { font-size: 0.95rem; }
-        .device-name { cursor: pointer; color: #fff; }
-        .device-name:hover { color: #00d4ff; text-decoration: underline; }
-        .mac { color: #888; font-family: monospace; font-size: 0.85rem; }
-        .bytes { font-family: monospace; }
-        .active { color: #00ff88; }
-        .inactive { color: #666; }
-        .btn {
-            background: #00d4ff; color: #000; border: none; padding: 8px 16px;
-            border-radius: 5px; cursor: pointer; font-weight: 600; font-size: 0.9rem;
-        }
-        .btn:hover { background: #00b8e6; }
-        .btn-danger { background: #ff4444; color: #fff; }
-        .btn-danger:hover { background: #cc3333; }
-        .btn-sm { padding: 4px 10px; font-size: 0.8rem; }
-        input[type="text"] {
-            background: #0f0f23; border: 1px solid #2a2a4a; color: #fff;
-            padding: 10px; border-radius: 5px; width: 100%; font-size: 1rem;
-        }
-        input[type="text"]:focus { outline: none; border-color: #00d4ff; }
-        .input-group { display: flex; gap: 10px; margin-bottom: 15px; }
-        .input-group input { flex: 1; }
-        .domain-list { max-height: 300px; overflow-y: auto; }
-        .domain-item {
-            display: flex; justify-content: space-between; align-items: center;
-            padding: 10px; background: #0f0f23; border-radius: 5px; margin-bottom: 5px;
-        }
-        .settings-grid { display: grid; grid-template-columns: repeat(auto-fit, minmax(300px, 1fr)); gap: 20px; }
-        .modal {
-            display: none; position: fixed; top: 0; left: 0; width: 100%; height: 100%;
-            background: rgba(0,0,0,0.8); justify-content: center; align-items: center; z-index: 1000;
-        }
-        .modal.active { display: flex; }
-        .modal-content {
-            background: #16213e; padding: 25px; border-radius: 10px; width: 90%; max-width: 400px;
-        }
-        .modal-content h3 { margin-bottom: 15px; }
-        .modal-actions { display: flex; gap: 10px; margin-top: 20px; }
-        .modal-actions button { flex: 1; }
-        @media (max-width: 600px) {
-            th, td { padding: 8px 4px; font-size: 0.85rem; }
-            .mac { display: block; font-size: 0.75rem; }
-        }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <h1>ESP32 Network Monitor</h1>
-
-        <div class="status-bar">
-            <div class="status-item">
-                <label>Router Connection</label>
-                <span id="routerStatus" class="status-offline">Disconnected</span>
-            </div>
-            <div class="status-item">
-                <label>Dashboard from Main WiFi</label>
-                <span id="staIP">-</span>
-                <span id="mdnsLink" style="display:block;font-size:0.85rem;color:#888;"></span>
-            </div>
-            <div class="status-item">
-                <label>Connected Devices</label>
-                <span id="deviceCount">0</span>
-            </div>
-            <div class="status-item">
-                <label>Uptime</label>
-                <span id="uptime">0s</span>
-            </div>
-            <div class="status-item">
-                <label>Free Memory</label>
-                <span id="freeHeap">-</span>
-                <span id="minFreeHeap" style="display:block;font-size:0.75rem;color:#888;"></span>
-            </div>
-            <div class="status-item">
-                <label>CPU Load</label>
-                <span id="cpuLoad">-</span>
-                <span id="loopFreq" style="display:block;font-size:0.75rem;color:#888;"></span>
-            </div>
-        </div>
-
-        <div class="card">
-            <div style="display: flex; justify-content: space-between; align-items: center; margin-bottom: 15px;">
-                <h2 style="margin: 0;">Devices</h2>
-                <button class="btn btn-danger btn-sm" onclick="resetAllStats()">Reset All Stats</button>
-            </div>
-            <div style="overflow-x: auto;">
-                <table>
-                    <thead>
-                        <tr>
-                            <th>Device</th>
-                            <th>Download</th>
-                            <th>Upload</th>
-                            <th>Total</th>
-                            <th>Actions</th>
-                        </tr>
-                    </thead>
-                    <tbody id="deviceTable"></tbody>
-                </table>
-            </div>
-        </div>
-
-        <div class="settings-grid">
-            <div class="card">
-                <h2>DNS Blocking</h2>
-                <div class="input-group">
-                    <input type="text" id="domainInput" placeholder="Enter domain (e.g. youtube.com)">
-                    <button class="btn" onclick="blockDomain()">Block</button>
-                </div>
-                <div class="domain-list" id="blockedDomains"></div>
-            </div>
-
-            <div class="card">
-                <h2>Settings</h2>
-                <div style="margin-bottom: 15px;">
-                    <label style="color: #888; display: block; margin-bottom: 5px;">Upstream DNS</label>
-                    <div class="input-group">
-                        <input type="text" id="dnsInput" placeholder="1.1.1.1">
-                        <button class="btn" onclick="saveDNS()">Save</button>
-                    </div>
-                </div>
-                <div style="margin-bottom: 15px;">
-                    <label style="color: #888; display: block; margin-bottom: 5px;">Router WiFi</label>
-                    <input type="text" id="wifiSSID" placeholder="SSID" style="margin-bottom: 5px;">
-                    <div class="input-group">
-                        <input type="text" id="wifiPassword" placeholder="Password">
-                        <button class="btn" onclick="saveWiFi()">Connect</button>
-                    </div>
-                </div>
-                <div>
-                    <label style="color: #888; display: block; margin-bottom: 5px;">DNS Stats</label>
-                    <span>Queries: <strong id="dnsQueries">0</strong></span> &nbsp;|&nbsp;
-                    <span>Blocked: <strong id="dnsBlocked">0</strong></span>
-                </div>
-            </div>
-        </div>
-    </div>
-
-    <div class="modal" id="renameModal">
-        <div class="modal-content">
-            <h3>Rename Device</h3>
-            <input type="text" id="newDeviceName" placeholder="Enter device name">
-            <input type="hidden" id="renameMAC">
-            <div class="modal-actions">
-                <button class="btn" onclick="saveDeviceName()">Save</button>
-                <button class="btn btn-danger" onclick="closeModal()">Cancel</button>
-            </div>
-        </div>
-    </div>
-
-    <script>
-        function formatBytes(bytes) {
-            if (bytes === 0) return '0 B';
-            const k = 1024;
-            const sizes = ['B', 'KB', 'MB', 'GB', 'TB'];
-            const i = Math.floor(Math.log(bytes) / Math.log(k));
-            return parseFloat((bytes / Math.pow(k, i)).toFixed(2)) + ' ' + sizes[i];
-        }
-
-        function formatUptime(seconds) {
-            const d = Math.floor(seconds / 86400);
-            const h = Math.floor((seconds % 86400) / 3600);
-            const m = Math.floor((seconds % 3600) / 60);
-            const s = seconds % 60;
-            if (d > 0) return d + 'd ' + h + 'h';
-            if (h > 0) return h + 'h ' + m + 'm';
-            if (m > 0) return m + 'm ' + s + 's';
-            return s + 's';
-        }
-
-        async function fetchData() {
-            try {
-                const [devices, domains, status] = await Promise.all([
-                    fetch('/api/devices').then(r => r.json()),
-                    fetch('/api/blockedDomains').then(r => r.json()),
-                    fetch('/api/status').then(r => r.json())
-                ]);
-                updateDevices(devices);
-                updateDomains(domains);
-                updateStatus(status);
-            } catch (e) {
-                console.error('Fetch error:', e);
-            }
-        }
-
-        function updateDevices(devices) {
-            const tbody = document.getElementById('deviceTable');
-            tbody.innerHTML = devices.map(d => `
-                <tr class="${d.active ? 'active' : 'inactive'}">
-                    <td>
-                        <span class="device-name" onclick="openRename('${d.mac}', '${d.name}')">${d.name}</span>
-                        <span class="mac">${d.mac}</span>
-                    </td>
-                    <td class="bytes">${formatBytes(d.download)}</td>
-                    <td class="bytes">${formatBytes(d.upload)}</td>
-                    <td class="bytes">${formatBytes(d.total)}</td>
-                    <td>
-                        <button class="btn btn-sm" onclick="resetDevice('${d.mac}')">Reset</button>
-                    </td>
-                </tr>
-            `).join('');
-            document.getElementById('deviceCount').textContent = devices.filter(d => d.active).length;
-        }
-
-        function updateDomains(domains) {
-            const list = document.getElementById('blockedDomains');
-            list.innerHTML = domains.map(d => `
-                <div class="domain-item">
-                    <span>${d}</span>
-                    <button class="btn btn-danger btn-sm" onclick="unblockDomain('${d}')">Unblock</button>
-                </div>
-            `).join('');
-        }
-
-        function updateStatus(status) {
-            document.getElementById('routerStatus').textContent = status.connected ? 'Connected' : 'Disconnected';
-            document.getElementById('routerStatus').className = status.connected ? 'status-online' : 'status-offline';
-            const staIPEl = document.getElementById('staIP');
-            const mdnsEl = document.getElementById('mdnsLink');
-            if (status.staIP && status.connected) {
-                staIPEl.innerHTML = '<a href="http://' + status.staIP + '" style="color:#00d4ff;">' + status.staIP + '</a>';
-                if (status.mdnsHost) {
-                    mdnsEl.innerHTML = '<a href="http://' + status.mdnsHost + '.local" style="color:#00d4ff;">' + status.mdnsHost + '.local</a>';
-                }
-            } else {
-                staIPEl.textContent = '-';
-                mdnsEl.textContent = '';
-            }
-            document.getElementById('uptime').textContent = formatUptime(status.uptime);
-            document.getElementById('freeHeap').textContent = formatBytes(status.freeHeap);
-            if (status.minFreeHeap) {
-                document.getElementById('minFreeHeap').textContent = 'Min: ' + formatBytes(status.minFreeHeap);
-            }
-            if (status.loopFreq !== undefined) {
-                const freq = status.loopFreq;
-                const el = document.getElementById('cpuLoad');
-                const freqEl = document.getElementById('loopFreq');
-                // Estimate load: with 1ms delay, max ~1000 loops/sec when idle
-                const maxLoops = 1000;
-                const load = Math.max(0, Math.min(100, Math.round((1 - freq / maxLoops) * 100)));
-                el.textContent = load + '%';
-                el.style.color = load < 50 ? '#00ff88' : load < 80 ? '#ffaa00' : '#ff4444';
-                freqEl.textContent = freq + ' loops/s @ ' + (status.cpuFreq || 240) + 'MHz';
-            }
-            document.getElementById('dnsQueries').textContent = status.dnsQueries || 0;
-            document.getElementById('dnsBlocked').textContent = status.dnsBlocked || 0;
-            document.getElementById('dnsInput').placeholder = status.upstreamDNS || '1.1.1.1';
-        }
-
-        function openRename(mac, name) {
-            document.getElementById('renameMAC').value = mac;
-            document.getElementById('newDeviceName').value = name === 'Unknown Device' ? '' : name;
-            document.getElementById('renameModal').classList.add('active');
-            document.getElementById('newDeviceName').focus();
-        }
-
-        function closeModal() {
-            document.getElementById('renameModal').classList.remove('active');
-        }
-
-        async function saveDeviceName() {
-            const mac = document.getElementById('renameMAC').value;
-            const name = document.getElementById('newDeviceName').value;
-            await fetch('/api/devices/' + encodeURIComponent(mac) + '/name', {
-                method: 'POST',
-                headers: {'Content-Type': 'application/json'},
-                body: JSON.stringify({name})
-            });
-            closeModal();
-            fetchData();
-        }
-
-        async function resetDevice(mac) {
-            await fetch('/api/devices/' + encodeURIComponent(mac) + '/reset', {method: 'POST'});
-            fetchData();
-        }
-
-        async function resetAllStats() {
-            if (confirm('Reset bandwidth stats for all devices?')) {
-                await fetch('/api/stats/reset', {method: 'POST'});
-                fetchData();
-            }
-        }
-
-        async function blockDomain() {
-            const domain = document.getElementById('domainInput').value.trim();
-            if (!domain) return;
-            await fetch('/api/blockDomain', {
-                method: 'POST',
-                headers: {'Content-Type': 'application/json'},
-                body: JSON.stringify({domain})
-            });
-            document.getElementById('domainInput').value = '';
-            fetchData();
-        }
-
-        async function unblockDomain(domain) {
-            await fetch('/api/unblockDomain', {
-                method: 'POST',
-                headers: {'Content-Type': 'application/json'},
-                body: JSON.stringify({domain})
-            });
-            fetchData();
-        }
+#include <Arduino.h>
 
-        async function saveDNS() {
-            const dns = document.getElementById('dnsInput').value.trim();
-            if (!dns) return;
-            await fetch('/api/settings/dns', {
-                method: 'POST',
-                headers: {'Content-Type': 'application/json'},
-                body: JSON.stringify({dns})
-            });
-            fetchData();
-        }
+// One dashboard file, stored gzip-compressed
+struct WebAsset {
+    const char* path;
+    const char* contentType;
+    const uint8_t* data;
+    size_t length;
+    const char* etag;  // Quoted content hash
+    bool immutable;    // URL carries the hash; cache for good
+};
 
-        async function saveWiFi() {
-            const ssid = document.getElementById('wifiSSID').value.trim();
-            const password = document.getElementById('wifiPassword').value;
-            if (!ssid) return;
-            document.getElementById('routerStatus').textContent = 'Connecting...';
-            await fetch('/api/settings/wifi', {
-                method: 'POST',
-                headers: {'Content-Type': 'application/json'},
-                body: JSON.stringify({ssid, password})
-            });
-            setTimeout(fetchData, 5000);
-        }
+static const uint8_t APP_CSS_GZ[] PROGMEM = {
+    0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x55, 0x4D, 0x8F, 0xDB, 0x36,
+    0x10, 0xFD, 0x2B, 0x42, 0x16, 0x41, 0x76, 0x0B, 0xD3, 0x90, 0x64, 0xAF, 0xAB, 0x50, 0x28, 0x50,
+    0xF4, 0x50, 0xA0, 0x87, 0x5E, 0x1A, 0xE4, 0x54, 0xF4, 0x40, 0x49, 0x43, 0x9B, 0x5D, 0x89, 0x14,
+    0x44, 0x6A, 0x6D, 0x47, 0xF0, 0x7F, 0xEF, 0x90, 0xFA, 0xA4, 0xAD, 0xA4, 0x5E, 0x40, 0x2B, 0x91,
+    0x33, 0xC3, 0x37, 0x6F, 0x66, 0x1E, 0x7F, 0xEA, 0x2A, 0xD6, 0x1C, 0x85, 0xA4, 0x61, 0x5A, 0xB3,
+    0xA2, 0x10, 0xF2, 0x88, 0x6F, 0x99, 0xBA, 0x10, 0x2D, 0xBE, 0xD9, 0x8F, 0x4C, 0x35, 0x05, 0x34,
+    0x04, 0x57, 0x6E, 0x99, 0x2A, 0xAE, 0x1D, 0x57, 0xD2, 0x10, 0xCE, 0x2A, 0x51, 0x5E, 0x29, 0x61,
+    0x75, 0x5D, 0x02, 0xD1, 0x57, 0x6D, 0xA0, 0xDA, 0xFC, 0x56, 0x0A, 0xF9, 0xF6, 0x27, 0xCB, 0xBF,
+    0xB8, 0xCF, 0xDF, 0xD1, 0x6E, 0xF3, 0xE9, 0x0B, 0x1C, 0x15, 0x04, 0x5F, 0xFF, 0xF8, 0xB4, 0xF9,
+    0x4B, 0x65, 0xCA, 0xA8, 0x8D, 0x66, 0x52, 0x13, 0x0D, 0x8D, 0xE0, 0x69, 0xC6, 0xF2, 0xB7, 0x63,
+    0xA3, 0x5A, 0x59, 0xD0, 0xA7, 0x88, 0x45, 0x2C, 0x86, 0x34, 0x57, 0xA5, 0x6A, 0xE8, 0x13, 0x00,
+    0xA4, 0x95, 0x90, 0xE4, 0x04, 0xE2, 0x78, 0x32, 0x34, 0x0A, 0xC3, 0xF7, 0xD3, 0x84, 0x2E, 0x0E,
+    0xEB, 0xCB, 0x6D, 0x9B, 0x63, 0x78, 0x26, 0x24, 0x34, 0x08, 0xFF, 0x42, 0xCE, 0xA2, 0x30, 0x27,
+    0x1A, 0xC5, 0x21, 0xEE, 0xA5, 0x63, 0x3E, 0x01, 0x6B, 0x8D, 0xBA, 0x9D, 0xA2, 0x6E, 0x88, 0x1A,
+    0x86, 0xC5, 0x9E, 0xF3, 0x61, 0x1B, 0x13, 0x32, 0x46, 0x55, 0x2E, 0x5A, 0xEA, 0x72, 0xC2, 0x7C,
+    0x81, 0x46, 0xDB, 0xA4, 0x81, 0xEA, 0x76, 0x8A, 0x57, 0x9D, 0x9C, 0x75, 0x10, 0x06, 0xD1, 0xEB,
+    0x9D, 0xD3, 0xCE, 0x3A, 0x6D, 0xB5, 0x61, 0xA6, 0xD5, 0x24, 0x63, 0x4D, 0x57, 0x08, 0x5D, 0x97,
+    0xEC, 0x4A, 0x79, 0x09, 0x68, 0x89, 0x0F, 0x72, 0x6E, 0x58, 0x4D, 0xED, 0x23, 0x3D, 0xE2, 0x8B,
+    0x8B, 0xE0, 0x11, 0x70, 0x88, 0xA3, 0x1D, 0x4C, 0x49, 0xF6, 0xFB, 0x3D, 0xF5, 0x0D, 0x2B, 0x44,
+    0xAB, 0x91, 0x85, 0x29, 0xB7, 0x25, 0xF8, 0xE9, 0x58, 0x81, 0xA4, 0x77, 0xF6, 0x28, 0x1A, 0x39,
+    0xF2, 0x06, 0x4E, 0x5E, 0xEF, 0x6D, 0x82, 0x92, 0x65, 0x50, 0x8E, 0xF9, 0x25, 0x49, 0xB2, 0xC8,
+    0x24, 0xDC, 0x26, 0xAF, 0x98, 0x4A, 0x3A, 0xC2, 0xCF, 0x4A, 0x95, 0xBF, 0xF9, 0xDE, 0xBA, 0x66,
+    0xB2, 0x5B, 0xE6, 0x1E, 0x59, 0x07, 0xB7, 0x70, 0xEE, 0xCB, 0x95, 0xA9, 0xB2, 0x98, 0x7C, 0x94,
+    0xC4, 0xAE, 0x80, 0x99, 0x4D, 0xCE, 0x93, 0x64, 0xDE, 0xE4, 0x7C, 0xB9, 0xCB, 0xF9, 0x1E, 0x7F,
+    0x58, 0x5B, 0xD6, 0x14, 0xDD, 0x0A, 0x39, 0x2B, 0x7C, 0x2C, 0x9B, 0x62, 0x8D, 0x1C, 0xC3, 0xB2,
+    0x12, 0xBA, 0x81, 0x8A, 0x30, 0xFC, 0x38, 0xC6, 0xC0, 0x13, 0x4B, 0x56, 0x6B, 0xA0, 0xE3, 0xCB,
+    0xCD, 0x9C, 0x36, 0xA6, 0xE8, 0x26, 0xFE, 0x63, 0x2C, 0x74, 0x82, 0x31, 0x0D, 0x5C, 0x0C, 0x61,
+    0xA5, 0x38, 0x4A, 0x5A, 0x02, 0x37, 0xE9, 0x34, 0x0E, 0xEE, 0x8C, 0x08, 0xAD, 0xB4, 0x2A, 0x45,
+    0x11, 0x3C, 0xC5, 0x2C, 0x66, 0x7B, 0x86, 0x61, 0xEE, 0x3A, 0x67, 0xC9, 0xCC, 0x21, 0x0C, 0x3D,
+    0xB2, 0x3F, 0xDB, 0xB6, 0xC1, 0x53, 0xBD, 0xB5, 0x57, 0xD7, 0x4B, 0x05, 0xBC, 0x8B, 0x1C, 0x88,
+    0x64, 0x15, 0xD2, 0xD3, 0x36, 0x1A, 0x23, 0xD6, 0x4A, 0x48, 0x03, 0x4D, 0x3A, 0xB1, 0xC5, 0x3D,
+    0x33, 0x7A, 0x52, 0xEF, 0x38, 0x0E, 0xFE, 0xE9, 0x0E, 0x7E, 0x01, 0xB9, 0x6A, 0x98, 0x11, 0x4A,
+    0x52, 0xA4, 0x13, 0x1A, 0xCB, 0xF9, 0x6D, 0x5B, 0xB1, 0xFC, 0xA1, 0x09, 0x86, 0xB9, 0xAE, 0x94,
+    0x54, 0x58, 0xE7, 0x1C, 0x1E, 0x5B, 0xE3, 0xB6, 0xCD, 0xAE, 0x06, 0x74, 0xB7, 0x6A, 0x7E, 0xDB,
+    0xB2, 0xDC, 0x88, 0xF7, 0x87, 0x72, 0x0B, 0xE9, 0xAF, 0x1F, 0x0E, 0x07, 0x8C, 0x63, 0xA4, 0x57,
+    0xE4, 0x01, 0xF1, 0xE4, 0x1A, 0x0E, 0x5C, 0x53, 0xA9, 0xE4, 0x3C, 0x18, 0x58, 0x93, 0x20, 0x3A,
+    0x3C, 0x0C, 0x87, 0x1D, 0x97, 0x3B, 0x9A, 0xFE, 0x97, 0x78, 0x8B, 0x60, 0x20, 0xCD, 0xC7, 0x91,
+    0x25, 0xD0, 0xE3, 0x23, 0x05, 0x93, 0xC7, 0xBB, 0xED, 0xBE, 0x49, 0xBD, 0x22, 0xCC, 0x96, 0x2B,
+    0xE1, 0xF2, 0x7C, 0x87, 0xBF, 0xDE, 0x48, 0x57, 0x53, 0x83, 0xED, 0x6D, 0x1E, 0xBE, 0xF6, 0x84,
+    0xBD, 0xF6, 0x08, 0x59, 0xB7, 0xE6, 0x6F, 0x73, 0xAD, 0xE1, 0x97, 0x0F, 0xB6, 0x7C, 0x1F, 0xFE,
+    0xF1, 0xE1, 0xF1, 0x90, 0xC7, 0xBB, 0x91, 0x9B, 0x87, 0x06, 0x5C, 0x00, 0x9B, 0xC5, 0x24, 0x5C,
+    0xE5, 0x6B, 0x31, 0x15, 0x8B, 0x79, 0x5E, 0x87, 0x40, 0xB9, 0xCA, 0x5B, 0xDD, 0xA9, 0xD6, 0xD8,
+    0xE6, 0xE9, 0x4B, 0x32, 0x8F, 0xD2, 0xDC, 0x70, 0xB6, 0xD6, 0xE8, 0x4B, 0x2C, 0xDA, 0xDA, 0x57,
+    0x41, 0x27, 0x7B, 0x8F, 0x63, 0x6A, 0x95, 0xCE, 0xF3, 0x0A, 0xDC, 0xFB, 0xA0, 0x64, 0xD8, 0xE1,
+    0xAA, 0x42, 0x9D, 0x27, 0xA5, 0xD0, 0xC6, 0x49, 0xFD, 0x70, 0x27, 0xEC, 0x9C, 0xD4, 0x5B, 0xB6,
+    0x79, 0xA9, 0xCE, 0xE4, 0x4A, 0x9D, 0xD8, 0x8F, 0xD6, 0x4E, 0x0B, 0xBD, 0xD3, 0xFF, 0x6D, 0xB5,
+    0x11, 0xFC, 0x4A, 0xEC, 0xBD, 0x01, 0xD2, 0x50, 0xD7, 0xAF, 0x24, 0x03, 0x73, 0x06, 0x90, 0xA9,
+    0x1B, 0x70, 0xE7, 0xA5, 0x69, 0x0E, 0xAE, 0x7D, 0x7C, 0xF2, 0xBE, 0x57, 0x80, 0x25, 0x9F, 0x7E,
+    0x5E, 0x2E, 0x2D, 0x0D, 0xC6, 0x60, 0x10, 0x8D, 0x99, 0x89, 0x62, 0x02, 0x64, 0x3F, 0x52, 0xFB,
+    0x20, 0x78, 0x20, 0xAE, 0x18, 0xB0, 0x24, 0xB6, 0x95, 0xD4, 0xB4, 0x81, 0x1A, 0x98, 0x79, 0xB6,
+    0xC9, 0x10, 0x2E, 0xCC, 0x06, 0x85, 0x1C, 0x93, 0x7E, 0x76, 0xD9, 0x6E, 0x22, 0xDE, 0xBC, 0xBC,
+    0x38, 0x1E, 0x7B, 0xE1, 0xAF, 0x54, 0xC1, 0xCA, 0x29, 0x6A, 0x3F, 0x26, 0x4A, 0x0B, 0x37, 0xE8,
+    0x5C, 0x5C, 0xA0, 0x48, 0x8D, 0xAA, 0xF1, 0x36, 0xB7, 0xC2, 0x85, 0xFF, 0x16, 0xF5, 0x9E, 0x2F,
+    0xD6, 0x8F, 0xCB, 0xDC, 0x9A, 0x63, 0xC6, 0x9E, 0xC3, 0x8D, 0xFB, 0xDB, 0x26, 0x2F, 0x0F, 0xA4,
+    0x0D, 0xD4, 0xAC, 0xB0, 0xF5, 0x8D, 0x08, 0x54, 0x96, 0x8B, 0x8D, 0x18, 0x0E, 0xC0, 0x46, 0x2D,
+    0x58, 0x96, 0x61, 0xD8, 0x1A, 0x03, 0x76, 0x3F, 0xB8, 0x01, 0xE3, 0xEF, 0xDC, 0x80, 0x7D, 0x16,
+    0x9F, 0x11, 0xF8, 0x7C, 0xF1, 0xEF, 0xC3, 0x99, 0x8F, 0x31, 0x76, 0x70, 0xDA, 0x75, 0x6B, 0x9D,
+    0xD6, 0x1B, 0x59, 0x6C, 0x4A, 0xEA, 0x1F, 0x77, 0xA8, 0x65, 0x6F, 0xC1, 0xF4, 0xE8, 0x14, 0x64,
+    0x2D, 0xC6, 0x93, 0x63, 0x87, 0xFE, 0x5A, 0x41, 0x21, 0x58, 0xF0, 0x3C, 0xC3, 0x39, 0x58, 0x38,
+    0x2F, 0x9D, 0x7F, 0xA3, 0x58, 0xE1, 0xDA, 0xDF, 0xCF, 0x7B, 0xAF, 0xA8, 0x56, 0x89, 0xBD, 0x1B,
+    0xD7, 0x33, 0xFA, 0xD9, 0x19, 0xDD, 0xFE, 0x03, 0x4D, 0x93, 0x6E, 0x94, 0xA8, 0x09, 0x00, 0x00,
+};
 
-        document.getElementById('domainInput').addEventListener('keypress', e => {
-            if (e.key === 'Enter') blockDomain();
-        });
+static const uint8_t APP_JS_GZ[] PROGMEM = {
+    0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xBD, 0x1A, 0x6B, 0x77, 0xD3, 0xC8,
+    0xF5, 0xBB, 0x7F, 0xC5, 0x90, 0x76, 0x91, 0x54, 0x1C, 0xD9, 0x3C, 0x96, 0xD2, 0x24, 0x0E, 0x4B,
+    0x42, 0x58, 0x68, 0x13, 0x48, 0x71, 0x68, 0x3F, 0xB0, 0x39, 0x87, 0xB1, 0x34, 0xC6, 0xDA, 0xC8,
+    0x33, 0x46, 0x33, 0x4A, 0xF0, 0xB2, 0xF9, 0xEF, 0xBD, 0x77, 0x1E, 0xD2, 0xC8, 0x96, 0x95, 0xB0,
+    0x6D, 0xBA, 0x9C, 0x35, 0xD2, 0xCC, 0x9D, 0xFB, 0x7E, 0x8E, 0x98, 0x96, 0x3C, 0x51, 0x99, 0xE0,
+    0x64, 0x2A, 0x8A, 0x39, 0x55, 0x07, 0x4B, 0xC5, 0x64, 0x38, 0xC1, 0xDF, 0x88, 0x7C, 0xEB, 0x65,
+    0x53, 0x62, 0x5E, 0xC8, 0x68, 0x34, 0x22, 0xC3, 0x88, 0x14, 0x4C, 0x95, 0x05, 0x27, 0xC1, 0x90,
+    0x1C, 0x04, 0xBB, 0xBD, 0x44, 0x70, 0xA9, 0xC8, 0x05, 0x19, 0x91, 0x87, 0xC3, 0x47, 0x4F, 0xDC,
+    0xBB, 0xCC, 0x7E, 0xC3, 0x03, 0xE4, 0x63, 0x70, 0x10, 0xF4, 0x49, 0xF0, 0x0F, 0xFD, 0x7B, 0xA2,
+    0x7F, 0x7F, 0xD6, 0xBF, 0x67, 0x07, 0xC1, 0xB9, 0x03, 0xCE, 0x00, 0xF0, 0x84, 0xAA, 0x59, 0x3C,
+    0xCD, 0x85, 0x28, 0x42, 0xFD, 0x98, 0x8B, 0xCF, 0x8E, 0x85, 0x01, 0xA9, 0x56, 0x2E, 0xA2, 0x68,
+    0xB7, 0x67, 0xE9, 0x2F, 0x68, 0x21, 0xD9, 0xAB, 0x5C, 0x50, 0x15, 0x5A, 0xFE, 0x2C, 0xE0, 0x42,
+    0x5C, 0x85, 0x17, 0x7D, 0x92, 0x45, 0x51, 0xAC, 0xC4, 0xAB, 0xEC, 0x2B, 0x4B, 0xC3, 0x47, 0x51,
+    0x44, 0x1E, 0x90, 0x00, 0xFE, 0x3C, 0x30, 0xAC, 0x7D, 0xCC, 0x80, 0xFA, 0x75, 0x6F, 0xDA, 0x94,
+    0xFC, 0x3D, 0x55, 0xCC, 0xE0, 0x3A, 0x65, 0xC5, 0x98, 0x25, 0x28, 0xBE, 0xA5, 0xB6, 0xA6, 0x1A,
+    0x03, 0x41, 0x7E, 0xFF, 0x1D, 0x55, 0x02, 0xB8, 0x07, 0x32, 0x68, 0xC1, 0xF8, 0x61, 0xA1, 0xB2,
+    0x39, 0x0B, 0x25, 0x03, 0x49, 0x53, 0xAD, 0x4E, 0x23, 0x72, 0xDA, 0x14, 0xD9, 0xEE, 0x83, 0x04,
+    0xCF, 0x9E, 0x3E, 0x19, 0x0E, 0x23, 0xA7, 0x99, 0x59, 0x13, 0xAC, 0x82, 0xFB, 0xC1, 0xC2, 0xC1,
+    0x81, 0xC7, 0x4F, 0x3D, 0xF8, 0xF9, 0x46, 0x78, 0x0D, 0x06, 0xE0, 0x4F, 0x6B, 0x60, 0xB4, 0x4F,
+    0x0D, 0xF0, 0x74, 0xB8, 0xAB, 0x4D, 0x9D, 0x92, 0x7D, 0xCF, 0xC8, 0x29, 0x8A, 0x96, 0x6A, 0xBD,
+    0xCD, 0xF0, 0x71, 0x16, 0x18, 0xA8, 0x59, 0x03, 0xCA, 0x6C, 0x69, 0xA8, 0x39, 0x3E, 0xCE, 0x2D,
+    0xD4, 0xBC, 0x01, 0x65, 0xB6, 0x8C, 0x0D, 0xF0, 0x11, 0x15, 0x66, 0xB7, 0xAA, 0xF7, 0x6B, 0xA7,
+    0x1F, 0x76, 0x99, 0x25, 0xEC, 0xBD, 0xB8, 0x42, 0x26, 0x39, 0xBB, 0x02, 0xA9, 0x16, 0x61, 0xC5,
+    0xB9, 0xD9, 0x3D, 0xCA, 0x57, 0x36, 0x73, 0xE6, 0xB6, 0x7E, 0x66, 0x1C, 0xB7, 0xCA, 0x3C, 0xF7,
+    0x57, 0x0F, 0x84, 0x50, 0xD5, 0x32, 0x95, 0x4B, 0x9E, 0x90, 0xDA, 0x5C, 0x4C, 0x25, 0xB3, 0x97,
+    0x1A, 0x4C, 0x86, 0xB5, 0x9D, 0xBE, 0x00, 0xBC, 0x87, 0x72, 0x64, 0x4E, 0x93, 0xE7, 0xC0, 0x6D,
+    0xC6, 0x13, 0x36, 0x1A, 0x06, 0x64, 0xC7, 0x3D, 0xA3, 0x60, 0x35, 0x2C, 0x08, 0x74, 0x7F, 0x02,
+    0x04, 0xBD, 0x65, 0xA4, 0x0F, 0x84, 0x17, 0x8B, 0x7C, 0x69, 0x28, 0x1D, 0xCE, 0x28, 0xFF, 0x0C,
+    0xF4, 0xE8, 0x15, 0xCD, 0x94, 0x61, 0x21, 0x0C, 0x06, 0x74, 0x91, 0x0D, 0xCC, 0x01, 0xF9, 0x1C,
+    0x0F, 0x7F, 0x01, 0x3F, 0x9E, 0x31, 0x1E, 0x16, 0x64, 0xB4, 0x4F, 0x8A, 0xF8, 0x57, 0x29, 0x78,
+    0x18, 0x45, 0x7D, 0xA2, 0x8A, 0x92, 0x45, 0xA8, 0xB2, 0x56, 0x51, 0xA8, 0xA2, 0x5A, 0x0E, 0x55,
+    0x2C, 0x2B, 0x69, 0x3E, 0xF6, 0x49, 0x2A, 0xE6, 0x34, 0xE3, 0xB2, 0x4F, 0xA4, 0xA2, 0xAA, 0x94,
+    0xE7, 0x20, 0x9F, 0xA1, 0x7E, 0x5A, 0x88, 0x79, 0x26, 0x59, 0x4C, 0xF3, 0x3C, 0xFC, 0xD8, 0x6B,
+    0xAA, 0xA3, 0xDF, 0xF3, 0x79, 0x9B, 0xE4, 0x22, 0xB9, 0x60, 0xE9, 0x4B, 0x83, 0x29, 0x68, 0xE7,
+    0xAE, 0x71, 0xC2, 0xD0, 0x6A, 0x87, 0xEC, 0x9D, 0x83, 0x0C, 0xE5, 0x22, 0x85, 0xD0, 0xB3, 0x18,
+    0x43, 0xCB, 0x63, 0xB5, 0x3E, 0xD6, 0xC7, 0x43, 0x83, 0x05, 0x25, 0x26, 0x09, 0x05, 0xE4, 0x24,
+    0x64, 0xCE, 0x50, 0x22, 0x67, 0x31, 0x2B, 0x0A, 0x70, 0xF9, 0xE0, 0x15, 0xD2, 0x25, 0xFA, 0x65,
+    0x07, 0x12, 0x8D, 0xD1, 0xD0, 0xB5, 0xF6, 0x82, 0x85, 0xC8, 0xF3, 0x33, 0x08, 0xC7, 0xA2, 0x72,
+    0x82, 0x4A, 0x67, 0x80, 0xBB, 0x50, 0xA7, 0xB0, 0x9F, 0xF1, 0xCF, 0xA1, 0xCB, 0x7A, 0xF7, 0xAA,
+    0x03, 0x51, 0xE3, 0xAC, 0x64, 0xEA, 0x0D, 0x57, 0xAC, 0xB8, 0xA4, 0x79, 0x58, 0x29, 0xBB, 0x4F,
+    0x7E, 0x1C, 0xEA, 0x48, 0xF4, 0x72, 0x80, 0x36, 0xF5, 0x07, 0x2D, 0x43, 0x58, 0x3A, 0xAC, 0x65,
+    0x9C, 0xFA, 0xC6, 0x8F, 0x48, 0x8B, 0x43, 0xAC, 0xC0, 0xF4, 0xC9, 0x94, 0xE6, 0x12, 0x45, 0xB1,
+    0x08, 0xAC, 0x82, 0x48, 0x53, 0x6F, 0xF5, 0x86, 0x03, 0xB4, 0x2A, 0x23, 0x0D, 0x3D, 0x56, 0xCB,
+    0x0D, 0x5E, 0x8D, 0x06, 0x4A, 0x39, 0xAB, 0xC5, 0xBF, 0xCA, 0x78, 0x2A, 0xAE, 0xE2, 0xA3, 0x4B,
+    0xC6, 0xD5, 0x58, 0x94, 0x45, 0xA2, 0xF5, 0xDD, 0x54, 0x95, 0x0B, 0xE1, 0x3A, 0x74, 0x99, 0x8B,
+    0x4A, 0xEF, 0x9C, 0xF5, 0x03, 0x86, 0x2B, 0xE0, 0x07, 0xBB, 0x3D, 0x26, 0x63, 0x9A, 0xA6, 0x1A,
+    0xE2, 0x38, 0x93, 0x8A, 0x71, 0x06, 0xA6, 0x33, 0x5C, 0xA2, 0xD1, 0xD0, 0x43, 0x7C, 0xE5, 0xFD,
+    0x7D, 0xFC, 0xEE, 0x6D, 0xAC, 0x13, 0x7E, 0xC8, 0x62, 0x58, 0xA1, 0x51, 0xB4, 0x09, 0xC9, 0xA4,
+    0x94, 0x4B, 0x40, 0x01, 0x52, 0x00, 0x8E, 0x6F, 0x08, 0x93, 0xE4, 0x02, 0xCE, 0x01, 0xFC, 0x2A,
+    0xE7, 0xD7, 0x06, 0x87, 0xE0, 0xDA, 0x5B, 0x80, 0x6B, 0x77, 0x08, 0xA5, 0x87, 0x8D, 0x82, 0xD1,
+    0x74, 0x89, 0x4A, 0x63, 0x3A, 0xF2, 0x3D, 0x79, 0xE2, 0xC3, 0xE3, 0x77, 0xE3, 0xA3, 0x97, 0x11,
+    0x59, 0x43, 0xB9, 0x6E, 0xFF, 0xA6, 0x65, 0x93, 0xBE, 0x89, 0x4F, 0x96, 0x56, 0x6A, 0x4E, 0xE2,
+    0x29, 0xE6, 0x94, 0xFB, 0xF7, 0x49, 0x12, 0xEB, 0x4C, 0x42, 0xEE, 0x8D, 0xBC, 0xAC, 0x53, 0xC1,
+    0x55, 0xE7, 0x9A, 0xC1, 0xE9, 0x5B, 0x00, 0xE1, 0x0C, 0xBA, 0xC8, 0x4B, 0xA1, 0xA0, 0x01, 0x46,
+    0x0B, 0x9D, 0x3E, 0x41, 0xA6, 0xB9, 0xB8, 0x64, 0x69, 0x0C, 0xE5, 0xE9, 0x88, 0x42, 0x80, 0xCE,
+    0x69, 0x82, 0x32, 0x7B, 0xC0, 0x29, 0x83, 0x58, 0x61, 0xB8, 0x11, 0xE9, 0x13, 0x36, 0x15, 0x55,
+    0x27, 0xD2, 0x15, 0x78, 0x88, 0x86, 0x30, 0x8D, 0x01, 0x1C, 0x92, 0x0B, 0x9E, 0xF0, 0x33, 0x70,
+    0x12, 0x7F, 0x46, 0xAB, 0x50, 0xD4, 0x86, 0xDB, 0xB1, 0x59, 0x38, 0x89, 0x27, 0x3A, 0x1D, 0x16,
+    0x8C, 0xA7, 0xAC, 0x70, 0xD2, 0x58, 0x5D, 0x3C, 0x37, 0x69, 0x76, 0x87, 0x54, 0xE4, 0x57, 0x9C,
+    0x95, 0xA9, 0x33, 0xF6, 0x55, 0x85, 0x2C, 0x87, 0x34, 0x08, 0x0F, 0x4E, 0x47, 0x2C, 0x8F, 0xF1,
+    0xF5, 0x50, 0x40, 0x78, 0x72, 0xA5, 0xF5, 0x68, 0xB6, 0x57, 0x36, 0xCC, 0x72, 0x03, 0x65, 0x02,
+    0xD6, 0x86, 0x50, 0x72, 0x72, 0x69, 0xF9, 0xAB, 0xC4, 0xA9, 0xD0, 0x3B, 0x52, 0x91, 0x94, 0x73,
+    0x38, 0x1D, 0x1B, 0xD0, 0xA3, 0x9C, 0xE1, 0x5B, 0x18, 0xA8, 0x02, 0x3D, 0x5A, 0x15, 0x71, 0xC6,
+    0x41, 0xD6, 0xD7, 0x67, 0x27, 0xC7, 0x00, 0xFC, 0xA9, 0xB7, 0xA7, 0xD2, 0xFD, 0x3D, 0xB9, 0xA0,
+    0x80, 0x3A, 0xA7, 0x52, 0x8E, 0xB6, 0x8C, 0x24, 0xDB, 0x9C, 0xCE, 0xD9, 0xD6, 0xFE, 0xDE, 0x00,
+    0xB7, 0x9A, 0x00, 0x40, 0xB2, 0xDE, 0x18, 0xC0, 0x71, 0xC4, 0xE1, 0x36, 0x75, 0xD3, 0xB1, 0xF5,
+    0xBF, 0x5B, 0xB7, 0x54, 0xCC, 0x5F, 0x93, 0x62, 0x65, 0xC1, 0x9D, 0x82, 0xAD, 0x52, 0x29, 0x51,
+    0xB1, 0x38, 0x51, 0x9C, 0xC0, 0xFF, 0xDB, 0x72, 0xBE, 0xB5, 0xFF, 0x9E, 0x81, 0x19, 0xF6, 0x06,
+    0x06, 0xC0, 0x1C, 0xF9, 0xA4, 0xF5, 0xF0, 0xA5, 0x64, 0xC5, 0x72, 0x0C, 0x6E, 0x94, 0x28, 0xCC,
+    0xC8, 0xB1, 0x27, 0x38, 0xD4, 0x00, 0xC1, 0x93, 0x3C, 0x4B, 0x2E, 0xAA, 0x70, 0x13, 0x0B, 0xC6,
+    0xDF, 0x33, 0xDC, 0x0C, 0x8D, 0x13, 0xD5, 0xAE, 0xF5, 0x19, 0x5C, 0x0B, 0xED, 0x10, 0xE3, 0x6E,
+    0xD4, 0x86, 0xDB, 0x10, 0x6F, 0xC1, 0x5A, 0x20, 0x73, 0xC6, 0x9A, 0x1A, 0x45, 0xD5, 0x6A, 0xA8,
+    0xA2, 0xD9, 0xA6, 0x65, 0x79, 0x5E, 0x1B, 0x5D, 0x15, 0xE8, 0xC4, 0x95, 0xD9, 0x13, 0x74, 0x94,
+    0x22, 0x4E, 0x58, 0x9E, 0x4B, 0x4D, 0x5D, 0x6B, 0xE1, 0x2D, 0x30, 0x83, 0xEE, 0x10, 0x53, 0x40,
+    0x71, 0xC9, 0xB0, 0x19, 0x30, 0x4F, 0xBA, 0x17, 0xC8, 0xB8, 0x7D, 0x81, 0x7C, 0x63, 0xBD, 0x34,
+    0xF9, 0x38, 0x3C, 0x8F, 0xA7, 0x59, 0x21, 0x95, 0xF5, 0x99, 0xC3, 0x59, 0x96, 0xA7, 0x40, 0xC9,
+    0xC9, 0xD5, 0x00, 0x04, 0x12, 0x6B, 0x70, 0x18, 0xA5, 0x0F, 0xA0, 0x37, 0x8B, 0x85, 0x44, 0x72,
+    0xE4, 0x97, 0x72, 0x38, 0x9C, 0xFC, 0x55, 0xB7, 0x52, 0x7A, 0xCD, 0xF5, 0xB6, 0x69, 0xAC, 0x96,
+    0x0B, 0x86, 0x6C, 0x04, 0x51, 0x03, 0xEF, 0xC3, 0xF3, 0x7E, 0xA3, 0x85, 0x4D, 0xA1, 0x54, 0x5C,
+    0x71, 0x68, 0x9E, 0xD3, 0x26, 0xDC, 0xA3, 0x35, 0xB8, 0x72, 0xB1, 0x0E, 0xF5, 0x78, 0x0D, 0x4A,
+    0x09, 0x45, 0xF3, 0x26, 0xD0, 0x93, 0x56, 0x99, 0x83, 0x5F, 0xCA, 0x47, 0x0F, 0xFF, 0xF6, 0x58,
+    0x73, 0xEB, 0x35, 0xDD, 0x35, 0x3F, 0xF8, 0xBA, 0x86, 0x68, 0x5D, 0x27, 0x06, 0xCF, 0xC3, 0x75,
+    0x3C, 0x86, 0x5F, 0x87, 0xC5, 0xB3, 0xF4, 0x4A, 0xA2, 0xD1, 0xF9, 0xD8, 0xB3, 0xB5, 0x9A, 0x88,
+    0x74, 0xE9, 0x47, 0x39, 0x38, 0x9F, 0x25, 0x79, 0xB0, 0x7C, 0x93, 0x86, 0x81, 0xF1, 0xCB, 0x33,
+    0x3A, 0xC9, 0x19, 0xC6, 0x3B, 0x10, 0x85, 0x5C, 0x6B, 0xDA, 0x2A, 0xED, 0xB7, 0xAA, 0x38, 0x27,
+    0x62, 0x5A, 0xF7, 0xA6, 0x55, 0xDE, 0xF6, 0x1C, 0x7A, 0x46, 0xA5, 0x49, 0xAC, 0xBA, 0x31, 0xB3,
+    0xC9, 0x38, 0xAC, 0x92, 0x26, 0x9C, 0xF2, 0xD3, 0xAF, 0xE9, 0x5C, 0x1C, 0xAB, 0x38, 0x6A, 0x7C,
+    0x8C, 0xE3, 0xD8, 0x43, 0x07, 0x0D, 0x48, 0x89, 0x25, 0xE0, 0x3C, 0x6A, 0x66, 0xE7, 0x6F, 0xBA,
+    0xDD, 0x31, 0x49, 0xAB, 0x42, 0xFC, 0xD9, 0xE5, 0x69, 0xDB, 0x1D, 0xDC, 0x53, 0x85, 0x61, 0x03,
+    0x93, 0xF1, 0x4A, 0xF2, 0x73, 0x70, 0xF5, 0x69, 0x2F, 0xCB, 0xC3, 0x39, 0xAD, 0xD8, 0x96, 0xC8,
+    0x31, 0x35, 0xD5, 0x68, 0x45, 0x14, 0xA9, 0xEE, 0x96, 0x36, 0xF1, 0x1C, 0x4B, 0x51, 0xC0, 0xE8,
+    0x06, 0x8D, 0xD3, 0x44, 0x47, 0xEC, 0xC4, 0x38, 0x11, 0xD9, 0x26, 0xD4, 0xBA, 0xD3, 0x6E, 0x4F,
+    0xE3, 0xA8, 0x64, 0x0B, 0x53, 0x9C, 0xEA, 0x8C, 0x80, 0x7E, 0x5E, 0xDE, 0x28, 0xA2, 0xB6, 0x69,
+    0x9C, 0xA0, 0xC7, 0x80, 0xF5, 0x61, 0xE6, 0x33, 0x15, 0x01, 0xE4, 0x36, 0x3B, 0xD0, 0x2A, 0xB1,
+    0x42, 0x1D, 0x30, 0x20, 0xC0, 0xB4, 0x04, 0xEB, 0x07, 0x40, 0xE9, 0x58, 0x8A, 0xAC, 0x64, 0x9E,
+    0x3B, 0xB5, 0xB7, 0xAC, 0x15, 0x67, 0x39, 0x34, 0x24, 0x5D, 0xDE, 0xB4, 0xDA, 0x44, 0xC3, 0x9C,
+    0x02, 0x27, 0x1A, 0x25, 0xC4, 0xE2, 0x04, 0x79, 0x16, 0xC6, 0xAC, 0x50, 0x53, 0xD2, 0xEC, 0xB2,
+    0x2A, 0x27, 0x7A, 0x7B, 0x3B, 0x53, 0x0C, 0x72, 0x71, 0xCF, 0xA4, 0xEF, 0x3F, 0x7F, 0x4B, 0xAF,
+    0x6D, 0x0A, 0xEF, 0x6D, 0xC8, 0xDC, 0x29, 0x3A, 0x53, 0xE1, 0x92, 0x38, 0xB1, 0x79, 0x73, 0xB4,
+    0x55, 0x72, 0xCD, 0x92, 0x61, 0x28, 0x0C, 0x10, 0x53, 0x10, 0x6D, 0xED, 0x7F, 0x30, 0xCB, 0x55,
+    0x9A, 0xEF, 0xED, 0x0D, 0x80, 0x87, 0xFD, 0xDE, 0xA7, 0x28, 0xFE, 0x55, 0x20, 0x60, 0xD0, 0xA6,
+    0x96, 0x66, 0xC7, 0x0E, 0x4A, 0xD9, 0xA8, 0x87, 0x42, 0x94, 0xD0, 0x49, 0x8F, 0xAB, 0x01, 0xA1,
+    0x51, 0xA4, 0xCD, 0xF9, 0x18, 0x34, 0xCA, 0x21, 0xDF, 0x43, 0x08, 0x40, 0xEE, 0x3B, 0x74, 0x2F,
+    0x3A, 0xDB, 0xBE, 0xCC, 0x64, 0xB5, 0x0B, 0x19, 0xF7, 0xB6, 0x64, 0xFC, 0x3C, 0xDE, 0x46, 0xC4,
+    0xAC, 0x6D, 0x0B, 0x0E, 0x7D, 0x9D, 0x49, 0xEB, 0x6E, 0x65, 0x3A, 0xD5, 0x4B, 0xD5, 0x0C, 0xAD,
+    0xE8, 0x9B, 0xD3, 0xA3, 0xBC, 0xCB, 0xD2, 0x1A, 0x24, 0xA8, 0x47, 0xF4, 0x94, 0xCB, 0xEE, 0x03,
+    0x08, 0x71, 0x9C, 0xF1, 0x8B, 0xC0, 0x7A, 0xB1, 0x65, 0x50, 0xE3, 0xC1, 0x2E, 0x71, 0x95, 0x61,
+    0xDB, 0x94, 0x23, 0x1F, 0x0D, 0xFF, 0x09, 0xF6, 0x28, 0x99, 0x15, 0x6C, 0x3A, 0xDA, 0x9A, 0x29,
+    0xB5, 0xD8, 0x19, 0x0C, 0xF4, 0xE4, 0xED, 0x23, 0x83, 0xB2, 0xB1, 0x05, 0x2B, 0xCB, 0x9C, 0x8D,
+    0xB6, 0x12, 0x91, 0xC3, 0xC4, 0xF4, 0xA7, 0xE1, 0x30, 0x7D, 0x32, 0x9D, 0xEE, 0x6E, 0xED, 0xB7,
+    0x01, 0xEF, 0x0D, 0xE8, 0x7E, 0xD0, 0x60, 0x0A, 0x79, 0x7D, 0x2D, 0xA4, 0x6E, 0xC0, 0x8C, 0x64,
+    0xB7, 0x66, 0xC1, 0x1D, 0x45, 0xC4, 0x31, 0xF8, 0x18, 0xCD, 0x6F, 0xC3, 0xCB, 0xFA, 0x29, 0xCB,
+    0x14, 0xA4, 0x4A, 0xE8, 0xF2, 0x24, 0xF3, 0x94, 0xD1, 0x74, 0xA6, 0x60, 0x1B, 0xA0, 0x2C, 0x8F,
+    0x2B, 0x3B, 0xFA, 0xF8, 0x0D, 0x89, 0xFF, 0x50, 0x94, 0x5C, 0x6D, 0xF2, 0x50, 0xE3, 0x28, 0x1D,
+    0xFE, 0x57, 0xEA, 0x7B, 0xA0, 0xB5, 0xE3, 0xCD, 0x4B, 0x22, 0x83, 0xCB, 0x80, 0x46, 0x1D, 0xC8,
+    0xA6, 0x05, 0x63, 0xAF, 0x19, 0x5D, 0x6C, 0x40, 0x67, 0x6A, 0xB2, 0xC5, 0xE6, 0x60, 0x9B, 0xBE,
+    0x34, 0xCF, 0xF8, 0x2B, 0xB7, 0xD1, 0x15, 0x9D, 0x1E, 0xDC, 0x1A, 0xB1, 0xE0, 0x24, 0xE3, 0x3B,
+    0x5E, 0xFD, 0x6D, 0x90, 0xF5, 0x09, 0xB8, 0xC1, 0xC4, 0x6E, 0xE5, 0x42, 0x2C, 0x60, 0xEF, 0x8B,
+    0xCE, 0xC5, 0x25, 0xD4, 0xE4, 0x29, 0xA8, 0xCE, 0x2B, 0xC4, 0x53, 0xDC, 0xAB, 0x34, 0xEB, 0xA0,
+    0x5D, 0xF8, 0xB0, 0xCE, 0xD0, 0x49, 0x16, 0xE5, 0x31, 0x54, 0xFF, 0x3A, 0xDA, 0x10, 0x59, 0x77,
+    0xB4, 0x39, 0x02, 0x5E, 0x84, 0xD2, 0xAF, 0xC7, 0xB0, 0x28, 0xF5, 0x95, 0xE6, 0x70, 0xE8, 0x96,
+    0xB1, 0xAD, 0x70, 0xD7, 0x6B, 0x00, 0x12, 0x0E, 0xFB, 0xF6, 0x19, 0xB2, 0x20, 0xC0, 0xD9, 0x37,
+    0x48, 0x34, 0x3C, 0x0D, 0xC3, 0x87, 0x50, 0xC6, 0xB4, 0x20, 0x83, 0x0A, 0x5D, 0x44, 0xFE, 0x82,
+    0xF8, 0xCC, 0xE4, 0xBA, 0xEA, 0x82, 0x1A, 0x39, 0xB8, 0xF4, 0x0F, 0x81, 0xDE, 0xD4, 0x71, 0x10,
+    0xEB, 0x30, 0x70, 0x9B, 0x7B, 0xE4, 0xC7, 0x21, 0xA6, 0x26, 0x88, 0x8A, 0xE9, 0xF4, 0xD9, 0x33,
+    0x4C, 0x4A, 0x76, 0xFD, 0x99, 0x59, 0x9F, 0x4E, 0x29, 0x1D, 0x9A, 0xFB, 0x28, 0x78, 0x7E, 0x02,
+    0xFF, 0x01, 0x2E, 0x23, 0xFF, 0xAA, 0x9B, 0x20, 0x63, 0xD8, 0x32, 0xA2, 0xEC, 0x72, 0x20, 0xC9,
+    0x4F, 0xDA, 0x8C, 0xCE, 0x40, 0xA0, 0x44, 0x6D, 0x1F, 0x28, 0x7D, 0x8F, 0x9E, 0x98, 0xCB, 0xCD,
+    0x93, 0xD7, 0xBF, 0xDD, 0x10, 0x23, 0x5C, 0xFE, 0x13, 0x3A, 0xF3, 0x8C, 0x6D, 0x4C, 0xE2, 0x35,
+    0x84, 0xBE, 0x33, 0xDD, 0xED, 0xC4, 0x75, 0x60, 0xAA, 0x63, 0x07, 0x2E, 0x0B, 0x71, 0x0B, 0x5C,
+    0x6F, 0xF8, 0xA2, 0xC4, 0xC0, 0x5D, 0xE4, 0x34, 0x61, 0x33, 0x91, 0x9B, 0xAE, 0xA4, 0x0A, 0x36,
+    0xA9, 0xA0, 0xF7, 0x99, 0xBF, 0x7C, 0x3B, 0x46, 0x54, 0xC1, 0xC3, 0x58, 0xFF, 0xA9, 0xF2, 0x3B,
+    0x4D, 0x92, 0xCE, 0x32, 0x0E, 0xFB, 0x98, 0x17, 0x60, 0xFA, 0x37, 0x33, 0xC9, 0x4A, 0xCE, 0xAE,
+    0xB7, 0x31, 0x71, 0x57, 0x58, 0xCC, 0x84, 0x60, 0x11, 0xE9, 0x38, 0x40, 0x3A, 0x91, 0xFE, 0x35,
+    0x0D, 0x52, 0xCD, 0x61, 0x8D, 0xA2, 0x51, 0x67, 0x57, 0xA7, 0x26, 0x3D, 0x49, 0x74, 0x16, 0x5A,
+    0x0D, 0x7C, 0xF2, 0xE2, 0x10, 0x54, 0xE1, 0x48, 0xC0, 0xC9, 0x0E, 0xDD, 0x71, 0x76, 0x65, 0xFA,
+    0xBB, 0xB7, 0x66, 0x70, 0x73, 0xA7, 0xB8, 0xAE, 0x9B, 0xC0, 0x74, 0xF0, 0x81, 0x5F, 0x70, 0x68,
+    0xDB, 0x89, 0x01, 0x0B, 0xD0, 0x0D, 0xD1, 0xFF, 0x10, 0x60, 0xF7, 0x46, 0x4E, 0x44, 0x4A, 0x73,
+    0x57, 0x8A, 0xF1, 0xFA, 0x06, 0xEF, 0x72, 0x42, 0x37, 0x49, 0x45, 0xDF, 0xC1, 0xD7, 0x14, 0x00,
+    0xF5, 0x3D, 0x88, 0x3F, 0xCD, 0xE3, 0x9D, 0x8F, 0x26, 0x11, 0xDE, 0x46, 0x2B, 0x6B, 0xBC, 0xD8,
+    0xCE, 0xDC, 0x63, 0x67, 0xED, 0x9A, 0x55, 0xD2, 0x4B, 0x56, 0xF3, 0xE1, 0xDD, 0x19, 0xEB, 0x2B,
+    0x15, 0x72, 0x7B, 0x43, 0x38, 0x5F, 0xE3, 0x76, 0xAE, 0xFC, 0x2E, 0x7B, 0xB8, 0xC3, 0x85, 0xBE,
+    0x76, 0xDB, 0x78, 0x91, 0xAC, 0x0B, 0x2F, 0xE3, 0x89, 0x48, 0xD9, 0x87, 0xF7, 0x6F, 0x0E, 0xC5,
+    0x7C, 0x21, 0x38, 0x5E, 0x5E, 0xE8, 0x5B, 0x0E, 0xFC, 0x7A, 0xA1, 0x87, 0xF3, 0x3E, 0x56, 0x71,
+    0xA6, 0x66, 0x22, 0x85, 0x24, 0x72, 0xFA, 0x6E, 0x7C, 0x16, 0xF4, 0x7B, 0x33, 0x46, 0x21, 0x62,
+    0xE4, 0x0E, 0xF9, 0x16, 0xD8, 0x38, 0xDC, 0x3E, 0x83, 0x19, 0x33, 0x00, 0x08, 0xBC, 0xDE, 0xCA,
+    0x12, 0x7D, 0xB9, 0x33, 0xC0, 0xDB, 0xDC, 0xE0, 0xBA, 0xDF, 0xC3, 0x06, 0x7A, 0x87, 0xE8, 0xFB,
+    0x3A, 0x88, 0x2C, 0xF0, 0xDA, 0x6C, 0xBA, 0x0C, 0xBF, 0x21, 0xF6, 0xEB, 0x48, 0xB7, 0xD0, 0x7A,
+    0xF4, 0x28, 0xF0, 0xDA, 0xED, 0x02, 0x55, 0x46, 0x73, 0xA6, 0xA7, 0x00, 0xCD, 0x38, 0x2E, 0xDB,
+    0x6B, 0x61, 0x73, 0x9D, 0xDB, 0xBC, 0x5E, 0xF4, 0x6C, 0xBA, 0xDB, 0xF3, 0x6E, 0xB9, 0x5B, 0x8C,
+    0xB3, 0x3A, 0xFE, 0x23, 0xA5, 0x3F, 0xAC, 0x1B, 0x8D, 0x0C, 0x95, 0xD3, 0xD4, 0xCD, 0xF5, 0xED,
+    0xB8, 0x78, 0x91, 0xE7, 0xD8, 0x77, 0xCA, 0xEA, 0x5E, 0x15, 0x0C, 0x06, 0x83, 0xF1, 0x3C, 0x0C,
+    0xF4, 0x05, 0x0A, 0x99, 0x50, 0x9E, 0x5E, 0x65, 0xA9, 0x9A, 0xE9, 0x88, 0x97, 0x58, 0x4D, 0x09,
+    0xCD, 0x73, 0x52, 0x7D, 0x02, 0x88, 0xDA, 0xB9, 0xD7, 0xD0, 0xDF, 0xC1, 0xDB, 0x1A, 0x77, 0x7E,
+    0xBF, 0xEF, 0x7D, 0x99, 0xD2, 0x0B, 0x9D, 0x83, 0xB0, 0x86, 0x70, 0x69, 0x55, 0x7B, 0x61, 0x0C,
+    0xA6, 0x9E, 0x87, 0xCE, 0xBA, 0x06, 0xC0, 0x7D, 0xF7, 0xD9, 0x6D, 0xE1, 0xDD, 0x23, 0x7D, 0x77,
+    0x4E, 0x67, 0xD8, 0xB0, 0x6E, 0xF7, 0x3D, 0xD2, 0xD8, 0x96, 0xB0, 0xDB, 0xB6, 0xCD, 0x79, 0xC9,
+    0x89, 0xDC, 0x66, 0xA8, 0x06, 0xE4, 0xFF, 0x49, 0xDC, 0x6E, 0xDE, 0x75, 0xEA, 0x7A, 0x3B, 0xF6,
+    0xAD, 0xCE, 0x65, 0xA7, 0xC9, 0xEB, 0x32, 0xDA, 0x66, 0x6F, 0x1C, 0x7C, 0x37, 0x1B, 0x1B, 0x1C,
+    0x14, 0xCB, 0x97, 0x1C, 0x00, 0xDC, 0x1D, 0x8A, 0xCF, 0xE5, 0xAD, 0x65, 0x7F, 0x51, 0xD5, 0x54,
+    0x4F, 0x05, 0x13, 0x0A, 0x0D, 0x05, 0x4F, 0xBF, 0xAF, 0xDA, 0xBB, 0x24, 0xDC, 0x21, 0x75, 0x7D,
+    0xE8, 0xEE, 0x84, 0xB7, 0xBC, 0xDF, 0x4A, 0x01, 0xD8, 0x35, 0x8E, 0x2D, 0x73, 0x6B, 0x5F, 0x08,
+    0x1D, 0xD7, 0xAD, 0xB5, 0xC4, 0x6D, 0xB6, 0x7F, 0xC8, 0xB3, 0x8D, 0x8F, 0x85, 0x89, 0x2F, 0x81,
+    0x1F, 0x51, 0x40, 0xE7, 0x7B, 0x51, 0x76, 0xCF, 0x18, 0x06, 0xF0, 0x9D, 0x19, 0xB5, 0xA1, 0x06,
+    0xCF, 0x98, 0x6E, 0xEC, 0x46, 0xA4, 0x15, 0xD5, 0xCD, 0xA3, 0x96, 0x81, 0xFE, 0xF0, 0xFE, 0xD8,
+    0x0B, 0xE7, 0x76, 0x54, 0x65, 0x91, 0xEB, 0xA6, 0x2F, 0xA8, 0x26, 0x14, 0x07, 0xB6, 0x28, 0xE5,
+    0xCC, 0x7D, 0xE2, 0x3B, 0xE9, 0xBE, 0xC0, 0xF0, 0x41, 0xDB, 0x28, 0x36, 0x51, 0x99, 0x39, 0xB5,
+    0xE3, 0xF3, 0xA5, 0xB3, 0xCC, 0xFA, 0x17, 0xCC, 0x16, 0x3F, 0xFE, 0x97, 0x27, 0x8D, 0xE7, 0xC9,
+    0x46, 0x45, 0x5D, 0x8E, 0xDC, 0xAE, 0x73, 0xD7, 0x4B, 0xA0, 0x5E, 0x6E, 0x3C, 0xEC, 0x29, 0xB8,
+    0xCA, 0x06, 0xDD, 0xAD, 0x48, 0x15, 0x11, 0x06, 0xC1, 0xDD, 0x45, 0x83, 0x91, 0xBF, 0x8F, 0x72,
+    0xB4, 0x35, 0x1D, 0x37, 0xB6, 0x1C, 0xCD, 0x08, 0xD9, 0x90, 0x43, 0x4E, 0x3D, 0xBB, 0x7A, 0xBA,
+    0xCF, 0x2A, 0x53, 0x83, 0x0E, 0xF4, 0x17, 0x4B, 0x00, 0x0A, 0xBF, 0xCB, 0x7B, 0xFA, 0x30, 0x26,
+    0xDE, 0x5E, 0x99, 0x88, 0xE1, 0xEE, 0x54, 0x59, 0x8B, 0x73, 0x77, 0x9A, 0xFC, 0x77, 0xF6, 0x2A,
+    0xF3, 0x34, 0x28, 0x65, 0xD6, 0x99, 0x84, 0xAF, 0xB2, 0x69, 0x36, 0x1E, 0xBF, 0x79, 0xB9, 0xC1,
+    0xFB, 0x16, 0xD0, 0xC2, 0x5F, 0x89, 0xE2, 0x46, 0x14, 0xA7, 0x16, 0xAE, 0xCE, 0xE1, 0x5A, 0x34,
+    0xA4, 0x5E, 0x17, 0xB3, 0x3F, 0x76, 0x6D, 0xE9, 0xEE, 0x28, 0x41, 0xEA, 0x38, 0x8E, 0x83, 0xCE,
+    0xEA, 0x80, 0xAC, 0xDC, 0x9D, 0xF9, 0x50, 0x9A, 0x7E, 0xA5, 0x12, 0x6B, 0x42, 0xFC, 0xB2, 0x92,
+    0xCD, 0x19, 0x48, 0xD0, 0xFA, 0xAF, 0x17, 0x6E, 0xD9, 0x29, 0xAD, 0x7F, 0x79, 0xBF, 0x60, 0xCB,
+    0x05, 0x38, 0x81, 0x74, 0x1F, 0xF0, 0xED, 0x27, 0xD9, 0x18, 0xD6, 0xCD, 0xB8, 0x78, 0x84, 0xCE,
+    0x14, 0x44, 0xCD, 0xC6, 0x73, 0xB7, 0xBB, 0x3D, 0x5B, 0x1D, 0x7A, 0xFE, 0x0B, 0xB2, 0xAB, 0x03,
+    0x9B, 0xA1, 0xBC, 0xEA, 0xA2, 0x8D, 0xE2, 0xE9, 0xFD, 0xA3, 0x88, 0xDD, 0xFF, 0x00, 0x5E, 0xF9,
+    0x04, 0x81, 0x26, 0x27, 0x00, 0x00,
+};
 
-        document.getElementById('newDeviceName').addEventListener('keypress', e => {
-            if (e.key === 'Enter') saveDeviceName();
-        });
+static const uint8_t INDEX_HTML_GZ[] PROGMEM = {
+    0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xCD, 0x58, 0x6D, 0x6F, 0xDB, 0x36,
+    0x10, 0xFE, 0xDE, 0x5F, 0xC1, 0x69, 0xD8, 0xD0, 0x02, 0xF3, 0x5B, 0xDA, 0xB4, 0x8E, 0x6D, 0x79,
+    0x48, 0xE3, 0x06, 0x0B, 0x90, 0xB4, 0x5E, 0x1D, 0x6F, 0xD8, 0x47, 0x8A, 0x3A, 0x59, 0xAC, 0x29,
+    0x52, 0x13, 0x29, 0x3B, 0x1E, 0xF6, 0xE3, 0x77, 0x24, 0x25, 0xD7, 0xB1, 0x95, 0xC5, 0xD9, 0x3A,
+    0x74, 0x08, 0x02, 0x89, 0x77, 0xC7, 0xE3, 0xC3, 0x87, 0x77, 0xC7, 0x93, 0x47, 0xDF, 0x4C, 0x3E,
+    0x5C, 0xDC, 0xFE, 0x36, 0x7D, 0x47, 0x52, 0x93, 0x89, 0xF1, 0xB3, 0x91, 0x7D, 0x10, 0x41, 0xE5,
+    0x22, 0x0C, 0x40, 0x06, 0x56, 0x00, 0x34, 0xC6, 0x47, 0x06, 0x86, 0x12, 0x96, 0xD2, 0x42, 0x83,
+    0x09, 0x83, 0xF9, 0xED, 0x65, 0xAB, 0x1F, 0xD4, 0x62, 0x49, 0x33, 0x08, 0x83, 0x15, 0x87, 0x75,
+    0xAE, 0x0A, 0x13, 0x10, 0xA6, 0xA4, 0x01, 0x89, 0x66, 0x6B, 0x1E, 0x9B, 0x34, 0x8C, 0x61, 0xC5,
+    0x19, 0xB4, 0xDC, 0xE0, 0x07, 0xC2, 0x25, 0x37, 0x9C, 0x8A, 0x96, 0x66, 0x54, 0x40, 0xD8, 0x6B,
+    0x77, 0xAD, 0x1B, 0xC3, 0x8D, 0x80, 0xF1, 0xBB, 0xD9, 0xF4, 0xE5, 0x09, 0x79, 0x0F, 0x66, 0xAD,
+    0x8A, 0x25, 0xB9, 0x51, 0x68, 0xA9, 0x8A, 0x51, 0xC7, 0x2B, 0x9F, 0x8D, 0x04, 0x97, 0x4B, 0x52,
+    0x80, 0x08, 0x03, 0x6D, 0x36, 0x02, 0x74, 0x0A, 0x80, 0x8B, 0xA5, 0x05, 0x24, 0x61, 0xD0, 0xA1,
+    0x79, 0xDE, 0x66, 0x5A, 0xFF, 0xB8, 0x0A, 0xA1, 0x1B, 0x9D, 0x75, 0x5F, 0x9D, 0x9D, 0x9E, 0x9E,
+    0x24, 0x51, 0xF4, 0xA6, 0xFF, 0xC6, 0xFA, 0xD7, 0xAC, 0xE0, 0xB9, 0x21, 0xBA, 0x60, 0x95, 0xE9,
+    0x27, 0x6B, 0x19, 0xC7, 0x2C, 0x3E, 0x8B, 0x4E, 0x5E, 0x9F, 0xB1, 0x04, 0x7A, 0xD1, 0xAB, 0x97,
+    0x01, 0x89, 0x21, 0x81, 0x62, 0x3C, 0xEA, 0x78, 0x7B, 0x9C, 0xD8, 0xA9, 0xB6, 0x1F, 0xA9, 0x78,
+    0x83, 0x8F, 0x98, 0xAF, 0x08, 0x13, 0x54, 0xEB, 0x30, 0xB0, 0x9B, 0xA4, 0x5C, 0x42, 0xE1, 0x48,
+    0xEA, 0x3D, 0x04, 0x1E, 0x35, 0xF7, 0xA6, 0x69, 0x43, 0x4D, 0xA9, 0x5B, 0x11, 0x75, 0xF3, 0x0E,
+    0x15, 0xDC, 0x40, 0x66, 0x35, 0x82, 0x46, 0x20, 0xC6, 0x1F, 0x55, 0x69, 0xA0, 0x20, 0x17, 0x4A,
+    0x4A, 0x60, 0x86, 0x2B, 0x39, 0xEA, 0x78, 0x05, 0x6E, 0x29, 0xA7, 0x92, 0xF0, 0x38, 0x0C, 0x0A,
+    0x67, 0x33, 0x73, 0xD3, 0x83, 0x3D, 0x6F, 0x2A, 0x49, 0x90, 0x35, 0x08, 0xC6, 0x13, 0xAE, 0x99,
+    0x77, 0x02, 0x31, 0x6E, 0x0F, 0xE7, 0xDA, 0xCD, 0xE1, 0xF2, 0x47, 0x80, 0x98, 0x50, 0x9D, 0x46,
+    0x8A, 0x16, 0x31, 0x49, 0x0A, 0x95, 0x91, 0x1B, 0xDC, 0x35, 0xF9, 0x95, 0x5F, 0xF2, 0x06, 0x2C,
+    0x38, 0xFF, 0x6A, 0x1A, 0x8C, 0x5B, 0xDB, 0x25, 0xB6, 0x9A, 0x2C, 0x96, 0xFA, 0x1A, 0x0F, 0x30,
+    0x20, 0xEE, 0xF0, 0xC2, 0x20, 0xE6, 0x3A, 0x17, 0x74, 0x33, 0x88, 0x84, 0x62, 0xCB, 0x61, 0x82,
+    0x6C, 0xB6, 0x34, 0xFF, 0x03, 0x06, 0xDD, 0x76, 0xFF, 0xB4, 0x80, 0x6C, 0xC8, 0x94, 0x50, 0xC5,
+    0xE0, 0xDB, 0x7E, 0xBF, 0x3F, 0x0C, 0xC6, 0x4F, 0x85, 0x7C, 0x51, 0xEF, 0x95, 0x4C, 0x5C, 0xF0,
+    0xE9, 0x06, 0xAC, 0x3E, 0x2C, 0x2F, 0x54, 0x29, 0x4D, 0x30, 0xEE, 0x3E, 0x75, 0x85, 0x79, 0x6E,
+    0x78, 0x06, 0x0D, 0x6E, 0x4B, 0xA7, 0x40, 0x8F, 0xFA, 0xA9, 0x2E, 0x2F, 0x0B, 0x00, 0x72, 0x03,
+    0x99, 0x2A, 0x36, 0x0D, 0x7E, 0x13, 0xD4, 0xFE, 0x04, 0x34, 0x6F, 0x66, 0x97, 0xCB, 0xCB, 0x5A,
+    0xFF, 0x38, 0xC1, 0x6F, 0xBE, 0x00, 0xC1, 0xD3, 0x39, 0xB9, 0x56, 0x34, 0x6E, 0x00, 0xCA, 0xF2,
+    0xD2, 0x6A, 0x1A, 0x71, 0x0A, 0xA5, 0x72, 0x04, 0xFA, 0xFB, 0x97, 0x01, 0x79, 0x88, 0x95, 0x61,
+    0x94, 0xD6, 0x79, 0xB5, 0xB7, 0x02, 0x49, 0x04, 0xDC, 0x0D, 0xC9, 0xA7, 0x52, 0x1B, 0x9E, 0x6C,
+    0x5A, 0x55, 0x8D, 0x1A, 0x10, 0x74, 0x89, 0xC5, 0x29, 0xC2, 0xBC, 0x05, 0x90, 0x43, 0x42, 0x05,
+    0x5F, 0x48, 0xB7, 0x59, 0x3D, 0x20, 0x0C, 0x2D, 0xA0, 0x18, 0x92, 0x8C, 0x16, 0x0B, 0x2E, 0x5B,
+    0x91, 0x32, 0x46, 0x65, 0x03, 0xD2, 0x3B, 0xCD, 0xEF, 0x86, 0x2E, 0xED, 0x4F, 0xEA, 0x55, 0xBC,
+    0xC5, 0x80, 0x74, 0x51, 0xBE, 0x0D, 0xB9, 0xF4, 0xC4, 0x56, 0x8E, 0x12, 0x27, 0xC9, 0x1A, 0x60,
+    0x64, 0x24, 0xC1, 0xFF, 0x56, 0x8C, 0x15, 0x16, 0x13, 0xDB, 0xBE, 0xEA, 0x2C, 0x20, 0x4A, 0x32,
+    0xC1, 0xD9, 0x12, 0x93, 0x19, 0xB0, 0xBE, 0x9E, 0x0B, 0x61, 0xD3, 0x59, 0x3F, 0x7F, 0x11, 0x8C,
+    0x3F, 0x5A, 0x01, 0x41, 0x09, 0x71, 0xA2, 0x51, 0xC7, 0xFB, 0xBB, 0xBF, 0xFB, 0x0A, 0x84, 0x5A,
+    0x41, 0x91, 0x08, 0xB5, 0x6E, 0xDD, 0x0D, 0x08, 0x2D, 0x8D, 0x72, 0x18, 0x0D, 0x8D, 0x5C, 0xF5,
+    0x34, 0x55, 0x25, 0x33, 0x85, 0x1B, 0x54, 0x28, 0xB1, 0xBA, 0xA6, 0xD5, 0x58, 0xAD, 0xA5, 0x70,
+    0x27, 0x5A, 0x4B, 0xE6, 0xF9, 0xFD, 0xF1, 0xAD, 0x32, 0x54, 0x7C, 0x1E, 0xCE, 0x72, 0x80, 0x1D,
+    0xED, 0xB9, 0xAB, 0x4F, 0xBA, 0x12, 0x74, 0xDC, 0x32, 0x9D, 0xED, 0xA2, 0xB6, 0x7E, 0xEE, 0x64,
+    0xDD, 0xAD, 0x05, 0x65, 0x0F, 0xD4, 0x54, 0x85, 0xB5, 0x53, 0xC3, 0x7C, 0xF0, 0x68, 0x91, 0x06,
+    0xC3, 0xE5, 0x42, 0xB7, 0x16, 0x05, 0x8F, 0x83, 0xE6, 0x63, 0x47, 0xC2, 0x27, 0xEF, 0x67, 0xE4,
+    0xAD, 0x0D, 0x26, 0xB4, 0xAD, 0x4E, 0x60, 0xC7, 0x90, 0xCB, 0xBC, 0x34, 0xE8, 0x41, 0x95, 0xB9,
+    0xB5, 0x77, 0x43, 0x62, 0x36, 0x39, 0x92, 0x67, 0xE0, 0x0E, 0x6F, 0x13, 0x07, 0x51, 0x65, 0x58,
+    0xE2, 0xAE, 0xAC, 0x2E, 0x20, 0x18, 0x3B, 0x0C, 0x52, 0x25, 0x62, 0x28, 0xC2, 0xE0, 0x9D, 0x0D,
+    0x07, 0xE2, 0xF5, 0xE4, 0x39, 0xB4, 0x17, 0x6D, 0xB2, 0xC1, 0xEA, 0x5B, 0x46, 0xD0, 0x66, 0x2A,
+    0x7B, 0x11, 0x34, 0x1D, 0xF7, 0xCE, 0xE1, 0xBA, 0x20, 0x9F, 0xB8, 0xD9, 0xF6, 0x68, 0x1D, 0xCC,
+    0xE6, 0x03, 0xAD, 0xA6, 0xFB, 0x95, 0x5A, 0x82, 0xEB, 0x0A, 0x9A, 0xF3, 0x00, 0xB1, 0xF7, 0xA1,
+    0x2D, 0x81, 0x8F, 0x65, 0x02, 0x32, 0x30, 0xAB, 0x98, 0xDB, 0xA1, 0xE3, 0x5E, 0xD4, 0x1E, 0xC6,
+    0xB5, 0xCB, 0xE9, 0xDA, 0xC8, 0xA7, 0x20, 0x71, 0x39, 0x48, 0xB6, 0xD9, 0xE4, 0x13, 0x76, 0x3F,
+    0x33, 0xBC, 0x83, 0x79, 0xAE, 0x4D, 0x01, 0x34, 0x23, 0x78, 0x18, 0x9F, 0x0B, 0xC4, 0x93, 0x8F,
+    0x41, 0xEA, 0xA6, 0x33, 0xE8, 0xB5, 0xDD, 0xDF, 0x63, 0x5C, 0x6B, 0xBA, 0x02, 0x5C, 0xDE, 0xF2,
+    0x3C, 0xC3, 0xD7, 0x43, 0x9A, 0x0F, 0xD3, 0xE7, 0x3F, 0x62, 0xA3, 0xBA, 0xC3, 0xEF, 0xDF, 0x98,
+    0xCD, 0x5B, 0x5E, 0xF3, 0x84, 0xCF, 0x66, 0x57, 0x93, 0xBD, 0x2D, 0x7B, 0x51, 0x33, 0xCA, 0x1A,
+    0xE4, 0x53, 0xD9, 0xB5, 0x4B, 0x4D, 0xD1, 0x1C, 0xBB, 0x95, 0x78, 0x6F, 0xB9, 0xAD, 0xF8, 0x08,
+    0x8A, 0xED, 0xAE, 0x2C, 0xC7, 0xD5, 0x85, 0xFB, 0x15, 0x69, 0x7E, 0x4B, 0x65, 0xEC, 0x5A, 0x4C,
+    0x72, 0xCE, 0x98, 0xBD, 0xD4, 0x5D, 0x01, 0x78, 0x3C, 0xF8, 0x34, 0x08, 0x04, 0xEE, 0x38, 0xA1,
+    0xDB, 0x89, 0x33, 0x27, 0xB4, 0x6A, 0x95, 0xDB, 0xB2, 0x46, 0x56, 0x54, 0x94, 0x08, 0x2B, 0xC7,
+    0x06, 0x08, 0x3B, 0xA9, 0x52, 0x61, 0xAB, 0x35, 0xEE, 0x77, 0x4F, 0xDA, 0xBD, 0x1E, 0xD1, 0x92,
+    0x27, 0x89, 0x5B, 0xCC, 0xDB, 0x1E, 0x4C, 0x92, 0x80, 0x37, 0x4E, 0x30, 0x3E, 0x9F, 0x62, 0xEF,
+    0x8B, 0x91, 0x90, 0x20, 0xD5, 0x24, 0x55, 0x6A, 0xA9, 0x77, 0x66, 0x74, 0x3C, 0x8C, 0x23, 0x18,
+    0xFF, 0xBC, 0x3B, 0xCB, 0xFB, 0x79, 0x9E, 0x8B, 0xCD, 0x57, 0x64, 0xFD, 0x7E, 0x78, 0xB1, 0x14,
+    0xD8, 0x32, 0x52, 0x77, 0x3E, 0xC4, 0x56, 0x20, 0x63, 0x55, 0x7C, 0x90, 0xBE, 0x03, 0x25, 0xFE,
+    0x85, 0xFC, 0xE2, 0xA4, 0xD8, 0x3C, 0xA8, 0x65, 0x99, 0x3F, 0xFB, 0xE7, 0xE5, 0xC1, 0x7B, 0x9F,
+    0x7F, 0xBC, 0xDE, 0x8B, 0xDE, 0xD4, 0x98, 0x5C, 0x0F, 0x3A, 0xD8, 0xE5, 0xF3, 0x76, 0x46, 0x99,
+    0x37, 0xD3, 0xB6, 0x3E, 0x77, 0xBE, 0xD3, 0xC7, 0x84, 0xB4, 0x07, 0xE8, 0xF1, 0xFD, 0x0F, 0xCA,
+    0xC7, 0x35, 0x5F, 0x01, 0x99, 0xE7, 0x31, 0x35, 0x40, 0xAE, 0x6C, 0xFC, 0x60, 0x54, 0x91, 0xE7,
+    0x99, 0x7E, 0xF1, 0x54, 0xEA, 0x64, 0x99, 0x45, 0xF8, 0xB5, 0xE2, 0xC8, 0xCB, 0x4B, 0x9D, 0xD6,
+    0xCE, 0x02, 0x82, 0xDD, 0x63, 0x18, 0x9C, 0x76, 0xBB, 0xF8, 0x46, 0xEF, 0xC2, 0xE0, 0x75, 0xB7,
+    0x6B, 0xDF, 0xB5, 0x81, 0xDC, 0x8B, 0x8F, 0x20, 0x6D, 0xBA, 0xE3, 0xF0, 0x18, 0xD2, 0xFE, 0x3D,
+    0x2F, 0xF6, 0xA2, 0xAF, 0x5A, 0xA2, 0xDD, 0x16, 0x74, 0xFC, 0x73, 0x09, 0x05, 0x07, 0x6C, 0xDE,
+    0x46, 0x78, 0x09, 0x29, 0xB9, 0xA8, 0xEF, 0x92, 0x4A, 0xEE, 0x5B, 0x7D, 0xA7, 0xA9, 0xFB, 0x49,
+    0xF2, 0xBD, 0x8C, 0x74, 0x3E, 0xFC, 0xD3, 0x3F, 0x2A, 0x37, 0x6F, 0xFD, 0x4D, 0x7B, 0xE0, 0xA6,
+    0x92, 0x37, 0xB8, 0xD9, 0xDF, 0xE5, 0x83, 0x57, 0x73, 0xA6, 0x62, 0xCB, 0xBA, 0xFB, 0x76, 0x03,
+    0xFB, 0xED, 0x7C, 0xE3, 0x04, 0x0D, 0x46, 0x75, 0x97, 0xEA, 0x2E, 0xF2, 0x97, 0xD8, 0x0B, 0x5A,
+    0x6B, 0x52, 0x77, 0x6E, 0x28, 0x79, 0x28, 0x39, 0x24, 0xAC, 0xBD, 0xD5, 0x7B, 0x9C, 0xD0, 0xDC,
+    0xC4, 0x38, 0xB5, 0xFB, 0x74, 0xDF, 0x0F, 0x94, 0x94, 0xC7, 0x31, 0x7E, 0xFB, 0xEF, 0x02, 0x3C,
+    0xBF, 0x68, 0x84, 0x47, 0x7D, 0xCF, 0x77, 0xD4, 0x5D, 0xBC, 0x85, 0xD3, 0x10, 0x1E, 0x7F, 0xD7,
+    0x23, 0xEF, 0xF8, 0x61, 0x42, 0x69, 0x4F, 0x96, 0xBB, 0x72, 0xA8, 0x64, 0x20, 0x1E, 0x0C, 0xB2,
+    0xFA, 0x51, 0x37, 0x98, 0xEE, 0xF7, 0x8D, 0xBF, 0x00, 0xB4, 0xAF, 0x09, 0x4A, 0xEF, 0x10, 0x00,
+    0x00,
+};
 
-        fetchData();
-        setInterval(fetchData, 5000);
-    </script>
-</body>
-</html>
-)rawliteral";
+static const WebAsset WEB_ASSETS[] = {
+    { "/app.css", "text/css", APP_CSS_GZ, sizeof(APP_CSS_GZ), "\"e0b9049552fbb787\"", true },
+    { "/app.js", "application/javascript", APP_JS_GZ, sizeof(APP_JS_GZ), "\"ddcd9b269cfe1b43\"", true },
+    { "/", "text/html", INDEX_HTML_GZ, sizeof(INDEX_HTML_GZ), "\"75c19fd33d6af5ca\"", false },
+};
+static const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);
 
 #endif // WEB_CONTENT_H
@@ -2,31 +2,478 @@
 #include "web_content.h"
 #include "bandwidth_tracker.h"
 #include "device_manager.h"
+#include "presence.h"
 #include "dns_server.h"
 #include "wifi_manager.h"
 #include "storage_manager.h"
+#include "nat_engine.h"
+#include "traffic_shaper.h"
+#include "oui_lookup.h"
+#include "discovery.h"
+#include "network_scanner.h"
+#include "json_stream.h"
 #include <ArduinoJson.h>
+#include <memory>
 
 WebDashboard webDashboard;
 
-WebDashboard::WebDashboard() : server(WEB_SERVER_PORT) {}
+// FNV-1a, to notice unchanged push sections without keeping their text
+static uint32_t hashText(const String& s) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < s.length(); i++) {
+        h = (h ^ (uint8_t)s[i]) * 16777619u;
+    }
+    return h;
+}
+
+// One /api/devices row, copied out of the registry
+struct DeviceRow {
+    uint8_t mac[6];
+    char name[MAX_DEVICE_NAME];
+    uint64_t upload;
+    uint64_t download;
+    uint32_t uploadRate;
+    uint32_t downloadRate;
+    float uploadPps;
+    float downloadPps;
+    uint32_t uploadLimit;
+    uint32_t downloadLimit;
+    uint32_t presenceSince;  // Seconds of uptime, UINT32_MAX = never changed
+    uint8_t flags;
+    uint8_t dhcpClass;
+    bool limited;
+    bool quotaEnabled;
+};
+
+static void snapshotDevice(DeviceId id, DeviceRow& row) {
+    const DeviceRegistry& reg = deviceRegistry;
+    const TrafficRate& rate = reg.rate[id];
+    memcpy(row.mac, reg.mac[id], 6);
+    strncpy(row.name, reg.displayName(id), MAX_DEVICE_NAME - 1);
+    row.name[MAX_DEVICE_NAME - 1] = '\0';
+    row.upload = reg.uploadBytes[id];
+    row.download = reg.downloadBytes[id];
+    TrafficRate::Shown shown = rate.shown();
+    row.uploadRate = shown.upBps;
+    row.downloadRate = shown.downBps;
+    row.uploadPps = shown.upPps10 / 10.0f;
+    row.downloadPps = shown.downPps10 / 10.0f;
+    row.limited = trafficShaper.getLimit(reg.mac[id], row.uploadLimit, row.downloadLimit);
+    row.quotaEnabled = reg.quotaConfig[id].enabled();
+    row.presenceSince = reg.presenceSince[id] != 0 ? reg.presenceSince[id] / 1000 : UINT32_MAX;
+    row.flags = reg.flags[id];
+    row.dhcpClass = reg.dhcpClass[id];
+}
+
+static void writeDevice(const DeviceRow& row, JsonObject obj) {
+    char macStr[MAC_STRING_LEN];
+    formatMAC(row.mac, macStr);
+    obj["mac"] = macStr;  // Copied into the document
+    obj["name"] = row.name;
+    obj["upload"] = row.upload;
+    obj["download"] = row.download;
+    obj["total"] = row.upload + row.download;
+    obj["uploadRate"] = row.uploadRate;
+    obj["downloadRate"] = row.downloadRate;
+    obj["uploadPps"] = row.uploadPps;
+    obj["downloadPps"] = row.downloadPps;
+    if (row.limited) {
+        obj["uploadLimit"] = row.uploadLimit;
+        obj["downloadLimit"] = row.downloadLimit;
+    }
+    if (row.quotaEnabled) {
+        obj["quotaExceeded"] = (row.flags & DEVICE_QUOTA_EXCEEDED) != 0;
+    }
+    obj["active"] = (row.flags & DEVICE_ACTIVE) != 0;
+    obj["online"] = (row.flags & DEVICE_ONLINE) != 0;
+    if (row.presenceSince != UINT32_MAX) {
+        obj["presenceSince"] = row.presenceSince;  // Same clock as status "uptime"
+    }
+    if (row.dhcpClass != 0) {
+        obj["os"] = dhcpOSName(row.dhcpClass);
+        obj["type"] = dhcpDeviceType(row.dhcpClass);
+    }
+}
+
+// Devices changed after generation since (0 = every device), busiest first
+// (dataMutex held)
+static void snapshotDevices(std::vector<DeviceRow>& rows, uint32_t since = 0) {
+    static DeviceId ids[MAX_DEVICES];  // Only used with dataMutex held
+    const DeviceRegistry& reg = deviceRegistry;
+    uint16_t count = bandwidthTracker.getDevicesByTotal(ids);
+    rows.clear();
+    rows.reserve(count);
+    for (uint16_t i = 0; i < count; i++) {
+        if (reg.changed[ids[i]] > since) {
+            rows.emplace_back();
+            snapshotDevice(ids[i], rows.back());
+        }
+    }
+}
+
+// Chunked bodies of /api/devices and /api/blockedDomains
+class DeviceListStream : public JsonArrayStream {
+public:
+    std::vector<DeviceRow> rows;
+protected:
+    size_t count() const override { return rows.size(); }
+    void element(size_t i, JsonDocument& doc) const override { writeDevice(rows[i], doc.to<JsonObject>()); }
+};
+
+class DomainListStream : public JsonArrayStream {
+public:
+    std::vector<String> domains;
+protected:
+    size_t count() const override { return domains.size(); }
+    void element(size_t i, JsonDocument& doc) const override { doc.set(domains[i].c_str()); }
+};
+
+// /api/devices?since= and the push stream's "deviceChanges": the rows
+// changed after since and the MACs removed since then, or every row
+// ("full") when that delta can no longer be built
+struct DeviceChanges {
+    uint32_t since;
+    uint32_t generation;
+    bool full;
+    uint8_t removed[DEVICE_TOMBSTONES][6];
+    uint8_t removedCount;
+    std::shared_ptr<DeviceListStream> rows;
+
+    DeviceChanges() : since(0), generation(0), full(true), removedCount(0),
+                      rows(std::make_shared<DeviceListStream>()) {}
+
+    // Close the registry's generation and copy what changed (dataMutex held)
+    void snapshot(uint32_t from, bool forceFull) {
+        generation = deviceRegistry.seal();
+        full = forceFull || !deviceRegistry.deltaAvailable(from);
+        since = full ? 0 : from;
+        removedCount = full ? 0 : deviceRegistry.removedSince(since, removed);
+        snapshotDevices(rows->rows, since);
+    }
+
+    // The object up to the "devices" array; "}" closes it
+    String head(uint32_t boot) const {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "{\"generation\":%lu,\"boot\":%lu,\"full\":%s",
+                 (unsigned long)generation, (unsigned long)boot, full ? "true" : "false");
+        String out = buf;
+        if (!full) {
+            snprintf(buf, sizeof(buf), ",\"since\":%lu", (unsigned long)since);
+            out += buf;
+        }
+        out += ",\"removed\":[";
+        for (uint8_t i = 0; i < removedCount; i++) {
+            char macStr[MAC_STRING_LEN];
+            formatMAC(removed[i], macStr);
+            out += i ? ",\"" : "\"";
+            out += macStr;
+            out += '"';
+        }
+        out += "],\"devices\":";
+        return out;
+    }
+};
+
+// A stream into one String, stopping once out reaches limit.
+// True if the whole array was written (false too if the stream failed).
+static bool drainStream(JsonArrayStream& stream, String& out, size_t limit = SIZE_MAX) {
+    uint8_t buf[256];
+    while (out.length() < limit) {
+        size_t n = stream.fill(buf, sizeof(buf));
+        if (n == 0) {
+            return !stream.failed();
+        }
+        out.concat((const char*)buf, n);
+    }
+    return false;
+}
+
+// A response reading a shared body in place; each client only holds a reference
+static AsyncWebServerResponse* textResponse(AsyncWebServerRequest* request, std::shared_ptr<const String> text) {
+    return request->beginResponse("application/json", text->length(),
+        [text](uint8_t* buf, size_t maxLen, size_t index) -> size_t {
+            size_t n = text->length() - index;
+            if (n > maxLen) n = maxLen;
+            memcpy(buf, text->c_str() + index, n);
+            return n;
+        });
+}
+
+// head, the rest of stream, then tail, as one chunked response
+static AsyncWebServerResponse* streamResponse(AsyncWebServerRequest* request,
+                                              std::shared_ptr<const String> head,
+                                              std::shared_ptr<JsonArrayStream> stream,
+                                              const char* tail = "") {
+    size_t tailPos = 0;
+    return request->beginChunkedResponse("application/json",
+        [head, stream, tail, tailPos](uint8_t* buf, size_t maxLen, size_t index) mutable -> size_t {
+            if (index < head->length()) {
+                size_t n = head->length() - index;
+                if (n > maxLen) n = maxLen;
+                memcpy(buf, head->c_str() + index, n);
+                return n;
+            }
+            size_t n = stream->fill(buf, maxLen);
+            if (n == 0) {
+                n = strnlen(tail + tailPos, maxLen);
+                memcpy(buf, tail + tailPos, n);
+                tailPos += n;
+            }
+            return n;
+        });
+}
+
+static const size_t ETAG_LEN = 24;  // "c12345678-12345678"
+
+WebDashboard::WebDashboard() :
+    server(WEB_SERVER_PORT),
+    events("/api/events"),
+    _pushInterval(PUSH_INTERVAL_MS),
+    _lastPush(0),
+    _pushFull(false),
+    _pushId(0),
+    _pushFrames(0),
+    _pushBytes(0),
+    _bootTag(0),
+    _settingsGeneration(0),
+    _lastConnected(false),
+    _cacheHits(0),
+    _notModified(0) {
+    memset(_sectionHash, 0, sizeof(_sectionHash));
+    memset(_pushGeneration, 0, sizeof(_pushGeneration));
+    for (uint8_t i = 0; i < CACHE_SLOTS; i++) {
+        _cache[i].generation = 0;
+    }
+}
 
 bool WebDashboard::begin() {
+    setPushInterval(storage.loadPushInterval(PUSH_INTERVAL_MS));
+    _bootTag = esp_random();
     setupRoutes();
     server.begin();
     DEBUG_PRINTF("Web: Server started on port %d\n", WEB_SERVER_PORT);
     return true;
 }
 
+bool WebDashboard::setPushInterval(uint32_t ms) {
+    if (ms < PUSH_INTERVAL_MIN_MS || ms > PUSH_INTERVAL_MAX_MS) {
+        return false;
+    }
+    _pushInterval = ms;
+    settingsChanged();
+    return true;
+}
+
+void WebDashboard::update() {
+    // "connected" is part of /api/settings but changes without a request
+    bool connected = wifiMgr.isConnectedToRouter();
+    if (connected != _lastConnected) {
+        _lastConnected = connected;
+        settingsChanged();
+    }
+
+    unsigned long now = millis();
+    if (now - _lastPush < _pushInterval) {
+        return;
+    }
+    _lastPush = now;
+    if (events.count() == 0) {
+        return;
+    }
+
+    // Snapshot under the mutex, serialize after it is released. Lists whose
+    // generation has not moved since the last frame are skipped outright,
+    // and devices are sent as the rows changed since the last frame.
+    bool full = _pushFull.exchange(false);
+    DeviceChanges devices;
+    DomainListStream domains;
+    JsonDocument status;
+    bool devicesDue, domainsDue;
+    xSemaphoreTake(dataMutex, portMAX_DELAY);
+    uint32_t domainsGen = dnsServer.getBlocklistGeneration();
+    devicesDue = full || deviceRegistry.generation() != _pushGeneration[PUSH_DEVICES];
+    domainsDue = full || domainsGen != _pushGeneration[PUSH_DOMAINS];
+    if (devicesDue) {
+        devices.snapshot(_pushGeneration[PUSH_DEVICES], full);
+        _pushGeneration[PUSH_DEVICES] = devices.generation;
+    }
+    if (domainsDue) {
+        domains.domains = dnsServer.getBlockedDomains();
+    }
+    fillStatus(status.to<JsonObject>());
+    xSemaphoreGive(dataMutex);
+    _pushGeneration[PUSH_DOMAINS] = domainsGen;
+
+    // A list that failed to serialize is left out; the next frame is full
+    String parts[PUSH_SECTIONS];
+    if (devicesDue) {
+        parts[PUSH_DEVICES] = devices.head(_bootTag);
+        if (drainStream(*devices.rows, parts[PUSH_DEVICES])) {
+            parts[PUSH_DEVICES] += '}';
+        } else {
+            parts[PUSH_DEVICES] = "";
+            _pushFull = true;
+        }
+    }
+    if (domainsDue && !drainStream(domains, parts[PUSH_DOMAINS])) {
+        parts[PUSH_DOMAINS] = "";
+        _pushFull = true;
+    }
+    serializeJson(status, parts[PUSH_STATUS]);
+    String frame = buildPushFrame(parts, full);
+
+    if (frame.length() == 0) {
+        return;  // Nothing changed
+    }
+    // One copy of the text, queued to every client
+    events.send(frame.c_str(), "update", ++_pushId);
+    _pushFrames++;
+    _pushBytes += frame.length();
+}
+
+String WebDashboard::buildPushFrame(const String* parts, bool full) {
+    static const char* const SECTION_NAMES[PUSH_SECTIONS] = { "deviceChanges", "domains", "status" };
+
+    String frame;
+    for (uint8_t s = 0; s < PUSH_SECTIONS; s++) {
+        const String& part = parts[s];
+        if (part.length() == 0) {
+            continue;  // Not built, unchanged
+        }
+        uint32_t hash = hashText(part);
+        if (!full && hash == _sectionHash[s]) {
+            continue;
+        }
+        _sectionHash[s] = hash;
+
+        frame += frame.length() ? ",\"" : "{\"";
+        frame += SECTION_NAMES[s];
+        frame += "\":";
+        frame += part;
+    }
+    if (frame.length()) {
+        frame += '}';
+    }
+    return frame;
+}
+
+uint32_t WebDashboard::generation(CacheSlot slot) const {
+    switch (slot) {
+        case CACHE_DEVICES:  return deviceRegistry.generation();
+        case CACHE_DOMAINS:  return dnsServer.getBlocklistGeneration();
+        case CACHE_SETTINGS: return _settingsGeneration;
+        case CACHE_STATUS:   return millis() / 1000;  // Counters move constantly; reuse within a second
+        default:             return 0;
+    }
+}
+
+void WebDashboard::formatETag(CacheSlot slot, uint32_t gen, char* out) const {
+    static const char SLOT_TAGS[CACHE_SLOTS] = { 'd', 'b', 's', 't' };
+    snprintf(out, ETAG_LEN, "\"%c%lx-%lx\"", SLOT_TAGS[slot],
+             (unsigned long)gen, (unsigned long)_bootTag);
+}
+
+void WebDashboard::addCacheHeaders(AsyncWebServerResponse* response, CacheSlot slot, uint32_t gen) const {
+    char etag[ETAG_LEN];
+    formatETag(slot, gen, etag);
+    response->addHeader("ETag", etag);
+    response->addHeader("Cache-Control", "no-cache");  // Revalidate on every use
+}
+
+bool WebDashboard::sendCached(AsyncWebServerRequest* request, CacheSlot slot, uint32_t gen) {
+    if (request->hasHeader("If-None-Match")) {
+        char etag[ETAG_LEN];
+        formatETag(slot, gen, etag);
+        if (request->getHeader("If-None-Match")->value() == etag) {
+            AsyncWebServerResponse* response = request->beginResponse(304);
+            addCacheHeaders(response, slot, gen);
+            request->send(response);
+            _notModified++;
+            return true;
+        }
+    }
+
+    const CachedBody& cached = _cache[slot];
+    if (!cached.body || cached.generation != gen) {
+        return false;
+    }
+    AsyncWebServerResponse* response = textResponse(request, cached.body);
+    addCacheHeaders(response, slot, gen);
+    request->send(response);
+    _cacheHits++;
+    return true;
+}
+
+void WebDashboard::sendFresh(AsyncWebServerRequest* request, CacheSlot slot, uint32_t gen,
+                             std::shared_ptr<const String> body) {
+    _cache[slot].generation = gen;
+    _cache[slot].body = body;
+    AsyncWebServerResponse* response = textResponse(request, body);
+    addCacheHeaders(response, slot, gen);
+    request->send(response);
+}
+
+void WebDashboard::sendFresh(AsyncWebServerRequest* request, CacheSlot slot, uint32_t gen,
+                             std::shared_ptr<JsonArrayStream> stream) {
+    std::shared_ptr<String> text = std::make_shared<String>();
+    if (drainStream(*stream, *text, RESPONSE_CACHE_MAX_BYTES)) {
+        sendFresh(request, slot, gen, std::shared_ptr<const String>(text));
+        return;
+    }
+
+    // Too big to keep (or failed, and not worth keeping): send what was
+    // built, then the rest of the stream
+    AsyncWebServerResponse* response = streamResponse(request, text, stream);
+    addCacheHeaders(response, slot, gen);
+    request->send(response);
+}
+
 void WebDashboard::stop() {
     server.end();
     DEBUG_PRINTLN("Web: Server stopped");
 }
 
 void WebDashboard::setupRoutes() {
-    // Serve dashboard
-    server.on("/", HTTP_GET, [](AsyncWebServerRequest* request) {
-        request->send_P(200, "text/html", INDEX_HTML);
+    // Push stream. Runs on the web task: only flag that the next frame must
+    // be complete; clients over the limit are told to poll.
+    events.onConnect([this](AsyncEventSourceClient* client) {
+        if (events.count() > PUSH_MAX_CLIENTS) {
+            client->send("{}", "busy", 0, 0);
+            client->close();
+            return;
+        }
+        client->send("{}", "hello", _pushId, PUSH_RECONNECT_MS);
+        _pushFull = true;
+    });
+    server.addHandler(&events);
+
+    // Dashboard page, stylesheet and script (web_content.h)
+    for (size_t i = 0; i < WEB_ASSET_COUNT; i++) {
+        const WebAsset& asset = WEB_ASSETS[i];
+        server.on(asset.path, HTTP_GET, [this, &asset](AsyncWebServerRequest* request) {
+            handleGetAsset(request, asset);
+        });
+    }
+
+    // API: Get device history - must be registered before "/api/devices",
+    // which would otherwise match every GET under /api/devices/
+    server.on("^\\/api\\/devices\\/([A-Fa-f0-9:]+)\\/history$", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        handleGetDeviceHistory(request);
+    });
+
+    // API: Get device rate limit (also ahead of "/api/devices")
+    server.on("^\\/api\\/devices\\/([A-Fa-f0-9:]+)\\/limit$", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        handleGetDeviceLimit(request);
+    });
+
+    // API: Get device quota (also ahead of "/api/devices")
+    server.on("^\\/api\\/devices\\/([A-Fa-f0-9:]+)\\/quota$", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        handleGetDeviceQuota(request);
+    });
+
+    // API: Get device online sessions (also ahead of "/api/devices")
+    server.on("^\\/api\\/devices\\/([A-Fa-f0-9:]+)\\/sessions$", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        handleGetDeviceSessions(request);
     });
 
     // API: Get devices
@@ -57,6 +504,29 @@ void WebDashboard::setupRoutes() {
             }
         });
 
+    // API: Set device rate limit
+    server.on("^\\/api\\/devices\\/([A-Fa-f0-9:]+)\\/limit$", HTTP_POST, [](AsyncWebServerRequest* request) {},
+        nullptr,
+        [this](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+            if (index == 0) {
+                handleSetDeviceLimit(request, data, len);
+            }
+        });
+
+    // API: Set device quota
+    server.on("^\\/api\\/devices\\/([A-Fa-f0-9:]+)\\/quota$", HTTP_POST, [](AsyncWebServerRequest* request) {},
+        nullptr,
+        [this](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+            if (index == 0) {
+                handleSetDeviceQuota(request, data, len);
+            }
+        });
+
+    // API: Top flows / remote endpoints (optional ?mac=&limit=)
+    server.on("/api/flows", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        handleGetFlows(request);
+    });
+
     // API: Reset all stats
     server.on("/api/stats/reset", HTTP_POST, [this](AsyncWebServerRequest* request) {
         handleResetAllStats(request);
@@ -113,30 +583,403 @@ void WebDashboard::setupRoutes() {
             }
         });
 
+    // API: Set bandwidth accounting backend
+    server.on("/api/settings/accounting", HTTP_POST, [](AsyncWebServerRequest* request) {},
+        nullptr,
+        [this](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+            if (index == 0) {
+                handleSetAccounting(request, data, len);
+            }
+        });
+
+    // API: Online vendor lookup
+    server.on("/api/settings/vendor", HTTP_POST, [](AsyncWebServerRequest* request) {},
+        nullptr,
+        [this](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+            if (index == 0) {
+                handleSetVendorLookup(request, data, len);
+            }
+        });
+
+    // API: Push stream cadence
+    server.on("/api/settings/push", HTTP_POST, [](AsyncWebServerRequest* request) {},
+        nullptr,
+        [this](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+            if (index == 0) {
+                handleSetPush(request, data, len);
+            }
+        });
+
     // 404 handler
     server.onNotFound([](AsyncWebServerRequest* request) {
         request->send(404, "application/json", "{\"error\":\"Not found\"}");
     });
 }
 
+void WebDashboard::handleGetAsset(AsyncWebServerRequest* request, const WebAsset& asset) {
+    AsyncWebServerResponse* response;
+    if (request->hasHeader("If-None-Match") && request->getHeader("If-None-Match")->value() == asset.etag) {
+        response = request->beginResponse(304);
+    } else {
+        // Stored gzipped; every browser accepts that
+        response = request->beginResponse_P(200, asset.contentType, asset.data, asset.length);
+        response->addHeader("Content-Encoding", "gzip");
+    }
+    response->addHeader("ETag", asset.etag);
+    response->addHeader("Cache-Control", asset.immutable ? "public, max-age=31536000, immutable" : "no-cache");
+    request->send(response);
+}
+
 void WebDashboard::handleGetDevices(AsyncWebServerRequest* request) {
+    if (request->hasParam("since")) {
+        handleGetDeviceChanges(request);
+        return;
+    }
+    if (sendCached(request, CACHE_DEVICES, generation(CACHE_DEVICES))) {
+        return;
+    }
+
+    // Copy the rows under the mutex, serialize them after it is released
+    std::shared_ptr<DeviceListStream> stream = std::make_shared<DeviceListStream>();
+
+    xSemaphoreTake(dataMutex, portMAX_DELAY);
+    uint32_t gen = deviceRegistry.seal();
+    snapshotDevices(stream->rows);
+    xSemaphoreGive(dataMutex);
+
+    sendFresh(request, CACHE_DEVICES, gen, std::shared_ptr<JsonArrayStream>(stream));
+}
+
+void WebDashboard::handleGetDeviceChanges(AsyncWebServerRequest* request) {
+    // A generation from another boot (or none) means nothing; send everything
+    uint32_t since = strtoul(request->getParam("since")->value().c_str(), nullptr, 10);
+    bool sameBoot = request->hasParam("boot") &&
+        strtoul(request->getParam("boot")->value().c_str(), nullptr, 10) == _bootTag;
+
+    DeviceChanges changes;
+    xSemaphoreTake(dataMutex, portMAX_DELAY);
+    changes.snapshot(since, !sameBoot);
+    xSemaphoreGive(dataMutex);
+
+    std::shared_ptr<const String> head = std::make_shared<String>(changes.head(_bootTag));
+    request->send(streamResponse(request, head, changes.rows, "}"));
+}
+
+void WebDashboard::handleGetDeviceHistory(AsyncWebServerRequest* request) {
+    uint8_t mac[6];
+    if (!parseMACFromURL(request, "/history", mac)) {
+        request->send(400, "application/json", "{\"error\":\"Invalid MAC\"}");
+        return;
+    }
+
+    static const HistoryResolution resolutions[] = { HISTORY_SECONDS, HISTORY_MINUTES, HISTORY_HOURS };
+    static const char* resolutionNames[] = { "seconds", "minutes", "hours" };
+
+    String response;
+    bool found = false;
+
+    xSemaphoreTake(dataMutex, portMAX_DELAY);
+    {
+        const BandwidthHistory* history = bandwidthTracker.getDeviceHistory(mac);
+        if (history) {
+            found = true;
+
+            JsonDocument doc;
+            char macStr[MAC_STRING_LEN];
+            formatMAC(mac, macStr);
+            doc["mac"] = macStr;
+            doc["uptime"] = uptimeSeconds();
+
+            // Oldest first; the last element is the current, partial period
+            for (int r = 0; r < 3; r++) {
+                HistoryResolution res = resolutions[r];
+                JsonObject series = doc[resolutionNames[r]].to<JsonObject>();
+                series["interval"] = BandwidthHistory::interval(res);
+                JsonArray up = series["upload"].to<JsonArray>();
+                JsonArray down = series["download"].to<JsonArray>();
+                for (uint8_t i = 0; i < BandwidthHistory::count(res); i++) {
+                    up.add(history->uploadAt(res, i));
+                    down.add(history->downloadAt(res, i));
+                }
+            }
+
+            serializeJson(doc, response);
+        }
+    }
+    xSemaphoreGive(dataMutex);
+
+    if (!found) {
+        request->send(404, "application/json", "{\"error\":\"Device not found\"}");
+        return;
+    }
+    request->send(200, "application/json", response);
+}
+
+void WebDashboard::handleGetDeviceSessions(AsyncWebServerRequest* request) {
+    uint8_t mac[6];
+    if (!parseMACFromURL(request, "/sessions", mac)) {
+        request->send(400, "application/json", "{\"error\":\"Invalid MAC\"}");
+        return;
+    }
+
+    String response;
+    bool found = false;
+
+    xSemaphoreTake(dataMutex, portMAX_DELAY);
+    {
+        // Closed sessions outlive the registry row, so an evicted device
+        // still has its history
+        static PresenceSession sessions[PRESENCE_SESSIONS_MAX];  // Only used with dataMutex held
+        uint8_t count = presence.getSessions(mac, sessions, PRESENCE_SESSIONS_MAX);
+        DeviceId id = deviceRegistry.find(mac);
+        found = count > 0 || id != DEVICE_NONE;
+
+        if (found) {
+            JsonDocument doc;
+            char macStr[MAC_STRING_LEN];
+            formatMAC(mac, macStr);
+            doc["mac"] = macStr;
+            doc["uptime"] = uptimeSeconds();
+            doc["online"] = id != DEVICE_NONE && deviceRegistry.has(id, DEVICE_ONLINE);
+
+            // Newest first; times are uptime seconds, an open session has no end
+            JsonArray arr = doc["sessions"].to<JsonArray>();
+            for (uint8_t i = 0; i < count; i++) {
+                const PresenceSession& s = sessions[i];
+                JsonObject obj = arr.add<JsonObject>();
+                obj["start"] = s.start;
+                if (s.end != 0) {
+                    obj["end"] = s.end;
+                }
+                obj["bytes"] = s.bytes;
+                obj["source"] = PresenceTracker::sourceName(s.source);
+            }
+
+            serializeJson(doc, response);
+        }
+    }
+    xSemaphoreGive(dataMutex);
+
+    if (!found) {
+        request->send(404, "application/json", "{\"error\":\"Device not found\"}");
+        return;
+    }
+    request->send(200, "application/json", response);
+}
+
+void WebDashboard::handleGetDeviceLimit(AsyncWebServerRequest* request) {
+    uint8_t mac[6];
+    if (!parseMACFromURL(request, "/limit", mac)) {
+        request->send(400, "application/json", "{\"error\":\"Invalid MAC\"}");
+        return;
+    }
+
+    uint32_t upLimit, downLimit, upDropped, downDropped;
+    trafficShaper.getLimit(mac, upLimit, downLimit);
+    trafficShaper.getDropped(mac, upDropped, downDropped);
+
+    JsonDocument doc;
+    char macStr[MAC_STRING_LEN];
+    formatMAC(mac, macStr);
+    doc["mac"] = macStr;
+    doc["uploadKbps"] = upLimit;
+    doc["downloadKbps"] = downLimit;
+    doc["uploadDropped"] = upDropped;
+    doc["downloadDropped"] = downDropped;
+
+    String response;
+    serializeJson(doc, response);
+    request->send(200, "application/json", response);
+}
+
+void WebDashboard::handleSetDeviceLimit(AsyncWebServerRequest* request, uint8_t* data, size_t len) {
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(doc, data, len);
+
+    if (error) {
+        request->send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+        return;
+    }
+
+    uint8_t mac[6];
+    if (!parseMACFromURL(request, "/limit", mac)) {
+        request->send(400, "application/json", "{\"error\":\"Invalid MAC\"}");
+        return;
+    }
+
+    // 0 (or omitted) means unlimited in that direction
+    uint32_t upLimit = doc["uploadKbps"] | 0;
+    uint32_t downLimit = doc["downloadKbps"] | 0;
+    if (upLimit > SHAPER_MAX_KBPS || downLimit > SHAPER_MAX_KBPS) {
+        request->send(400, "application/json", "{\"error\":\"Limit too large\"}");
+        return;
+    }
+
+    xSemaphoreTake(dataMutex, portMAX_DELAY);
+    bool ok = trafficShaper.setLimit(mac, upLimit, downLimit);
+    DeviceId id = deviceRegistry.find(mac);
+    if (ok && id != DEVICE_NONE) {
+        deviceRegistry.touch(id);  // Limits are part of the device list
+    }
+    xSemaphoreGive(dataMutex);
+
+    if (!ok) {
+        request->send(507, "application/json", "{\"error\":\"Too many limited devices\"}");
+        return;
+    }
+    request->send(200, "application/json", "{\"success\":true}");
+}
+
+void WebDashboard::handleGetDeviceQuota(AsyncWebServerRequest* request) {
+    uint8_t mac[6];
+    if (!parseMACFromURL(request, "/quota", mac)) {
+        request->send(400, "application/json", "{\"error\":\"Invalid MAC\"}");
+        return;
+    }
+
     String response;
+    bool found = false;
 
     xSemaphoreTake(dataMutex, portMAX_DELAY);
     {
-        std::vector<DeviceStats> stats = bandwidthTracker.getAllStats();
+        const DeviceRegistry& reg = deviceRegistry;
+        DeviceId id = reg.find(mac);
+        if (id != DEVICE_NONE) {
+            found = true;
+            const QuotaConfig& cfg = reg.quotaConfig[id];
+
+            JsonDocument doc;
+            char macStr[MAC_STRING_LEN];
+            formatMAC(mac, macStr);
+            doc["mac"] = macStr;
+            doc["dailyMB"] = (uint32_t)(cfg.dailyBytes / 1000000ULL);
+            doc["monthlyMB"] = (uint32_t)(cfg.monthlyBytes / 1000000ULL);
+            doc["action"] = cfg.action == QUOTA_ACTION_BLOCK_DNS ? "block" : "throttle";
+            doc["throttleKbps"] = cfg.throttleKbps;
+            doc["dayBytes"] = reg.quota[id].dayBytes;
+            doc["monthBytes"] = reg.quota[id].monthBytes;
+            doc["exceeded"] = reg.has(id, DEVICE_QUOTA_EXCEEDED);
+            doc["clockSynced"] = bandwidthTracker.isClockSynced();
+
+            serializeJson(doc, response);
+        }
+    }
+    xSemaphoreGive(dataMutex);
+
+    if (!found) {
+        request->send(404, "application/json", "{\"error\":\"Device not found\"}");
+        return;
+    }
+    request->send(200, "application/json", response);
+}
+
+void WebDashboard::handleSetDeviceQuota(AsyncWebServerRequest* request, uint8_t* data, size_t len) {
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(doc, data, len);
+
+    if (error) {
+        request->send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+        return;
+    }
+
+    uint8_t mac[6];
+    if (!parseMACFromURL(request, "/quota", mac)) {
+        request->send(400, "application/json", "{\"error\":\"Invalid MAC\"}");
+        return;
+    }
+
+    // Caps in MB (10^6 bytes), 0 or omitted = no cap
+    QuotaConfig cfg;
+    cfg.dailyBytes = (uint64_t)(doc["dailyMB"] | 0u) * 1000000ULL;
+    cfg.monthlyBytes = (uint64_t)(doc["monthlyMB"] | 0u) * 1000000ULL;
+    cfg.throttleKbps = doc["throttleKbps"] | 0u;
+    String action = doc["action"] | "throttle";
+    if (action == "throttle") {
+        cfg.action = QUOTA_ACTION_THROTTLE;
+    } else if (action == "block") {
+        cfg.action = QUOTA_ACTION_BLOCK_DNS;
+    } else {
+        request->send(400, "application/json", "{\"error\":\"Action must be throttle or block\"}");
+        return;
+    }
+    if (cfg.throttleKbps > SHAPER_MAX_KBPS) {
+        request->send(400, "application/json", "{\"error\":\"Throttle too large\"}");
+        return;
+    }
+
+    xSemaphoreTake(dataMutex, portMAX_DELAY);
+    bool ok = bandwidthTracker.setDeviceQuota(mac, cfg);
+    xSemaphoreGive(dataMutex);
+
+    if (!ok) {
+        request->send(404, "application/json", "{\"error\":\"Device not found\"}");
+        return;
+    }
+    request->send(200, "application/json", "{\"success\":true}");
+}
+
+void WebDashboard::handleGetFlows(AsyncWebServerRequest* request) {
+    uint8_t mac[6];
+    bool filterMac = false;
+    if (request->hasParam("mac")) {
+        if (!deviceManager.parseMAC(request->getParam("mac")->value(), mac)) {
+            request->send(400, "application/json", "{\"error\":\"Invalid MAC\"}");
+            return;
+        }
+        filterMac = true;
+    }
+
+    int limit = 10;
+    if (request->hasParam("limit")) {
+        limit = request->getParam("limit")->value().toInt();
+    }
+    limit = constrain(limit, 1, FLOW_TOP_MAX);
+
+    static const char* protoNames[] = { "icmp", "tcp", "udp" };
+    const FlowEntry* flows[FLOW_TOP_MAX];
+    FlowTalker remotes[FLOW_TOP_MAX];
+    String response;
+
+    xSemaphoreTake(dataMutex, portMAX_DELAY);
+    {
+        const FlowTable& table = bandwidthTracker.getFlowTable();
+        const uint8_t* macFilter = filterMac ? mac : nullptr;
+        size_t nFlows = table.topFlows(macFilter, flows, limit);
+        size_t nRemotes = table.topRemotes(macFilter, remotes, limit);
+        uint32_t now = millis();
 
         JsonDocument doc;
-        JsonArray arr = doc.to<JsonArray>();
-
-        for (const auto& s : stats) {
-            JsonObject obj = arr.add<JsonObject>();
-            obj["mac"] = deviceManager.macToString(s.mac);
-            obj["name"] = deviceManager.getDeviceName(s.mac);
-            obj["upload"] = s.uploadBytes;
-            obj["download"] = s.downloadBytes;
-            obj["total"] = s.totalBytes();
-            obj["active"] = s.active;
+        doc["active"] = table.size();
+        doc["capacity"] = table.capacity();
+        doc["evictions"] = table.evictions();
+
+        JsonArray flowArr = doc["flows"].to<JsonArray>();
+        for (size_t i = 0; i < nFlows; i++) {
+            const FlowEntry* f = flows[i];
+            JsonObject obj = flowArr.add<JsonObject>();
+            char macStr[MAC_STRING_LEN];
+            formatMAC(f->mac, macStr);
+            obj["mac"] = macStr;
+            obj["proto"] = f->proto == 1 ? protoNames[0] : f->proto == 6 ? protoNames[1] :
+                           f->proto == 17 ? protoNames[2] : "other";
+            obj["localIP"] = IPAddress(f->localIP).toString();
+            obj["localPort"] = f->localPort;
+            obj["remoteIP"] = IPAddress(f->remoteIP).toString();
+            obj["remotePort"] = f->remotePort;
+            obj["upload"] = f->uploadBytes;
+            obj["download"] = f->downloadBytes;
+            obj["packets"] = f->uploadPackets + f->downloadPackets;
+            obj["age"] = (now - f->firstSeen) / 1000;
+            obj["idle"] = (now - f->lastSeen) / 1000;
+        }
+
+        JsonArray remoteArr = doc["remotes"].to<JsonArray>();
+        for (size_t i = 0; i < nRemotes; i++) {
+            JsonObject obj = remoteArr.add<JsonObject>();
+            obj["ip"] = IPAddress(remotes[i].remoteIP).toString();
+            obj["upload"] = remotes[i].uploadBytes;
+            obj["download"] = remotes[i].downloadBytes;
+            obj["flows"] = remotes[i].flows;
         }
 
         serializeJson(doc, response);
@@ -173,9 +1016,13 @@ void WebDashboard::handleSetDeviceName(AsyncWebServerRequest* request, uint8_t*
     String name = doc["name"] | "";
 
     xSemaphoreTake(dataMutex, portMAX_DELAY);
-    deviceManager.setDeviceName(mac, name);
+    bool ok = deviceManager.setDeviceName(mac, name);
     xSemaphoreGive(dataMutex);
 
+    if (!ok) {
+        request->send(507, "application/json", "{\"error\":\"Name not stored (device table or name pool full)\"}");
+        return;
+    }
     request->send(200, "application/json", "{\"success\":true}");
 }
 
@@ -211,24 +1058,18 @@ void WebDashboard::handleResetAllStats(AsyncWebServerRequest* request) {
 }
 
 void WebDashboard::handleGetBlockedDomains(AsyncWebServerRequest* request) {
-    String response;
-
-    xSemaphoreTake(dataMutex, portMAX_DELAY);
-    {
-        std::vector<String> domains = dnsServer.getBlockedDomains();
-
-        JsonDocument doc;
-        JsonArray arr = doc.to<JsonArray>();
+    if (sendCached(request, CACHE_DOMAINS, generation(CACHE_DOMAINS))) {
+        return;
+    }
 
-        for (const auto& d : domains) {
-            arr.add(d);
-        }
+    std::shared_ptr<DomainListStream> stream = std::make_shared<DomainListStream>();
 
-        serializeJson(doc, response);
-    }
+    xSemaphoreTake(dataMutex, portMAX_DELAY);
+    uint32_t gen = dnsServer.getBlocklistGeneration();
+    stream->domains = dnsServer.getBlockedDomains();
     xSemaphoreGive(dataMutex);
 
-    request->send(200, "application/json", response);
+    sendFresh(request, CACHE_DOMAINS, gen, std::shared_ptr<JsonArrayStream>(stream));
 }
 
 void WebDashboard::handleBlockDomain(AsyncWebServerRequest* request, uint8_t* data, size_t len) {
@@ -284,50 +1125,113 @@ void WebDashboard::handleUnblockDomain(AsyncWebServerRequest* request, uint8_t*
 }
 
 void WebDashboard::handleGetStatus(AsyncWebServerRequest* request) {
-    String response;
+    uint32_t gen = generation(CACHE_STATUS);
+    if (sendCached(request, CACHE_STATUS, gen)) {
+        return;
+    }
+
+    // Filled under the mutex, written out after it is released
+    JsonDocument doc;
 
     xSemaphoreTake(dataMutex, portMAX_DELAY);
-    {
-        JsonDocument doc;
+    fillStatus(doc.to<JsonObject>());
+    xSemaphoreGive(dataMutex);
 
-        doc["connected"] = wifiMgr.isConnectedToRouter();
-        doc["staIP"] = wifiMgr.isConnectedToRouter() ? wifiMgr.getSTAIP().toString() : "";
-        doc["apIP"] = wifiMgr.getAPIP().toString();
-        doc["ssid"] = wifiMgr.getSTASSID();
-        doc["clients"] = wifiMgr.getConnectedClients();
-        doc["uptime"] = millis() / 1000;
-        doc["freeHeap"] = ESP.getFreeHeap();
-        doc["minFreeHeap"] = ESP.getMinFreeHeap();
-        doc["cpuFreq"] = ESP.getCpuFreqMHz();
-        doc["loopFreq"] = loopsPerSecond;
-        doc["upstreamDNS"] = dnsServer.getUpstreamDNS().toString();
-        doc["dnsQueries"] = dnsServer.getQueryCount();
-        doc["dnsBlocked"] = dnsServer.getBlockedCount();
-        doc["mdnsHost"] = MDNS_HOSTNAME;
+    std::shared_ptr<String> body = std::make_shared<String>();
+    serializeJson(doc, *body);
+    sendFresh(request, CACHE_STATUS, gen, std::shared_ptr<const String>(body));
+}
 
-        serializeJson(doc, response);
+void WebDashboard::fillStatus(JsonObject doc) {
+    doc["connected"] = wifiMgr.isConnectedToRouter();
+    doc["staIP"] = wifiMgr.isConnectedToRouter() ? wifiMgr.getSTAIP().toString() : "";
+    doc["apIP"] = wifiMgr.getAPIP().toString();
+    doc["ssid"] = wifiMgr.getSTASSID();
+    doc["clients"] = wifiMgr.getConnectedClients();
+    doc["online"] = presence.onlineCount();
+    doc["sessions"] = presence.sessionCount();
+    JsonObject names = doc["names"].to<JsonObject>();
+    names["strings"] = namePool.strings();
+    names["bytes"] = namePool.bytes();
+    names["capacity"] = NamePool::capacity();
+    names["entries"] = NAME_POOL_ENTRIES;
+    names["failed"] = namePool.getFailures();
+    doc["uptime"] = millis() / 1000;
+    doc["freeHeap"] = ESP.getFreeHeap();
+    doc["minFreeHeap"] = ESP.getMinFreeHeap();
+    doc["cpuFreq"] = ESP.getCpuFreqMHz();
+    doc["loopFreq"] = loopsPerSecond;
+    doc["upstreamDNS"] = dnsServer.getUpstreamDNS().toString();
+    doc["dnsQueries"] = dnsServer.getQueryCount();
+    doc["dnsBlocked"] = dnsServer.getBlockedCount();
+    doc["captureRetries"] = natEngine.getRetriesDropped();
+    doc["captureForeign"] = natEngine.getForeignFramesDropped();
+    doc["accounting"] = NATEngine::backendName(natEngine.getAccountingBackend());
+    for (uint8_t b = ACCOUNTING_PROMISCUOUS; b <= ACCOUNTING_NETIF; b++) {
+        CaptureMetrics m = natEngine.getCaptureMetrics((AccountingBackend)b);
+        JsonObject cap = doc["capture"][NATEngine::backendName((AccountingBackend)b)].to<JsonObject>();
+        cap["frames"] = m.frames;
+        cap["cyclesPerFrame"] = m.frames ? (uint32_t)(m.cycles / m.frames) : 0;
     }
-    xSemaphoreGive(dataMutex);
-
-    request->send(200, "application/json", response);
+    doc["shaperDropped"] = trafficShaper.getTotalDropped();
+    uint32_t up = uptimeSeconds();
+    doc["statsSaves"] = statsStore.getSaveCount();
+    doc["statsBytesWritten"] = statsStore.getBytesWritten();
+    doc["statsBytesPerDay"] = up > 0 ? (uint32_t)((uint64_t)statsStore.getBytesWritten() * 86400 / up) : 0;
+    doc["uploadRate"] = (uint32_t)bandwidthTracker.getTotalUploadRate();
+    doc["downloadRate"] = (uint32_t)bandwidthTracker.getTotalDownloadRate();
+    doc["mdnsHost"] = MDNS_HOSTNAME;
+    doc["vendorResolved"] = ouiLookup.getResolvedCount();
+    doc["vendorFailed"] = ouiLookup.getFailedCount();
+    doc["discoveryRounds"] = discovery.getRounds();
+    doc["discoveryResponses"] = discovery.getResponses();
+    ScanMetrics scan = networkScanner.getMetrics();
+    JsonObject arp = doc["scan"].to<JsonObject>();
+    arp["hosts"] = scan.hosts;
+    arp["liveHosts"] = scan.liveHosts;
+    arp["probes"] = scan.probesSent;
+    arp["sweeps"] = scan.sweeps;
+    arp["sweepPeriodMs"] = scan.sweepPeriodMs;
+    arp["lastSweepMs"] = scan.lastSweepMs;
+    arp["liveIntervalMs"] = scan.liveIntervalMs;
+    arp["lockUs"] = scan.lockMicros;
+    arp["changes"] = scan.changes;
+    JsonObject push = doc["push"].to<JsonObject>();
+    push["clients"] = (uint32_t)events.count();
+    push["intervalMs"] = _pushInterval;
+    push["frames"] = _pushFrames;
+    push["bytes"] = _pushBytes;
+    JsonObject cache = doc["responseCache"].to<JsonObject>();
+    cache["hits"] = _cacheHits;
+    cache["notModified"] = _notModified;
 }
 
 void WebDashboard::handleGetSettings(AsyncWebServerRequest* request) {
-    String response;
+    if (sendCached(request, CACHE_SETTINGS, generation(CACHE_SETTINGS))) {
+        return;
+    }
+
+    std::shared_ptr<String> response = std::make_shared<String>();
 
     xSemaphoreTake(dataMutex, portMAX_DELAY);
+    uint32_t gen = _settingsGeneration;
     {
         JsonDocument doc;
 
         doc["upstreamDNS"] = dnsServer.getUpstreamDNS().toString();
         doc["staSSID"] = wifiMgr.getSTASSID();
         doc["connected"] = wifiMgr.isConnectedToRouter();
+        doc["accounting"] = NATEngine::backendName(natEngine.getAccountingBackend());
+        JsonObject vendor = doc["vendorLookup"].to<JsonObject>();
+        vendor["online"] = ouiLookup.isOnlineEnabled();
+        vendor["url"] = ouiLookup.getResolverURL();
+        doc["pushIntervalMs"] = _pushInterval;
 
-        serializeJson(doc, response);
+        serializeJson(doc, *response);
     }
     xSemaphoreGive(dataMutex);
 
-    request->send(200, "application/json", response);
+    sendFresh(request, CACHE_SETTINGS, gen, std::shared_ptr<const String>(response));
 }
 
 void WebDashboard::handleSetDNS(AsyncWebServerRequest* request, uint8_t* data, size_t len) {
@@ -354,7 +1258,83 @@ void WebDashboard::handleSetDNS(AsyncWebServerRequest* request, uint8_t* data, s
     xSemaphoreTake(dataMutex, portMAX_DELAY);
     dnsServer.setUpstreamDNS(dns);
     xSemaphoreGive(dataMutex);
+    settingsChanged();
+
+    request->send(200, "application/json", "{\"success\":true}");
+}
+
+void WebDashboard::handleSetAccounting(AsyncWebServerRequest* request, uint8_t* data, size_t len) {
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(doc, data, len);
+
+    if (error) {
+        request->send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+        return;
+    }
+
+    String backendStr = doc["backend"] | "";
+    AccountingBackend backend;
+    if (backendStr == "promiscuous") {
+        backend = ACCOUNTING_PROMISCUOUS;
+    } else if (backendStr == "netif") {
+        backend = ACCOUNTING_NETIF;
+    } else {
+        request->send(400, "application/json", "{\"error\":\"Backend must be promiscuous or netif\"}");
+        return;
+    }
+
+    xSemaphoreTake(dataMutex, portMAX_DELAY);
+    bool ok = natEngine.setAccountingBackend(backend);
+    xSemaphoreGive(dataMutex);
+    settingsChanged();
+
+    if (!ok) {
+        request->send(500, "application/json", "{\"error\":\"Failed to switch backend\"}");
+        return;
+    }
+    request->send(200, "application/json", "{\"success\":true}");
+}
+
+void WebDashboard::handleSetVendorLookup(AsyncWebServerRequest* request, uint8_t* data, size_t len) {
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(doc, data, len);
+
+    if (error) {
+        request->send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+        return;
+    }
+
+    bool online = doc["online"] | false;
+    String url = doc["url"] | "";
+    url.trim();
+
+    xSemaphoreTake(dataMutex, portMAX_DELAY);
+    bool ok = ouiLookup.setOnline(online, url);
+    xSemaphoreGive(dataMutex);
+    settingsChanged();
 
+    if (!ok) {
+        request->send(400, "application/json", "{\"error\":\"URL must be http(s)://... or file:/path\"}");
+        return;
+    }
+    request->send(200, "application/json", "{\"success\":true}");
+}
+
+void WebDashboard::handleSetPush(AsyncWebServerRequest* request, uint8_t* data, size_t len) {
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(doc, data, len);
+
+    if (error) {
+        request->send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+        return;
+    }
+
+    uint32_t ms = doc["intervalMs"] | 0;
+    if (!setPushInterval(ms)) {
+        request->send(400, "application/json", "{\"error\":\"intervalMs out of range\"}");
+        return;
+    }
+    storage.savePushInterval(ms);
     request->send(200, "application/json", "{\"success\":true}");
 }
 
@@ -381,6 +1361,7 @@ void WebDashboard::handleSetWiFi(AsyncWebServerRequest* request, uint8_t* data,
     // Connect in next loop iteration
     delay(100);
     wifiMgr.connectToRouter(ssid, password);
+    settingsChanged();
 }
 
 String WebDashboard::getContentType(const String& path) {
@@ -390,3 +1371,20 @@ String WebDashboard::getContentType(const String& path) {
     if (path.endsWith(".json")) return "application/json";
     return "text/plain";
 }
+
+// Extract the MAC from a URL of the form /api/devices/{mac}<suffix>
+bool WebDashboard::parseMACFromURL(AsyncWebServerRequest* request, const char* suffix, uint8_t* mac) {
+    String url = request->url();
+    int start = url.indexOf("/devices/") + 9;
+    int end = url.indexOf(suffix, start);
+    if (start < 9 || end < start) {
+        return false;
+    }
+    String macStr = url.substring(start, end);
+
+    // URL decode
+    macStr.replace("%3A", ":");
+    macStr.replace("%3a", ":");
+
+    return deviceManager.parseMAC(macStr, mac);
+}
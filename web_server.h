@@ -3,8 +3,28 @@
 
 #include <Arduino.h>
 #include <ESPAsyncWebServer.h>
+#include <ArduinoJson.h>
+#include <atomic>
+#include <memory>
 #include "config.h"
 
+class JsonArrayStream;
+struct WebAsset;
+
+// REST API, dashboard page and the /api/events push stream.
+//
+// Open dashboards get their data from the push stream instead of polling.
+// update() builds one frame per PUSH interval and the event source hands
+// the same text to every client. Without clients nothing is built. A frame
+// only carries the sections (devices, domains, status) whose JSON changed
+// since the last frame, except right after a client connected, when it
+// carries everything.
+//
+// Each polled data domain (devices, blocklist, settings, status) has a
+// generation that changes whenever its JSON would. GET responses carry it
+// in an ETag, a matching If-None-Match is answered with 304, and the body
+// built for a generation is kept and handed to every client that asks
+// before it changes, without taking dataMutex or serializing again.
 class WebDashboard {
 public:
     WebDashboard();
@@ -12,14 +32,79 @@ public:
     bool begin();
     void stop();
 
+    // Push a frame when one is due (call in loop() without dataMutex held)
+    void update();
+
+    bool setPushInterval(uint32_t ms);
+
 private:
+    enum PushSection : uint8_t { PUSH_DEVICES, PUSH_DOMAINS, PUSH_STATUS, PUSH_SECTIONS };
+    enum CacheSlot : uint8_t { CACHE_DEVICES, CACHE_DOMAINS, CACHE_SETTINGS, CACHE_STATUS, CACHE_SLOTS };
+
+    struct CachedBody {
+        uint32_t generation;
+        std::shared_ptr<const String> body;  // Shared with responses still sending it
+    };
+
     AsyncWebServer server;
+    AsyncEventSource events;
+
+    uint32_t _pushInterval;
+    unsigned long _lastPush;
+    std::atomic<bool> _pushFull;            // Set by the web task on connect
+    uint32_t _sectionHash[PUSH_SECTIONS];   // Of the JSON last sent
+    uint32_t _pushId;
+    uint32_t _pushFrames;
+    uint32_t _pushBytes;
+    uint32_t _pushGeneration[PUSH_SECTIONS];  // Devices and domains last sent
+
+    // Response cache, only touched by the web task
+    CachedBody _cache[CACHE_SLOTS];
+    uint32_t _bootTag;                          // In every ETag, so tags from before a reboot never match
+    std::atomic<uint32_t> _settingsGeneration;  // Bumped by the settings handlers and update()
+    bool _lastConnected;
+    uint32_t _cacheHits;
+    uint32_t _notModified;
+
+    // Current generation of a domain (no mutex needed)
+    uint32_t generation(CacheSlot slot) const;
+    void settingsChanged() { _settingsGeneration++; }
+
+    // 304 or the cached body when either fits gen. False if nothing was sent.
+    bool sendCached(AsyncWebServerRequest* request, CacheSlot slot, uint32_t gen);
+    // Cache a fresh body for gen and send it
+    void sendFresh(AsyncWebServerRequest* request, CacheSlot slot, uint32_t gen,
+                   std::shared_ptr<const String> body);
+    // Same for an array stream; bodies over RESPONSE_CACHE_MAX_BYTES are
+    // streamed and not cached
+    void sendFresh(AsyncWebServerRequest* request, CacheSlot slot, uint32_t gen,
+                   std::shared_ptr<JsonArrayStream> stream);
+    void formatETag(CacheSlot slot, uint32_t gen, char* out) const;
+    void addCacheHeaders(AsyncWebServerResponse* response, CacheSlot slot, uint32_t gen) const;
+
+    // Sections that changed (all if full) as one JSON object, "" if none.
+    // Empty parts were not built and are left out.
+    String buildPushFrame(const String* parts, bool full);
+
+    // Status body for /api/status and the push stream (dataMutex held).
+    // Stores only copied or static strings, so it can be serialized later.
+    void fillStatus(JsonObject doc);
 
     // Route handlers
     void setupRoutes();
 
+    void handleGetAsset(AsyncWebServerRequest* request, const WebAsset& asset);
+
     // API handlers
     void handleGetDevices(AsyncWebServerRequest* request);
+    void handleGetDeviceChanges(AsyncWebServerRequest* request);
+    void handleGetDeviceHistory(AsyncWebServerRequest* request);
+    void handleGetDeviceSessions(AsyncWebServerRequest* request);
+    void handleGetFlows(AsyncWebServerRequest* request);
+    void handleGetDeviceLimit(AsyncWebServerRequest* request);
+    void handleSetDeviceLimit(AsyncWebServerRequest* request, uint8_t* data, size_t len);
+    void handleGetDeviceQuota(AsyncWebServerRequest* request);
+    void handleSetDeviceQuota(AsyncWebServerRequest* request, uint8_t* data, size_t len);
     void handleSetDeviceName(AsyncWebServerRequest* request, uint8_t* data, size_t len);
     void handleResetDevice(AsyncWebServerRequest* request);
     void handleResetAllStats(AsyncWebServerRequest* request);
@@ -29,10 +114,14 @@ private:
     void handleGetStatus(AsyncWebServerRequest* request);
     void handleSetDNS(AsyncWebServerRequest* request, uint8_t* data, size_t len);
     void handleSetWiFi(AsyncWebServerRequest* request, uint8_t* data, size_t len);
+    void handleSetAccounting(AsyncWebServerRequest* request, uint8_t* data, size_t len);
+    void handleSetVendorLookup(AsyncWebServerRequest* request, uint8_t* data, size_t len);
+    void handleSetPush(AsyncWebServerRequest* request, uint8_t* data, size_t len);
     void handleGetSettings(AsyncWebServerRequest* request);
 
     // Utility
     String getContentType(const String& path);
+    bool parseMACFromURL(AsyncWebServerRequest* request, const char* suffix, uint8_t* mac);
 };
 
 extern WebDashboard webDashboard;
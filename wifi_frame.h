@@ -0,0 +1,141 @@
+#ifndef WIFI_FRAME_H
+#define WIFI_FRAME_H
+
+#include <stdint.h>
+#include <string.h>
+
+// 802.11 data frame classification for promiscuous capture.
+//
+// Works out the real MAC header length (QoS control, HT control), strips
+// security overhead (WEP / TKIP / CCMP) and the FCS to get the MSDU size,
+// and reports the retry bit and sequence control so repeated transmissions
+// can be dropped. Only 3-address infrastructure frames are counted: IBSS
+// and 4-address WDS/mesh frames come back as WIFI_FRAME_NOT_INFRA and are
+// ignored. Everything is inline, allocation free and
+// platform independent, so it can run inside an IRAM_ATTR callback and is
+// tested on a host by test/wifi_frame_test.cpp.
+
+enum WifiFrameResult : uint8_t {
+    WIFI_FRAME_OK = 0,
+    WIFI_FRAME_SHORT,         // Truncated or malformed
+    WIFI_FRAME_NOT_DATA,      // Management / control
+    WIFI_FRAME_NO_PAYLOAD,    // Null / QoS-Null / CF-only subtypes
+    WIFI_FRAME_NOT_INFRA,     // IBSS (no DS bits) or 4-address WDS/mesh, ignored
+    WIFI_FRAME_FOREIGN_BSS    // Not addressed through our BSSID
+};
+
+struct WifiFrameInfo {
+    const uint8_t* transmitter;  // addr2
+    const uint8_t* receiver;     // addr1
+    const uint8_t* station;      // Client side of the exchange
+    uint16_t headerLen;          // MAC header incl. QoS/HT control
+    uint16_t msduLen;            // Payload after security and FCS removal
+    uint16_t seqCtrl;            // Sequence number << 4 | fragment number
+    bool isUpload;               // To-DS (station -> AP)
+    bool retry;
+};
+
+static const uint16_t WIFI_FCS_LEN = 4;
+
+// bssid may be null to skip the BSS filter
+static inline WifiFrameResult wifiParseDataFrame(const uint8_t* frame, uint16_t sigLen,
+                                                 const uint8_t* bssid, WifiFrameInfo& out) {
+    if (sigLen < 24 + WIFI_FCS_LEN) return WIFI_FRAME_SHORT;
+
+    uint16_t fc = frame[0] | (frame[1] << 8);
+    uint8_t type = (fc >> 2) & 0x03;
+    uint8_t subtype = (fc >> 4) & 0x0F;
+    if (type != 2) return WIFI_FRAME_NOT_DATA;
+    if (subtype & 0x04) return WIFI_FRAME_NO_PAYLOAD;
+
+    bool toDS = fc & 0x0100;
+    bool fromDS = fc & 0x0200;
+    if (toDS == fromDS) return WIFI_FRAME_NOT_INFRA;
+
+    const uint8_t* addr1 = frame + 4;
+    const uint8_t* addr2 = frame + 10;
+    const uint8_t* frameBssid = toDS ? addr1 : addr2;
+    if (bssid && memcmp(frameBssid, bssid, 6) != 0) return WIFI_FRAME_FOREIGN_BSS;
+
+    // Header: 24 bytes (3-address), +2 QoS control, +4 HT control if Order set on QoS data
+    uint16_t hdr = 24;
+    bool qos = subtype & 0x08;
+    if (qos) {
+        hdr += 2;
+        if (fc & 0x8000) hdr += 4;
+    }
+
+    // Security overhead: IV/header before, MIC/ICV after the payload
+    uint16_t secHead = 0, secTail = 0;
+    if (fc & 0x4000) {
+        if (sigLen < hdr + 4 + WIFI_FCS_LEN) return WIFI_FRAME_SHORT;
+        const uint8_t* iv = frame + hdr;
+        if (iv[3] & 0x20) {
+            // Extended IV: TKIP sets byte 1 to (TSC1 | 0x20) & 0x7F, CCMP leaves byte 2 reserved
+            bool tkip = iv[1] == ((iv[0] | 0x20) & 0x7F);
+            secHead = 8;
+            secTail = tkip ? 12 : 8;  // TKIP: MIC 8 + ICV 4, CCMP: MIC 8
+        } else {
+            secHead = 4;  // WEP IV
+            secTail = 4;  // WEP ICV
+        }
+    }
+
+    uint16_t overhead = hdr + secHead + secTail + WIFI_FCS_LEN;
+    if (sigLen < overhead) return WIFI_FRAME_SHORT;
+
+    out.receiver = addr1;
+    out.transmitter = addr2;
+    out.station = toDS ? addr2 : addr1;
+    out.headerLen = hdr;
+    out.msduLen = sigLen - overhead;
+    out.seqCtrl = frame[22] | (frame[23] << 8);
+    out.isUpload = toDS;
+    out.retry = fc & 0x0800;
+    return WIFI_FRAME_OK;
+}
+
+// Per-station duplicate filter: a frame with the retry bit set and the same
+// sequence control as the last one seen from that station (per direction)
+// is a retransmission of something already counted.
+template <uint8_t Slots>
+class WifiSeqDedup {
+public:
+    WifiSeqDedup() : _next(0) { memset(_entries, 0, sizeof(_entries)); }
+
+    bool isDuplicate(const uint8_t* station, bool isUpload, uint16_t seqCtrl, bool retry) {
+        Entry* e = find(station);
+        uint8_t dir = isUpload ? 0 : 1;
+        bool dup = retry && e->valid[dir] && e->lastSeq[dir] == seqCtrl;
+        e->lastSeq[dir] = seqCtrl;
+        e->valid[dir] = true;
+        return dup;
+    }
+
+private:
+    struct Entry {
+        uint8_t mac[6];
+        bool used;
+        bool valid[2];
+        uint16_t lastSeq[2];
+    };
+
+    Entry _entries[Slots];
+    uint8_t _next;  // Round-robin replacement
+
+    Entry* find(const uint8_t* station) {
+        for (uint8_t i = 0; i < Slots; i++) {
+            if (_entries[i].used && memcmp(_entries[i].mac, station, 6) == 0) {
+                return &_entries[i];
+            }
+        }
+        Entry* e = &_entries[_next];
+        _next = (uint8_t)((_next + 1) % Slots);
+        memcpy(e->mac, station, 6);
+        e->used = true;
+        e->valid[0] = e->valid[1] = false;
+        return e;
+    }
+};
+
+#endif // WIFI_FRAME_H